@@ -36,7 +36,9 @@
 #include <cstring>
 #include <climits>
 
-#include "processing_element.h"
+#include "systolic_array.h"
+#include "clocked_register_array.h"
+#include "aligned_allocator.h"
 
 //#define ACCUMULATOR_ARRAY_DEBUG ACCUMULATOR_ARRAY_DEBUG
 
@@ -72,7 +74,10 @@ enum class SystolicArrayStartupMode
  *                              the MCU that a tile can be read from accumulator array memory.
  *                              This is currently done using the readDiagonal method, to ensure
  *                              that tiles of all heights, down to a height of 1, can be retrieved
- *                              from memory without stalling the systolic array.
+ *                              from memory without stalling the systolic array. Tiles that are not
+ *                              overwritten before their last diagonal is read can alternatively
+ *                              be read row by row using readRow. Both buffers start at a 64 byte
+ *                              boundary, so that the row copies can use aligned vector loads.
  *                              The module has two startup modes: In WeightsPreloaded mode, the
  *                              first weight tile is assumed to already be stored into the
  *                              PE weight registers before the start of the active systolic array
@@ -101,35 +106,28 @@ public:
      * @tparam WeightDatatype           The weight datatype used by the MPU
      * @tparam ActivationDatatype       The activation datatype used by the MPU
      * @tparam AccumulatorDatatype      The accumulator datatype used by the MPU
-     * @param pePtrVector               A pointer to a std::vector of std::unique_ptr objects pointing
-     *                                  to ProcessingElement subclass objects representing the PEs
-     *                                  at the lower edge of the systolic array
-     * @param systolicArrayWidth        The width of the systolic array
+     * @param systolicArrayPtr          A pointer to the systolic array whose lower edge
+     *                                  PEs write to the accumulator array
      * @param accumulatorArrayHeight    The desired height of the accumulator array
      */
     
-    AccumulatorArray(std::vector<std::unique_ptr<
-                        ProcessingElement<WeightDatatype,
+    AccumulatorArray(const SystolicArray<WeightDatatype,
                                             ActivationDatatype,
-                                            AccumulatorDatatype>>>* pePtrVector,
-                                                    const size_t systolicArrayWidth,
-                                                    const size_t accumulatorArrayHeight): m_pePtrVector{pePtrVector},
-                                                                                            m_width{systolicArrayWidth},
+                                            AccumulatorDatatype>* const systolicArrayPtr,
+                                                    const size_t accumulatorArrayHeight): m_systolicArrayPtr{systolicArrayPtr},
+                                                                                            m_width{m_systolicArrayPtr->getWidth()},
                                                                                             m_height{accumulatorArrayHeight},
                                                                                             m_bufferHeight{m_height/2UL},
-                                                                                            m_dataArray(m_width*m_height),
+                                                                                            m_bufferStride{getBufferStride(m_width*m_bufferHeight)},
+                                                                                            m_dataArray(m_bufferStride +
+                                                                                                            m_width*(m_height - m_bufferHeight)),
                                                                                             m_buffer0Address(m_dataArray.begin()),
                                                                                             m_buffer1Address(m_dataArray.begin() +
-                                                                                                                            m_width*
-                                                                                                                            m_bufferHeight),
-                                                                                            m_rowPtrArrayCurrent(m_width),
-                                                                                            m_rowPtrArrayNext(m_width),
-                                                                                            m_rowAdditionCountArrayCurrent(m_width),
-                                                                                            m_rowAdditionCountArrayNext(m_width),
-                                                                                            m_writeAddressSelectBitArrayCurrent(m_width),
-                                                                                            m_writeAddressSelectBitArrayNext(m_width),
-                                                                                            m_firstWeightUpdateDoneArrayCurrent(m_width),
-                                                                                            m_firstWeightUpdateDoneArrayNext(m_width)
+                                                                                                                            m_bufferStride),
+                                                                                            m_rowPtrArray(m_width),
+                                                                                            m_rowAdditionCountArray(m_width),
+                                                                                            m_writeAddressSelectBitArray(m_width),
+                                                                                            m_firstWeightUpdateDoneArray(m_width)
     {
     }
 
@@ -169,17 +167,13 @@ public:
          * number of bits required per accumulator array
          * column.
          * The required bits are the minimum bitwidth of the
-         * row pointers (modelled by m_rowPtrArrayCurrent
-         * and m_rowPtrArrayNext), the minimum bitwidth of
-         * the addition counters (modelled by
-         * m_rowAdditionCountArrayCurrent and
-         * m_rowAdditionCountArrayNext) plus the write
-         * address select bit (modelled by
-         * m_writeAddressSelectBitArrayCurrent and
-         * m_writeAddressSelectBitArrayNext) and the first
+         * row pointers (modelled by m_rowPtrArray), the
+         * minimum bitwidth of the addition counters
+         * (modelled by m_rowAdditionCountArray) plus the
+         * write address select bit (modelled by
+         * m_writeAddressSelectBitArray) and the first
          * weight update done flag bit (modelled by
-         * m_firstWeightUpdateDoneArrayCurrent and
-         * m_firstWeightUpdateDoneArrayNext).
+         * m_firstWeightUpdateDoneArray).
          * Additionally, the addition count needs to be
          * stored.
          * The additional four flag bits not dependent on
@@ -216,7 +210,8 @@ public:
     }
 
     /**
-     * @brief
+     * @brief   Read a diagonal of a result matrix tile from one of the buffers.
+     *          If dest is nullptr, the loads are only counted.
      * @param dest
      * @param destMatrixWidth
      * @param bufferSelectBit
@@ -262,6 +257,12 @@ public:
 
         columnEnd = columnStart - diagonalElements + 1;
 
+        if(!dest)
+        {
+            loadCount += diagonalElements;
+            return;
+        }
+
         for(size_t elementCount{0}; elementCount < diagonalElements;
                                                             ++elementCount)
         {
@@ -314,9 +315,16 @@ public:
         m_gotFirstInputNext = false;
     }
 
+    /**
+     * @brief   Clear the data ready bit. A data ready signal raised
+     *          in the current iteration is kept, as the blocks of
+     *          single row activation matrix blocks are ready in
+     *          consecutive iterations.
+     */
+
     void clearDataReadyBit()
     {
-        m_dataReadyNext = false;
+        m_dataReadyNext = m_dataReadyRaised;
     }
 
     void clearBufferWriteDoneBit()
@@ -326,139 +334,244 @@ public:
 
     void clearFirstUpdateDoneBits()
     {
-        for(size_t elementCount{0}; elementCount < m_width;
-                                                    ++elementCount)
-        {
-            m_firstWeightUpdateDoneArrayNext.at(elementCount) = false;
-        }
+        m_firstWeightUpdateDoneArray.fillNext(false);
     }
 
     void resetCounters()
     {
-        for(size_t elementCount{0}; elementCount < m_width;
-                                                    ++elementCount)
-        {
-            m_rowPtrArrayNext.at(elementCount) = 0UL;
-            m_rowAdditionCountArrayNext.at(elementCount) = 0UL;
-            m_writeAddressSelectBitArrayNext.at(elementCount) = false;
-        }
+        std::vector<std::uint32_t>& rowPtrArrayNext{m_rowPtrArray.next()};
+        std::vector<std::uint32_t>& rowAdditionCountArrayNext{m_rowAdditionCountArray.next()};
+
+        std::fill(rowPtrArrayNext.begin(), rowPtrArrayNext.end(), 0U);
+        std::fill(rowAdditionCountArrayNext.begin(), rowAdditionCountArrayNext.end(), 0U);
+
+        m_writeAddressSelectBitArray.fillNext(false);
     }
 
     void runIteration()
     {
-        for(std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                ActivationDatatype,
-                                                AccumulatorDatatype>>& pePtr : *m_pePtrVector)
+        /* The clocked per-column registers are held as a
+         * whole, only the registers changed in this
+         * iteration are written afterwards. */
+
+        m_rowPtrArray.holdAll();
+        m_rowAdditionCountArray.holdAll();
+        m_writeAddressSelectBitArray.holdAll();
+        m_firstWeightUpdateDoneArray.holdAll();
+
+        const std::vector<std::uint32_t>& rowPtrArrayCurrent{m_rowPtrArray.current()};
+        std::vector<std::uint32_t>& rowPtrArrayNext{m_rowPtrArray.next()};
+
+        const std::vector<std::uint32_t>& rowAdditionCountArrayCurrent{m_rowAdditionCountArray.current()};
+        std::vector<std::uint32_t>& rowAdditionCountArrayNext{m_rowAdditionCountArray.next()};
+
+        for(size_t column{0}; column < m_width; ++column)
         {
-            const size_t column{pePtr->getPosition().x};
+            const bool validSignal{m_systolicArrayPtr->bottomRowHasValidSignal(column)};
 
-            if(pePtr->hasValidSignal())
+            if(validSignal)
             {
                 m_gotFirstInputNext = true;
 
                 auto writeAddress{getBufferAddress(
-                                    m_writeAddressSelectBitArrayCurrent.at(column)) +
-                                        m_width*m_rowPtrArrayCurrent.at(column) + column};
+                                    m_writeAddressSelectBitArray.current(column)) +
+                                        m_width*rowPtrArrayCurrent[column] + column};
 
-                if(m_rowAdditionCountArrayCurrent.at(column) != 0)
+                if(rowAdditionCountArrayCurrent[column] != 0)
                 {
-                   *writeAddress += pePtr->getSum();
+                   *writeAddress += m_systolicArrayPtr->getBottomRowSum(column);
                 }
 
                 else
                 {
-                    *writeAddress = pePtr->getSum();
+                    *writeAddress = m_systolicArrayPtr->getBottomRowSum(column);
                 }
 
 
-                m_rowPtrArrayNext.at(column) =
-                            m_rowPtrArrayCurrent.at(column) + 1;
+                rowPtrArrayNext[column] =
+                            rowPtrArrayCurrent[column] + 1U;
             }
 
-            if(pePtr->hasUpdateWeightSignal())
+            if(m_systolicArrayPtr->bottomRowHasUpdateWeightSignal(column))
             {
                 if(m_systolicArrayStartupModeCurrent ==
                             SystolicArrayStartupMode::WeightsNotPreloaded)
                 {
-                    if(m_firstWeightUpdateDoneArrayCurrent.at(column) == true)
+                    if(m_firstWeightUpdateDoneArray.current(column) == true)
                     {
-                        m_rowPtrArrayNext.at(column) = 0;
-                        m_rowAdditionCountArrayNext.at(column) =
-                                        m_rowAdditionCountArrayCurrent.at(column) + 1;
+                        rowPtrArrayNext[column] = 0U;
+                        rowAdditionCountArrayNext[column] =
+                                        rowAdditionCountArrayCurrent[column] + 1U;
                     }
 
                     else
                     {
-                        m_firstWeightUpdateDoneArrayNext.at(column) = true;
+                        m_firstWeightUpdateDoneArray.setNext(column, true);
                     }
                 }
 
                 else
                 {
-                    m_rowPtrArrayNext.at(column) = 0;
-                    m_rowAdditionCountArrayNext.at(column) =
-                                    m_rowAdditionCountArrayCurrent.at(column) + 1;
+                    rowPtrArrayNext[column] = 0U;
+                    rowAdditionCountArrayNext[column] =
+                                    rowAdditionCountArrayCurrent[column] + 1U;
                 }
 
             }
 
-            if((pePtr->hasValidSignal() || m_gotFirstInputCurrent) &&
+            /* If the activation matrix is multiplied in a single pass,
+             * the row of a single row block carries the update weight
+             * signal ending the block, so the addition count of a valid
+             * row is taken before the update */
+
+            const size_t rowAdditionCount{(validSignal && (m_additionCountCurrent == 1)) ?
+                                            rowAdditionCountArrayCurrent[column] :
+                                            rowAdditionCountArrayNext[column]};
+
+            if((validSignal || m_gotFirstInputCurrent) &&
                                                         (column == 0) &&
-                        (m_rowAdditionCountArrayNext.at(column) ==
-                                            (m_additionCountCurrent - 1)) &&
-                                            (m_rowPtrArrayCurrent.at(column) == 0))
+                        (rowAdditionCount == (m_additionCountCurrent - 1)) &&
+                                            (rowPtrArrayCurrent[column] == 0))
             {
                 m_dataReadyNext = true;
+                m_dataReadyRaised = true;
 
 #ifdef ACCUMULATOR_ARRAY_DEBUG
                 std::cout << "Accumulator array: Buffer: "
-                            << m_writeAddressSelectBitArrayCurrent.at(column)
+                            << m_writeAddressSelectBitArray.current(column)
                             << " data ready" << std::endl;
 #endif
             }
 
             if((column == (m_width - 1)) &&
-                    (m_rowAdditionCountArrayNext.at(column) ==
+                    (rowAdditionCountArrayNext[column] ==
                                              m_additionCountCurrent))
             {
                 m_bufferWriteDoneNext = true;
 
 #ifdef ACCUMULATOR_ARRAY_DEBUG
                 std::cout << "Accumulator array: Buffer "
-                            << m_writeAddressSelectBitArrayCurrent.at(column)
+                            << m_writeAddressSelectBitArray.current(column)
                             << " write done" << std::endl;
 #endif
             }
+        }
+
+        /* Columns whose addition count reached the addition count
+         * of the current multiplication switch buffers. The compare
+         * is evaluated for a word of columns at a time, and the
+         * resulting mask toggles their write address select bits. */
+
+        std::uint64_t* const writeAddressSelectBitWordPtr{
+                                m_writeAddressSelectBitArray.nextWords()};
 
-            if(m_rowAdditionCountArrayNext.at(column) ==
-                                            m_additionCountCurrent)
+        const std::uint32_t additionCount{static_cast<std::uint32_t>(m_additionCountCurrent)};
+
+        for(size_t word{0}; word < m_writeAddressSelectBitArray.wordCount(); ++word)
+        {
+            const size_t columnStart{word*ClockedBitArray::wordBits};
+            const size_t columnEnd{std::min(columnStart + ClockedBitArray::wordBits, m_width)};
+
+            std::uint64_t additionCountReachedMask{0UL};
+
+            for(size_t column{columnStart}; column < columnEnd; ++column)
             {
-                m_rowAdditionCountArrayNext.at(column) = 0;
+                const bool additionCountReached{rowAdditionCountArrayNext[column] == additionCount};
 
-                m_writeAddressSelectBitArrayNext.at(column) =
-                        !m_writeAddressSelectBitArrayCurrent.at(column);
+                additionCountReachedMask |= static_cast<std::uint64_t>(additionCountReached) <<
+                                                                        (column - columnStart);
+
+                rowAdditionCountArrayNext[column] = additionCountReached ? 0U :
+                                                        rowAdditionCountArrayNext[column];
             }
+
+            writeAddressSelectBitWordPtr[word] ^= additionCountReachedMask;
         }
     }
 
-    void updateState()
+    /**
+     * @brief   Get the number of iterations the accumulator array can
+     *          write one row of partial sums per iteration in, without
+     *          raising the data ready or buffer write done signals or
+     *          switching buffers, assuming all bottom row PEs of the
+     *          systolic array hold valid signals and no update weight
+     *          signals. Returns zero if a row pointer of column 0 is at
+     *          the start of a buffer, as the data ready signal is raised
+     *          at that position.
+     */
+
+    size_t getSteadyStateIterationsMax() const
+    {
+        const std::vector<std::uint32_t>& rowPtrArrayCurrent{m_rowPtrArray.current()};
+        const std::vector<std::uint32_t>& rowAdditionCountArrayCurrent{m_rowAdditionCountArray.current()};
+
+        if(m_dataReadyCurrent || (rowPtrArrayCurrent[0] == 0))
+        {
+            return 0UL;
+        }
+
+        size_t iterationsMax{m_bufferHeight};
+
+        for(size_t column{0}; column < m_width; ++column)
+        {
+            if((rowPtrArrayCurrent[column] >= m_bufferHeight) ||
+                    (rowAdditionCountArrayCurrent[column] ==
+                                                m_additionCountCurrent))
+            {
+                return 0UL;
+            }
+
+            iterationsMax = std::min(iterationsMax, m_bufferHeight -
+                                                    rowPtrArrayCurrent[column]);
+        }
+
+        return iterationsMax;
+    }
+
+    /**
+     * @brief               Run a single iteration of steady state operation as
+     *                      determined by getSteadyStateIterationsMax(), writing
+     *                      a row of partial sums provided by the caller instead
+     *                      of the partial sums of the systolic array bottom row
+     * @param rowSumPtr     The partial sums, one per column
+     */
+
+    void runIterationSteadyState(const AccumulatorDatatype* const rowSumPtr)
     {
-        for(size_t elementCount{0}; elementCount < m_width;
-                                                    ++elementCount)
+        const std::vector<std::uint32_t>& rowPtrArrayCurrent{m_rowPtrArray.current()};
+        std::vector<std::uint32_t>& rowPtrArrayNext{m_rowPtrArray.next()};
+
+        const std::vector<std::uint32_t>& rowAdditionCountArrayCurrent{m_rowAdditionCountArray.current()};
+
+        for(size_t column{0}; column < m_width; ++column)
         {
-            m_rowPtrArrayCurrent.at(elementCount) =
-                            m_rowPtrArrayNext.at(elementCount);
+            auto writeAddress{getBufferAddress(
+                                m_writeAddressSelectBitArray.current(column)) +
+                                    m_width*rowPtrArrayCurrent[column] + column};
 
-            m_rowAdditionCountArrayCurrent.at(elementCount) =
-                            m_rowAdditionCountArrayNext.at(elementCount);
+            if(rowAdditionCountArrayCurrent[column] != 0)
+            {
+                *writeAddress += rowSumPtr[column];
+            }
 
-            m_writeAddressSelectBitArrayCurrent.at(elementCount) =
-                            m_writeAddressSelectBitArrayNext.at(elementCount);
+            else
+            {
+                *writeAddress = rowSumPtr[column];
+            }
 
-            m_firstWeightUpdateDoneArrayCurrent.at(elementCount) =
-                            m_firstWeightUpdateDoneArrayNext.at(elementCount);
+            rowPtrArrayNext[column] = rowPtrArrayCurrent[column] + 1U;
         }
 
+        m_gotFirstInputNext = true;
+    }
+
+    void updateState()
+    {
+        m_rowPtrArray.update();
+        m_rowAdditionCountArray.update();
+        m_writeAddressSelectBitArray.update();
+        m_firstWeightUpdateDoneArray.update();
+
         m_additionCountCurrent =
                         m_additionCountNext;
 
@@ -471,6 +584,8 @@ public:
         m_dataReadyCurrent =
                         m_dataReadyNext;
 
+        m_dataReadyRaised = false;
+
         m_bufferWriteDoneCurrent =
                         m_bufferWriteDoneNext;
 
@@ -480,9 +595,12 @@ public:
     {
         for(size_t rowCount = 0; rowCount < m_height; rowCount++)
         {
+            const size_t rowOffset{(rowCount < m_bufferHeight) ? rowCount*m_width :
+                                        (m_bufferStride + (rowCount - m_bufferHeight)*m_width)};
+
             for(size_t columnCount = 0; columnCount < m_width; columnCount++)
             {
-                std::cout << m_dataArray.at(rowCount*m_width + columnCount) << '\t';
+                std::cout << m_dataArray.at(rowOffset + columnCount) << '\t';
             }
 
             std::cout << '\n';
@@ -493,35 +611,54 @@ public:
 
 private:
 
-    typename std::vector<AccumulatorDatatype>::iterator& getBufferAddress(const bool bufferSelectBit)
+    using DataArray = std::vector<AccumulatorDatatype,
+                                    AlignedAllocator<AccumulatorDatatype, 64UL>>;
+
+    /**
+     * @brief               Get the offset of the second buffer, the size of
+     *                      a buffer rounded up to a multiple of 64 byte
+     * @param bufferSize    The number of elements in a buffer
+     */
+
+    static size_t getBufferStride(const size_t bufferSize)
+    {
+        constexpr size_t alignmentElements{(64UL % sizeof(AccumulatorDatatype)) ? 1UL :
+                                                (64UL/sizeof(AccumulatorDatatype))};
+
+        return ((bufferSize + alignmentElements - 1UL)/alignmentElements)*alignmentElements;
+    }
+
+    typename DataArray::iterator& getBufferAddress(const bool bufferSelectBit)
     {
         return (bufferSelectBit == ::low) ? m_buffer0Address :
                                                 m_buffer1Address;
     }
 
-    std::vector<std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                    ActivationDatatype,
-                                                    AccumulatorDatatype>>>* const m_pePtrVector;
+    const SystolicArray<WeightDatatype,
+                            ActivationDatatype,
+                            AccumulatorDatatype>* const m_systolicArrayPtr;
     const size_t m_width;
     const size_t m_height;
     const size_t m_bufferHeight;
+    const size_t m_bufferStride;
+
+    DataArray m_dataArray;
 
-    std::vector<AccumulatorDatatype> m_dataArray;
+    typename DataArray::iterator m_buffer0Address;
+    typename DataArray::iterator m_buffer1Address;
 
-    typename std::vector<AccumulatorDatatype>::iterator m_buffer0Address;
-    typename std::vector<AccumulatorDatatype>::iterator m_buffer1Address;
+    /* The per-column counters are stored in 32 bit registers,
+     * the per-column flags as bit planes. The bitwidths reported
+     * by getControlRegisterBits() are the minimum bitwidths
+     * required by the values they assumed. */
 
-    std::vector<size_t> m_rowPtrArrayCurrent;
-    std::vector<size_t> m_rowPtrArrayNext;
+    ClockedRegisterArray<std::uint32_t> m_rowPtrArray;
 
-    std::vector<size_t> m_rowAdditionCountArrayCurrent;
-    std::vector<size_t> m_rowAdditionCountArrayNext;
+    ClockedRegisterArray<std::uint32_t> m_rowAdditionCountArray;
 
-    std::vector<bool> m_writeAddressSelectBitArrayCurrent;
-    std::vector<bool> m_writeAddressSelectBitArrayNext;
+    ClockedBitArray m_writeAddressSelectBitArray;
 
-    std::vector<bool> m_firstWeightUpdateDoneArrayCurrent;
-    std::vector<bool> m_firstWeightUpdateDoneArrayNext;
+    ClockedBitArray m_firstWeightUpdateDoneArray;
 
     size_t m_additionCountCurrent{0UL};
     size_t m_additionCountNext{0UL};
@@ -538,6 +675,7 @@ private:
 
     bool m_dataReadyCurrent{false};
     bool m_dataReadyNext{false};
+    bool m_dataReadyRaised{false};
 
     bool m_bufferWriteDoneCurrent{false};
     bool m_bufferWriteDoneNext{false};
@@ -30,6 +30,7 @@
 #define ACTIVATION_FIFO_H
 
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <cstdint>
 #include <cassert>
@@ -41,12 +42,16 @@
  *                  systolic array. They are implemented as
  *                  a ring buffer. Data memory is emulated
  *                  using a std::vector of the respective
- *                  datatype. Attempting to push to a full
- *                  FIFO does not result in an error, the
- *                  push operation is simply ignored in
- *                  that case. Popping from an empty FIFO
- *                  causes an assertion failure in debug
- *                  builds.
+ *                  datatype, the capacity of which is rounded
+ *                  up to a power of two, so that the ring
+ *                  buffer is indexed by masking free running
+ *                  read and write counters. A FIFO of the given
+ *                  size holds at most size - 1 activations.
+ *                  Attempting to push to a full FIFO does not
+ *                  result in an error, the push operation is
+ *                  simply ignored in that case. Popping from an
+ *                  empty FIFO causes an assertion failure in
+ *                  debug builds.
  * @tparam DataType The datatype of the stored activations
  */
 
@@ -56,7 +61,10 @@ template<typename DataType> class ActivationFifo
 public:
 
     ActivationFifo(const size_t size): m_size{size},
-                                        m_dataVector(m_size)
+                                        m_indexMask{getCapacity(m_size) - 1UL},
+                                        m_contentSizeEmptyNextIteration{1UL % m_size},
+                                        m_contentSizeEmptyInTwoIterations{2UL % m_size},
+                                        m_dataVector(m_indexMask + 1UL)
     {
     }
 
@@ -64,30 +72,87 @@ public:
     {
         if(!isFull())
         {
-            m_dataVector.at(m_writePtr) = value;
-            m_writePtr = (m_writePtr + 1) % m_size;
-            ++m_contentSize;
+            m_dataVector[m_writeCount & m_indexMask] = value;
+            ++m_writeCount;
         }
     }
 
     DataType pop()
     {
-        DataType returnValue{m_dataVector.at(m_readPtr)};
+        DataType returnValue{m_dataVector[m_readCount & m_indexMask]};
 
         assert(!isEmpty());
 
         if(!isEmpty())
         {
-            m_readPtr = (m_readPtr + 1) % m_size;
-            --m_contentSize;
+            ++m_readCount;
         }
 
         return returnValue;
     }
 
+    /**
+     * @brief           Push a value and pop a value in each of the given
+     *                  number of iterations, as done by the SDSU and the
+     *                  systolic array while streaming activations through
+     *                  a FIFO that is neither full nor empty. As the content
+     *                  size stays constant, the values popped are the values
+     *                  held by the FIFO followed by the values pushed, so
+     *                  they are copied in bulk.
+     * @param inputPtr  The values pushed, one per iteration
+     * @param outputPtr The values popped, one per iteration
+     * @param count     The number of iterations
+     */
+
+    void pushPop(const DataType* const inputPtr,
+                    DataType* const outputPtr,
+                    const size_t count)
+    {
+        const size_t contentSize{getContentSize()};
+
+        /* Pushes to a full FIFO are dropped, which
+         * is handled one iteration at a time */
+
+        if((contentSize + 1UL) >= m_size)
+        {
+            for(size_t iterationCount{0}; iterationCount < count; ++iterationCount)
+            {
+                push(inputPtr[iterationCount]);
+                outputPtr[iterationCount] = pop();
+            }
+
+            return;
+        }
+
+        const size_t storedCount{std::min(contentSize, count)};
+
+        copyFromRingBuffer(m_readCount, outputPtr, storedCount);
+
+        std::copy(inputPtr, inputPtr + (count - storedCount),
+                                        outputPtr + storedCount);
+
+        /* Only the last pushes to each storage
+         * element determine its final value */
+
+        const size_t capacity{m_indexMask + 1UL};
+
+        const size_t writtenCount{std::min(count, capacity)};
+
+        copyToRingBuffer(m_writeCount + count - writtenCount,
+                            inputPtr + count - writtenCount, writtenCount);
+
+        m_writeCount += count;
+        m_readCount += count;
+    }
+
     size_t getContentSize() const
     {
-        return m_contentSize;
+        return m_writeCount - m_readCount;
+    }
+
+    size_t getSize() const
+    {
+        return m_size;
     }
     
     /**
@@ -97,41 +162,81 @@ public:
     void setContent(const std::vector<DataType>& vector)
     {
         assert(vector.size() == m_size);
-        m_dataVector.assign(vector.begin(), vector.end());
-        m_readPtr = 0;
-        m_writePtr = m_size - 1;
-        m_contentSize = m_size - 1;
+        std::copy(vector.begin(), vector.end(), m_dataVector.begin());
+        m_readCount = 0;
+        m_writeCount = m_size - 1;
     }
 
     bool isEmpty() const
     {
-        return m_readPtr == m_writePtr;
+        return m_readCount == m_writeCount;
     }
 
     bool isEmptyNextIteration() const
     {
-        return ((m_readPtr + 1) % m_size) == m_writePtr;
+        return getContentSize() == m_contentSizeEmptyNextIteration;
     }
 
     bool isEmptyInTwoIterations() const
     {
-        return ((m_readPtr + 2) % m_size) == m_writePtr;
+        return getContentSize() == m_contentSizeEmptyInTwoIterations;
     }
 
     bool isFull() const
     {
-        return ((m_writePtr + 1) % m_size) == m_readPtr;
+        return getContentSize() == (m_size - 1UL);
     }
 
 private:
 
+    static size_t getCapacity(const size_t size)
+    {
+        size_t capacity{1UL};
+
+        while(capacity < size)
+        {
+            capacity <<= 1;
+        }
+
+        return capacity;
+    }
+
+    void copyFromRingBuffer(const size_t countStart,
+                                DataType* const outputPtr,
+                                const size_t count) const
+    {
+        const size_t index{countStart & m_indexMask};
+        const size_t countFirst{std::min(count, m_indexMask + 1UL - index)};
+
+        std::copy(m_dataVector.begin() + index,
+                    m_dataVector.begin() + index + countFirst, outputPtr);
+
+        std::copy(m_dataVector.begin(),
+                    m_dataVector.begin() + (count - countFirst), outputPtr + countFirst);
+    }
+
+    void copyToRingBuffer(const size_t countStart,
+                            const DataType* const inputPtr,
+                            const size_t count)
+    {
+        const size_t index{countStart & m_indexMask};
+        const size_t countFirst{std::min(count, m_indexMask + 1UL - index)};
+
+        std::copy(inputPtr, inputPtr + countFirst, m_dataVector.begin() + index);
+
+        std::copy(inputPtr + countFirst, inputPtr + count, m_dataVector.begin());
+    }
+
     const size_t m_size;
+    const size_t m_indexMask;
+
+    const size_t m_contentSizeEmptyNextIteration;
+    const size_t m_contentSizeEmptyInTwoIterations;
 
     std::vector<DataType> m_dataVector;
-    size_t m_readPtr{0};
-    size_t m_writePtr{0};
 
-    size_t m_contentSize{0};
+    size_t m_readCount{0};
+    size_t m_writeCount{0};
 
 };
 
@@ -0,0 +1,97 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        aligned_allocator.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+/**
+ * @class               AlignedAllocator
+ * @brief               Minimal allocator returning memory aligned to the given
+ *                      boundary, used for buffers that are copied in bulk so
+ *                      that the copies can use aligned vector loads
+ * @tparam T            The element datatype
+ * @tparam Alignment    The alignment in bytes, a power of two
+ *                      and a multiple of sizeof(void*)
+ */
+
+template<typename T, size_t Alignment = 64UL> class AlignedAllocator
+{
+
+public:
+
+    using value_type = T;
+
+    template<typename U> struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+    {
+    }
+
+    T* allocate(const size_t count)
+    {
+        void* ptr{nullptr};
+
+        if(posix_memalign(&ptr, Alignment, count*sizeof(T)))
+        {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* const ptr, const size_t)
+    {
+        std::free(ptr);
+    }
+
+};
+
+template<typename T, typename U, size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&,
+                    const AlignedAllocator<U, Alignment>&)
+{
+    return true;
+}
+
+template<typename T, typename U, size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&,
+                    const AlignedAllocator<U, Alignment>&)
+{
+    return false;
+}
+
+#endif
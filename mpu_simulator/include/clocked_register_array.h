@@ -0,0 +1,315 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        clocked_register_array.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef CLOCKED_REGISTER_ARRAY_H
+#define CLOCKED_REGISTER_ARRAY_H
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+/**
+ * @struct      RegisterStorage
+ * @brief       Storage of an array of registers. For a size known at
+ *              compile time, the registers are held in a std::array, so
+ *              that loops over them have constant trip counts. A size of
+ *              zero selects a std::vector sized at runtime.
+ * @tparam T    The register datatype
+ * @tparam Size The number of registers, or zero if only known at runtime
+ */
+
+template<typename T, size_t Size> struct RegisterStorage
+{
+    using Type = std::array<T, Size>;
+
+    static void resize(Type& storage, const size_t size)
+    {
+        assert(size == Size);
+        static_cast<void>(size);
+
+        storage.fill(T());
+    }
+};
+
+template<typename T> struct RegisterStorage<T, 0UL>
+{
+    using Type = std::vector<T>;
+
+    static void resize(Type& storage, const size_t size)
+    {
+        storage.resize(size);
+    }
+};
+
+/**
+ * @class       ClockedRegisterArray
+ * @brief       Array of registers holding the current and the next state
+ *              in two separate buffers. Instead of copying the next state
+ *              into the current state element by element, update() commits
+ *              a cycle by swapping the roles of the two buffers.
+ *              As the next state buffer holds the state of the cycle before
+ *              the current one after a swap, a unit accessing the next
+ *              state using next() has to write every element of it in
+ *              the same cycle. If next() was not called since the last
+ *              call to update(), update() keeps the current state.
+ * @tparam T    The register datatype
+ * @tparam Size The number of registers if known at compile time,
+ *              see RegisterStorage
+ */
+
+template<typename T, size_t Size = 0UL> class ClockedRegisterArray
+{
+
+public:
+
+    using Storage = typename RegisterStorage<T, Size>::Type;
+
+    /**
+     * @brief       ClockedRegisterArray constructor
+     * @param size  The number of registers
+     */
+
+    explicit ClockedRegisterArray(const size_t size): m_bufferArray()
+    {
+        RegisterStorage<T, Size>::resize(m_bufferArray[0], size);
+        RegisterStorage<T, Size>::resize(m_bufferArray[1], size);
+    }
+
+    size_t size() const
+    {
+        return m_bufferArray[0].size();
+    }
+
+    const Storage& current() const
+    {
+        return m_bufferArray[m_currentBufferIndex];
+    }
+
+    /**
+     * @brief   Get the next state buffer for writing. Every
+     *          element has to be written before the next
+     *          call to update().
+     */
+
+    Storage& next()
+    {
+        m_nextWritten = true;
+
+        return m_bufferArray[m_currentBufferIndex ^ 1U];
+    }
+
+    /**
+     * @brief       Keep the current value of a register
+     *              in the next state
+     * @param index The index of the register
+     */
+
+    void hold(const size_t index)
+    {
+        next()[index] = current()[index];
+    }
+
+    /**
+     * @brief   Keep the current value of all
+     *          registers in the next state
+     */
+
+    void holdAll()
+    {
+        const Storage& currentArray{current()};
+
+        std::copy(currentArray.begin(), currentArray.end(), next().begin());
+    }
+
+    bool nextWritten() const
+    {
+        return m_nextWritten;
+    }
+
+    void update()
+    {
+        if(m_nextWritten)
+        {
+            m_currentBufferIndex ^= 1U;
+            m_nextWritten = false;
+        }
+    }
+
+private:
+
+    Storage m_bufferArray[2];
+
+    unsigned int m_currentBufferIndex{0U};
+
+    bool m_nextWritten{false};
+
+};
+
+/**
+ * @class       ClockedBitArray
+ * @brief       Array of single bit registers holding the current and the
+ *              next state, packed into 64 bit words. Follows the buffer
+ *              swapping scheme of ClockedRegisterArray: a unit writing the
+ *              next state has to write every bit of it in the same cycle,
+ *              for example by calling holdAll() first. Bits past the size
+ *              of the array are kept at zero, so that any() and the word
+ *              accessors operate on whole words.
+ */
+
+class ClockedBitArray
+{
+
+public:
+
+    static constexpr size_t wordBits{64UL};
+
+    /**
+     * @brief       ClockedBitArray constructor
+     * @param size  The number of bit registers
+     */
+
+    explicit ClockedBitArray(const size_t size): m_size{size},
+                                                    m_wordCount{(size + wordBits - 1UL)/wordBits},
+                                                    m_bufferArray{std::vector<std::uint64_t>(m_wordCount),
+                                                                    std::vector<std::uint64_t>(m_wordCount)}
+    {
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    size_t wordCount() const
+    {
+        return m_wordCount;
+    }
+
+    bool current(const size_t index) const
+    {
+        return (m_bufferArray[m_currentBufferIndex][index/wordBits] >> (index % wordBits)) & std::uint64_t{1};
+    }
+
+    bool next(const size_t index) const
+    {
+        return (m_bufferArray[m_currentBufferIndex ^ 1U][index/wordBits] >> (index % wordBits)) & std::uint64_t{1};
+    }
+
+    const std::uint64_t* currentWords() const
+    {
+        return m_bufferArray[m_currentBufferIndex].data();
+    }
+
+    /**
+     * @brief   Get the words of the next state for writing.
+     *          Bits past the size of the array must not be set.
+     */
+
+    std::uint64_t* nextWords()
+    {
+        m_nextWritten = true;
+
+        return m_bufferArray[m_currentBufferIndex ^ 1U].data();
+    }
+
+    void setNext(const size_t index, const bool value)
+    {
+        std::uint64_t& word{nextWords()[index/wordBits]};
+
+        const std::uint64_t bit{std::uint64_t{1} << (index % wordBits)};
+
+        word = value ? (word | bit) : (word & ~bit);
+    }
+
+    void holdAll()
+    {
+        const std::vector<std::uint64_t>& currentArray{m_bufferArray[m_currentBufferIndex]};
+
+        std::copy(currentArray.begin(), currentArray.end(), nextWords());
+    }
+
+    void fillNext(const bool value)
+    {
+        std::uint64_t* const nextWordPtr{nextWords()};
+
+        std::fill(nextWordPtr, nextWordPtr + m_wordCount, value ? ~std::uint64_t{0} : std::uint64_t{0});
+
+        if(value && (m_size % wordBits))
+        {
+            nextWordPtr[m_wordCount - 1UL] = (std::uint64_t{1} << (m_size % wordBits)) - 1UL;
+        }
+    }
+
+    bool anyCurrent() const
+    {
+        return any(m_bufferArray[m_currentBufferIndex]);
+    }
+
+    bool anyNext() const
+    {
+        return any(m_bufferArray[m_currentBufferIndex ^ 1U]);
+    }
+
+    void update()
+    {
+        if(m_nextWritten)
+        {
+            m_currentBufferIndex ^= 1U;
+            m_nextWritten = false;
+        }
+    }
+
+private:
+
+    static bool any(const std::vector<std::uint64_t>& wordArray)
+    {
+        std::uint64_t result{0UL};
+
+        for(const std::uint64_t& word : wordArray)
+        {
+            result |= word;
+        }
+
+        return result != 0UL;
+    }
+
+    const size_t m_size;
+    const size_t m_wordCount;
+
+    std::vector<std::uint64_t> m_bufferArray[2];
+
+    unsigned int m_currentBufferIndex{0U};
+
+    bool m_nextWritten{false};
+
+};
+
+#endif
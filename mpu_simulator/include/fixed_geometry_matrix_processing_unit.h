@@ -0,0 +1,128 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        fixed_geometry_matrix_processing_unit.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef FIXED_GEOMETRY_MATRIX_PROCESSING_UNIT_H
+#define FIXED_GEOMETRY_MATRIX_PROCESSING_UNIT_H
+
+#include <cstddef>
+
+#include "systolic_array_structure_of_arrays.h"
+#include "matrix_processing_unit.h"
+
+/**
+ * @class                       FixedGeometryMatrixProcessingUnit
+ * @brief                       MPU with a systolic array geometry and activation FIFO depth
+ *                              fixed at compile time. The systolic array is simulated by the
+ *                              structure of arrays engine specialized for the geometry, which
+ *                              keeps its planes in std::arrays and steps complete rows with
+ *                              row kernels of constant trip count. The MPU is otherwise identical
+ *                              to a MatrixProcessingUnit of the same configuration using the
+ *                              structure of arrays engine, and produces identical results and
+ *                              execution metrics.
+ * @tparam WeightDatatype       The weight datatype used by the MPU
+ * @tparam ActivationDatatype   The activation datatype used by the MPU
+ * @tparam AccumulatorDatatype  The partial sum/result datatype used by the MPU
+ * @tparam Width                The width of the systolic array
+ * @tparam Height               The height of the systolic array
+ * @tparam ActivationFifoDepth  The depth of the activation FIFOs
+ */
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename AccumulatorDatatype,
+            size_t Width,
+            size_t Height,
+            size_t ActivationFifoDepth> class FixedGeometryMatrixProcessingUnit final:
+                                                                public MatrixProcessingUnit<WeightDatatype,
+                                                                                            ActivationDatatype,
+                                                                                            AccumulatorDatatype>
+{
+
+public:
+
+    static_assert((Width != 0UL) && (Height != 0UL) && (ActivationFifoDepth != 0UL),
+                        "Fixed MPU geometry dimensions have to be non-zero");
+
+    /**
+     * @brief                           FixedGeometryMatrixProcessingUnit constructor
+     * @param accumulatorArrayHeight    The height of the accumulator array, at least
+     *                                  twice the systolic array height
+     * @param unifiedBufferSizeByteMax  The maximum size of the unified buffer
+     */
+
+    FixedGeometryMatrixProcessingUnit(const size_t accumulatorArrayHeight,
+                                        const size_t unifiedBufferSizeByteMax):
+                                                MatrixProcessingUnit<WeightDatatype,
+                                                                        ActivationDatatype,
+                                                                        AccumulatorDatatype>(Width,
+                                                                                                Height,
+                                                                                                ActivationFifoDepth,
+                                                                                                accumulatorArrayHeight,
+                                                                                                unifiedBufferSizeByteMax,
+                                                                                                &createSystolicArray)
+    {
+    }
+
+    /**
+     * @brief                       Check if an MPU configuration
+     *                              matches the fixed geometry
+     * @param systolicArrayWidth    The width of the systolic array
+     * @param systolicArrayHeight   The height of the systolic array
+     * @param activationFifoDepth   The depth of the activation FIFOs
+     */
+
+    static constexpr bool matchesGeometry(const size_t systolicArrayWidth,
+                                            const size_t systolicArrayHeight,
+                                            const size_t activationFifoDepth)
+    {
+        return (systolicArrayWidth == Width) &&
+                (systolicArrayHeight == Height) &&
+                (activationFifoDepth == ActivationFifoDepth);
+    }
+
+private:
+
+    static SystolicArray<WeightDatatype,
+                            ActivationDatatype,
+                            AccumulatorDatatype>* createSystolicArray(const SystolicArrayEngine,
+                                                                        const size_t,
+                                                                        const size_t,
+                                                                        const size_t)
+    {
+        return new SystolicArrayStructureOfArrays<WeightDatatype,
+                                                    ActivationDatatype,
+                                                    AccumulatorDatatype,
+                                                    Width,
+                                                    Height>(Width,
+                                                            Height,
+                                                            ActivationFifoDepth);
+    }
+
+};
+
+#endif
@@ -30,24 +30,133 @@
 #define MATRIX_PROCESSING_UNIT_H
 
 #include <vector>
+#include <algorithm>
+#include <memory>
 #include <utility>
 #include <exception>
 #include <cstring>
 #include <cmath>
 #include <cstddef>
 #include <cassert>
+#include <limits>
+#include <type_traits>
+#include <random>
+#include <chrono>
+#include <thread>
+
+#include <omp.h>
 
 #include <eigen3/Eigen/Dense>
 
 #include "mpu_exception.h"
 #include "systolic_data_setup_unit.h"
 #include "systolic_array.h"
+#include "systolic_array_processing_elements.h"
+#include "systolic_array_structure_of_arrays.h"
 #include "weight_fetcher.h"
+#include "ring_buffer_queue.h"
+#include "accumulator_array.h"
 #include "memory_management_unit.h"
+#include "mpu_analytical_model.h"
 #include "mpu_statistics_log_entry.h"
 
 template<typename T> using RMatrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
 
+/**
+ * @enum    MpuSimulationMode
+ * @brief   Selects how matrix multiplications are performed by the MPU.
+ *          CycleAccurate simulates every iteration of all MPU submodules.
+ *          Analytical computes the result matrix using Eigen and derives
+ *          the execution metrics from the tiling of the input matrices
+ *          using MpuAnalyticalModel, without simulating any iteration.
+ *          TileParallel splits the activation matrix row blocks into
+ *          contiguous ranges, and simulates the ranges concurrently on
+ *          private MPU replicas, cycle by cycle. Decoupled splits the
+ *          simulation into a timing pass, which simulates every iteration
+ *          without functional simulation of the systolic array data registers
+ *          and without storing results, and a functional pass, which computes
+ *          the result matrix using Eigen, optionally concurrently with the
+ *          timing pass. All modes produce identical results and execution
+ *          metrics.
+ */
+
+enum class MpuSimulationMode
+{
+    CycleAccurate,
+    Analytical,
+    TileParallel,
+    Decoupled
+};
+
+/**
+ * @enum    MpuVerificationPolicy
+ * @brief   Selects how the result matrix of a cycle accurate or tile
+ *          parallel matrix multiplication is verified. Full recomputes
+ *          the complete product of the input matrices using Eigen.
+ *          Freivalds multiplies the result matrix and the input matrices
+ *          with random vectors, which detects an incorrect result with a
+ *          probability of at least 1 - 2^-rounds at a cost linear in the
+ *          size of the matrices. SampledTiles recomputes randomly selected
+ *          result matrix tiles of the size of an accumulator array buffer.
+ *          Off disables the verification.
+ */
+
+enum class MpuVerificationPolicy
+{
+    Full,
+    Freivalds,
+    SampledTiles,
+    Off
+};
+
+/**
+ * @struct  FreivaldsArithmetic
+ * @brief   Datatypes used by the Freivalds verification. Integer results
+ *          are summed in an unsigned type of at least the size of an
+ *          unsigned int, so that the sums wrap modulo 2^n instead of
+ *          overflowing, and are compared in the unsigned type of the
+ *          accumulator datatype, in which the MPU results wrap. The
+ *          Freivalds identity holds modulo 2^n as well, so the check
+ *          remains valid. Floating point results are summed and
+ *          compared in the accumulator datatype.
+ */
+
+template<typename AccumulatorDatatype,
+            bool IsInteger = std::numeric_limits<AccumulatorDatatype>::is_integer>
+struct FreivaldsArithmetic
+{
+    using SumDatatype = AccumulatorDatatype;
+    using CompareDatatype = AccumulatorDatatype;
+};
+
+template<typename AccumulatorDatatype> struct FreivaldsArithmetic<AccumulatorDatatype, true>
+{
+    using SumDatatype = typename std::make_unsigned<
+                            typename std::common_type<AccumulatorDatatype, int>::type>::type;
+    using CompareDatatype = typename std::make_unsigned<AccumulatorDatatype>::type;
+};
+
+/**
+ * @enum    AccumulatorArrayDrainMode
+ * @brief   Selects how result matrix tiles are read from the accumulator
+ *          array. Diagonal reads one diagonal of each tile in progress per
+ *          iteration, element by element. RowBlock copies each row of a
+ *          tile as one contiguous block in the iteration in which its last
+ *          element is read by the diagonal read, and derives the load counts
+ *          and per column access counts from the tile dimensions. Tiles that
+ *          could be overwritten before their last row is copied are read
+ *          diagonally in both modes. Both modes produce identical results
+ *          and execution metrics. RowBlock is the default of the structure
+ *          of arrays engine, Diagonal the default of the processing element
+ *          engine.
+ */
+
+enum class AccumulatorArrayDrainMode
+{
+    Diagonal,
+    RowBlock
+};
+
 /**
  * @struct  AccumulatorArrayReadOperation
  * @brief   Struct containing the data required for performing
@@ -61,6 +170,8 @@ template<typename T> using RMatrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dyn
 struct AccumulatorArrayReadOperation
 {
 
+    AccumulatorArrayReadOperation() = default;
+
     /**
      * @brief                                   AccumulatorArrayReadOperation constructor
      * @param destMatrixRowStart                The row of the result matrix tile within the result matrix
@@ -69,29 +180,34 @@ struct AccumulatorArrayReadOperation
      *                                          of the buffer containing the result matrix tile
      * @param blockHeight                       The height of the result matrix tile
      * @param blockWidth                        The width of the result matrix tile
+     * @param rowBlockCopy                      If true, the rows of the tile are copied as
+     *                                          contiguous blocks instead of being read diagonally
      */
     
     AccumulatorArrayReadOperation(const size_t destMatrixRowStart,
                                     const size_t destMatrixColumnStart,
                                     const bool accumulatorArrayBufferSelectBit,
                                     const size_t blockHeight,
-                                    const size_t blockWidth): destMatrixRowStart{destMatrixRowStart},
+                                    const size_t blockWidth,
+                                    const bool rowBlockCopy): destMatrixRowStart{destMatrixRowStart},
                                                                 destMatrixColumnStart{destMatrixColumnStart},
                                                                 blockHeight{blockHeight},
                                                                 blockWidth{blockWidth},
                                                                 blockDiagonals{blockHeight + blockWidth - 1},
-                                                                accumulatorArrayBufferSelectBit{accumulatorArrayBufferSelectBit}
+                                                                accumulatorArrayBufferSelectBit{accumulatorArrayBufferSelectBit},
+                                                                rowBlockCopy{rowBlockCopy}
     {
     }
 
-    size_t destMatrixRowStart;
-    size_t destMatrixColumnStart;
-    size_t blockHeight;
-    size_t blockWidth;
-    size_t blockDiagonals;
+    size_t destMatrixRowStart{0UL};
+    size_t destMatrixColumnStart{0UL};
+    size_t blockHeight{0UL};
+    size_t blockWidth{0UL};
+    size_t blockDiagonals{0UL};
     size_t diagonalCoordinate{0UL};
 
-    bool accumulatorArrayBufferSelectBit;
+    bool accumulatorArrayBufferSelectBit{false};
+    bool rowBlockCopy{false};
 };
 
 /**
@@ -115,51 +231,28 @@ public:
      * @param systolicArrayWidth        The width of the systolic array
      * @param systolicArrayHeight       The height of the systolic array
      * @param activationFifoDepth       The depth of the activation FIFOs connecting the SDSU and the systolic array
-     * @param accumulatorArrayHeight    The height of the accumulator array
+     * @param accumulatorArrayHeight    The height of the accumulator array, at least
+     *                                  twice the systolic array height
      * @param unifiedBufferSizeByteMax  The maximum size of the unified buffer
+     * @param systolicArrayEngine       The engine used to simulate the systolic array
      */
     
     MatrixProcessingUnit(const size_t systolicArrayWidth,
                             const size_t systolicArrayHeight,
                             const size_t activationFifoDepth,
                             const size_t accumulatorArrayHeight,
-                            const size_t unifiedBufferSizeByteMax): m_systolicArrayWidth{systolicArrayWidth},
-                                                                    m_systolicArrayHeight{systolicArrayHeight},
-                                                                    m_systolicArrayDiagonals{m_systolicArrayWidth +
-                                                                                            m_systolicArrayHeight - 1UL},
-                                                                    m_activationFifoDepth{activationFifoDepth},
-                                                                    m_accumulatorArrayHeight{accumulatorArrayHeight},
-                                                                    m_accumulatorArrayBufferHeight{m_accumulatorArrayHeight/2UL},
-                                                                    m_unifiedBufferSizeByteMax{unifiedBufferSizeByteMax},
-                                                                    m_systolicArray(m_systolicArrayWidth,
-                                                                                        m_systolicArrayHeight,
-                                                                                        m_activationFifoDepth),
-                                                                    m_systolicDataSetupUnit(
-                                                                                m_systolicArray.getActivationFifoArrayPtr()),
-                                                                    m_weightFetcher(&m_systolicArray),
-                                                                    m_accumulatorArray(m_systolicArray.getBottomPePtrRowPtr(),
-                                                                                                            m_systolicArrayWidth,
-                                                                                                            accumulatorArrayHeight),
-                                                                    m_memoryManagementUnit(&m_unifiedBuffer,
-                                                                                                m_unifiedBufferSizeByteMax)
+                            const size_t unifiedBufferSizeByteMax,
+                            const SystolicArrayEngine systolicArrayEngine =
+                                                SystolicArrayEngine::ProcessingElements):
+                                                                    MatrixProcessingUnit(systolicArrayWidth,
+                                                                                            systolicArrayHeight,
+                                                                                            activationFifoDepth,
+                                                                                            accumulatorArrayHeight,
+                                                                                            unifiedBufferSizeByteMax,
+                                                                                            systolicArrayEngine,
+                                                                                            &createSystolicArray,
+                                                                                            false)
     {
-        std::cout << "Constructed MPU object\n\tWeights size: "
-                    << sizeof(WeightDatatype)
-                    << " byte\n\tActivations datatype size: "
-                    << sizeof(ActivationDatatype)
-                    << " byte\n\tResults datatype size: "
-                    << sizeof(AccumulatorDatatype)
-                    << " byte\n\tSystolic array height: "
-                    << m_systolicArrayHeight 
-                    << "\n\tSystolic array width: "
-                    << m_systolicArrayWidth
-                    << "\n\tActivation FIFO depth: "
-                    << m_activationFifoDepth
-                    << "\n\tAccumulator array height: "
-                    << m_accumulatorArrayHeight
-                    << "\n\tMax unified buffer size: "
-                    << m_unifiedBufferSizeByteMax
-                    << " byte" << std::endl;
     }
 
     size_t getActivationMatrixBlocksYBitwidthMin() const
@@ -204,6 +297,29 @@ public:
                 std::ceil(std::log2(getSystolicArrayDiagonals())) + 1UL;
     }
 
+    /**
+     * @brief   Get the mean length of the accumulator array read
+     *          operation queue seen by the read operations added since
+     *          the data movement metrics were last reset, including
+     *          the read operation itself
+     */
+
+    double getAccumulatorArrayReadOperationQueueOccupancyMean() const
+    {
+        return m_accumulatorArrayReadOperationQueue.getOccupancyMean();
+    }
+
+    /**
+     * @brief   Get the mean length of the weight fetcher update request
+     *          queue seen by the requests issued since the data movement
+     *          metrics were last reset, including the request itself
+     */
+
+    double getWeightUpdateRequestQueueOccupancyMean() const
+    {
+        return m_weightFetcher.getWeightUpdateRequestQueueOccupancyMean();
+    }
+
     size_t getControlRegisterBitsMpu() const
     {
 
@@ -221,8 +337,8 @@ public:
     {
         return m_systolicDataSetupUnit.getControlRegisterBits(
                     m_memoryManagementUnit.getMemoryUsageMaxByte()) +
-                m_systolicArray.getControlRegisterBitsSystolicArray() +
-                m_systolicArray.getControlRegisterBitsActivationFifos() +
+                m_systolicArrayPtr->getControlRegisterBitsSystolicArray() +
+                m_systolicArrayPtr->getControlRegisterBitsActivationFifos() +
                 m_weightFetcher.getControlRegisterBits(
                     m_memoryManagementUnit.getMemoryUsageMaxByte()) +
                 m_accumulatorArray.getControlRegisterBits() +
@@ -231,8 +347,8 @@ public:
 
     size_t getDataRegisterBits() const
     {
-        return m_systolicArray.getDataRegisterBitsSystolicArray() +
-                m_systolicArray.getDataRegisterBitsActivationFifos() +
+        return m_systolicArrayPtr->getDataRegisterBitsSystolicArray() +
+                m_systolicArrayPtr->getDataRegisterBitsActivationFifos() +
                 m_accumulatorArray.getDataRegisterBits();
     }
 
@@ -255,6 +371,7 @@ public:
     void resetDataMovementAndFootprintMetrics()
     {
         m_accumulatorArrayReadOperationQueueLengthMax = 0UL;
+        m_accumulatorArrayReadOperationQueue.resetOccupancyStatistics();
         m_activationMatrixBlocksYMax = 0UL;
         m_activationMatrixRowsLastBlockMax = 0UL;
         m_weightMatrixBlocksXMax = 0UL;
@@ -267,7 +384,7 @@ public:
 
         m_systolicDataSetupUnit.resetLoadCount();
         m_systolicDataSetupUnit.resetMaxRegisterValues();
-        m_systolicArray.resetExecutionMetrics();
+        m_systolicArrayPtr->resetExecutionMetrics();
         m_weightFetcher.resetDataMovementCounters();
         m_accumulatorArray.resetAdditionCountMaxValue();
     }
@@ -293,11 +410,195 @@ public:
         return m_systolicArrayDiagonals;
     }
 
+    SystolicArrayEngine getSystolicArrayEngine() const
+    {
+        return m_systolicArrayEngine;
+    }
+
+    /**
+     * @brief                   Select how result matrix tiles are read from
+     *                          the accumulator array, see AccumulatorArrayDrainMode
+     * @param drainMode         The accumulator array drain mode
+     */
+
+    void setAccumulatorArrayDrainMode(const AccumulatorArrayDrainMode drainMode)
+    {
+        m_accumulatorArrayDrainMode = drainMode;
+    }
+
+    AccumulatorArrayDrainMode getAccumulatorArrayDrainMode() const
+    {
+        return m_accumulatorArrayDrainMode;
+    }
+
     size_t getActivationFifoDepth() const
     {
         return m_activationFifoDepth;
     }
 
+    void setSimulationMode(const MpuSimulationMode simulationMode)
+    {
+        m_simulationMode = simulationMode;
+    }
+
+    MpuSimulationMode getSimulationMode() const
+    {
+        return m_simulationMode;
+    }
+
+    /**
+     * @brief                           Select if the functional pass of the decoupled
+     *                                  simulation mode runs on a separate thread
+     *                                  concurrently with the timing pass, or after it
+     *                                  on the calling thread. It runs concurrently by
+     *                                  default.
+     * @param functionalPassConcurrent  The value of the flag
+     */
+
+    void setDecoupledFunctionalPassConcurrent(const bool functionalPassConcurrent)
+    {
+        m_decoupledFunctionalPassConcurrent = functionalPassConcurrent;
+    }
+
+    bool getDecoupledFunctionalPassConcurrent() const
+    {
+        return m_decoupledFunctionalPassConcurrent;
+    }
+
+    /**
+     * @brief                       Enable or disable skipping of steady state
+     *                              iterations in cycle accurate simulation mode.
+     *                              Skipping is enabled by default. It does not
+     *                              change the results or any execution metric.
+     * @param steadyStateSkipping   The value of the flag
+     */
+
+    void setSteadyStateSkipping(const bool steadyStateSkipping)
+    {
+        m_steadyStateSkipping = steadyStateSkipping;
+    }
+
+    bool getSteadyStateSkipping() const
+    {
+        return m_steadyStateSkipping;
+    }
+
+    /**
+     * @brief               Set the number of workers computing the rows of the
+     *                      systolic array in each simulated cycle. By default, the
+     *                      maximum number of OpenMP threads is used. The number is
+     *                      limited to the systolic array height.
+     * @param workerCount   The number of workers, including the calling thread
+     */
+
+    void setSystolicArrayWorkerCount(const size_t workerCount)
+    {
+        m_systolicArrayPtr->setWorkerCount(workerCount);
+    }
+
+    size_t getSystolicArrayWorkerCount() const
+    {
+        return m_systolicArrayPtr->getWorkerCount();
+    }
+
+    /**
+     * @brief                           Select how the systolic array executes skipped
+     *                                  steady state iterations, see SteadyStateExecutionMode
+     * @param steadyStateExecutionMode  The steady state execution mode
+     */
+
+    void setSteadyStateExecutionMode(const SteadyStateExecutionMode steadyStateExecutionMode)
+    {
+        m_systolicArrayPtr->setSteadyStateExecutionMode(steadyStateExecutionMode);
+    }
+
+    SteadyStateExecutionMode getSteadyStateExecutionMode() const
+    {
+        return m_systolicArrayPtr->getSteadyStateExecutionMode();
+    }
+
+    void setTemporalTileIterations(const size_t tileIterations)
+    {
+        m_systolicArrayPtr->setTemporalTileIterations(tileIterations);
+    }
+
+    size_t getTemporalTileIterations() const
+    {
+        return m_systolicArrayPtr->getTemporalTileIterations();
+    }
+
+    /**
+     * @brief               Set the maximum number of tile replicas used in the
+     *                      tile parallel simulation mode. By default, the maximum
+     *                      number of OpenMP threads is used.
+     * @param replicaCount  The number of replicas, at least 1
+     */
+
+    void setTileReplicaCount(const size_t replicaCount)
+    {
+        if(!replicaCount)
+        {
+            throw MpuException("Tile replica count must be at least 1");
+        }
+
+        m_tileReplicaCount = replicaCount;
+    }
+
+    size_t getTileReplicaCount() const
+    {
+        return m_tileReplicaCount;
+    }
+
+    /**
+     * @brief                       Select how the result matrices of cycle accurate
+     *                              and tile parallel multiplications are verified,
+     *                              see MpuVerificationPolicy. Results are fully
+     *                              verified by default.
+     * @param verificationPolicy    The verification policy
+     */
+
+    void setVerificationPolicy(const MpuVerificationPolicy verificationPolicy)
+    {
+        m_verificationPolicy = verificationPolicy;
+    }
+
+    MpuVerificationPolicy getVerificationPolicy() const
+    {
+        return m_verificationPolicy;
+    }
+
+    /**
+     * @brief                       Set the number of random vectors used by the
+     *                              Freivalds verification, or the number of tiles
+     *                              recomputed by the sampled tile verification
+     * @param verificationRounds    The number of rounds, at least 1
+     */
+
+    void setVerificationRounds(const size_t verificationRounds)
+    {
+        if(!verificationRounds)
+        {
+            throw MpuException("Verification round count must be at least 1");
+        }
+
+        m_verificationRounds = verificationRounds;
+    }
+
+    size_t getVerificationRounds() const
+    {
+        return m_verificationRounds;
+    }
+
+    /**
+     * @brief   Get the host time spent verifying the result
+     *          matrix of the last matrix multiplication
+     */
+
+    double getVerificationTimeSeconds() const
+    {
+        return m_verificationTimeSeconds;
+    }
+
     size_t getAccumulatorBufferHeight() const
     {
         return m_accumulatorArrayBufferHeight;
@@ -397,6 +698,47 @@ public:
                                                 columns);
     }
     
+    /**
+     * @brief                   Function to allocate the unified buffer space of a weight
+     *                          matrix, so that it can be written in place instead of
+     *                          being copied in by storeWeightMatrix. Unified buffer
+     *                          footprint accounting is the same as for storeWeightMatrix.
+     * @param operationName     The string identifier of the weight matrix
+     * @param rows              The rows of the weight matrix
+     * @param columns           The columns of the weight matrix
+     * @return                  A pointer to the weight matrix in the unified buffer,
+     *                          valid until the next store, allocation, or multiplication
+     */
+
+    WeightDatatype* allocateWeightMatrix(const std::string& operationName,
+                                                    const size_t rows,
+                                                    const size_t columns)
+    {
+        return m_memoryManagementUnit.allocateWeightMatrixManaged(
+                                                    operationName,
+                                                    rows,
+                                                    columns);
+    }
+
+    /**
+     * @brief           Function to allocate the unified buffer space of the activation
+     *                  matrix, so that it can be written in place instead of being
+     *                  copied in by storeActivationMatrix. Unified buffer footprint
+     *                  accounting is the same as for storeActivationMatrix.
+     * @param rows      The rows of the activation matrix
+     * @param columns   The columns of the activation matrix
+     * @return          A pointer to the activation matrix in the unified buffer,
+     *                  valid until the next store, allocation, or multiplication
+     */
+
+    ActivationDatatype* allocateActivationMatrix(const size_t rows,
+                                                    const size_t columns)
+    {
+        return m_memoryManagementUnit.allocateActivationMatrixManaged(
+                                                                rows,
+                                                                columns);
+    }
+
     /**
      * @brief       Function to load result matrices from the unified buffer
      * @param dest  A pointer to which the result matrix will be stored
@@ -409,6 +751,18 @@ public:
         m_memoryManagementUnit.loadResultMatrixManaged(dest, size);
     }
 
+    /**
+     * @brief   Function to read the result matrix of the last multiplication
+     *          in place, without copying it out of the unified buffer
+     * @return  A read-only pointer to the row major result matrix in the unified
+     *          buffer, valid until the next store, allocation, or multiplication
+     */
+
+    const AccumulatorDatatype* getResultMatrixView() const
+    {
+        return m_memoryManagementUnit.getResultMatrixPtrManaged();
+    }
+
     void printUnifiedBufferLayout() const
     {
         m_memoryManagementUnit.printMemoryLayout();
@@ -475,89 +829,393 @@ public:
                                     "matrix outside MPU address space");
         }
 
-        /* Startup */
+        m_verificationTimeSeconds = 0.0;
 
-        if(m_debugFlag)
+        if(m_simulationMode == MpuSimulationMode::Analytical)
         {
-            std::cout << "Matrix Processing Unit: Matrix multiplication: "
-                        << "Startup\nInput matrix dimensions:\tM: " << sizeM
-                        << "\tN: " << sizeN << "\tK: " << sizeK << std::endl;
+            runMultiplicationAnalytical(sizeM, sizeN, sizeK,
+                                            matrixAPtr, matrixBPtr, matrixCPtr);
+            return;
         }
 
-        m_weightMatrixBlockCoordinateX = 0UL;
-        m_weightMatrixBlockCoordinateY = 0UL;
-
-        m_weightFetcherActivationMatrixRowBlockCoordinate = 0UL;
-        m_systolicArrayActivationMatrixRowBlockCoordinate = 0UL;
-
-        m_resultMatrixReadInProgressBlockCoordinateX = 0UL;
-        m_resultMatrixReadInProgressBlockCoordinateY = 0UL;
-
-        m_resultMatrixReadDoneBlockCoordinateX = 0UL;
-        m_resultMatrixReadDoneBlockCoordinateY = 0UL;
-
-        m_accumulatorArrayBufferSelectBit = false;
-
-        m_weightFetcher.setInput(matrixBPtr, sizeN, sizeK);
-        m_weightFetcher.clearWeightUpdateRequestQueue();
-        m_weightFetcher.updateState();
-
-        m_weightMatrixBlocksX = m_weightFetcher.getBlockCountX();
-
-        if(m_weightMatrixBlocksXMax < m_weightMatrixBlocksX)
+        if(m_simulationMode == MpuSimulationMode::TileParallel)
         {
-            m_weightMatrixBlocksXMax = m_weightMatrixBlocksX;
+            runMultiplicationTileParallel(sizeM, sizeN, sizeK,
+                                            matrixAPtr, matrixBPtr, matrixCPtr);
         }
 
-        m_weightMatrixBlocksY = m_weightFetcher.getBlockCountY();
+        else if(m_simulationMode == MpuSimulationMode::Decoupled)
+        {
+            runMultiplicationDecoupled(sizeM, sizeN, sizeK,
+                                        matrixAPtr, matrixBPtr, matrixCPtr);
+        }
 
-        if(m_weightMatrixBlocksYMax < m_weightMatrixBlocksY)
+        else
         {
-            m_weightMatrixBlocksYMax = m_weightMatrixBlocksY;
+            runMultiplicationCycleAccurate(sizeM, sizeN, sizeK,
+                                            matrixAPtr, matrixBPtr, matrixCPtr,
+                                            0UL, std::numeric_limits<size_t>::max());
         }
 
-        m_weightMatrixColumnsLastBlock =
-                        m_weightFetcher.getActiveColumnsLastBlock();
+        bool sanityCheckPassed{true};
 
-        if(m_weightMatrixColumnsLastBlockMax < m_weightMatrixColumnsLastBlock)
+        if(m_verificationPolicy != MpuVerificationPolicy::Off)
         {
-            m_weightMatrixColumnsLastBlockMax = m_weightMatrixColumnsLastBlock;
-        }
+            const std::chrono::steady_clock::time_point verificationTimeStart{
+                                                            std::chrono::steady_clock::now()};
 
-        m_systolicDataSetupUnit.addInputMatrix(matrixAPtr, sizeK,
-                                    (m_accumulatorArrayBufferHeight < sizeM) ?
-                                                        m_accumulatorArrayBufferHeight : sizeM,
-                                                                            m_weightMatrixBlocksX);
+            sanityCheckPassed = verifyResultMatrix(sizeM, sizeN, sizeK,
+                                                    matrixAPtr, matrixBPtr, matrixCPtr);
 
-        m_activationMatrixBlocksY =
-                            std::ceil(static_cast<float>(sizeM)/
-                                        static_cast<float>(m_accumulatorArrayBufferHeight));
+            m_verificationTimeSeconds = std::chrono::duration<double>(
+                                                std::chrono::steady_clock::now() -
+                                                                verificationTimeStart).count();
+        }
 
-        if(m_activationMatrixBlocksYMax < m_activationMatrixBlocksY)
+        if(m_debugFlag)
         {
-            m_activationMatrixBlocksYMax = m_activationMatrixBlocksY;
+            std::cout << "Sanity check "
+                        << (sanityCheckPassed ? "passed" : "failed") << std::endl;
         }
 
-        m_activationMatrixRowsLastBlock =
-                            m_accumulatorArrayBufferHeight*(1L - m_activationMatrixBlocksY) + sizeM;
+        assert(sanityCheckPassed);
 
-        if(m_activationMatrixRowsLastBlockMax <
-                                m_activationMatrixRowsLastBlock)
+        if(!sanityCheckPassed)
         {
-            m_activationMatrixRowsLastBlockMax =
-                            m_activationMatrixRowsLastBlock;
+            throw MpuException("MPU: Matrix multiplication "
+                                    "result failed sanity check");
         }
 
-        m_activationMatrixBlockCoordinateY = 1UL;
-
         if(m_debugFlag)
         {
-            std::cout << "Weight matrix:\nBlock count x: "
-                                << m_weightMatrixBlocksX
-                                << "\nBlock count y: "
-                                << m_weightMatrixBlocksY
-                                << "\nActive columns last block column: "
-                                << m_weightMatrixColumnsLastBlock << std::endl;
+            std::cout << "Matrix processing unit: "
+                            "Matrix multiplication: Done\nRequired iterations: "
+                        << m_iterationCountTotal
+                        << "\nStalled iterations: "
+                        << m_iterationCountStalled
+                        << "\nUnified buffer I/O:\nSystolic data setup unit:"
+                                                        "\n\tLoad operations: "
+                        << m_systolicDataSetupUnit.getLoadCount()
+                        << "\nWeight fetcher:\n\tLoad operations: "
+                        << m_weightFetcher.getLoadCount()
+                        << "\n\tMax. concurrent loads per column: "
+                        << m_weightFetcher.getConcurrentLoadsPerColumnMax()
+                        << "\n\tMax. concurrent loads total: "
+                        << m_weightFetcher.getConcurrentLoadsMax()
+                        << "\n\tMax. concurrent load operations: "
+                        << m_concurrentAccumulatorLoadCountMax
+                        << "\n\tMax. concurrent load operations per column: "
+                        << m_concurrentAccumulatorArrayLoadCountPerColumnMax
+                        << "\nStore operations to unified buffer: "
+                        << m_accumulatorArrayLoadCount << std::endl;
+        }
+    }
+
+    
+    /**
+     * @brief
+     * @param operationName
+     */
+    
+    void runMultiplication(const std::string& operationName)
+    {
+
+        const auto weightMatrixDimensions{
+                        m_memoryManagementUnit.getWeightMatrixDimensionsManaged(operationName)};
+
+        const auto activationMatrixDimensions{
+                        m_memoryManagementUnit.getActivationMatrixDimensionsManaged()};
+
+        assert(weightMatrixDimensions.first ==
+                        activationMatrixDimensions.second);
+
+        if(weightMatrixDimensions.first !=
+                        activationMatrixDimensions.second)
+        {
+            throw MpuException("Stored activation matrix "
+                                "column count not equal to "
+                                "requested weight matrix row count");
+        }
+
+        m_memoryManagementUnit.setResultMatrixSizeManaged(
+                                        activationMatrixDimensions.first,
+                                        weightMatrixDimensions.second);
+
+        runMultiplication(activationMatrixDimensions.first,
+                                weightMatrixDimensions.second,
+                                activationMatrixDimensions.second,
+                                m_memoryManagementUnit.getActivationMatrixPtrManaged(),
+                                m_memoryManagementUnit.getWeightMatrixPtrManaged(operationName),
+                                m_memoryManagementUnit.getResultMatrixPtrManaged());
+
+        m_statisticsLogEntryAvailableCallback(
+                                MpuStatisticsLogEntry{operationName,
+                                                        activationMatrixDimensions.first,
+                                                        weightMatrixDimensions.second,
+                                                        activationMatrixDimensions.second,
+                                                        m_systolicArrayHeight,
+                                                        m_systolicArrayWidth,
+                                                        m_activationFifoDepth,
+                                                        m_accumulatorArrayHeight,
+                                                        getControlRegisterBitsMpu(),
+                                                        m_systolicDataSetupUnit.getControlRegisterBits(
+                                                            m_memoryManagementUnit.getMemoryUsageMaxByte()),
+                                                        m_systolicArrayPtr->getControlRegisterBitsActivationFifos(),
+                                                        m_weightFetcher.getControlRegisterBits(
+                                                            m_memoryManagementUnit.getMemoryUsageMaxByte()),
+                                                        m_systolicArrayPtr->getControlRegisterBitsSystolicArray(),
+                                                        m_accumulatorArray.getControlRegisterBits(),
+                                                        m_systolicArrayPtr->getDataRegisterBitsActivationFifos(),
+                                                        m_systolicArrayPtr->getDataRegisterBitsSystolicArray(),
+                                                        m_accumulatorArray.getDataRegisterBits(),
+                                                        m_memoryManagementUnit.getMemoryUsageMaxBit(),
+                                                        m_systolicArrayPtr->getIntraPeDataMovements(),
+                                                        m_systolicArrayPtr->getInterPeDataMovements(),
+                                                        m_systolicDataSetupUnit.getLoadCount(),
+                                                        m_weightFetcher.getLoadCount(),
+                                                        m_weightFetcher.getConcurrentLoadsMax(),
+                                                        m_weightFetcher.getConcurrentLoadsPerColumnMax(),
+                                                        m_accumulatorArrayLoadCount,
+                                                        m_concurrentAccumulatorLoadCountMax,
+                                                        m_concurrentAccumulatorArrayLoadCountPerColumnMax,
+                                                        m_iterationCountTotal,
+                                                        m_iterationCountStalled,
+                                                        m_systolicArrayPtr->getMuliplicationsWithWeightZeroCountTotal(),
+                                                        m_verificationTimeSeconds});
+
+    }
+    
+    virtual ~MatrixProcessingUnit()
+    {
+        if(!m_tileReplicaFlag)
+        {
+            std::cout << "MPU object destroyed" << std::endl;
+        }
+    }
+
+protected:
+
+    using SystolicArrayFactory = SystolicArray<WeightDatatype,
+                                                ActivationDatatype,
+                                                AccumulatorDatatype>* (*)(const SystolicArrayEngine,
+                                                                            const size_t,
+                                                                            const size_t,
+                                                                            const size_t);
+
+    /**
+     * @brief                           MatrixProcessingUnit constructor for MPUs using
+     *                                  a specialized structure of arrays systolic array
+     *                                  engine, see the public constructor
+     * @param systolicArrayFactory      Creates the systolic array of the MPU and
+     *                                  of its tile replicas
+     */
+
+    MatrixProcessingUnit(const size_t systolicArrayWidth,
+                            const size_t systolicArrayHeight,
+                            const size_t activationFifoDepth,
+                            const size_t accumulatorArrayHeight,
+                            const size_t unifiedBufferSizeByteMax,
+                            const SystolicArrayFactory systolicArrayFactory):
+                                                                    MatrixProcessingUnit(systolicArrayWidth,
+                                                                                            systolicArrayHeight,
+                                                                                            activationFifoDepth,
+                                                                                            accumulatorArrayHeight,
+                                                                                            unifiedBufferSizeByteMax,
+                                                                                            SystolicArrayEngine::StructureOfArrays,
+                                                                                            systolicArrayFactory,
+                                                                                            false)
+    {
+    }
+
+private:
+
+    /**
+     * @brief                           MatrixProcessingUnit constructor, see the public
+     *                                  constructor. Tile replicas are constructed
+     *                                  without console output.
+     * @param systolicArrayFactory      Creates the systolic array
+     * @param tileReplicaFlag           True if the MPU is a tile replica of another MPU
+     */
+
+    MatrixProcessingUnit(const size_t systolicArrayWidth,
+                            const size_t systolicArrayHeight,
+                            const size_t activationFifoDepth,
+                            const size_t accumulatorArrayHeight,
+                            const size_t unifiedBufferSizeByteMax,
+                            const SystolicArrayEngine systolicArrayEngine,
+                            const SystolicArrayFactory systolicArrayFactory,
+                            const bool tileReplicaFlag):
+                                                                    m_systolicArrayWidth{systolicArrayWidth},
+                                                                    m_systolicArrayHeight{systolicArrayHeight},
+                                                                    m_systolicArrayDiagonals{m_systolicArrayWidth +
+                                                                                            m_systolicArrayHeight - 1UL},
+                                                                    m_activationFifoDepth{activationFifoDepth},
+                                                                    m_accumulatorArrayHeight{accumulatorArrayHeight},
+                                                                    m_accumulatorArrayBufferHeight{m_accumulatorArrayHeight/2UL},
+                                                                    m_unifiedBufferSizeByteMax{unifiedBufferSizeByteMax},
+                                                                    m_systolicArrayEngine{systolicArrayEngine},
+                                                                    m_systolicArrayFactory{systolicArrayFactory},
+                                                                    m_systolicArrayPtr{m_systolicArrayFactory(
+                                                                                                m_systolicArrayEngine,
+                                                                                                m_systolicArrayWidth,
+                                                                                                m_systolicArrayHeight,
+                                                                                                m_activationFifoDepth)},
+                                                                    m_systolicDataSetupUnit(
+                                                                                m_systolicArrayPtr->getActivationFifoArrayPtr()),
+                                                                    m_weightFetcher(m_systolicArrayPtr.get()),
+                                                                    m_accumulatorArray(m_systolicArrayPtr.get(),
+                                                                                                            accumulatorArrayHeight),
+                                                                    m_analyticalModel(m_systolicArrayWidth,
+                                                                                        m_systolicArrayHeight,
+                                                                                        m_accumulatorArrayBufferHeight),
+                                                                    m_memoryManagementUnit(&m_unifiedBuffer,
+                                                                                                m_unifiedBufferSizeByteMax),
+                                                                    m_accumulatorArrayReadOperationQueue(m_accumulatorArrayBufferHeight +
+                                                                                                            m_systolicArrayWidth),
+                                                                    m_accumulatorArrayColumnAccessCountArray(m_systolicArrayWidth),
+                                                                    m_accumulatorArrayColumnAccessRangeArray(
+                                                                                m_accumulatorArrayReadOperationQueue.capacity()),
+                                                                    m_tileReplicaFlag{tileReplicaFlag}
+    {
+        /* Each accumulator array buffer is written again by the activation
+         * matrix block two positions later. For buffers holding fewer rows
+         * than the systolic array height, this can happen before the block
+         * is completely read, so these configurations are rejected. */
+
+        if(m_accumulatorArrayBufferHeight < m_systolicArrayHeight)
+        {
+            throw MpuException("Accumulator array height must be at least "
+                                    "twice the systolic array height");
+        }
+
+        if(m_tileReplicaFlag)
+        {
+            return;
+        }
+
+        std::cout << "Constructed MPU object\n\tWeights size: "
+                    << sizeof(WeightDatatype)
+                    << " byte\n\tActivations datatype size: "
+                    << sizeof(ActivationDatatype)
+                    << " byte\n\tResults datatype size: "
+                    << sizeof(AccumulatorDatatype)
+                    << " byte\n\tSystolic array height: "
+                    << m_systolicArrayHeight 
+                    << "\n\tSystolic array width: "
+                    << m_systolicArrayWidth
+                    << "\n\tActivation FIFO depth: "
+                    << m_activationFifoDepth
+                    << "\n\tAccumulator array height: "
+                    << m_accumulatorArrayHeight
+                    << "\n\tMax unified buffer size: "
+                    << m_unifiedBufferSizeByteMax
+                    << " byte\n\tSystolic array engine: "
+                    << ((m_systolicArrayEngine ==
+                            SystolicArrayEngine::StructureOfArrays) ?
+                                            "structure of arrays" :
+                                            "processing elements") << std::endl;
+    }
+
+    static SystolicArray<WeightDatatype,
+                            ActivationDatatype,
+                            AccumulatorDatatype>* createSystolicArray(
+                                                    const SystolicArrayEngine systolicArrayEngine,
+                                                    const size_t systolicArrayWidth,
+                                                    const size_t systolicArrayHeight,
+                                                    const size_t activationFifoDepth)
+    {
+        switch(systolicArrayEngine)
+        {
+            case SystolicArrayEngine::StructureOfArrays:
+                return new SystolicArrayStructureOfArrays<WeightDatatype,
+                                                            ActivationDatatype,
+                                                            AccumulatorDatatype>(systolicArrayWidth,
+                                                                                    systolicArrayHeight,
+                                                                                    activationFifoDepth);
+
+            default:
+                return new SystolicArrayProcessingElements<WeightDatatype,
+                                                            ActivationDatatype,
+                                                            AccumulatorDatatype>(systolicArrayWidth,
+                                                                                    systolicArrayHeight,
+                                                                                    activationFifoDepth);
+        }
+    }
+
+    /**
+     * @brief                   Perform a matrix multiplication by simulating every iteration
+     *                          of all MPU submodules. The execution metrics are reset at the
+     *                          start of the window unless it starts at the first main loop
+     *                          iteration, the tile window report is stored at its end, and
+     *                          results are only stored in the iterations of the window. The
+     *                          iterations after the window are simulated nevertheless, so
+     *                          that the MPU is left in the same state as after a complete
+     *                          multiplication. Tile replicas use windows to simulate a part
+     *                          of a multiplication, otherwise the window spans the whole
+     *                          main loop.
+     * @param sizeM             The row count of the activation matrix
+     * @param sizeN             The column count of the weight matrix
+     * @param sizeK             The column count of the activation matrix
+     * @param matrixAPtr        A pointer to the activation matrix
+     * @param matrixBPtr        A pointer to the weight matrix
+     * @param matrixCPtr        A pointer to the result matrix
+     * @param iterationBegin    The first main loop iteration of the window
+     * @param iterationEnd      The main loop iteration ending the window
+     */
+
+    void runMultiplicationCycleAccurate(const size_t sizeM,
+                                            const size_t sizeN,
+                                            const size_t sizeK,
+                                            const ActivationDatatype* const matrixAPtr,
+                                            const WeightDatatype* const matrixBPtr,
+                                            AccumulatorDatatype* const matrixCPtr,
+                                            const size_t iterationBegin,
+                                            const size_t iterationEnd)
+    {
+        /* Startup */
+
+        if(m_debugFlag)
+        {
+            std::cout << "Matrix Processing Unit: Matrix multiplication: "
+                        << "Startup\nInput matrix dimensions:\tM: " << sizeM
+                        << "\tN: " << sizeN << "\tK: " << sizeK << std::endl;
+        }
+
+        m_weightMatrixBlockCoordinateX = 0UL;
+        m_weightMatrixBlockCoordinateY = 0UL;
+
+        m_weightFetcherActivationMatrixRowBlockCoordinate = 0UL;
+        m_systolicArrayActivationMatrixRowBlockCoordinate = 0UL;
+
+        m_resultMatrixReadInProgressBlockCoordinateX = 0UL;
+        m_resultMatrixReadInProgressBlockCoordinateY = 0UL;
+
+        m_resultMatrixReadDoneBlockCoordinateX = 0UL;
+        m_resultMatrixReadDoneBlockCoordinateY = 0UL;
+
+        m_accumulatorArrayBufferSelectBit = false;
+
+        m_weightFetcher.setInput(matrixBPtr, sizeN, sizeK);
+        m_weightFetcher.clearWeightUpdateRequestQueue();
+        m_weightFetcher.updateState();
+
+        updateTilingParameters(sizeM);
+
+        m_systolicDataSetupUnit.addInputMatrix(matrixAPtr, sizeK,
+                                    (m_accumulatorArrayBufferHeight < sizeM) ?
+                                                        m_accumulatorArrayBufferHeight : sizeM,
+                                                                            m_weightMatrixBlocksX);
+
+        m_activationMatrixBlockCoordinateY = 1UL;
+
+        if(m_debugFlag)
+        {
+            std::cout << "Weight matrix:\nBlock count x: "
+                                << m_weightMatrixBlocksX
+                                << "\nBlock count y: "
+                                << m_weightMatrixBlocksY
+                                << "\nActive columns last block column: "
+                                << m_weightMatrixColumnsLastBlock << std::endl;
 
             std::cout << "Activation matrix:\nBlock count y: "
                             << m_activationMatrixBlocksY
@@ -573,11 +1231,11 @@ public:
         m_weightFetcher.runIteration();
         m_weightFetcher.updateState();
 
-        m_systolicArray.setUpdateWeightsSignal(true);
-        m_systolicArray.updateState();
+        m_systolicArrayPtr->setUpdateWeightsSignal(true);
+        m_systolicArrayPtr->updateState();
 
-        m_systolicArray.readUpdateWeightSignals();
-        m_systolicArray.updateState();
+        m_systolicArrayPtr->readUpdateWeightSignals();
+        m_systolicArrayPtr->updateState();
 
         m_systolicDataSetupUnit.runIteration();
         m_systolicDataSetupUnit.updateState();
@@ -590,6 +1248,7 @@ public:
 
         m_accumulatorArray.resetCounters();
         m_accumulatorArray.clearGotFirstInputBit();
+        m_accumulatorArray.clearDataReadyBit();
         m_accumulatorArray.clearFirstUpdateDoneBits();
         m_accumulatorArray.clearBufferWriteDoneBit();
         m_accumulatorArray.setSystolicArrayStartupMode(
@@ -597,17 +1256,54 @@ public:
         m_accumulatorArray.setAdditionCount(m_weightMatrixBlocksY);
         m_accumulatorArray.updateState();
 
-        m_systolicArray.resetIterationCount();
+        m_systolicArrayPtr->resetIterationCount();
 
         m_iterationCountTotal += 4UL;
         m_iterationCountStalled += 4UL;
 
         m_systolicArrayInputCount = 0UL;
 
+        const size_t iterationCountLoopStart{m_iterationCountTotal};
+
         /* Matrix multiplication */
 
         do
         {
+            const size_t loopIteration{m_iterationCountTotal - iterationCountLoopStart};
+
+            if((iterationBegin != 0UL) && (loopIteration == iterationBegin))
+            {
+                resetTileWindowMetrics();
+            }
+
+            if(loopIteration == iterationEnd)
+            {
+                storeTileWindowReport(iterationBegin, iterationEnd - iterationBegin);
+            }
+
+            /* Results are only stored in the iterations of the window */
+
+            const bool windowActive{(loopIteration >= iterationBegin) &&
+                                        (loopIteration < iterationEnd)};
+
+            AccumulatorDatatype* const resultMatrixPtr{windowActive ? matrixCPtr : nullptr};
+
+            if(m_steadyStateSkipping)
+            {
+                const size_t iterationNext{(loopIteration < iterationBegin) ? iterationBegin :
+                                                    (windowActive ? iterationEnd :
+                                                            std::numeric_limits<size_t>::max())};
+
+                const size_t steadyStateIterations{getSteadyStateIterations(iterationNext -
+                                                                                loopIteration)};
+
+                if(steadyStateIterations)
+                {
+                    runIterationsSteadyState(steadyStateIterations, resultMatrixPtr, sizeN);
+                    continue;
+                }
+            }
+
             if(m_debugFlag && m_verboseDebugOutputFlag)
             {
                 std::cout << "------------------------------------------- "
@@ -616,9 +1312,17 @@ public:
                             << std::endl;
             }
 
+            /* The accumulator array is read before it is written in
+             * each iteration. Otherwise, the partial sums of a block
+             * of a single row activation matrix block would already be
+             * overwritten by the block two positions later, which uses
+             * the same accumulator array buffer. */
+
+            processAccumulatorArrayReadOperations(resultMatrixPtr, sizeN);
+
             m_systolicDataSetupUnit.runIteration();
             m_weightFetcher.runIteration();
-            m_systolicArray.runIteration();
+            m_systolicArrayPtr->runIteration();
             m_accumulatorArray.runIteration();
 
             const size_t weightMatrixOutputRowsWeightUpdateSignal{
@@ -638,7 +1342,7 @@ public:
                 if(m_systolicArrayActivationMatrixRowBlockCoordinate !=
                                                     m_activationMatrixBlocksY)
                 {
-                    m_systolicArray.setUpdateWeightsSignal(true);
+                    m_systolicArrayPtr->setUpdateWeightsSignal(true);
 
                     if(m_debugFlag && m_verboseDebugOutputFlag)
                     {
@@ -734,348 +1438,1268 @@ public:
                 }
             }
 
-            std::vector<size_t> accumulatorArrayColumnAccessCountVector(m_systolicArrayWidth);
-            size_t concurrentAccumulatorArrayLoadCount{0UL};
-
-            for(auto readOperationQueueIterator{m_accumulatorArrayReadOperationQueue.begin()};
-                        readOperationQueueIterator < m_accumulatorArrayReadOperationQueue.end();)
+            if(m_accumulatorArray.hasDataReadySignal()  &&
+                            (m_resultMatrixReadInProgressBlockCoordinateY != m_activationMatrixBlocksY))
             {
+                m_accumulatorArray.clearDataReadyBit();
 
-                size_t accumulatorArrayColumnAccessStart{0UL};
-                size_t accumulatorArrayColumnAccessEnd{0UL};
-
-                loadAccumulatorData(matrixCPtr,
-                                        sizeN,
-                                        readOperationQueueIterator->destMatrixRowStart,
-                                        readOperationQueueIterator->destMatrixColumnStart,
-                                        readOperationQueueIterator->accumulatorArrayBufferSelectBit,
-                                        readOperationQueueIterator->diagonalCoordinate,
-                                        readOperationQueueIterator->blockHeight,
-                                        readOperationQueueIterator->blockWidth,
-                                        concurrentAccumulatorArrayLoadCount,
-                                        accumulatorArrayColumnAccessStart,
-                                        accumulatorArrayColumnAccessEnd);
-
-                for(size_t columnCount{accumulatorArrayColumnAccessEnd};
-                                    columnCount <= accumulatorArrayColumnAccessStart; ++columnCount)
-                {
-                    ++accumulatorArrayColumnAccessCountVector.at(columnCount);
-                }
+                const size_t outputRows{(m_resultMatrixReadInProgressBlockCoordinateY !=
+                                                            (m_activationMatrixBlocksY - 1)) ?
+                                                                    m_accumulatorArrayBufferHeight :
+                                                                    m_activationMatrixRowsLastBlock};
 
-                ++(readOperationQueueIterator->diagonalCoordinate);
+                const size_t outputColumns{(m_resultMatrixReadInProgressBlockCoordinateX !=
+                                                                    (m_weightMatrixBlocksX - 1)) ?
+                                                                                m_systolicArrayWidth :
+                                                                                m_weightMatrixColumnsLastBlock};
 
-                if(readOperationQueueIterator->diagonalCoordinate ==
-                                        readOperationQueueIterator->blockDiagonals)
-                {
-                    if(m_debugFlag)
-                    {
-                        if(m_verboseDebugOutputFlag)
-                        {
-                            std::cout << "Result matrix read at queue position "
-                                        << readOperationQueueIterator -
-                                                    m_accumulatorArrayReadOperationQueue.begin()
-                                        << " done, coordinate ("
-                                        << m_resultMatrixReadDoneBlockCoordinateX
-                                        << ", "
-                                        << m_resultMatrixReadDoneBlockCoordinateY
-                                        << ") of {"
-                                        << m_weightMatrixBlocksX - 1
-                                        << ", "
-                                        << m_activationMatrixBlocksY - 1
-                                        << "}, columns: "
-                                        << readOperationQueueIterator->blockWidth
-                                        << ", rows: "
-                                        << readOperationQueueIterator->blockHeight
-                                        << std::endl;
-                        }
-
-                        else
-                        {
-                            std::cout << m_resultMatrixReadDoneBlockCoordinateY*
-                                            m_weightMatrixBlocksX +
-                                            m_resultMatrixReadDoneBlockCoordinateX + 1
-                                        << " of "
-                                        << m_weightMatrixBlocksX*m_activationMatrixBlocksY
-                                        << " output blocks done" << std::endl;
-                        }
-                    }
+                /* The buffer holding the tile is only overwritten after the
+                 * remaining rows of the tile and the rows of all addition
+                 * passes of the next tile, at least one each, have been
+                 * written. Rows copied in the iteration in which the diagonal
+                 * read would load their last element are still intact if the
+                 * tile is narrower than this number of rows. */
 
-                    if(m_resultMatrixReadDoneBlockCoordinateX <
-                                                (m_weightMatrixBlocksX - 1))
-                    {
-                        ++m_resultMatrixReadDoneBlockCoordinateX;
-                    }
+                const bool rowBlockCopy{(m_accumulatorArrayDrainMode ==
+                                                AccumulatorArrayDrainMode::RowBlock) &&
+                                            (outputColumns < (outputRows + m_weightMatrixBlocksY))};
 
-                    else
-                    {
-                        m_resultMatrixReadDoneBlockCoordinateX = 0;
-                        ++m_resultMatrixReadDoneBlockCoordinateY;
-                    }
+                m_accumulatorArrayReadOperationQueue.push_back(
+                                                AccumulatorArrayReadOperation(
+                                                                    m_resultMatrixReadInProgressBlockCoordinateY*
+                                                                    m_accumulatorArrayBufferHeight,
+                                                                    m_systolicArrayWidth*
+                                                                    m_resultMatrixReadInProgressBlockCoordinateX,
+                                                                    m_accumulatorArrayBufferSelectBit,
+                                                                    outputRows,
+                                                                    outputColumns,
+                                                                    rowBlockCopy));
 
-                    m_accumulatorArrayReadOperationQueue.erase(readOperationQueueIterator);
+                if(m_accumulatorArrayReadOperationQueueLengthMax <
+                                    m_accumulatorArrayReadOperationQueue.size())
+                {
+                    m_accumulatorArrayReadOperationQueueLengthMax =
+                                    m_accumulatorArrayReadOperationQueue.size();
+                }
+
+                if(m_debugFlag && m_verboseDebugOutputFlag)
+                {
+                    std::cout << "Added accumulator array read operation, "
+                                                            "queue position: "
+                                << m_accumulatorArrayReadOperationQueue.size() - 1
+                                << ", accumulator array buffer: "
+                                << m_accumulatorArrayBufferSelectBit
+                                << ", block coordinate: ("
+                                << m_resultMatrixReadInProgressBlockCoordinateX
+                                << ", "
+                                << m_resultMatrixReadInProgressBlockCoordinateY
+                                << "), columns: "
+                                << outputColumns
+                                << ", rows: "
+                                << outputRows
+                                << std::endl;
+                }
+
+                m_accumulatorArrayBufferSelectBit =
+                            !m_accumulatorArrayBufferSelectBit;
+
+                if(m_resultMatrixReadInProgressBlockCoordinateX <
+                                                    (m_weightMatrixBlocksX - 1))
+                {
+                    ++m_resultMatrixReadInProgressBlockCoordinateX;
+                }
+
+                else
+                {
+                    m_resultMatrixReadInProgressBlockCoordinateX = 0;
+                    ++m_resultMatrixReadInProgressBlockCoordinateY;
+                }
+            }
+
+            m_systolicDataSetupUnit.updateState();
+            m_weightFetcher.updateState();
+            m_systolicArrayPtr->updateState();
+            m_accumulatorArray.updateState();
+
+            ++m_systolicArrayInputCount;
+            ++m_iterationCountTotal;
+
+            if(m_systolicArrayInputCountMax <
+                            m_systolicArrayInputCount)
+            {
+                m_systolicArrayInputCountMax =
+                            m_systolicArrayInputCount;
+            }
+        }
+
+        while(m_resultMatrixReadDoneBlockCoordinateY !=
+                                            m_activationMatrixBlocksY);
+    }
+
+    /**
+     * @brief       Read the weight matrix tiling from the weight fetcher and
+     *              compute the activation matrix tiling, updating the
+     *              corresponding maximum register values
+     * @param sizeM The row count of the activation matrix
+     */
+
+    void updateTilingParameters(const size_t sizeM)
+    {
+        m_weightMatrixBlocksX = m_weightFetcher.getBlockCountX();
+
+        if(m_weightMatrixBlocksXMax < m_weightMatrixBlocksX)
+        {
+            m_weightMatrixBlocksXMax = m_weightMatrixBlocksX;
+        }
+
+        m_weightMatrixBlocksY = m_weightFetcher.getBlockCountY();
+
+        if(m_weightMatrixBlocksYMax < m_weightMatrixBlocksY)
+        {
+            m_weightMatrixBlocksYMax = m_weightMatrixBlocksY;
+        }
+
+        m_weightMatrixColumnsLastBlock =
+                        m_weightFetcher.getActiveColumnsLastBlock();
+
+        if(m_weightMatrixColumnsLastBlockMax < m_weightMatrixColumnsLastBlock)
+        {
+            m_weightMatrixColumnsLastBlockMax = m_weightMatrixColumnsLastBlock;
+        }
+
+        m_activationMatrixBlocksY =
+                            std::ceil(static_cast<float>(sizeM)/
+                                        static_cast<float>(m_accumulatorArrayBufferHeight));
+
+        if(m_activationMatrixBlocksYMax < m_activationMatrixBlocksY)
+        {
+            m_activationMatrixBlocksYMax = m_activationMatrixBlocksY;
+        }
+
+        m_activationMatrixRowsLastBlock =
+                            m_accumulatorArrayBufferHeight*(1L - m_activationMatrixBlocksY) + sizeM;
+
+        if(m_activationMatrixRowsLastBlockMax <
+                                m_activationMatrixRowsLastBlock)
+        {
+            m_activationMatrixRowsLastBlockMax =
+                            m_activationMatrixRowsLastBlock;
+        }
+    }
+
+    /**
+     * @brief               Set the weight fetcher input and the tiling parameters, and
+     *                      update the metrics of the SDSU and the accumulator array that
+     *                      only depend on the tiling of the input matrices, without
+     *                      simulating any iteration
+     * @param sizeM         The row count of the activation matrix
+     * @param sizeN         The column count of the weight matrix
+     * @param sizeK         The column count of the activation matrix
+     * @param matrixBPtr    A pointer to the weight matrix
+     */
+
+    void updateBlockLevelMetrics(const size_t sizeM,
+                                    const size_t sizeN,
+                                    const size_t sizeK,
+                                    const WeightDatatype* const matrixBPtr)
+    {
+        m_weightFetcher.setInput(matrixBPtr, sizeN, sizeK);
+        m_weightFetcher.clearWeightUpdateRequestQueue();
+        m_weightFetcher.updateState();
+
+        updateTilingParameters(sizeM);
+
+        /* The first activation matrix row block is stored to the
+         * matrix 0 registers of the SDSU, the following ones are
+         * stored to the matrix 1 and matrix 0 registers in turn,
+         * as a new block is added as soon as one of them is free. */
+
+        for(size_t blockCoordinateY{0UL};
+                        blockCoordinateY < m_activationMatrixBlocksY; ++blockCoordinateY)
+        {
+            m_systolicDataSetupUnit.addInputMatrixMetrics(sizeK,
+                                        (blockCoordinateY != (m_activationMatrixBlocksY - 1)) ?
+                                                                m_accumulatorArrayBufferHeight :
+                                                                m_activationMatrixRowsLastBlock,
+                                        m_weightMatrixBlocksX,
+                                        (blockCoordinateY % 2UL) != 0UL);
+        }
+
+        m_accumulatorArray.setAdditionCount(m_weightMatrixBlocksY);
+    }
+
+    /**
+     * @brief               Verify the result matrix of a matrix multiplication
+     *                      according to the selected verification policy
+     * @param sizeM         The row count of the activation matrix
+     * @param sizeN         The column count of the weight matrix
+     * @param sizeK         The column count of the activation matrix
+     * @param matrixAPtr    A pointer to the activation matrix
+     * @param matrixBPtr    A pointer to the weight matrix
+     * @param matrixCPtr    A pointer to the result matrix
+     * @return              False if the result matrix is incorrect
+     */
+
+    bool verifyResultMatrix(const size_t sizeM,
+                                const size_t sizeN,
+                                const size_t sizeK,
+                                const ActivationDatatype* const __restrict__ matrixAPtr,
+                                const WeightDatatype* const __restrict__ matrixBPtr,
+                                const AccumulatorDatatype* const __restrict__ matrixCPtr)
+    {
+        switch(m_verificationPolicy)
+        {
+            case MpuVerificationPolicy::Full:
+                return verifyResultMatrixFull(sizeM, sizeN, sizeK,
+                                                matrixAPtr, matrixBPtr, matrixCPtr);
+
+            case MpuVerificationPolicy::Freivalds:
+                return verifyResultMatrixFreivalds(sizeM, sizeN, sizeK,
+                                                    matrixAPtr, matrixBPtr, matrixCPtr);
+
+            case MpuVerificationPolicy::SampledTiles:
+                return verifyResultMatrixSampledTiles(sizeM, sizeN, sizeK,
+                                                        matrixAPtr, matrixBPtr, matrixCPtr);
+
+            default:
+                return true;
+        }
+    }
+
+    bool verifyResultMatrixFull(const size_t sizeM,
+                                    const size_t sizeN,
+                                    const size_t sizeK,
+                                    const ActivationDatatype* const __restrict__ matrixAPtr,
+                                    const WeightDatatype* const __restrict__ matrixBPtr,
+                                    const AccumulatorDatatype* const __restrict__ matrixCPtr)
+    {
+        Eigen::Map<const RMatrix<ActivationDatatype>> matrixAEigen(matrixAPtr, sizeM, sizeK);
+        Eigen::Map<const RMatrix<WeightDatatype>> matrixBEigen(matrixBPtr, sizeK, sizeN);
+        const RMatrix<AccumulatorDatatype> matrixCEigen{matrixAEigen.template cast<AccumulatorDatatype>()*
+                                                            matrixBEigen.template cast<AccumulatorDatatype>()};
+
+        bool resultCorrect{true};
+
+        for(size_t rowCount{0}; rowCount < sizeM; ++rowCount)
+        {
+            for(size_t columnCount{0}; columnCount < sizeN; ++columnCount)
+            {
+                if(matrixCPtr[rowCount*sizeN + columnCount] !=
+                                    matrixCEigen(rowCount, columnCount))
+                {
+                    if(m_debugFlag && m_verboseDebugOutputFlag)
+                    {
+                        std::cout << "Systolic array output incorrect at ("
+                                    << columnCount << ", " << rowCount
+                                    << "): Expected value: "
+                                    << matrixCEigen(rowCount, columnCount)
+                                    << " actual value: "
+                                    << matrixCPtr[rowCount*sizeN + columnCount] << std::endl;
+                    }
+
+                    resultCorrect = false;
+                }
+            }
+        }
+
+        return resultCorrect;
+    }
+
+    /**
+     * @brief   Freivalds verification: For random vectors r with elements
+     *          in {0, 1}, check that A*(B*r) equals C*r. Only three matrix
+     *          vector products are required per round instead of the
+     *          complete matrix product. Integer results are compared
+     *          exactly modulo 2^n, see FreivaldsArithmetic, floating point
+     *          results within a tolerance scaled with the magnitude of the
+     *          summands.
+     */
+
+    bool verifyResultMatrixFreivalds(const size_t sizeM,
+                                        const size_t sizeN,
+                                        const size_t sizeK,
+                                        const ActivationDatatype* const __restrict__ matrixAPtr,
+                                        const WeightDatatype* const __restrict__ matrixBPtr,
+                                        const AccumulatorDatatype* const __restrict__ matrixCPtr)
+    {
+        using SumDatatype = typename FreivaldsArithmetic<AccumulatorDatatype>::SumDatatype;
+        using CompareDatatype = typename FreivaldsArithmetic<AccumulatorDatatype>::CompareDatatype;
+
+        constexpr bool isInteger{std::numeric_limits<AccumulatorDatatype>::is_integer};
+
+        std::uniform_int_distribution<int> randomVectorElementDistribution(0, 1);
+
+        std::vector<SumDatatype> randomVector(sizeN);
+        std::vector<SumDatatype> productBRVector(sizeK);
+        std::vector<double> productBRMagnitudeVector(sizeK);
+
+        const double tolerance{static_cast<double>(sizeK + sizeN)*
+                                    static_cast<double>(
+                                        std::numeric_limits<AccumulatorDatatype>::epsilon())};
+
+        for(size_t roundCount{0UL}; roundCount < m_verificationRounds; ++roundCount)
+        {
+            for(SumDatatype& element : randomVector)
+            {
+                element = static_cast<SumDatatype>(
+                                randomVectorElementDistribution(m_verificationRng));
+            }
+
+            for(size_t rowCount{0}; rowCount < sizeK; ++rowCount)
+            {
+                SumDatatype sum{0};
+                double magnitude{0.0};
+
+                for(size_t columnCount{0}; columnCount < sizeN; ++columnCount)
+                {
+                    const SumDatatype weight{static_cast<SumDatatype>(
+                                                static_cast<AccumulatorDatatype>(
+                                                    matrixBPtr[rowCount*sizeN + columnCount]))};
+
+                    const SumDatatype product{weight*randomVector[columnCount]};
+
+                    sum += product;
+
+                    if(!isInteger)
+                    {
+                        magnitude += std::abs(static_cast<double>(product));
+                    }
+                }
+
+                productBRVector[rowCount] = sum;
+                productBRMagnitudeVector[rowCount] = magnitude;
+            }
+
+            for(size_t rowCount{0}; rowCount < sizeM; ++rowCount)
+            {
+                SumDatatype expected{0};
+                double magnitude{0.0};
+
+                for(size_t columnCount{0}; columnCount < sizeK; ++columnCount)
+                {
+                    const SumDatatype activation{static_cast<SumDatatype>(
+                                                    static_cast<AccumulatorDatatype>(
+                                                        matrixAPtr[rowCount*sizeK + columnCount]))};
+
+                    expected += activation*productBRVector[columnCount];
+
+                    if(!isInteger)
+                    {
+                        magnitude += std::abs(static_cast<double>(activation))*
+                                        productBRMagnitudeVector[columnCount];
+                    }
+                }
+
+                SumDatatype actual{0};
+
+                for(size_t columnCount{0}; columnCount < sizeN; ++columnCount)
+                {
+                    actual += static_cast<SumDatatype>(matrixCPtr[rowCount*sizeN + columnCount])*
+                                                                        randomVector[columnCount];
+                }
+
+                const bool rowCorrect{isInteger ?
+                                        (static_cast<CompareDatatype>(actual) ==
+                                                static_cast<CompareDatatype>(expected)) :
+                                        (std::abs(static_cast<double>(actual) -
+                                                    static_cast<double>(expected)) <=
+                                                    tolerance*magnitude)};
+
+                if(!rowCorrect)
+                {
+                    if(m_debugFlag && m_verboseDebugOutputFlag)
+                    {
+                        std::cout << "Systolic array output incorrect in row "
+                                    << rowCount << ": Expected value of C*r: "
+                                    << static_cast<AccumulatorDatatype>(
+                                            static_cast<CompareDatatype>(expected))
+                                    << " actual value: "
+                                    << static_cast<AccumulatorDatatype>(
+                                            static_cast<CompareDatatype>(actual))
+                                    << std::endl;
+                    }
+
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief   Sampled tile verification: Recompute randomly selected
+     *          result matrix tiles of the size of an accumulator array
+     *          buffer, i.e. of the output of single MPU tiles, using
+     *          Eigen. If the number of rounds is not smaller than the
+     *          number of tiles, all tiles are checked.
+     */
+
+    bool verifyResultMatrixSampledTiles(const size_t sizeM,
+                                            const size_t sizeN,
+                                            const size_t sizeK,
+                                            const ActivationDatatype* const __restrict__ matrixAPtr,
+                                            const WeightDatatype* const __restrict__ matrixBPtr,
+                                            const AccumulatorDatatype* const __restrict__ matrixCPtr)
+    {
+        Eigen::Map<const RMatrix<ActivationDatatype>> matrixAEigen(matrixAPtr, sizeM, sizeK);
+        Eigen::Map<const RMatrix<WeightDatatype>> matrixBEigen(matrixBPtr, sizeK, sizeN);
+        Eigen::Map<const RMatrix<AccumulatorDatatype>> matrixCEigen(matrixCPtr, sizeM, sizeN);
+
+        const size_t tileHeight{m_accumulatorArrayBufferHeight};
+        const size_t tileWidth{m_systolicArrayWidth};
+
+        const size_t tilesY{(sizeM + tileHeight - 1UL)/tileHeight};
+        const size_t tilesX{(sizeN + tileWidth - 1UL)/tileWidth};
+        const size_t tileCount{tilesY*tilesX};
+
+        const bool checkAllTiles{m_verificationRounds >= tileCount};
+
+        std::uniform_int_distribution<size_t> tileDistribution(0UL, tileCount - 1UL);
+
+        for(size_t roundCount{0UL}; roundCount < std::min(m_verificationRounds, tileCount); ++roundCount)
+        {
+            const size_t tile{checkAllTiles ? roundCount :
+                                    tileDistribution(m_verificationRng)};
+
+            const size_t rowStart{(tile/tilesX)*tileHeight};
+            const size_t columnStart{(tile % tilesX)*tileWidth};
+
+            const size_t rows{std::min(tileHeight, sizeM - rowStart)};
+            const size_t columns{std::min(tileWidth, sizeN - columnStart)};
+
+            const RMatrix<AccumulatorDatatype> tileExpected{
+                        matrixAEigen.middleRows(rowStart, rows).template cast<AccumulatorDatatype>()*
+                        matrixBEigen.middleCols(columnStart, columns).template cast<AccumulatorDatatype>()};
+
+            if(tileExpected != matrixCEigen.block(rowStart, columnStart, rows, columns))
+            {
+                if(m_debugFlag && m_verboseDebugOutputFlag)
+                {
+                    std::cout << "Systolic array output incorrect in tile at ("
+                                << columnStart << ", " << rowStart
+                                << ")" << std::endl;
+                }
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief               Perform a matrix multiplication in analytical simulation
+     *                      mode. The result matrix is computed using Eigen, and the
+     *                      execution metrics of all submodules are updated with the
+     *                      values a cycle accurate simulation would produce. The data
+     *                      movement counts are closed form functions of the tiling,
+     *                      the timing dependent metrics are taken from the analytical
+     *                      model of the MCU.
+     * @param sizeM         The row count of the activation matrix
+     * @param sizeN         The column count of the weight matrix
+     * @param sizeK         The column count of the activation matrix
+     * @param matrixAPtr    A pointer to the activation matrix
+     * @param matrixBPtr    A pointer to the weight matrix
+     * @param matrixCPtr    A pointer to the result matrix
+     */
+
+    void runMultiplicationAnalytical(const size_t sizeM,
+                                        const size_t sizeN,
+                                        const size_t sizeK,
+                                        const ActivationDatatype* const matrixAPtr,
+                                        const WeightDatatype* const matrixBPtr,
+                                        AccumulatorDatatype* const matrixCPtr)
+    {
+        if(m_debugFlag)
+        {
+            std::cout << "Matrix Processing Unit: Analytical matrix multiplication:"
+                        << "\nInput matrix dimensions:\tM: " << sizeM
+                        << "\tN: " << sizeN << "\tK: " << sizeK << std::endl;
+        }
+
+        updateBlockLevelMetrics(sizeM, sizeN, sizeK, matrixBPtr);
+
+        m_analyticalModel.evaluate(matrixBPtr,
+                                    sizeM,
+                                    sizeN,
+                                    sizeK,
+                                    m_activationMatrixBlocksY,
+                                    m_activationMatrixRowsLastBlock,
+                                    m_weightMatrixBlocksX,
+                                    m_weightMatrixBlocksY,
+                                    m_weightMatrixColumnsLastBlock);
+
+        m_systolicArrayPtr->addExecutionMetrics(m_analyticalModel.getIntraPeDataMovements(),
+                                                m_analyticalModel.getInterPeDataMovements(),
+                                                m_analyticalModel.getMultiplicationsWithWeightZeroCount());
+
+        m_weightFetcher.addDataMovementMetrics(m_activationMatrixBlocksY*sizeK*sizeN,
+                                                m_analyticalModel.getWeightFetcherConcurrentLoadsMax(),
+                                                m_analyticalModel.getWeightFetcherConcurrentLoadsPerColumnMax(),
+                                                m_analyticalModel.getWeightUpdateRequestQueueLengthMax());
+
+        m_accumulatorArrayLoadCount += m_analyticalModel.getAccumulatorArrayLoadCount();
+
+        m_concurrentAccumulatorLoadCountMax =
+                    std::max(m_concurrentAccumulatorLoadCountMax,
+                                m_analyticalModel.getConcurrentAccumulatorLoadCountMax());
+
+        m_concurrentAccumulatorArrayLoadCountPerColumnMax =
+                    std::max(m_concurrentAccumulatorArrayLoadCountPerColumnMax,
+                                m_analyticalModel.getConcurrentAccumulatorArrayLoadCountPerColumnMax());
+
+        m_accumulatorArrayReadOperationQueueLengthMax =
+                    std::max(m_accumulatorArrayReadOperationQueueLengthMax,
+                                m_analyticalModel.getAccumulatorArrayReadOperationQueueLengthMax());
+
+        m_systolicArrayInputCountMax =
+                    std::max(m_systolicArrayInputCountMax,
+                                m_analyticalModel.getSystolicArrayInputCountMax());
+
+        /* The startup sequence takes four stalled iterations */
+
+        m_iterationCountTotal += 4UL + m_analyticalModel.getIterationCount();
+        m_iterationCountStalled += 4UL;
+
+        Eigen::Map<const RMatrix<ActivationDatatype>> matrixAEigen(matrixAPtr, sizeM, sizeK);
+        Eigen::Map<const RMatrix<WeightDatatype>> matrixBEigen(matrixBPtr, sizeK, sizeN);
+        Eigen::Map<RMatrix<AccumulatorDatatype>> matrixCEigen(matrixCPtr, sizeM, sizeN);
+
+        matrixCEigen.noalias() = matrixAEigen.template cast<AccumulatorDatatype>()*
+                                    matrixBEigen.template cast<AccumulatorDatatype>();
+
+        if(m_debugFlag)
+        {
+            std::cout << "Matrix processing unit: Analytical "
+                            "matrix multiplication: Done\nRequired iterations: "
+                        << m_iterationCountTotal << std::endl;
+        }
+    }
+
+    /**
+     * @brief               Perform a matrix multiplication in decoupled simulation mode.
+     *                      The control flow of the MPU only depends on the dimensions of
+     *                      the input matrices and the signals derived from them, never on
+     *                      the data values. The timing pass therefore runs the cycle
+     *                      accurate simulation with the functional simulation of the
+     *                      systolic array disabled and only counts the accumulator array
+     *                      loads, which yields all execution metrics. The functional pass
+     *                      computes the result matrix as a blocked matrix multiplication
+     *                      using Eigen, on a separate thread if enabled.
+     * @param sizeM         The row count of the activation matrix
+     * @param sizeN         The column count of the weight matrix
+     * @param sizeK         The column count of the activation matrix
+     * @param matrixAPtr    A pointer to the activation matrix
+     * @param matrixBPtr    A pointer to the weight matrix
+     * @param matrixCPtr    A pointer to the result matrix
+     */
+
+    void runMultiplicationDecoupled(const size_t sizeM,
+                                        const size_t sizeN,
+                                        const size_t sizeK,
+                                        const ActivationDatatype* const matrixAPtr,
+                                        const WeightDatatype* const matrixBPtr,
+                                        AccumulatorDatatype* const matrixCPtr)
+    {
+        const auto runFunctionalPass = [=]()
+        {
+            Eigen::Map<const RMatrix<ActivationDatatype>> matrixAEigen(matrixAPtr, sizeM, sizeK);
+            Eigen::Map<const RMatrix<WeightDatatype>> matrixBEigen(matrixBPtr, sizeK, sizeN);
+            Eigen::Map<RMatrix<AccumulatorDatatype>> matrixCEigen(matrixCPtr, sizeM, sizeN);
+
+            matrixCEigen.noalias() = matrixAEigen.template cast<AccumulatorDatatype>()*
+                                        matrixBEigen.template cast<AccumulatorDatatype>();
+        };
+
+        std::exception_ptr functionalPassExceptionPtr;
+
+        std::thread functionalPassThread;
+
+        if(m_decoupledFunctionalPassConcurrent)
+        {
+            functionalPassThread = std::thread([&]()
+            {
+                try
+                {
+                    runFunctionalPass();
+                }
+
+                catch(...)
+                {
+                    functionalPassExceptionPtr = std::current_exception();
+                }
+            });
+        }
+
+        m_systolicArrayPtr->setFunctionalSimulation(false);
+
+        try
+        {
+            runMultiplicationCycleAccurate(sizeM, sizeN, sizeK,
+                                            matrixAPtr, matrixBPtr, nullptr,
+                                            0UL, std::numeric_limits<size_t>::max());
+        }
+
+        catch(...)
+        {
+            m_systolicArrayPtr->setFunctionalSimulation(true);
+
+            if(functionalPassThread.joinable())
+            {
+                functionalPassThread.join();
+            }
+
+            throw;
+        }
+
+        m_systolicArrayPtr->setFunctionalSimulation(true);
+
+        if(functionalPassThread.joinable())
+        {
+            functionalPassThread.join();
+        }
+
+        else
+        {
+            runFunctionalPass();
+        }
+
+        if(functionalPassExceptionPtr)
+        {
+            std::rethrow_exception(functionalPassExceptionPtr);
+        }
+    }
+
+    /**
+     * @struct  TileWindowReport
+     * @brief   Execution metrics a tile replica collected in the main
+     *          loop iterations of its window, and the number of halo
+     *          iterations it simulated before the window to reproduce
+     *          the pipeline state at the boundary to the preceding window
+     */
+
+    struct TileWindowReport
+    {
+        size_t iterationsHalo{0UL};
+        size_t iterationsWindow{0UL};
+        size_t intraPeDataMovements{0UL};
+        size_t interPeDataMovements{0UL};
+        size_t multiplicationsWithWeightZeroCount{0UL};
+        size_t weightFetcherLoadCount{0UL};
+        size_t weightFetcherConcurrentLoadsMax{0UL};
+        size_t weightFetcherConcurrentLoadsPerColumnMax{0UL};
+        size_t weightUpdateRequestQueueLengthMax{0UL};
+        size_t accumulatorArrayLoadCount{0UL};
+        size_t concurrentAccumulatorLoadCountMax{0UL};
+        size_t concurrentAccumulatorArrayLoadCountPerColumnMax{0UL};
+        size_t accumulatorArrayReadOperationQueueLengthMax{0UL};
+        size_t systolicArrayInputCountMax{0UL};
+    };
+
+    /**
+     * @brief               Perform a matrix multiplication in tile parallel simulation mode.
+     *                      As the systolic array never stalls after the startup sequence,
+     *                      every activation matrix row block but the last one occupies the
+     *                      systolic array for the same number of iterations, and the main
+     *                      loop iteration at which each row block enters the systolic array
+     *                      is known in advance. The main loop is split at these iterations
+     *                      into windows of contiguous row blocks, which are simulated cycle
+     *                      accurately on private tile replicas concurrently. Each replica
+     *                      starts at an earlier row block, so that the pipeline state at
+     *                      the start of its window is the same as in a serial simulation,
+     *                      and only collects execution metrics and stores results within its
+     *                      window. The execution metrics of the windows are then reduced
+     *                      to the ones of the serial simulation.
+     * @param sizeM         The row count of the activation matrix
+     * @param sizeN         The column count of the weight matrix
+     * @param sizeK         The column count of the activation matrix
+     * @param matrixAPtr    A pointer to the activation matrix
+     * @param matrixBPtr    A pointer to the weight matrix
+     * @param matrixCPtr    A pointer to the result matrix
+     */
+
+    void runMultiplicationTileParallel(const size_t sizeM,
+                                        const size_t sizeN,
+                                        const size_t sizeK,
+                                        const ActivationDatatype* const matrixAPtr,
+                                        const WeightDatatype* const matrixBPtr,
+                                        AccumulatorDatatype* const matrixCPtr)
+    {
+        const size_t activationMatrixBlocksY{(sizeM + m_accumulatorArrayBufferHeight - 1UL)/
+                                                            m_accumulatorArrayBufferHeight};
+
+        const size_t windowCount{std::min(m_tileReplicaCount, activationMatrixBlocksY)};
+
+        if(windowCount < 2UL)
+        {
+            runMultiplicationCycleAccurate(sizeM, sizeN, sizeK,
+                                            matrixAPtr, matrixBPtr, matrixCPtr,
+                                            0UL, std::numeric_limits<size_t>::max());
+            return;
+        }
+
+        updateBlockLevelMetrics(sizeM, sizeN, sizeK, matrixBPtr);
+
+        const size_t blockIterations{m_accumulatorArrayBufferHeight*
+                                        m_weightMatrixBlocksX*m_weightMatrixBlocksY};
+
+        /* A row block affects the state of the MPU for at most as many
+         * iterations after its last pass as it takes the last partial
+         * sums to leave the systolic array and the last result tile to
+         * be read from the accumulator array. The halo of a replica
+         * spans at least twice that, and starts at an even row block,
+         * so that the SDSU matrix registers and the accumulator array
+         * buffers are used in the same order as in a serial simulation. */
+
+        const size_t haloIterationsMin{2UL*(m_systolicArrayDiagonals +
+                                                m_systolicArrayHeight + 2UL)};
+
+        const size_t haloBlocks{(haloIterationsMin + blockIterations - 1UL)/blockIterations};
+
+        while(m_tileReplicaArray.size() < windowCount)
+        {
+            m_tileReplicaArray.emplace_back(new MatrixProcessingUnit(m_systolicArrayWidth,
+                                                                        m_systolicArrayHeight,
+                                                                        m_activationFifoDepth,
+                                                                        m_accumulatorArrayHeight,
+                                                                        0UL,
+                                                                        m_systolicArrayEngine,
+                                                                        m_systolicArrayFactory,
+                                                                        true));
+
+            m_tileReplicaArray.back()->setSystolicArrayWorkerCount(1UL);
+        }
+
+        m_tileWindowReportArray.assign(windowCount, TileWindowReport());
+
+        std::vector<std::exception_ptr> exceptionPtrArray(windowCount);
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for(size_t windowIndex = 0; windowIndex < windowCount; ++windowIndex)
+        {
+            const bool windowLast{windowIndex == (windowCount - 1UL)};
+
+            const size_t blockBegin{(windowIndex*activationMatrixBlocksY)/windowCount};
+            const size_t blockEnd{((windowIndex + 1UL)*activationMatrixBlocksY)/windowCount};
+
+            const size_t blockHalo{(blockBegin > haloBlocks) ?
+                                        ((blockBegin - haloBlocks) & ~1UL) : 0UL};
+
+            const size_t rowBegin{blockHalo*m_accumulatorArrayBufferHeight};
+            const size_t rowEnd{windowLast ? sizeM : blockEnd*m_accumulatorArrayBufferHeight};
+
+            MatrixProcessingUnit& tileReplica{*m_tileReplicaArray[windowIndex]};
+
+            tileReplica.setSteadyStateSkipping(m_steadyStateSkipping);
+            tileReplica.setAccumulatorArrayDrainMode(m_accumulatorArrayDrainMode);
+            tileReplica.setSteadyStateExecutionMode(getSteadyStateExecutionMode());
+            tileReplica.setTemporalTileIterations(getTemporalTileIterations());
+
+            try
+            {
+                tileReplica.runMultiplicationTileWindow(rowEnd - rowBegin, sizeN, sizeK,
+                                                        matrixAPtr + rowBegin*sizeK,
+                                                        matrixBPtr,
+                                                        matrixCPtr + rowBegin*sizeN,
+                                                        (blockBegin - blockHalo)*blockIterations,
+                                                        windowLast ?
+                                                            std::numeric_limits<size_t>::max() :
+                                                            (blockEnd - blockHalo)*blockIterations,
+                                                        m_tileWindowReportArray[windowIndex]);
+            }
+
+            catch(...)
+            {
+                exceptionPtrArray[windowIndex] = std::current_exception();
+            }
+        }
+
+        for(const std::exception_ptr& exceptionPtr : exceptionPtrArray)
+        {
+            if(exceptionPtr)
+            {
+                std::rethrow_exception(exceptionPtr);
+            }
+        }
+
+        /* Reduction */
+
+        size_t iterationCount{0UL};
+        size_t intraPeDataMovements{0UL};
+        size_t interPeDataMovements{0UL};
+        size_t multiplicationsWithWeightZeroCount{0UL};
+        size_t weightFetcherLoadCount{0UL};
+        size_t weightFetcherConcurrentLoadsMax{0UL};
+        size_t weightFetcherConcurrentLoadsPerColumnMax{0UL};
+        size_t weightUpdateRequestQueueLengthMax{0UL};
+
+        for(const TileWindowReport& tileWindowReport : m_tileWindowReportArray)
+        {
+            iterationCount += tileWindowReport.iterationsWindow;
+
+            intraPeDataMovements += tileWindowReport.intraPeDataMovements;
+            interPeDataMovements += tileWindowReport.interPeDataMovements;
+            multiplicationsWithWeightZeroCount += tileWindowReport.multiplicationsWithWeightZeroCount;
+
+            weightFetcherLoadCount += tileWindowReport.weightFetcherLoadCount;
+
+            weightFetcherConcurrentLoadsMax =
+                        std::max(weightFetcherConcurrentLoadsMax,
+                                    tileWindowReport.weightFetcherConcurrentLoadsMax);
+
+            weightFetcherConcurrentLoadsPerColumnMax =
+                        std::max(weightFetcherConcurrentLoadsPerColumnMax,
+                                    tileWindowReport.weightFetcherConcurrentLoadsPerColumnMax);
+
+            weightUpdateRequestQueueLengthMax =
+                        std::max(weightUpdateRequestQueueLengthMax,
+                                    tileWindowReport.weightUpdateRequestQueueLengthMax);
+
+            m_accumulatorArrayLoadCount += tileWindowReport.accumulatorArrayLoadCount;
+
+            m_concurrentAccumulatorLoadCountMax =
+                        std::max(m_concurrentAccumulatorLoadCountMax,
+                                    tileWindowReport.concurrentAccumulatorLoadCountMax);
+
+            m_concurrentAccumulatorArrayLoadCountPerColumnMax =
+                        std::max(m_concurrentAccumulatorArrayLoadCountPerColumnMax,
+                                    tileWindowReport.concurrentAccumulatorArrayLoadCountPerColumnMax);
+
+            m_accumulatorArrayReadOperationQueueLengthMax =
+                        std::max(m_accumulatorArrayReadOperationQueueLengthMax,
+                                    tileWindowReport.accumulatorArrayReadOperationQueueLengthMax);
+
+            m_systolicArrayInputCountMax =
+                        std::max(m_systolicArrayInputCountMax,
+                                    tileWindowReport.systolicArrayInputCountMax);
+
+            if(m_debugFlag)
+            {
+                std::cout << "Tile replica: Halo iterations: "
+                            << tileWindowReport.iterationsHalo
+                            << "\tWindow iterations: "
+                            << tileWindowReport.iterationsWindow << std::endl;
+            }
+        }
+
+        m_systolicArrayPtr->addExecutionMetrics(intraPeDataMovements,
+                                                    interPeDataMovements,
+                                                    multiplicationsWithWeightZeroCount);
+
+        m_weightFetcher.addDataMovementMetrics(weightFetcherLoadCount,
+                                                weightFetcherConcurrentLoadsMax,
+                                                weightFetcherConcurrentLoadsPerColumnMax,
+                                                weightUpdateRequestQueueLengthMax);
+
+        /* The startup sequence takes four stalled iterations */
+
+        m_iterationCountTotal += 4UL + iterationCount;
+        m_iterationCountStalled += 4UL;
+    }
+
+    /**
+     * @brief                   Simulate the window of a tile replica, see
+     *                          runMultiplicationTileParallel()
+     * @param sizeM             The row count of the activation matrix rows of the replica
+     * @param sizeN             The column count of the weight matrix
+     * @param sizeK             The column count of the activation matrix
+     * @param matrixAPtr        A pointer to the first activation matrix row of the replica
+     * @param matrixBPtr        A pointer to the weight matrix
+     * @param matrixCPtr        A pointer to the first result matrix row of the replica
+     * @param iterationBegin    The first main loop iteration of the window
+     * @param iterationEnd      The main loop iteration ending the window
+     * @param tileWindowReport  Receives the execution metrics of the window
+     */
+
+    void runMultiplicationTileWindow(const size_t sizeM,
+                                        const size_t sizeN,
+                                        const size_t sizeK,
+                                        const ActivationDatatype* const matrixAPtr,
+                                        const WeightDatatype* const matrixBPtr,
+                                        AccumulatorDatatype* const matrixCPtr,
+                                        const size_t iterationBegin,
+                                        const size_t iterationEnd,
+                                        TileWindowReport& tileWindowReport)
+    {
+        resetTileWindowMetrics();
+        resetIterationCounts();
+
+        runMultiplicationCycleAccurate(sizeM, sizeN, sizeK,
+                                        matrixAPtr, matrixBPtr, matrixCPtr,
+                                        iterationBegin, iterationEnd);
+
+        if(iterationEnd == std::numeric_limits<size_t>::max())
+        {
+            storeTileWindowReport(iterationBegin, m_iterationCountTotal - 4UL - iterationBegin);
+        }
+
+        tileWindowReport = m_tileWindowReport;
+    }
+
+    /**
+     * @brief                   Store the execution metrics collected since the start
+     *                          of the window of a tile replica to its tile window report
+     * @param iterationsHalo    The main loop iterations before the window
+     * @param iterationsWindow  The main loop iterations of the window
+     */
+
+    void storeTileWindowReport(const size_t iterationsHalo,
+                                const size_t iterationsWindow)
+    {
+        TileWindowReport& tileWindowReport{m_tileWindowReport};
+
+        tileWindowReport.iterationsHalo = iterationsHalo;
+        tileWindowReport.iterationsWindow = iterationsWindow;
+
+
+        tileWindowReport.intraPeDataMovements = m_systolicArrayPtr->getIntraPeDataMovements();
+        tileWindowReport.interPeDataMovements = m_systolicArrayPtr->getInterPeDataMovements();
+        tileWindowReport.multiplicationsWithWeightZeroCount =
+                                    m_systolicArrayPtr->getMuliplicationsWithWeightZeroCountTotal();
+
+        tileWindowReport.weightFetcherLoadCount = m_weightFetcher.getLoadCount();
+        tileWindowReport.weightFetcherConcurrentLoadsMax = m_weightFetcher.getConcurrentLoadsMax();
+        tileWindowReport.weightFetcherConcurrentLoadsPerColumnMax =
+                                    m_weightFetcher.getConcurrentLoadsPerColumnMax();
+        tileWindowReport.weightUpdateRequestQueueLengthMax =
+                                    m_weightFetcher.getWeightUpdateRequestQueueLengthMax();
+
+        tileWindowReport.accumulatorArrayLoadCount = m_accumulatorArrayLoadCount;
+        tileWindowReport.concurrentAccumulatorLoadCountMax = m_concurrentAccumulatorLoadCountMax;
+        tileWindowReport.concurrentAccumulatorArrayLoadCountPerColumnMax =
+                                    m_concurrentAccumulatorArrayLoadCountPerColumnMax;
+        tileWindowReport.accumulatorArrayReadOperationQueueLengthMax =
+                                    m_accumulatorArrayReadOperationQueueLengthMax;
+
+        tileWindowReport.systolicArrayInputCountMax = m_systolicArrayInputCountMax;
+    }
+
+    /**
+     * @brief   Reset the execution metrics of a tile replica
+     *          at the start of its window
+     */
+
+    void resetTileWindowMetrics()
+    {
+        resetDataMovementAndFootprintMetrics();
+
+        m_weightFetcher.resetMaxRegisterValues();
+    }
+
+    /**
+     * @brief   Get the number of upcoming iterations of the current
+     *          matrix multiplication that can be skipped, as all
+     *          functional units are in steady state in them. In steady
+     *          state, the weight fetcher is idle, the SDSU streams rows of
+     *          a single activation matrix block to all activation FIFOs,
+     *          the systolic array computes in all PEs, and the accumulator
+     *          array writes a row of partial sums per iteration. The steady
+     *          state ends at the next weight update, activation matrix
+     *          block, or accumulator array buffer event. Returns zero if
+     *          fewer iterations than required to amortize the skip remain.
+     * @param iterationsLimit   The maximum number of iterations to skip
+     */
+
+    size_t getSteadyStateIterations(const size_t iterationsLimit) const
+    {
+        if(m_weightFetcher.hasBusySignal() ||
+                    m_accumulatorArray.hasDataReadySignal() ||
+                    (!m_systolicDataSetupUnit.hasBusySignal() &&
+                        (m_activationMatrixBlockCoordinateY != m_activationMatrixBlocksY)))
+        {
+            return 0UL;
+        }
+
+        size_t iterations{std::min({m_systolicDataSetupUnit.getSteadyStateIterationsMax(),
+                                        m_accumulatorArray.getSteadyStateIterationsMax(),
+                                        iterationsLimit})};
+
+        if(m_systolicArrayActivationMatrixRowBlockCoordinate != m_activationMatrixBlocksY)
+        {
+            const size_t weightMatrixOutputRowsWeightUpdateSignal{
+                                (m_systolicArrayActivationMatrixRowBlockCoordinate !=
+                                                                    (m_activationMatrixBlocksY - 1)) ?
+                                                                    m_accumulatorArrayBufferHeight :
+                                                                    m_activationMatrixRowsLastBlock};
+
+            if(m_systolicArrayInputCount <= weightMatrixOutputRowsWeightUpdateSignal)
+            {
+                iterations = std::min(iterations, weightMatrixOutputRowsWeightUpdateSignal -
+                                                                        m_systolicArrayInputCount);
+            }
+        }
+
+        if(m_weightFetcherActivationMatrixRowBlockCoordinate != m_activationMatrixBlocksY)
+        {
+            const size_t weightMatrixOutputRowsWeightUpdate{
+                                (m_weightFetcherActivationMatrixRowBlockCoordinate !=
+                                                                (m_activationMatrixBlocksY - 1)) ?
+                                                                m_accumulatorArrayBufferHeight :
+                                                                m_activationMatrixRowsLastBlock};
+
+            if(m_systolicArrayInputCount <= (weightMatrixOutputRowsWeightUpdate - 1))
+            {
+                iterations = std::min(iterations, weightMatrixOutputRowsWeightUpdate - 1 -
+                                                                        m_systolicArrayInputCount);
+            }
+        }
+
+        if((iterations < (m_systolicArrayWidth + m_systolicArrayHeight)) ||
+                                        !m_systolicArrayPtr->isInSteadyState())
+        {
+            return 0UL;
+        }
+
+        return iterations;
+    }
+
+    /**
+     * @brief               Run the given number of steady state iterations as determined
+     *                      by getSteadyStateIterations(). The SDSU and the systolic array
+     *                      are advanced by all iterations at once. The accumulator array
+     *                      writes and the accumulator array read operations are stepped
+     *                      per iteration, as read operations in progress can read rows
+     *                      written in the same iterations.
+     * @param iterations    The number of iterations
+     * @param matrixCPtr    The result matrix, or nullptr if no results are stored
+     * @param sizeN         The column count of the result matrix
+     */
+
+    void runIterationsSteadyState(const size_t iterations,
+                                    AccumulatorDatatype* const matrixCPtr,
+                                    const size_t sizeN)
+    {
+        if(m_debugFlag && m_verboseDebugOutputFlag)
+        {
+            std::cout << "Iterations " << m_iterationCountTotal << " to "
+                        << m_iterationCountTotal + iterations - 1
+                        << " in steady state" << std::endl;
+        }
+
+        m_systolicDataSetupUnit.streamSteadyState(iterations, m_steadyStateFifoInputArray);
+
+        m_systolicArrayPtr->runIterationsSteadyState(iterations,
+                                                        m_steadyStateFifoInputArray,
+                                                        m_steadyStateBottomRowSumArray);
+
+        for(size_t iterationCount{0}; iterationCount < iterations; ++iterationCount)
+        {
+            processAccumulatorArrayReadOperations(matrixCPtr, sizeN);
+
+            m_accumulatorArray.runIterationSteadyState(m_steadyStateBottomRowSumArray.data() +
+                                                            iterationCount*m_systolicArrayWidth);
+
+            m_accumulatorArray.updateState();
+        }
+
+        m_systolicArrayInputCount += iterations;
+        m_iterationCountTotal += iterations;
 
-                    if(m_debugFlag && m_verboseDebugOutputFlag)
-                    {
-                        std::cout << "Read operations currently in progress: "
-                                    << m_accumulatorArrayReadOperationQueue.size() << std::endl;
-                    }
-                }
+        if(m_systolicArrayInputCountMax <
+                        m_systolicArrayInputCount)
+        {
+            m_systolicArrayInputCountMax =
+                        m_systolicArrayInputCount;
+        }
+    }
 
-                else
-                {
-                    ++readOperationQueueIterator;
-                }
-            }
+    /**
+     * @brief               Advance all accumulator array read operations in progress
+     *                      by one diagonal, and remove finished operations from the queue
+     * @param matrixCPtr    The result matrix, or nullptr if the loads are
+     *                      only counted without storing the results
+     * @param sizeN         The column count of the result matrix
+     */
+
+    void processAccumulatorArrayReadOperations(AccumulatorDatatype* const matrixCPtr,
+                                                    const size_t sizeN)
+    {
+        const bool rowBlockDrain{m_accumulatorArrayDrainMode ==
+                                        AccumulatorArrayDrainMode::RowBlock};
+
+        if(!rowBlockDrain)
+        {
+            std::fill(m_accumulatorArrayColumnAccessCountArray.begin(),
+                        m_accumulatorArrayColumnAccessCountArray.end(), 0UL);
+        }
+
+        size_t concurrentAccumulatorArrayLoadCount{0UL};
+        size_t columnAccessRangeCount{0UL};
+
+        /* Read operations of narrower blocks can complete before
+         * operations added earlier, so completed operations are
+         * retired at their position in the queue */
 
-            for(const size_t& element : accumulatorArrayColumnAccessCountVector)
+        for(size_t readOperationIndex{0UL};
+                    readOperationIndex < m_accumulatorArrayReadOperationQueue.size();)
+        {
+            AccumulatorArrayReadOperation& readOperation{
+                                m_accumulatorArrayReadOperationQueue[readOperationIndex]};
+
+            size_t accumulatorArrayColumnAccessStart{0UL};
+            size_t accumulatorArrayColumnAccessEnd{0UL};
+
+            loadAccumulatorData(readOperation.rowBlockCopy ? nullptr : matrixCPtr,
+                                    sizeN,
+                                    readOperation.destMatrixRowStart,
+                                    readOperation.destMatrixColumnStart,
+                                    readOperation.accumulatorArrayBufferSelectBit,
+                                    readOperation.diagonalCoordinate,
+                                    readOperation.blockHeight,
+                                    readOperation.blockWidth,
+                                    concurrentAccumulatorArrayLoadCount,
+                                    accumulatorArrayColumnAccessStart,
+                                    accumulatorArrayColumnAccessEnd);
+
+            /* A row is copied in the iteration in which
+             * the diagonal read would load its last element */
+
+            if(readOperation.rowBlockCopy && matrixCPtr &&
+                    (readOperation.diagonalCoordinate >= (readOperation.blockWidth - 1UL)))
             {
-                if(m_concurrentAccumulatorArrayLoadCountPerColumnMax <
-                                                                element)
-                {
-                    m_concurrentAccumulatorArrayLoadCountPerColumnMax = element;
-                }
+                const size_t row{readOperation.diagonalCoordinate -
+                                            (readOperation.blockWidth - 1UL)};
+
+                m_accumulatorArray.readRow(matrixCPtr + (readOperation.destMatrixRowStart + row)*sizeN +
+                                                                    readOperation.destMatrixColumnStart,
+                                            readOperation.accumulatorArrayBufferSelectBit,
+                                            row,
+                                            readOperation.blockWidth);
             }
 
-            if(m_concurrentAccumulatorLoadCountMax <
-                                concurrentAccumulatorArrayLoadCount)
+            if(rowBlockDrain)
             {
-                m_concurrentAccumulatorLoadCountMax =
-                            concurrentAccumulatorArrayLoadCount;
+                m_accumulatorArrayColumnAccessRangeArray[columnAccessRangeCount] =
+                                            std::make_pair(accumulatorArrayColumnAccessEnd,
+                                                            accumulatorArrayColumnAccessStart);
+                ++columnAccessRangeCount;
             }
 
-            if(m_accumulatorArray.hasDataReadySignal()  &&
-                            (m_resultMatrixReadInProgressBlockCoordinateY != m_activationMatrixBlocksY))
+            else
             {
-                m_accumulatorArray.clearDataReadyBit();
-
-                const size_t outputRows{(m_resultMatrixReadInProgressBlockCoordinateY !=
-                                                            (m_activationMatrixBlocksY - 1)) ?
-                                                                    m_accumulatorArrayBufferHeight :
-                                                                    m_activationMatrixRowsLastBlock};
-
-                const size_t outputColumns{(m_resultMatrixReadInProgressBlockCoordinateX !=
-                                                                    (m_weightMatrixBlocksX - 1)) ?
-                                                                                m_systolicArrayWidth :
-                                                                                m_weightMatrixColumnsLastBlock};
-
-                m_accumulatorArrayReadOperationQueue.emplace_back(
-                                                AccumulatorArrayReadOperation(
-                                                                    m_resultMatrixReadInProgressBlockCoordinateY*
-                                                                    m_accumulatorArrayBufferHeight,
-                                                                    m_systolicArrayWidth*
-                                                                    m_resultMatrixReadInProgressBlockCoordinateX,
-                                                                    m_accumulatorArrayBufferSelectBit,
-                                                                    outputRows,
-                                                                    outputColumns));
-
-                if(m_accumulatorArrayReadOperationQueueLengthMax <
-                                    m_accumulatorArrayReadOperationQueue.size())
+                for(size_t columnCount{accumulatorArrayColumnAccessEnd};
+                                    columnCount <= accumulatorArrayColumnAccessStart; ++columnCount)
                 {
-                    m_accumulatorArrayReadOperationQueueLengthMax =
-                                    m_accumulatorArrayReadOperationQueue.size();
+                    ++m_accumulatorArrayColumnAccessCountArray.at(columnCount);
                 }
+            }
 
-                if(m_debugFlag && m_verboseDebugOutputFlag)
+            ++(readOperation.diagonalCoordinate);
+
+            if(readOperation.diagonalCoordinate ==
+                                    readOperation.blockDiagonals)
+            {
+                if(m_debugFlag)
                 {
-                    std::cout << "Added accumulator array read operation, "
-                                                            "queue position: "
-                                << m_accumulatorArrayReadOperationQueue.size() - 1
-                                << ", accumulator array buffer: "
-                                << m_accumulatorArrayBufferSelectBit
-                                << ", block coordinate: ("
-                                << m_resultMatrixReadInProgressBlockCoordinateX
-                                << ", "
-                                << m_resultMatrixReadInProgressBlockCoordinateY
-                                << "), columns: "
-                                << outputColumns
-                                << ", rows: "
-                                << outputRows
-                                << std::endl;
-                }
+                    if(m_verboseDebugOutputFlag)
+                    {
+                        std::cout << "Result matrix read at queue position "
+                                    << readOperationIndex
+                                    << " done, coordinate ("
+                                    << m_resultMatrixReadDoneBlockCoordinateX
+                                    << ", "
+                                    << m_resultMatrixReadDoneBlockCoordinateY
+                                    << ") of {"
+                                    << m_weightMatrixBlocksX - 1
+                                    << ", "
+                                    << m_activationMatrixBlocksY - 1
+                                    << "}, columns: "
+                                    << readOperation.blockWidth
+                                    << ", rows: "
+                                    << readOperation.blockHeight
+                                    << std::endl;
+                    }
 
-                m_accumulatorArrayBufferSelectBit =
-                            !m_accumulatorArrayBufferSelectBit;
+                    else
+                    {
+                        std::cout << m_resultMatrixReadDoneBlockCoordinateY*
+                                        m_weightMatrixBlocksX +
+                                        m_resultMatrixReadDoneBlockCoordinateX + 1
+                                    << " of "
+                                    << m_weightMatrixBlocksX*m_activationMatrixBlocksY
+                                    << " output blocks done" << std::endl;
+                    }
+                }
 
-                if(m_resultMatrixReadInProgressBlockCoordinateX <
-                                                    (m_weightMatrixBlocksX - 1))
+                if(m_resultMatrixReadDoneBlockCoordinateX <
+                                            (m_weightMatrixBlocksX - 1))
                 {
-                    ++m_resultMatrixReadInProgressBlockCoordinateX;
+                    ++m_resultMatrixReadDoneBlockCoordinateX;
                 }
 
                 else
                 {
-                    m_resultMatrixReadInProgressBlockCoordinateX = 0;
-                    ++m_resultMatrixReadInProgressBlockCoordinateY;
+                    m_resultMatrixReadDoneBlockCoordinateX = 0;
+                    ++m_resultMatrixReadDoneBlockCoordinateY;
                 }
-            }
 
-            m_systolicDataSetupUnit.updateState();
-            m_weightFetcher.updateState();
-            m_systolicArray.updateState();
-            m_accumulatorArray.updateState();
+                m_accumulatorArrayReadOperationQueue.erase(readOperationIndex);
 
-            ++m_systolicArrayInputCount;
-            ++m_iterationCountTotal;
+                if(m_debugFlag && m_verboseDebugOutputFlag)
+                {
+                    std::cout << "Read operations currently in progress: "
+                                << m_accumulatorArrayReadOperationQueue.size() << std::endl;
+                }
+            }
 
-            if(m_systolicArrayInputCountMax <
-                            m_systolicArrayInputCount)
+            else
             {
-                m_systolicArrayInputCountMax =
-                            m_systolicArrayInputCount;
+                ++readOperationIndex;
             }
         }
 
-        while(m_resultMatrixReadDoneBlockCoordinateY !=
-                                            m_activationMatrixBlocksY);
+        if(rowBlockDrain)
+        {
+            /* The maximum number of overlapping column ranges
+             * is reached at the first column of one of them */
 
-        Eigen::Map<const RMatrix<ActivationDatatype>> matrixAEigen(matrixAPtr, sizeM, sizeK);
-        Eigen::Map<const RMatrix<WeightDatatype>> matrixBEigen(matrixBPtr, sizeK, sizeN);
-        const RMatrix<AccumulatorDatatype> matrixCEigen{matrixAEigen.template cast<AccumulatorDatatype>()*
-                                                            matrixBEigen.template cast<AccumulatorDatatype>()};
+            for(size_t rangeIndex{0UL}; rangeIndex < columnAccessRangeCount; ++rangeIndex)
+            {
+                const size_t column{m_accumulatorArrayColumnAccessRangeArray[rangeIndex].first};
 
-        bool sanityCheckPassed{true};
+                size_t columnAccessCount{0UL};
 
-        for(size_t rowCount{0}; rowCount < sizeM; ++rowCount)
-        {
-            for(size_t columnCount{0}; columnCount < sizeN; ++columnCount)
-            {
-                if(matrixCPtr[rowCount*sizeN + columnCount] !=
-                                    matrixCEigen(rowCount, columnCount))
+                for(size_t rangeIndexOther{0UL}; rangeIndexOther < columnAccessRangeCount;
+                                                                        ++rangeIndexOther)
                 {
-                    if(m_debugFlag && m_verboseDebugOutputFlag)
+                    const std::pair<size_t, size_t>& range{
+                                m_accumulatorArrayColumnAccessRangeArray[rangeIndexOther]};
+
+                    if((range.first <= column) && (column <= range.second))
                     {
-                        std::cout << "Systolic array output incorrect at ("
-                                    << columnCount << ", " << rowCount
-                                    << "): Expected value: "
-                                    << matrixCEigen(rowCount, columnCount)
-                                    << " actual value: "
-                                    << matrixCPtr[rowCount*sizeN + columnCount] << std::endl;
+                        ++columnAccessCount;
                     }
+                }
 
-                    sanityCheckPassed = false;
+                if(m_concurrentAccumulatorArrayLoadCountPerColumnMax <
+                                                        columnAccessCount)
+                {
+                    m_concurrentAccumulatorArrayLoadCountPerColumnMax = columnAccessCount;
                 }
             }
         }
 
-        if(m_debugFlag)
-        {
-            std::cout << "Sanity check "
-                        << (sanityCheckPassed ? "passed" : "failed") << std::endl;
-        }
-
-        assert(sanityCheckPassed);
-
-        if(!sanityCheckPassed)
-        {
-            throw MpuException("MPU: Matrix multiplication "
-                                    "result failed sanity check");
-        }
-
-        if(m_debugFlag)
+        else
         {
-            std::cout << "Matrix processing unit: "
-                            "Matrix multiplication: Done\nRequired iterations: "
-                        << m_iterationCountTotal
-                        << "\nStalled iterations: "
-                        << m_iterationCountStalled
-                        << "\nUnified buffer I/O:\nSystolic data setup unit:"
-                                                        "\n\tLoad operations: "
-                        << m_systolicDataSetupUnit.getLoadCount()
-                        << "\nWeight fetcher:\n\tLoad operations: "
-                        << m_weightFetcher.getLoadCount()
-                        << "\n\tMax. concurrent loads per column: "
-                        << m_weightFetcher.getConcurrentLoadsPerColumnMax()
-                        << "\n\tMax. concurrent loads total: "
-                        << m_weightFetcher.getConcurrentLoadsMax()
-                        << "\n\tMax. concurrent load operations: "
-                        << m_concurrentAccumulatorLoadCountMax
-                        << "\n\tMax. concurrent load operations per column: "
-                        << m_concurrentAccumulatorArrayLoadCountPerColumnMax
-                        << "\nStore operations to unified buffer: "
-                        << m_accumulatorArrayLoadCount << std::endl;
+            for(const size_t& element : m_accumulatorArrayColumnAccessCountArray)
+            {
+                if(m_concurrentAccumulatorArrayLoadCountPerColumnMax <
+                                                                element)
+                {
+                    m_concurrentAccumulatorArrayLoadCountPerColumnMax = element;
+                }
+            }
         }
-    }
-
-    
-    /**
-     * @brief
-     * @param operationName
-     */
-    
-    void runMultiplication(const std::string& operationName)
-    {
-
-        const auto weightMatrixDimensions{
-                        m_memoryManagementUnit.getWeightMatrixDimensionsManaged(operationName)};
-
-        const auto activationMatrixDimensions{
-                        m_memoryManagementUnit.getActivationMatrixDimensionsManaged()};
 
-        assert(weightMatrixDimensions.first ==
-                        activationMatrixDimensions.second);
-
-        if(weightMatrixDimensions.first !=
-                        activationMatrixDimensions.second)
+        if(m_concurrentAccumulatorLoadCountMax <
+                            concurrentAccumulatorArrayLoadCount)
         {
-            throw MpuException("Stored activation matrix "
-                                "column count not equal to "
-                                "requested weight matrix row count");
+            m_concurrentAccumulatorLoadCountMax =
+                        concurrentAccumulatorArrayLoadCount;
         }
-
-        m_memoryManagementUnit.setResultMatrixSizeManaged(
-                                        activationMatrixDimensions.first,
-                                        weightMatrixDimensions.second);
-
-        runMultiplication(activationMatrixDimensions.first,
-                                weightMatrixDimensions.second,
-                                activationMatrixDimensions.second,
-                                m_memoryManagementUnit.getActivationMatrixPtrManaged(),
-                                m_memoryManagementUnit.getWeightMatrixPtrManaged(operationName),
-                                m_memoryManagementUnit.getResultMatrixPtrManaged());
-
-        m_statisticsLogEntryAvailableCallback(
-                                MpuStatisticsLogEntry{operationName,
-                                                        activationMatrixDimensions.first,
-                                                        weightMatrixDimensions.second,
-                                                        activationMatrixDimensions.second,
-                                                        m_systolicArrayHeight,
-                                                        m_systolicArrayWidth,
-                                                        m_activationFifoDepth,
-                                                        m_accumulatorArrayHeight,
-                                                        getControlRegisterBitsMpu(),
-                                                        m_systolicDataSetupUnit.getControlRegisterBits(
-                                                            m_memoryManagementUnit.getMemoryUsageMaxByte()),
-                                                        m_systolicArray.getControlRegisterBitsActivationFifos(),
-                                                        m_weightFetcher.getControlRegisterBits(
-                                                            m_memoryManagementUnit.getMemoryUsageMaxByte()),
-                                                        m_systolicArray.getControlRegisterBitsSystolicArray(),
-                                                        m_accumulatorArray.getControlRegisterBits(),
-                                                        m_systolicArray.getDataRegisterBitsActivationFifos(),
-                                                        m_systolicArray.getDataRegisterBitsSystolicArray(),
-                                                        m_accumulatorArray.getDataRegisterBits(),
-                                                        m_memoryManagementUnit.getMemoryUsageMaxBit(),
-                                                        m_systolicArray.getIntraPeDataMovements(),
-                                                        m_systolicArray.getInterPeDataMovements(),
-                                                        m_systolicDataSetupUnit.getLoadCount(),
-                                                        m_weightFetcher.getLoadCount(),
-                                                        m_weightFetcher.getConcurrentLoadsMax(),
-                                                        m_weightFetcher.getConcurrentLoadsPerColumnMax(),
-                                                        m_accumulatorArrayLoadCount,
-                                                        m_concurrentAccumulatorLoadCountMax,
-                                                        m_concurrentAccumulatorArrayLoadCountPerColumnMax,
-                                                        m_iterationCountTotal,
-                                                        m_iterationCountStalled,
-                                                        m_systolicArray.getMuliplicationsWithWeightZeroCountTotal()});
-
-    }
-    
-    ~MatrixProcessingUnit()
-    {
-        std::cout << "MPU object destroyed" << std::endl;
     }
 
-private:
-
     void loadAccumulatorData(AccumulatorDatatype* const destMatrixPtr,
                                 const size_t matrixWidth,
                                 const size_t matrixRowStart,
@@ -1097,9 +2721,9 @@ private:
                                 "larger than accumulator array buffer width");
         }
 
-        AccumulatorDatatype* const dest{destMatrixPtr +
-                                            matrixRowStart*matrixWidth +
-                                            matrixColumnStart};
+        AccumulatorDatatype* const dest{destMatrixPtr ? (destMatrixPtr +
+                                                            matrixRowStart*matrixWidth +
+                                                            matrixColumnStart) : nullptr};
 
         m_accumulatorArray.readDiagonal(dest,
                                         matrixWidth,
@@ -1124,16 +2748,54 @@ private:
 
     const size_t m_unifiedBufferSizeByteMax;
 
-    SystolicArray<WeightDatatype, ActivationDatatype, AccumulatorDatatype> m_systolicArray;
+    const SystolicArrayEngine m_systolicArrayEngine;
+    const SystolicArrayFactory m_systolicArrayFactory;
+
+    std::unique_ptr<SystolicArray<WeightDatatype,
+                                    ActivationDatatype,
+                                    AccumulatorDatatype>> m_systolicArrayPtr;
     SystolicDataSetupUnit<ActivationDatatype> m_systolicDataSetupUnit;
     WeightFetcher<WeightDatatype, ActivationDatatype, AccumulatorDatatype> m_weightFetcher;
     AccumulatorArray<WeightDatatype, ActivationDatatype, AccumulatorDatatype> m_accumulatorArray;
 
-    std::vector<mpusim::byte> m_unifiedBuffer;
+    MpuAnalyticalModel m_analyticalModel;
+
+    MpuSimulationMode m_simulationMode{MpuSimulationMode::CycleAccurate};
+
+    bool m_steadyStateSkipping{true};
+
+    bool m_decoupledFunctionalPassConcurrent{true};
+
+    AccumulatorArrayDrainMode m_accumulatorArrayDrainMode{
+                        (m_systolicArrayEngine == SystolicArrayEngine::StructureOfArrays) ?
+                                                        AccumulatorArrayDrainMode::RowBlock :
+                                                        AccumulatorArrayDrainMode::Diagonal};
+
+    MpuVerificationPolicy m_verificationPolicy{MpuVerificationPolicy::Full};
+    size_t m_verificationRounds{8UL};
+    double m_verificationTimeSeconds{0.0};
+
+    std::default_random_engine m_verificationRng;
+
+    std::vector<ActivationDatatype> m_steadyStateFifoInputArray;
+    std::vector<AccumulatorDatatype> m_steadyStateBottomRowSumArray;
+
+    mpusim::UnifiedBuffer m_unifiedBuffer;
 
     MemoryManagementUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> m_memoryManagementUnit;
 
-    std::vector<AccumulatorArrayReadOperation> m_accumulatorArrayReadOperationQueue;
+    /* A read operation is added at most once per iteration and
+     * completes after reading all diagonals of its block, which
+     * bounds the queue length */
+
+    RingBufferQueue<AccumulatorArrayReadOperation> m_accumulatorArrayReadOperationQueue;
+
+    /* Per iteration scratch storage of the accumulator array read
+     * operations, allocated once so that no heap allocations
+     * are performed in the simulated cycles */
+
+    std::vector<size_t> m_accumulatorArrayColumnAccessCountArray;
+    std::vector<std::pair<size_t, size_t>> m_accumulatorArrayColumnAccessRangeArray;
 
     std::function<void(MpuStatisticsLogEntry&&)> m_statisticsLogEntryAvailableCallback;
 
@@ -1189,6 +2851,15 @@ private:
     bool m_debugFlag{false};
     bool m_verboseDebugOutputFlag{false};
 
+    const bool m_tileReplicaFlag;
+
+    size_t m_tileReplicaCount{static_cast<size_t>(omp_get_max_threads())};
+
+    std::vector<std::unique_ptr<MatrixProcessingUnit>> m_tileReplicaArray;
+    std::vector<TileWindowReport> m_tileWindowReportArray;
+
+    TileWindowReport m_tileWindowReport;
+
 };
 
 
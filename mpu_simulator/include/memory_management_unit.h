@@ -47,12 +47,22 @@
 #include <climits>
 
 #include "mpu_exception.h"
+#include "unified_buffer_allocator.h"
+#include "aligned_allocator.h"
 
 //#define MEMORY_MANAGEMENT_UNIT_DEBUG MEMORY_MANAGEMENT_UNIT_DEBUG
 
 namespace mpusim
 {
 using byte = unsigned char;
+
+/**
+ * @brief   Storage of the unified buffer, aligned like the
+ *          segments handed out by the UnifiedBufferAllocator
+ */
+
+using UnifiedBuffer = std::vector<byte, AlignedAllocator<byte,
+                                    UnifiedBufferAllocator::SegmentAlignmentByte>>;
 }
 
 /**
@@ -78,7 +88,7 @@ struct WeightMatrixDopeVector
     {
     }
 
-    const size_t address;
+    size_t address;
 
     const size_t rows;
     const size_t columns;
@@ -87,6 +97,14 @@ struct WeightMatrixDopeVector
 
 /**
  * @class                       MemoryManagementUnit
+ * @brief                       Manages the weight, activation and result
+ *                              matrices stored in the MPU unified buffer.
+ *                              Every matrix occupies a segment handed out by
+ *                              a segment table allocator, so storing a matrix
+ *                              only copies the matrix itself. The unified
+ *                              buffer is only compacted when it is too
+ *                              fragmented to fit a matrix that would fit
+ *                              into the free space as a whole.
  * @tparam WeightDatatype       
  * @tparam ActivationDatatype   
  * @tparam ResultDatatype       
@@ -104,12 +122,14 @@ public:
      * @param unifiedBufferDynamicResize
      */
 
-    MemoryManagementUnit(std::vector<mpusim::byte>* const unifiedBufferPtr,
+    MemoryManagementUnit(mpusim::UnifiedBuffer* const unifiedBufferPtr,
                                             const size_t unifiedBufferSizeByteMax,
                                             const bool unifiedBufferDynamicResize = true):
                                                                     m_unifiedBufferPtr{unifiedBufferPtr},
                                                                     m_unifiedBufferSizeByteMax{
-                                                                                unifiedBufferSizeByteMax}
+                                                                                unifiedBufferSizeByteMax},
+                                                                    m_unifiedBufferAllocator(
+                                                                                unifiedBufferSizeByteMax)
 
     {
         setUnifiedBufferDynamicResize(unifiedBufferDynamicResize);
@@ -117,7 +137,7 @@ public:
 
     size_t getMemoryUsageMaxByte() const
     {
-        return m_weightMatrixSpaceEnd +
+        return m_weightMatrixSpaceSizeByte +
                 m_combinedActivationAndResultMatrixSpacesSizeMaxByte;
     }
 
@@ -132,7 +152,7 @@ public:
 
         if(m_unifiedBufferDynamicResize)
         {
-            m_unifiedBufferPtr->resize(m_resultMatrixSpaceEnd);
+            m_unifiedBufferPtr->resize(m_unifiedBufferAllocator.getEnd());
         }
 
         else
@@ -209,17 +229,21 @@ public:
     }
 
     /**
-     * @brief
-     * @param oparationName
-     * @param src
-     * @param rows
-     * @param columns
+     * @brief               Allocate the unified buffer space of a weight matrix
+     *                      without copying any data into it, so that the caller
+     *                      can write the weight matrix directly into the unified
+     *                      buffer. If the weight matrix is already present, its
+     *                      space is returned instead.
+     * @param operationName The string identifier of the weight matrix
+     * @param rows          The rows of the weight matrix
+     * @param columns       The columns of the weight matrix
+     * @return              A pointer to the weight matrix space, valid until the
+     *                      next store, allocation, or multiplication
      */
-    
-    void storeWeightMatrixManaged(const std::string& operationName,
-                                    const WeightDatatype* const src,
-                                    const size_t rows,
-                                    const size_t columns)
+
+    WeightDatatype* allocateWeightMatrixManaged(const std::string& operationName,
+                                                    const size_t rows,
+                                                    const size_t columns)
     {
 
         if(operationName.empty())
@@ -237,84 +261,87 @@ public:
                                 "count of zero");
         }
 
-        const mpusim::byte* const srcPtrByte{
-                                    reinterpret_cast<const mpusim::byte* const>(src)};
-
-        const size_t sizeByte{rows*columns*sizeof(WeightDatatype)};
+        const auto weightMatrixDopeVectorIterator =
+                                m_weightMatrixDopeVectorMap.find(operationName);
 
-        if(m_weightMatrixDopeVectorMap.find(operationName) ==
-                                        m_weightMatrixDopeVectorMap.end())
+        if(weightMatrixDopeVectorIterator !=
+                                m_weightMatrixDopeVectorMap.end())
         {
-
-            if((m_resultMatrixSpaceEnd + sizeByte) > m_unifiedBufferSizeByteMax)
+            if((weightMatrixDopeVectorIterator->second.rows != rows) ||
+                    (weightMatrixDopeVectorIterator->second.columns != columns))
             {
-                throw MpuException("Memory management unit: Cannot store "
-                                    "weight matrix to MPU unified buffer, "
-                                    "as new unified buffer size would "
-                                    "exceed maximum allowed size");
+                throw MpuException("Memory management unit: Weight matrix "
+                                    "for operation \"" + operationName +
+                                    "\" already present in unified buffer "
+                                    "with different dimensions");
             }
 
-            if(m_unifiedBufferDynamicResize)
-            {
+#ifdef MEMORY_MANAGEMENT_UNIT_DEBUG
+            std::cout << "Memory management unit: Weight matrix "
+                            "for operation \"" << operationName
+                        << "\" already present in unified buffer" << std::endl;
+#endif
 
-                m_unifiedBufferPtr->insert(m_unifiedBufferPtr->begin() +
-                                                    m_weightMatrixSpaceEnd,
-                                                    srcPtrByte,
-                                                    srcPtrByte + sizeByte);
-            }
+            return getWeightMatrixPtrManaged(operationName);
+        }
 
-            else
-            {
-                const std::vector<mpusim::byte> activationAndResultMatrixBuffer(
-                                                            m_unifiedBufferPtr->begin() +
-                                                                        m_weightMatrixSpaceEnd,
-                                                            m_unifiedBufferPtr->begin() +
-                                                                        m_resultMatrixSpaceEnd);
-
-                std::copy(activationAndResultMatrixBuffer.begin(),
-                            activationAndResultMatrixBuffer.end(),
-                            m_unifiedBufferPtr->begin() +
-                            m_weightMatrixSpaceEnd + sizeByte);
-
-                std::copy(srcPtrByte,
-                            srcPtrByte + sizeByte,
-                            m_unifiedBufferPtr->begin() +
-                                    m_weightMatrixSpaceEnd);
+        const size_t sizeByte{rows*columns*sizeof(WeightDatatype)};
 
-            }
+        if((m_unifiedBufferAllocator.getAllocatedSizeByte() +
+                    UnifiedBufferAllocator::getSegmentSizeByte(sizeByte)) >
+                                                    m_unifiedBufferSizeByteMax)
+        {
+            throw MpuException("Memory management unit: Cannot store "
+                                "weight matrix to MPU unified buffer, "
+                                "as new unified buffer size would "
+                                "exceed maximum allowed size");
+        }
+
+        const size_t address{allocateSegment(sizeByte)};
 
 #ifdef MEMORY_MANAGEMENT_UNIT_DEBUG
-            std::cout << "Memory management unit:\n\tAdded "
-                            "weight matrix for operation \""
-                        << operationName
-                        << "\"\n\tAddress: 0x"
-                        <<  std::hex << m_weightMatrixSpaceEnd
-                        << "\n\tSize: " << std::dec << sizeByte
-                        << " byte\n\tActivation matrix "
-                                "start address is now 0x"
-                        << std::hex
-                        << m_weightMatrixSpaceEnd + sizeByte
-                        << "\n\rResult matrix space "
-                                "start address is now 0x"
-                        << m_activationMatrixSpaceEnd + sizeByte
-                        << std::endl;
+        std::cout << "Memory management unit:\n\tAdded "
+                        "weight matrix for operation \""
+                    << operationName
+                    << "\"\n\tAddress: 0x"
+                    <<  std::hex << address
+                    << "\n\tSize: " << std::dec << sizeByte
+                    << " byte\n\tTotal memory size: "
+                    << m_unifiedBufferAllocator.getAllocatedSizeByte()
+                    << " byte" << std::endl;
 #endif
 
-            m_weightMatrixDopeVectorMap.emplace(operationName,
-                                                    WeightMatrixDopeVector(
-                                                            m_weightMatrixSpaceEnd,
-                                                                        rows, columns));
+        m_weightMatrixDopeVectorMap.emplace(operationName,
+                                                WeightMatrixDopeVector(
+                                                                    address,
+                                                                    rows, columns));
 
-            m_weightMatrixSpaceEnd += sizeByte;
-            m_activationMatrixSpaceEnd += sizeByte;
-            m_resultMatrixSpaceEnd += sizeByte;
+        m_weightMatrixSpaceSizeByte += sizeByte;
 
-#ifdef MEMORY_MANAGEMENT_UNIT_DEBUG
-            std::cout << "\n\tTotal memory size: "
-                        << m_resultMatrixSpaceEnd << " byte"
-                        << std::endl;
-#endif
+        return reinterpret_cast<WeightDatatype*>(
+                                    m_unifiedBufferPtr->data() + address);
+    }
 
+    /**
+     * @brief
+     * @param oparationName
+     * @param src
+     * @param rows
+     * @param columns
+     */
+    
+    void storeWeightMatrixManaged(const std::string& operationName,
+                                    const WeightDatatype* const src,
+                                    const size_t rows,
+                                    const size_t columns)
+    {
+        if(m_weightMatrixDopeVectorMap.find(operationName) ==
+                                        m_weightMatrixDopeVectorMap.end())
+        {
+            WeightDatatype* const dest{allocateWeightMatrixManaged(operationName,
+                                                                    rows, columns)};
+
+            std::copy(src, src + rows*columns, dest);
         }
 
         else
@@ -337,18 +364,21 @@ public:
     ActivationDatatype* getActivationMatrixPtrManaged() const
     {
         return reinterpret_cast<ActivationDatatype*>(m_unifiedBufferPtr->data() +
-                                                            m_weightMatrixSpaceEnd);
+                                                            m_activationMatrixAddress);
     }
     
     /**
-     * @brief
-     * @param src
-     * @param rows
-     * @param columns
+     * @brief           Allocate the unified buffer space of the activation
+     *                  matrix without copying any data into it, so that the
+     *                  caller can write the activation matrix directly into
+     *                  the unified buffer. Replaces the stored activation matrix.
+     * @param rows      The rows of the activation matrix
+     * @param columns   The columns of the activation matrix
+     * @return          A pointer to the activation matrix space, valid until
+     *                  the next store, allocation, or multiplication
      */
 
-    void storeActivationMatrixManaged(const ActivationDatatype* const src,
-                                                            const size_t rows,
+    ActivationDatatype* allocateActivationMatrixManaged(const size_t rows,
                                                             const size_t columns)
     {
         if((rows == 0UL) || (columns == 0UL))
@@ -362,18 +392,12 @@ public:
         m_activationMatrixRows = rows;
         m_activationMatrixColumns = columns;
 
-        const mpusim::byte* const srcPtrByte{
-                                    reinterpret_cast<const mpusim::byte* const>(src)};
-
-        const ssize_t sizeByte = rows*columns*sizeof(ActivationDatatype);
+        const size_t sizeByte{rows*columns*sizeof(ActivationDatatype)};
 
-        const ssize_t activationMatrixSpaceGrowth = sizeByte -
-                                                    m_activationMatrixSpaceEnd +
-                                                    m_weightMatrixSpaceEnd;
-
-        if((static_cast<ssize_t>(m_resultMatrixSpaceEnd) +
-                                    activationMatrixSpaceGrowth) >
-                                        static_cast<ssize_t>(m_unifiedBufferSizeByteMax))
+        if((m_unifiedBufferAllocator.getAllocatedSizeByte() -
+                    UnifiedBufferAllocator::getSegmentSizeByte(m_activationMatrixSizeByte) +
+                    UnifiedBufferAllocator::getSegmentSizeByte(sizeByte)) >
+                                                        m_unifiedBufferSizeByteMax)
         {
             throw MpuException("Memory management unit: Cannot store "
                                 "activation matrix to MPU unified "
@@ -381,87 +405,45 @@ public:
                                 "would exceed maximum allowed size");
         }
 
-        if(m_unifiedBufferDynamicResize)
-        {
-            if(activationMatrixSpaceGrowth > 0L)
-            {
-                m_unifiedBufferPtr->insert(m_unifiedBufferPtr->begin() +
-                                                m_activationMatrixSpaceEnd,
-                                                activationMatrixSpaceGrowth,
-                                                mpusim::byte{0});
-            }
-
-            else
-            {
-                m_unifiedBufferPtr->erase(m_unifiedBufferPtr->begin() +
-                                                m_activationMatrixSpaceEnd +
-                                                activationMatrixSpaceGrowth,
-                                            m_unifiedBufferPtr->begin() +
-                                                m_activationMatrixSpaceEnd);
-            }
-        }
-
-        else
-        {
-            const std::vector<mpusim::byte> resultMatrixBuffer(
-                                                m_unifiedBufferPtr->begin() +
-                                                        m_activationMatrixSpaceEnd,
-                                                m_unifiedBufferPtr->begin() +
-                                                        m_resultMatrixSpaceEnd);
-
-            std::copy(resultMatrixBuffer.begin(),
-                            resultMatrixBuffer.end(),
-                            m_unifiedBufferPtr->begin() +
-                            m_activationMatrixSpaceEnd +
-                            activationMatrixSpaceGrowth);
-        }
-
-        m_activationMatrixSpaceEnd += activationMatrixSpaceGrowth;
-        m_resultMatrixSpaceEnd += activationMatrixSpaceGrowth;
-        
-        if(sizeByte)
-
-#ifdef MEMORY_MANAGEMENT_UNIT_DEBUG
-        if(activationMatrixSpaceGrowth != 0L)
-        {
-            std::cout << "Memory management unit:\nExtended "
-                            "activation matrix space, new size: "
-                        << sizeByte
-                        << " byte\n\tGrowth from previous size: "
-                        << activationMatrixSpaceGrowth
-                        << "\n\tResult matrix space "
-                                "start address is now 0x"
-                        << std::hex
-                        << m_activationMatrixSpaceEnd +
-                               activationMatrixSpaceGrowth
-                        << " byte\n\tTotal memory size: "
-                        << std::dec
-                        << m_resultMatrixSpaceEnd << " byte"
-                        << std::endl;
-        }
-#endif
-
-        std::copy(srcPtrByte,
-                    srcPtrByte + sizeByte,
-                    m_unifiedBufferPtr->begin() +
-                            m_weightMatrixSpaceEnd);
+        reallocateSegment(m_activationMatrixAddress,
+                            m_activationMatrixSizeByte,
+                            sizeByte);
 
 #ifdef MEMORY_MANAGEMENT_UNIT_DEBUG
         std::cout << "Memory management unit:\n\tStored "
                         "activation matrix\n\tAddress: 0x"
                     << std::hex
-                    << m_weightMatrixSpaceEnd
+                    << m_activationMatrixAddress
                     << "\n\tSize: " << std::dec
-                    << sizeByte << " byte" << std::endl;
+                    << sizeByte << " byte\n\tTotal memory size: "
+                    << m_unifiedBufferAllocator.getAllocatedSizeByte()
+                    << " byte" << std::endl;
 #endif
 
+        return getActivationMatrixPtrManaged();
+    }
+
+    /**
+     * @brief
+     * @param src
+     * @param rows
+     * @param columns
+     */
+
+    void storeActivationMatrixManaged(const ActivationDatatype* const src,
+                                                            const size_t rows,
+                                                            const size_t columns)
+    {
+        ActivationDatatype* const dest{allocateActivationMatrixManaged(rows, columns)};
+
+        std::copy(src, src + rows*columns, dest);
     }
 
     ResultDatatype* getResultMatrixPtrManaged() const
     {
         return reinterpret_cast<ResultDatatype*>(
                                         m_unifiedBufferPtr->data() +
-                                        m_activationMatrixSpaceEnd);
+                                        m_resultMatrixAddress);
     }
 
     /**
@@ -477,39 +459,38 @@ public:
         m_resultMatrixRows = rows;
         m_resultMatrixColumns = columns;
 
-        const ssize_t sizeByte = m_resultMatrixRows*
-                                    m_resultMatrixColumns*
-                                    sizeof(ResultDatatype);
-
-        const ssize_t resultMatrixSpaceGrowth = sizeByte -
-                                                m_resultMatrixSpaceEnd +
-                                                m_activationMatrixSpaceEnd;
+        const size_t sizeByte{m_resultMatrixRows*
+                                m_resultMatrixColumns*
+                                sizeof(ResultDatatype)};
 
-        if(static_cast<ssize_t>(m_resultMatrixSpaceEnd +
-                                    resultMatrixSpaceGrowth) >
-                                        static_cast<ssize_t>(m_unifiedBufferSizeByteMax))
+        if((m_unifiedBufferAllocator.getAllocatedSizeByte() -
+                    UnifiedBufferAllocator::getSegmentSizeByte(m_resultMatrixSizeByte) +
+                    UnifiedBufferAllocator::getSegmentSizeByte(sizeByte)) >
+                                                        m_unifiedBufferSizeByteMax)
         {
             throw MpuException("Memory management unit: Cannot extend result "
                                 "matrix size, as new MPU unified buffer "
                                 "size would exceed maximum allowed size");
         }
 
-        m_resultMatrixSpaceEnd += resultMatrixSpaceGrowth;
+        const size_t unifiedBufferSizeByteOld{m_unifiedBufferPtr->size()};
 
-        if(m_unifiedBufferDynamicResize)
+        reallocateSegment(m_resultMatrixAddress,
+                            m_resultMatrixSizeByte,
+                            sizeByte);
+
+        if(m_unifiedBufferDynamicResize &&
+                (m_unifiedBufferPtr->size() != unifiedBufferSizeByteOld))
         {
-            m_unifiedBufferPtr->resize(m_resultMatrixSpaceEnd);
             std::cout << "Resized unified buffer, new size: "
-                        << m_resultMatrixSpaceEnd << " byte" << std::endl;
+                        << m_unifiedBufferPtr->size() << " byte" << std::endl;
         }
-        
+
         if(m_combinedActivationAndResultMatrixSpacesSizeMaxByte <
-                                                    (m_resultMatrixSpaceEnd -
-                                                        m_weightMatrixSpaceEnd))
+                                (m_activationMatrixSizeByte + m_resultMatrixSizeByte))
         {
             m_combinedActivationAndResultMatrixSpacesSizeMaxByte =
-                                                    m_resultMatrixSpaceEnd -
-                                                        m_weightMatrixSpaceEnd;
+                                m_activationMatrixSizeByte + m_resultMatrixSizeByte;
             std::cout << "New max combined activation and "
                                     "result matrix space size: "
                         << m_combinedActivationAndResultMatrixSpacesSizeMaxByte 
@@ -517,13 +498,14 @@ public:
         }
 
 #ifdef MEMORY_MANAGEMENT_UNIT_DEBUG
-        std::cout << "Memory management unit:\n\tExtended "
-                            "result matrix space, new size: "
+        std::cout << "Memory management unit:\n\tSet "
+                            "result matrix size: "
                     << sizeByte
-                    << " byte\n\tGrowth from previous size: "
-                    << resultMatrixSpaceGrowth
-                    << " byte\n\tTotal memory size: "
-                    << m_resultMatrixSpaceEnd << " byte" << std::endl;
+                    << " byte\n\tAddress: 0x"
+                    << std::hex << m_resultMatrixAddress
+                    << std::dec << "\n\tTotal memory size: "
+                    << m_unifiedBufferAllocator.getAllocatedSizeByte()
+                    << " byte" << std::endl;
 #endif
 
     }
@@ -544,9 +526,9 @@ public:
         const size_t sizeByte{size*sizeof(ResultDatatype)};
 
         std::copy(m_unifiedBufferPtr->begin() +
-                        m_activationMatrixSpaceEnd,
+                        m_resultMatrixAddress,
                         m_unifiedBufferPtr->begin() +
-                        m_activationMatrixSpaceEnd +
+                        m_resultMatrixAddress +
                         sizeByte, destPtrByte);
 
 #ifdef MEMORY_MANAGEMENT_UNIT_DEBUG
@@ -599,6 +581,12 @@ public:
                                                         numberSignCountHeaderRight + 1 :
                                                         numberSignCountHeaderRight};
 
+        // Format the whole layout into a local stream, so that printing
+        // neither changes the format flags of std::cout nor interleaves
+        // with the output of MPUs running concurrently in other threads
+
+        std::stringstream layoutStringStream;
+
         std::stringstream headerStringStream;
 
         headerStringStream << '\n';
@@ -628,7 +616,7 @@ public:
             elementSeparatorStringStream << '#';
         }
 
-        std::cout << headerStringStream.str()
+        layoutStringStream << headerStringStream.str()
                     << elementSeparatorStringStream.str();
 
         for(const auto& element : weightMatrixDopeVectorMapByAddress)
@@ -649,7 +637,7 @@ public:
                                                 sizeof(WeightDatatype) > 1024UL) ?
                                                                         " kB" : " B")};
 
-            std::cout << "\n#" << std::setw(lineWidth - 1UL)
+            layoutStringStream << "\n#" << std::setw(lineWidth - 1UL)
                         << '#' << "\n# Address: 0x"
                         << std::left
                         << std::hex << std::setw(10)
@@ -668,28 +656,24 @@ public:
                         << std::get<2>(element.second)
                         << std::right
                         << " #\n#" << std::setw(lineWidth - 1UL)
-                        << '#' << std::endl
+                        << '#' << '\n'
                         << elementSeparatorStringStream.str();
 
         }
 
         const std::string activationMatrixSizeByteString{
                                                 std::to_string(
-                                                    ((m_activationMatrixSpaceEnd -
-                                                    m_weightMatrixSpaceEnd) > 1024UL) ?
-                                                        (m_activationMatrixSpaceEnd -
-                                                        m_weightMatrixSpaceEnd)/1024UL :
-                                                        m_activationMatrixSpaceEnd -
-                                                        m_weightMatrixSpaceEnd) +
-                                                ((m_activationMatrixSpaceEnd -
-                                                m_weightMatrixSpaceEnd > 1024UL) ?
+                                                    (m_activationMatrixSizeByte > 1024UL) ?
+                                                        m_activationMatrixSizeByte/1024UL :
+                                                        m_activationMatrixSizeByte) +
+                                                ((m_activationMatrixSizeByte > 1024UL) ?
                                                                         " kB" : " B")};
 
-        std::cout << "\n#" << std::setw(lineWidth - 1UL)
+        layoutStringStream << "\n#" << std::setw(lineWidth - 1UL)
                     << '#' << "\n# Address: 0x"
                     << std::left
                     << std::hex << std::setw(10)
-                    << m_weightMatrixSpaceEnd
+                    << m_activationMatrixAddress
                     << std::setw(weightMatrixOperationNameLength + 17)
                     << "   Activation matrix"
                     << "   Size: "
@@ -703,27 +687,23 @@ public:
                     << m_activationMatrixColumns
                     << std::right
                     << " #\n#" << std::setw(lineWidth - 1UL)
-                    << '#' << std::endl
+                    << '#' << '\n'
                     << elementSeparatorStringStream.str();
 
         const std::string resultMatrixSizeByteString{
                                             std::to_string(
-                                                ((m_resultMatrixSpaceEnd -
-                                                m_activationMatrixSpaceEnd) > 1024UL) ?
-                                                    (m_resultMatrixSpaceEnd -
-                                                    m_activationMatrixSpaceEnd)/1024UL :
-                                                    m_resultMatrixSpaceEnd -
-                                                    m_activationMatrixSpaceEnd) +
-                                            ((m_resultMatrixSpaceEnd -
-                                            m_activationMatrixSpaceEnd > 1024UL) ?
+                                                (m_resultMatrixSizeByte > 1024UL) ?
+                                                    m_resultMatrixSizeByte/1024UL :
+                                                    m_resultMatrixSizeByte) +
+                                            ((m_resultMatrixSizeByte > 1024UL) ?
                                                                         " kB" : " B")};
 
 
-        std::cout << "\n#" << std::setw(lineWidth - 1UL)
+        layoutStringStream << "\n#" << std::setw(lineWidth - 1UL)
                     << '#' << "\n# Address: 0x"
                     << std::left
                     << std::hex << std::setw(10)
-                    << m_activationMatrixSpaceEnd
+                    << m_resultMatrixAddress
                     << std::setw(weightMatrixOperationNameLength + 17)
                     << "   Result matrix"
                     << "   Size: "
@@ -737,18 +717,22 @@ public:
                     << m_resultMatrixColumns
                     << std::right
                     << " #\n#" << std::setw(lineWidth - 1UL)
-                    << '#' << std::endl
+                    << '#' << '\n'
                     << elementSeparatorStringStream.str();
 
-        std::cout << '\n'
+        layoutStringStream << '\n'
                     << elementSeparatorStringStream.str()
-                    << std::endl;
+                    << '\n';
+
+        std::cout << layoutStringStream.str() << std::flush;
     }
 
     void reset()
     {
         m_weightMatrixDopeVectorMap.clear();
 
+        m_unifiedBufferAllocator.reset();
+
         if(m_unifiedBufferDynamicResize)
         {
             m_unifiedBufferPtr->clear();
@@ -760,20 +744,160 @@ public:
         m_resultMatrixRows = 0UL;
         m_resultMatrixColumns = 0UL;
 
-        m_weightMatrixSpaceEnd = 0UL;
-        m_activationMatrixSpaceEnd = 0UL;
-        m_resultMatrixSpaceEnd = 0UL;
+        m_weightMatrixSpaceSizeByte = 0UL;
+
+        m_activationMatrixAddress = 0UL;
+        m_activationMatrixSizeByte = 0UL;
+
+        m_resultMatrixAddress = 0UL;
+        m_resultMatrixSizeByte = 0UL;
 
         m_combinedActivationAndResultMatrixSpacesSizeMaxByte = 0UL;
     }
 
 private:
 
-    std::vector<mpusim::byte>* const m_unifiedBufferPtr;
+    /**
+     * @brief           Allocate a unified buffer segment, compacting the
+     *                  unified buffer if it is too fragmented. The caller
+     *                  has to make sure that the segment fits into the
+     *                  free space of the unified buffer as a whole.
+     * @param sizeByte  The size of the segment
+     * @return          The address of the segment
+     */
+
+    size_t allocateSegment(const size_t sizeByte)
+    {
+        size_t address;
+
+        if(!m_unifiedBufferAllocator.allocate(sizeByte, address))
+        {
+            compactUnifiedBuffer();
+
+            if(!m_unifiedBufferAllocator.allocate(sizeByte, address))
+            {
+                throw MpuException("Memory management unit: Failed to "
+                                    "allocate unified buffer segment "
+                                    "after compaction");
+            }
+        }
+
+        updateUnifiedBufferSize();
+
+        return address;
+    }
+
+    /**
+     * @brief                   Replace the segment of the activation or result
+     *                          matrix with one of the given size, resizing it
+     *                          in place when possible. The previous contents
+     *                          are not preserved when the segment moves.
+     * @param address           The address of the segment, updated
+     *                          to the address of the new segment
+     * @param segmentSizeByte   The size of the segment, zero if no
+     *                          segment is allocated, updated to the
+     *                          new size
+     * @param sizeByte          The new size
+     */
+
+    void reallocateSegment(size_t& address,
+                                size_t& segmentSizeByte,
+                                const size_t sizeByte)
+    {
+        if(segmentSizeByte != 0UL)
+        {
+            if((sizeByte != 0UL) &&
+                    m_unifiedBufferAllocator.resize(address, sizeByte))
+            {
+                segmentSizeByte = sizeByte;
+
+                updateUnifiedBufferSize();
+                return;
+            }
+
+            m_unifiedBufferAllocator.deallocate(address);
+
+            address = 0UL;
+            segmentSizeByte = 0UL;
+        }
+
+        if(sizeByte == 0UL)
+        {
+            updateUnifiedBufferSize();
+            return;
+        }
+
+        address = allocateSegment(sizeByte);
+        segmentSizeByte = sizeByte;
+    }
+
+    void compactUnifiedBuffer()
+    {
+        const std::vector<UnifiedBufferSegmentRelocation> relocationArray{
+                                                m_unifiedBufferAllocator.compact()};
+
+        std::map<size_t, size_t> addressMap;
+
+        for(const UnifiedBufferSegmentRelocation& relocation : relocationArray)
+        {
+            std::copy(m_unifiedBufferPtr->begin() + relocation.addressOld,
+                        m_unifiedBufferPtr->begin() + relocation.addressOld +
+                                                        relocation.sizeByte,
+                        m_unifiedBufferPtr->begin() + relocation.addressNew);
+
+            addressMap.emplace(relocation.addressOld, relocation.addressNew);
+        }
+
+        const auto relocate = [&addressMap](size_t& address)
+        {
+            const auto addressIterator = addressMap.find(address);
+
+            if(addressIterator != addressMap.end())
+            {
+                address = addressIterator->second;
+            }
+        };
+
+        for(auto& element : m_weightMatrixDopeVectorMap)
+        {
+            relocate(element.second.address);
+        }
+
+        if(m_activationMatrixSizeByte != 0UL)
+        {
+            relocate(m_activationMatrixAddress);
+        }
+
+        if(m_resultMatrixSizeByte != 0UL)
+        {
+            relocate(m_resultMatrixAddress);
+        }
+
+        updateUnifiedBufferSize();
+
+#ifdef MEMORY_MANAGEMENT_UNIT_DEBUG
+        std::cout << "Memory management unit: Compacted unified "
+                        "buffer, relocated "
+                    << relocationArray.size()
+                    << " segments" << std::endl;
+#endif
+    }
+
+    void updateUnifiedBufferSize()
+    {
+        if(m_unifiedBufferDynamicResize)
+        {
+            m_unifiedBufferPtr->resize(m_unifiedBufferAllocator.getEnd());
+        }
+    }
+
+    mpusim::UnifiedBuffer* const m_unifiedBufferPtr;
 
     const size_t m_unifiedBufferSizeByteMax;
 
-    std::unordered_map<std::string, const WeightMatrixDopeVector> m_weightMatrixDopeVectorMap;
+    UnifiedBufferAllocator m_unifiedBufferAllocator;
+
+    std::unordered_map<std::string, WeightMatrixDopeVector> m_weightMatrixDopeVectorMap;
 
     size_t m_activationMatrixRows{0UL};
     size_t m_activationMatrixColumns{0UL};
@@ -781,9 +905,13 @@ private:
     size_t m_resultMatrixRows{0UL};
     size_t m_resultMatrixColumns{0UL};
 
-    size_t m_weightMatrixSpaceEnd{0UL};
-    size_t m_activationMatrixSpaceEnd{0UL};
-    size_t m_resultMatrixSpaceEnd{0UL};
+    size_t m_weightMatrixSpaceSizeByte{0UL};
+
+    size_t m_activationMatrixAddress{0UL};
+    size_t m_activationMatrixSizeByte{0UL};
+
+    size_t m_resultMatrixAddress{0UL};
+    size_t m_resultMatrixSizeByte{0UL};
 
     size_t m_combinedActivationAndResultMatrixSpacesSizeMaxByte{0UL};
 
@@ -0,0 +1,779 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        mpu_analytical_model.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef MPU_ANALYTICAL_MODEL_H
+#define MPU_ANALYTICAL_MODEL_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <sys/types.h>
+
+/**
+ * @class   MpuAnalyticalModel
+ * @brief   Block level model of the timing dependent execution metrics
+ *          of a matrix multiplication performed by the MCU.
+ * @details The MCU streams the activation matrix tiles through the
+ *          systolic array in passes, one pass per combination of
+ *          activation matrix row block, weight matrix block column
+ *          and weight matrix block row, in that order. Each pass
+ *          takes one iteration per activation matrix row of the tile,
+ *          as the systolic array never stalls after the startup
+ *          sequence. All events of a multiplication are therefore
+ *          known in advance: The weight update request of a pass is
+ *          issued in the last iteration of the preceding pass, and the
+ *          accumulator array signals a finished result matrix tile
+ *          m_systolicArrayHeight + 2 iterations after the start of the
+ *          last pass accumulating into it. The weight fetcher and the
+ *          accumulator array read operations process one diagonal per
+ *          iteration. The maxima of the concurrent load counts are
+ *          sums of piecewise linear functions of the iteration, and
+ *          are evaluated only at the iterations at which one of their
+ *          terms changes its slope. The per column maxima and queue
+ *          lengths are interval overlap maxima. The systolic array
+ *          data movement counts are closed form functions of the
+ *          tiling, corrected for the PE operations that are cut off
+ *          by the end of the MCU loop. All values are equal to the
+ *          ones produced by simulating the multiplication cycle by
+ *          cycle. Iterations are counted from the first
+ *          iteration of the main MCU loop, the startup sequence is
+ *          not included.
+ */
+
+class MpuAnalyticalModel
+{
+
+public:
+
+    /**
+     * @brief                               MpuAnalyticalModel constructor
+     * @param systolicArrayWidth            The width of the systolic array
+     * @param systolicArrayHeight           The height of the systolic array
+     * @param accumulatorArrayBufferHeight  The height of one of the accumulator array buffers
+     */
+
+    MpuAnalyticalModel(const size_t systolicArrayWidth,
+                        const size_t systolicArrayHeight,
+                        const size_t accumulatorArrayBufferHeight): m_systolicArrayWidth{systolicArrayWidth},
+                                                                    m_systolicArrayHeight{systolicArrayHeight},
+                                                                    m_systolicArrayDiagonals{systolicArrayWidth +
+                                                                                                systolicArrayHeight - 1UL},
+                                                                    m_accumulatorArrayBufferHeight{accumulatorArrayBufferHeight}
+    {
+    }
+
+    /**
+     * @brief                               Evaluate the model for a matrix multiplication
+     * @param weightMatrixPtr               Pointer to the weight matrix
+     * @param sizeM                         The row count of the activation matrix
+     * @param sizeN                         The column count of the weight matrix
+     * @param sizeK                         The column count of the activation matrix
+     * @param activationMatrixBlocksY       The number of activation matrix row blocks
+     * @param activationMatrixRowsLastBlock The rows of the last activation matrix row block
+     * @param weightMatrixBlocksX           The number of weight matrix block columns
+     * @param weightMatrixBlocksY           The number of weight matrix block rows
+     * @param weightMatrixColumnsLastBlock  The columns of the last weight matrix block column
+     */
+
+    template<typename WeightDatatype>
+    void evaluate(const WeightDatatype* const weightMatrixPtr,
+                    const size_t sizeM,
+                    const size_t sizeN,
+                    const size_t sizeK,
+                    const size_t activationMatrixBlocksY,
+                    const size_t activationMatrixRowsLastBlock,
+                    const size_t weightMatrixBlocksX,
+                    const size_t weightMatrixBlocksY,
+                    const size_t weightMatrixColumnsLastBlock)
+    {
+        const size_t idleRowsLastBlock{weightMatrixBlocksY*
+                                            m_systolicArrayHeight - sizeK};
+
+        m_weightUpdateRequestArray.clear();
+        m_readOperationArray.clear();
+        m_passArray.clear();
+
+        ssize_t passStart{0L};
+
+        for(size_t blockCoordinateY{0UL};
+                    blockCoordinateY < activationMatrixBlocksY; ++blockCoordinateY)
+        {
+            const size_t rows{(blockCoordinateY != (activationMatrixBlocksY - 1)) ?
+                                                        m_accumulatorArrayBufferHeight :
+                                                        activationMatrixRowsLastBlock};
+
+            /* A single row tile accumulated over multiple passes
+             * has its row pointer at zero one iteration earlier,
+             * so that its data ready signal is set one iteration
+             * earlier as well. */
+
+            const ssize_t dataReadyLatency{static_cast<ssize_t>(m_systolicArrayHeight) + 2L -
+                                                (((rows == 1UL) && (weightMatrixBlocksY > 1UL)) ? 1L : 0L)};
+
+            for(size_t blockCoordinateX{0UL};
+                        blockCoordinateX < weightMatrixBlocksX; ++blockCoordinateX)
+            {
+                const size_t columns{(blockCoordinateX != (weightMatrixBlocksX - 1)) ?
+                                                                m_systolicArrayWidth :
+                                                                weightMatrixColumnsLastBlock};
+
+                for(size_t weightBlockCoordinateY{0UL};
+                            weightBlockCoordinateY < weightMatrixBlocksY; ++weightBlockCoordinateY)
+                {
+                    /* The weight update request of the first pass is
+                     * issued before the two weight fetcher iterations
+                     * of the startup sequence. */
+
+                    m_weightUpdateRequestArray.emplace_back(
+                                    TileEvent{(passStart == 0L) ? -3L : (passStart - 1L), columns,
+                                                (weightBlockCoordinateY != (weightMatrixBlocksY - 1)) ?
+                                                                                0UL : idleRowsLastBlock});
+
+                    if(weightBlockCoordinateY == (weightMatrixBlocksY - 1))
+                    {
+                        m_readOperationArray.emplace_back(
+                                    TileEvent{passStart + dataReadyLatency, columns, rows});
+                    }
+
+                    m_passArray.emplace_back(Pass{passStart, rows, blockCoordinateX,
+                                                    weightBlockCoordinateY,
+                                                    m_weightUpdateRequestArray.back().columns,
+                                                    m_weightUpdateRequestArray.back().rows});
+
+                    passStart += rows;
+                }
+            }
+        }
+
+        m_systolicArrayInputCountTotal = passStart;
+
+        ssize_t iterationCount{0L};
+
+        for(const TileEvent& readOperation : m_readOperationArray)
+        {
+            iterationCount = std::max(iterationCount, readOperation.cycle +
+                                                        static_cast<ssize_t>(readOperation.columns +
+                                                                                readOperation.rows));
+        }
+
+        m_iterationCount = iterationCount;
+
+        /* The input count is reset at the end of every pass
+         * but the last, after which it keeps counting until
+         * the last read operation is done. */
+
+        m_systolicArrayInputCountMax = std::max(
+                                static_cast<size_t>(iterationCount - passStart) +
+                                                        activationMatrixRowsLastBlock,
+                                (activationMatrixBlocksY > 1UL) ?
+                                        m_accumulatorArrayBufferHeight : 0UL);
+
+        evaluateWeightFetcher(weightMatrixColumnsLastBlock);
+        evaluateAccumulatorArrayReads(weightMatrixColumnsLastBlock);
+        evaluateAccumulatorArrayLoadCount();
+
+        const size_t weightMatrixZeroCount = std::count(weightMatrixPtr,
+                                                            weightMatrixPtr + sizeK*sizeN,
+                                                            WeightDatatype(0));
+
+        evaluateSystolicArray(weightMatrixPtr, sizeN,
+                                sizeM*(sizeK*sizeN - weightMatrixZeroCount));
+    }
+
+    size_t getIterationCount() const
+    {
+        return m_iterationCount;
+    }
+
+    size_t getSystolicArrayInputCountTotal() const
+    {
+        return m_systolicArrayInputCountTotal;
+    }
+
+    size_t getSystolicArrayInputCountMax() const
+    {
+        return m_systolicArrayInputCountMax;
+    }
+
+    size_t getIntraPeDataMovements() const
+    {
+        return m_intraPeDataMovements;
+    }
+
+    size_t getInterPeDataMovements() const
+    {
+        return m_interPeDataMovements;
+    }
+
+    size_t getMultiplicationsWithWeightZeroCount() const
+    {
+        return m_multiplicationsWithWeightZeroCount;
+    }
+
+    size_t getAccumulatorArrayLoadCount() const
+    {
+        return m_accumulatorArrayLoadCount;
+    }
+
+    size_t getWeightUpdateRequestQueueLengthMax() const
+    {
+        return m_weightUpdateRequestQueueLengthMax;
+    }
+
+    size_t getWeightFetcherConcurrentLoadsMax() const
+    {
+        return m_weightFetcherConcurrentLoadsMax;
+    }
+
+    size_t getWeightFetcherConcurrentLoadsPerColumnMax() const
+    {
+        return m_weightFetcherConcurrentLoadsPerColumnMax;
+    }
+
+    size_t getAccumulatorArrayReadOperationQueueLengthMax() const
+    {
+        return m_accumulatorArrayReadOperationQueueLengthMax;
+    }
+
+    size_t getConcurrentAccumulatorLoadCountMax() const
+    {
+        return m_concurrentAccumulatorLoadCountMax;
+    }
+
+    size_t getConcurrentAccumulatorArrayLoadCountPerColumnMax() const
+    {
+        return m_concurrentAccumulatorArrayLoadCountPerColumnMax;
+    }
+
+private:
+
+    /**
+     * @struct  TileEvent
+     * @brief   Weight update request or accumulator array read
+     *          operation of a tile: The iteration it is issued in,
+     *          the width of the tile, and the idle rows of the
+     *          weight matrix tile or the rows of the result matrix
+     *          tile respectively. The tile is processed one diagonal
+     *          per iteration starting in the iteration after it
+     *          was issued.
+     */
+
+    struct TileEvent
+    {
+        ssize_t cycle;
+        size_t columns;
+        size_t rows;
+    };
+
+    /**
+     * @struct  Pass
+     * @brief   Pass of an activation matrix tile through the
+     *          systolic array: The iteration its first row enters
+     *          the systolic array, its row count, the coordinates
+     *          of the weight matrix tile held by the systolic array,
+     *          and the width and idle rows of that tile.
+     */
+
+    struct Pass
+    {
+        ssize_t cycle;
+        size_t rows;
+        size_t weightBlockCoordinateX;
+        size_t weightBlockCoordinateY;
+        size_t columns;
+        size_t idleRows;
+    };
+
+    using Interval = std::pair<ssize_t, ssize_t>;
+
+    /**
+     * @brief       Get the maximum number of overlapping closed
+     *              intervals within the closed range [begin, end]
+     */
+
+    static size_t getOverlapMax(const std::vector<Interval>& intervals,
+                                    const ssize_t begin,
+                                    const ssize_t end)
+    {
+        std::vector<std::pair<ssize_t, int>> events;
+
+        for(const Interval& interval : intervals)
+        {
+            const ssize_t intervalBegin{std::max(interval.first, begin)};
+            const ssize_t intervalEnd{std::min(interval.second, end)};
+
+            if(intervalBegin <= intervalEnd)
+            {
+                events.emplace_back(intervalBegin, 1);
+                events.emplace_back(intervalEnd + 1L, -1);
+            }
+        }
+
+        /* Intervals ending before an iteration are
+         * removed before the ones starting in it
+         * are added. */
+
+        std::sort(events.begin(), events.end());
+
+        size_t overlap{0UL};
+        size_t overlapMax{0UL};
+
+        for(const std::pair<ssize_t, int>& event : events)
+        {
+            overlap += event.second;
+            overlapMax = std::max(overlapMax, overlap);
+        }
+
+        return overlapMax;
+    }
+
+    size_t getWeightLoadsOnDiagonal(const TileEvent& weightUpdateRequest,
+                                        const ssize_t diagonal) const
+    {
+        const ssize_t rowBegin{std::max(static_cast<ssize_t>(weightUpdateRequest.rows),
+                                            diagonal - static_cast<ssize_t>(weightUpdateRequest.columns) + 1L)};
+
+        const ssize_t rowEnd{std::min(diagonal, static_cast<ssize_t>(m_systolicArrayHeight) - 1L)};
+
+        return (rowEnd >= rowBegin) ? static_cast<size_t>(rowEnd - rowBegin + 1L) : 0UL;
+    }
+
+    static size_t getAccumulatorLoadsOnDiagonal(const TileEvent& readOperation,
+                                                    const ssize_t diagonal)
+    {
+        const ssize_t diagonals{static_cast<ssize_t>(readOperation.rows +
+                                                        readOperation.columns) - 1L};
+
+        return static_cast<size_t>(std::min(std::min(diagonal + 1L, diagonals - diagonal),
+                                        static_cast<ssize_t>(std::min(readOperation.rows,
+                                                                        readOperation.columns))));
+    }
+
+    /**
+     * @brief       Get the sum of the loads of a read operation on
+     *              its first diagonals
+     * @param count The number of diagonals
+     */
+
+    static size_t getAccumulatorLoadsOnDiagonals(const TileEvent& readOperation,
+                                                    const ssize_t count)
+    {
+        const size_t diagonals{readOperation.rows + readOperation.columns - 1UL};
+        const size_t dimensionMin{std::min(readOperation.rows, readOperation.columns)};
+
+        const size_t countClipped{static_cast<size_t>(std::max(0L, count))};
+
+        /* The loads rise by one per diagonal up to the smaller
+         * dimension of the tile, stay constant until the larger
+         * dimension is reached, and fall by one per diagonal
+         * afterwards. */
+
+        const size_t fallingBegin{diagonals - dimensionMin + 1UL};
+
+        const size_t countRising{std::min(countClipped, dimensionMin)};
+        const size_t countFlat{std::min(countClipped, fallingBegin) - countRising};
+        const size_t countFalling{(countClipped > fallingBegin) ?
+                                        (countClipped - fallingBegin) : 0UL};
+
+        return countRising*(countRising + 1UL)/2UL + dimensionMin*countFlat +
+                    countFalling*(2UL*dimensionMin - 1UL - countFalling)/2UL;
+    }
+
+    void evaluateWeightFetcher(const size_t weightMatrixColumnsLastBlock)
+    {
+        const ssize_t diagonals{static_cast<ssize_t>(m_systolicArrayDiagonals)};
+        const ssize_t height{static_cast<ssize_t>(m_systolicArrayHeight)};
+
+        /* A request is removed from the queue in the
+         * iteration its last diagonal is processed in,
+         * before new requests are added. */
+
+        m_weightUpdateRequestQueueLengthMax = 0UL;
+
+        for(size_t requestCount{0UL}, oldestCount{0UL};
+                        requestCount < m_weightUpdateRequestArray.size(); ++requestCount)
+        {
+            while(m_weightUpdateRequestArray[oldestCount].cycle + diagonals <=
+                                        m_weightUpdateRequestArray[requestCount].cycle)
+            {
+                ++oldestCount;
+            }
+
+            m_weightUpdateRequestQueueLengthMax = std::max(m_weightUpdateRequestQueueLengthMax,
+                                                            requestCount - oldestCount + 1UL);
+        }
+
+        /* The weight fetcher is also run in the two
+         * iterations preceding the main MCU loop */
+
+        const ssize_t cycleBegin{-2L};
+        const ssize_t cycleEnd{static_cast<ssize_t>(m_iterationCount) - 1L};
+
+        std::vector<ssize_t> candidateCycles{cycleBegin, cycleEnd};
+
+        for(const TileEvent& request : m_weightUpdateRequestArray)
+        {
+            const ssize_t idleRows{static_cast<ssize_t>(request.rows)};
+            const ssize_t columns{static_cast<ssize_t>(request.columns)};
+
+            for(const ssize_t diagonal : {0L, idleRows, idleRows + columns - 1L,
+                                            height - 1L, height + columns - 2L, diagonals - 1L})
+            {
+                for(ssize_t offset{-1L}; offset <= 1L; ++offset)
+                {
+                    const ssize_t cycle{request.cycle + 1L + diagonal + offset};
+
+                    if((cycle >= cycleBegin) && (cycle <= cycleEnd))
+                    {
+                        candidateCycles.emplace_back(cycle);
+                    }
+                }
+            }
+        }
+
+        m_weightFetcherConcurrentLoadsMax = 0UL;
+
+        for(const ssize_t cycle : candidateCycles)
+        {
+            auto requestIterator = std::lower_bound(m_weightUpdateRequestArray.begin(),
+                                                    m_weightUpdateRequestArray.end(),
+                                                    cycle - diagonals,
+                                                    [](const TileEvent& request, const ssize_t value)
+            {
+                return request.cycle < value;
+            });
+
+            size_t loadCount{0UL};
+
+            for(; (requestIterator != m_weightUpdateRequestArray.end()) &&
+                                    (requestIterator->cycle < cycle); ++requestIterator)
+            {
+                loadCount += getWeightLoadsOnDiagonal(*requestIterator,
+                                                        cycle - requestIterator->cycle - 1L);
+            }
+
+            m_weightFetcherConcurrentLoadsMax = std::max(m_weightFetcherConcurrentLoadsMax, loadCount);
+        }
+
+        /* A request loads column x in the iterations
+         * [cycle + 1 + x + idle rows, cycle + x + height].
+         * The maximum over the columns narrower than the
+         * last block column and the maximum over the
+         * remaining columns, which are only loaded by
+         * requests of full width tiles, are evaluated
+         * on the intervals of column zero. */
+
+        std::vector<Interval> intervalsAllColumns;
+        std::vector<Interval> intervalsFullWidth;
+
+        for(const TileEvent& request : m_weightUpdateRequestArray)
+        {
+            const Interval interval{request.cycle + 1L + static_cast<ssize_t>(request.rows),
+                                                                        request.cycle + height};
+
+            intervalsAllColumns.emplace_back(interval);
+
+            if(request.columns == m_systolicArrayWidth)
+            {
+                intervalsFullWidth.emplace_back(interval);
+            }
+        }
+
+        const ssize_t columnsLastBlock{static_cast<ssize_t>(weightMatrixColumnsLastBlock)};
+
+        m_weightFetcherConcurrentLoadsPerColumnMax = getOverlapMax(intervalsAllColumns,
+                                                                    cycleBegin - columnsLastBlock + 1L,
+                                                                    cycleEnd);
+
+        if(weightMatrixColumnsLastBlock < m_systolicArrayWidth)
+        {
+            m_weightFetcherConcurrentLoadsPerColumnMax = std::max(m_weightFetcherConcurrentLoadsPerColumnMax,
+                                                                    getOverlapMax(intervalsFullWidth,
+                                                                                    cycleBegin - static_cast<ssize_t>(
+                                                                                            m_systolicArrayWidth) + 1L,
+                                                                                    cycleEnd - columnsLastBlock));
+        }
+    }
+
+    void evaluateAccumulatorArrayReads(const size_t weightMatrixColumnsLastBlock)
+    {
+        const ssize_t diagonalsMax{static_cast<ssize_t>(m_accumulatorArrayBufferHeight +
+                                                            m_systolicArrayWidth) - 1L};
+
+        /* A read operation is removed from the queue in
+         * the iteration its last diagonal is read in,
+         * before new read operations are added. */
+
+        m_accumulatorArrayReadOperationQueueLengthMax = 0UL;
+
+        for(size_t operationCount{0UL}; operationCount < m_readOperationArray.size(); ++operationCount)
+        {
+            const ssize_t cycle{m_readOperationArray[operationCount].cycle};
+
+            size_t queueLength{1UL};
+
+            for(size_t previousCount{operationCount}; (previousCount > 0UL) &&
+                        (m_readOperationArray[previousCount - 1].cycle + diagonalsMax > cycle); --previousCount)
+            {
+                const TileEvent& previous{m_readOperationArray[previousCount - 1]};
+
+                if(previous.cycle + static_cast<ssize_t>(previous.rows + previous.columns) - 1L > cycle)
+                {
+                    ++queueLength;
+                }
+            }
+
+            m_accumulatorArrayReadOperationQueueLengthMax =
+                            std::max(m_accumulatorArrayReadOperationQueueLengthMax, queueLength);
+        }
+
+        const ssize_t cycleEnd{static_cast<ssize_t>(m_iterationCount) - 1L};
+
+        std::vector<ssize_t> candidateCycles{0L, cycleEnd};
+
+        for(const TileEvent& readOperation : m_readOperationArray)
+        {
+            const ssize_t diagonals{static_cast<ssize_t>(readOperation.rows +
+                                                            readOperation.columns) - 1L};
+            const ssize_t dimensionMin{static_cast<ssize_t>(std::min(readOperation.rows,
+                                                                        readOperation.columns))};
+
+            for(const ssize_t diagonal : {0L, dimensionMin - 1L, diagonals - dimensionMin, diagonals - 1L})
+            {
+                for(ssize_t offset{-1L}; offset <= 1L; ++offset)
+                {
+                    const ssize_t cycle{readOperation.cycle + 1L + diagonal + offset};
+
+                    if((cycle >= 0L) && (cycle <= cycleEnd))
+                    {
+                        candidateCycles.emplace_back(cycle);
+                    }
+                }
+            }
+        }
+
+        m_concurrentAccumulatorLoadCountMax = 0UL;
+
+        for(const ssize_t cycle : candidateCycles)
+        {
+            auto readOperationIterator = std::lower_bound(m_readOperationArray.begin(),
+                                                            m_readOperationArray.end(),
+                                                            cycle - diagonalsMax,
+                                                            [](const TileEvent& readOperation, const ssize_t value)
+            {
+                return readOperation.cycle < value;
+            });
+
+            size_t loadCount{0UL};
+
+            for(; (readOperationIterator != m_readOperationArray.end()) &&
+                                (readOperationIterator->cycle < cycle); ++readOperationIterator)
+            {
+                const ssize_t diagonal{cycle - readOperationIterator->cycle - 1L};
+
+                if(diagonal < static_cast<ssize_t>(readOperationIterator->rows +
+                                                    readOperationIterator->columns) - 1L)
+                {
+                    loadCount += getAccumulatorLoadsOnDiagonal(*readOperationIterator, diagonal);
+                }
+            }
+
+            m_concurrentAccumulatorLoadCountMax = std::max(m_concurrentAccumulatorLoadCountMax, loadCount);
+        }
+
+        /* A read operation reads column x in the
+         * iterations [cycle + 1 + x, cycle + x + rows] */
+
+        std::vector<Interval> intervalsAllColumns;
+        std::vector<Interval> intervalsFullWidth;
+
+        for(const TileEvent& readOperation : m_readOperationArray)
+        {
+            const Interval interval{readOperation.cycle + 1L,
+                                        readOperation.cycle + static_cast<ssize_t>(readOperation.rows)};
+
+            intervalsAllColumns.emplace_back(interval);
+
+            if(readOperation.columns == m_systolicArrayWidth)
+            {
+                intervalsFullWidth.emplace_back(interval);
+            }
+        }
+
+        const ssize_t columnsLastBlock{static_cast<ssize_t>(weightMatrixColumnsLastBlock)};
+
+        m_concurrentAccumulatorArrayLoadCountPerColumnMax = getOverlapMax(intervalsAllColumns,
+                                                                            1L - columnsLastBlock,
+                                                                            cycleEnd);
+
+        if(weightMatrixColumnsLastBlock < m_systolicArrayWidth)
+        {
+            m_concurrentAccumulatorArrayLoadCountPerColumnMax =
+                            std::max(m_concurrentAccumulatorArrayLoadCountPerColumnMax,
+                                        getOverlapMax(intervalsFullWidth,
+                                                        1L - static_cast<ssize_t>(m_systolicArrayWidth),
+                                                        cycleEnd - columnsLastBlock));
+        }
+    }
+
+    void evaluateAccumulatorArrayLoadCount()
+    {
+        /* The MCU adds the running load count of an iteration
+         * to the total after every read operation processed in
+         * it, so that the loads of a read operation are counted
+         * once more for every later read operation processed in
+         * the same iteration. */
+
+        m_accumulatorArrayLoadCount = 0UL;
+
+        for(size_t operationCount{0UL}; operationCount < m_readOperationArray.size(); ++operationCount)
+        {
+            const TileEvent& readOperation{m_readOperationArray[operationCount]};
+
+            const ssize_t cycleEnd{readOperation.cycle +
+                                    static_cast<ssize_t>(readOperation.rows +
+                                                            readOperation.columns) - 1L};
+
+            m_accumulatorArrayLoadCount += readOperation.rows*readOperation.columns;
+
+            for(size_t laterCount{operationCount + 1UL}; (laterCount < m_readOperationArray.size()) &&
+                            (m_readOperationArray[laterCount].cycle < cycleEnd); ++laterCount)
+            {
+                const TileEvent& laterReadOperation{m_readOperationArray[laterCount]};
+
+                const ssize_t overlapEnd{std::min(cycleEnd, laterReadOperation.cycle +
+                                                    static_cast<ssize_t>(laterReadOperation.rows +
+                                                                            laterReadOperation.columns) - 1L)};
+
+                m_accumulatorArrayLoadCount +=
+                        getAccumulatorLoadsOnDiagonals(readOperation, overlapEnd - readOperation.cycle) -
+                        getAccumulatorLoadsOnDiagonals(readOperation, laterReadOperation.cycle - readOperation.cycle);
+            }
+        }
+    }
+
+    /**
+     * @brief                       Evaluate the systolic array execution metrics
+     * @param weightMatrixPtr       Pointer to the weight matrix
+     * @param sizeN                 The column count of the weight matrix
+     * @param nonzeroWeightProducts The number of products of an activation
+     *                              matrix element with a nonzero weight
+     */
+
+    template<typename WeightDatatype>
+    void evaluateSystolicArray(const WeightDatatype* const weightMatrixPtr,
+                                const size_t sizeN,
+                                const size_t nonzeroWeightProducts)
+    {
+        const size_t peCount{m_systolicArrayWidth*m_systolicArrayHeight};
+
+        size_t operationCount{m_systolicArrayInputCountTotal*peCount};
+        size_t interPeDataMovements{m_systolicArrayInputCountTotal*m_systolicArrayWidth*
+                                                            (2UL*m_systolicArrayHeight - 1UL)};
+        size_t multiplicationsWithWeightZeroCount{operationCount - nonzeroWeightProducts};
+
+        /* PE (x, y) processes the activation matrix row entering
+         * the systolic array in iteration i in iteration i + x + y + 1.
+         * The MCU loop ends as soon as the last read operation is
+         * done, so that the last rows of a narrow last tile never
+         * reach the PEs on the far side of the systolic array. */
+
+        const ssize_t diagonalLast{static_cast<ssize_t>(m_systolicArrayDiagonals) - 1L};
+
+        for(auto passIterator = m_passArray.rbegin(); passIterator != m_passArray.rend(); ++passIterator)
+        {
+            const ssize_t diagonalFirstMissing{static_cast<ssize_t>(m_iterationCount) - passIterator->cycle -
+                                                            static_cast<ssize_t>(passIterator->rows)};
+
+            if(diagonalFirstMissing > diagonalLast)
+            {
+                break;
+            }
+
+            for(ssize_t row{static_cast<ssize_t>(passIterator->rows) - 1L},
+                                diagonal{diagonalFirstMissing};
+                                (row >= 0L) && (diagonal <= diagonalLast); --row, ++diagonal)
+            {
+                for(size_t y{0UL}; y < m_systolicArrayHeight; ++y)
+                {
+                    for(size_t x{static_cast<size_t>(std::max(0L, diagonal - static_cast<ssize_t>(y)))};
+                                                                    x < m_systolicArrayWidth; ++x)
+                    {
+                        --operationCount;
+                        interPeDataMovements -= (y == 0UL) ? 1UL : 2UL;
+
+                        if((x >= passIterator->columns) || (y < passIterator->idleRows) ||
+                                (weightMatrixPtr[((passIterator->weightBlockCoordinateY*m_systolicArrayHeight) +
+                                                        y - passIterator->idleRows)*sizeN +
+                                                    passIterator->weightBlockCoordinateX*m_systolicArrayWidth + x] ==
+                                                                                            WeightDatatype(0)))
+                        {
+                            --multiplicationsWithWeightZeroCount;
+                        }
+                    }
+                }
+            }
+        }
+
+        m_intraPeDataMovements = 3UL*operationCount;
+        m_interPeDataMovements = interPeDataMovements;
+        m_multiplicationsWithWeightZeroCount = multiplicationsWithWeightZeroCount;
+    }
+
+    const size_t m_systolicArrayWidth;
+    const size_t m_systolicArrayHeight;
+    const size_t m_systolicArrayDiagonals;
+    const size_t m_accumulatorArrayBufferHeight;
+
+    std::vector<TileEvent> m_weightUpdateRequestArray;
+    std::vector<TileEvent> m_readOperationArray;
+    std::vector<Pass> m_passArray;
+
+    size_t m_iterationCount{0UL};
+
+    size_t m_systolicArrayInputCountTotal{0UL};
+    size_t m_systolicArrayInputCountMax{0UL};
+
+    size_t m_intraPeDataMovements{0UL};
+    size_t m_interPeDataMovements{0UL};
+    size_t m_multiplicationsWithWeightZeroCount{0UL};
+
+    size_t m_accumulatorArrayLoadCount{0UL};
+
+    size_t m_weightUpdateRequestQueueLengthMax{0UL};
+    size_t m_weightFetcherConcurrentLoadsMax{0UL};
+    size_t m_weightFetcherConcurrentLoadsPerColumnMax{0UL};
+
+    size_t m_accumulatorArrayReadOperationQueueLengthMax{0UL};
+    size_t m_concurrentAccumulatorLoadCountMax{0UL};
+    size_t m_concurrentAccumulatorArrayLoadCountPerColumnMax{0UL};
+
+};
+
+#endif
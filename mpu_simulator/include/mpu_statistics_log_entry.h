@@ -31,6 +31,7 @@
 
 #include <string>
 #include <sstream>
+#include <ostream>
 #include <cstddef>
 
 /**
@@ -75,6 +76,7 @@ public:
      * @param iterationsTotal
      * @param iterationsStalled
      * @param multiplicationsWithWeightZeroCountTotal
+     * @param verificationTimeSeconds   The host time spent verifying the result matrix
      */
 
     MpuStatisticsLogEntry(const std::string& operationNameString,
@@ -106,7 +108,8 @@ public:
                             const size_t accumulatorArrayConcurrentLoadsPerColumnMax,
                             const size_t iterationsTotal,
                             const size_t iterationsStalled,
-                            const size_t multiplicationsWithWeightZeroCountTotal):
+                            const size_t multiplicationsWithWeightZeroCountTotal,
+                            const double verificationTimeSeconds):
                                                                 m_operationNameString{operationNameString},
                                                                 m_sizeM{sizeM},
                                                                 m_sizeN{sizeN},
@@ -154,7 +157,8 @@ public:
                                                                 m_iterationsTotal{iterationsTotal},
                                                                 m_iterationsStalled{iterationsStalled},
                                                                 m_multiplicationsWithWeightZeroCountTotal{
-                                                                                multiplicationsWithWeightZeroCountTotal}
+                                                                                multiplicationsWithWeightZeroCountTotal},
+                                                                m_verificationTimeSeconds{verificationTimeSeconds}
     {
     }
 
@@ -164,47 +168,98 @@ public:
 
     MpuStatisticsLogEntry& operator=(MpuStatisticsLogEntry& other) = default;
 
+    size_t getIterationsTotal() const
+    {
+        return m_iterationsTotal;
+    }
+
+    double getVerificationTimeSeconds() const
+    {
+        return m_verificationTimeSeconds;
+    }
+
+    size_t getActivationUnitCycles() const
+    {
+        return m_activationUnitCycles;
+    }
+
+    /**
+     * @brief                       Set the cycles of the activation unit scaling
+     *                              the results of the multiplication, which runs
+     *                              outside of the MPU after the multiplication
+     * @param activationUnitCycles  The cycles of the activation unit
+     */
+
+    void setActivationUnitCycles(const size_t activationUnitCycles)
+    {
+        m_activationUnitCycles = activationUnitCycles;
+    }
+
     std::string getString() const
     {
+        std::stringstream logEntryStringStream;
 
+        writeExecutionMetrics(logEntryStringStream);
+
+        logEntryStringStream << '\t' << m_verificationTimeSeconds << '\n';
+
+        return logEntryStringStream.str();
+    }
+
+    /**
+     * @brief   Get the log entry without the host time measurements.
+     *          Unlike getString(), the returned string only depends
+     *          on the simulated matrix multiplication.
+     */
+
+    std::string getExecutionMetricsString() const
+    {
         std::stringstream logEntryStringStream;
 
-        logEntryStringStream << '\"' << m_operationNameString << "\"\t"
-                                << m_sizeM << '\t'
-                                << m_sizeN << '\t'
-                                << m_sizeK << '\t'
-                                << m_systolicArrayHeight << '\t'
-                                << m_systolicArrayWidth << '\t'
-                                << m_activationFifoDepth << '\t'
-                                << m_accumulatorArrayHeight << '\t'
-                                << m_mpuControlRegisterBits << '\t'
-                                << m_systolicDataSetupUnitControlRegisterBits << '\t'
-                                << m_activationFifoControlRegisterBits << '\t'
-                                << m_weightFetcherControlRegisterBits << '\t'
-                                << m_systolicArrayControlRegisterBits << '\t'
-                                << m_accumulatorArrayControlRegisterBits << '\t'
-                                << m_activationFifoDataRegisterBits << '\t'
-                                << m_systolicArrayDataRegisterBits << '\t'
-                                << m_accumulatorArrayDataRegisterBits << '\t'
-                                << m_unifiedBufferBits << '\t'
-                                << m_intraPeDataMovementsTotal << '\t'
-                                << m_interPeDataMovementsTotal << '\t'
-                                << m_systolicDataSetupUnitLoadCountTotal << '\t'
-                                << m_weightFetcherLoadCountTotal << '\t'
-                                << m_weightFetcherConcurrentLoadsMax << '\t'
-                                << m_weightFetcherConcurrentLoadsPerColumnMax << '\t'
-                                << m_accumulatorArrayLoadCountTotal << '\t'
-                                << m_accumulatorArrayConcurrentLoadsMax << '\t'
-                                << m_accumulatorArrayConcurrentLoadsPerColumnMax << '\t'
-                                << m_iterationsTotal << '\t'
-                                << m_iterationsStalled << '\t'
-                                << m_multiplicationsWithWeightZeroCountTotal << '\n';
+        writeExecutionMetrics(logEntryStringStream);
+
+        logEntryStringStream << '\n';
 
         return logEntryStringStream.str();
     }
 
 private:
 
+    void writeExecutionMetrics(std::ostream& logEntryStream) const
+    {
+        logEntryStream << '\"' << m_operationNameString << "\"\t"
+                        << m_sizeM << '\t'
+                        << m_sizeN << '\t'
+                        << m_sizeK << '\t'
+                        << m_systolicArrayHeight << '\t'
+                        << m_systolicArrayWidth << '\t'
+                        << m_activationFifoDepth << '\t'
+                        << m_accumulatorArrayHeight << '\t'
+                        << m_mpuControlRegisterBits << '\t'
+                        << m_systolicDataSetupUnitControlRegisterBits << '\t'
+                        << m_activationFifoControlRegisterBits << '\t'
+                        << m_weightFetcherControlRegisterBits << '\t'
+                        << m_systolicArrayControlRegisterBits << '\t'
+                        << m_accumulatorArrayControlRegisterBits << '\t'
+                        << m_activationFifoDataRegisterBits << '\t'
+                        << m_systolicArrayDataRegisterBits << '\t'
+                        << m_accumulatorArrayDataRegisterBits << '\t'
+                        << m_unifiedBufferBits << '\t'
+                        << m_intraPeDataMovementsTotal << '\t'
+                        << m_interPeDataMovementsTotal << '\t'
+                        << m_systolicDataSetupUnitLoadCountTotal << '\t'
+                        << m_weightFetcherLoadCountTotal << '\t'
+                        << m_weightFetcherConcurrentLoadsMax << '\t'
+                        << m_weightFetcherConcurrentLoadsPerColumnMax << '\t'
+                        << m_accumulatorArrayLoadCountTotal << '\t'
+                        << m_accumulatorArrayConcurrentLoadsMax << '\t'
+                        << m_accumulatorArrayConcurrentLoadsPerColumnMax << '\t'
+                        << m_iterationsTotal << '\t'
+                        << m_iterationsStalled << '\t'
+                        << m_multiplicationsWithWeightZeroCountTotal << '\t'
+                        << m_activationUnitCycles;
+    }
+
     std::string m_operationNameString;
     
     size_t m_sizeM{0UL};
@@ -244,6 +299,10 @@ private:
     
     size_t m_multiplicationsWithWeightZeroCountTotal{0UL};
 
+    size_t m_activationUnitCycles{0UL};
+
+    double m_verificationTimeSeconds{0.0};
+
 
 };
 
@@ -32,6 +32,7 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <mutex>
 
 #include "matrix_processing_unit.h"
 #include "mpu_statistics_log_entry.h"
@@ -96,11 +97,19 @@ public:
                             "\"Accumulator Array Concurrent Load Count Per Column Max\"\t"
                             "\"Iterations Total\"\t"
                             "\"Iterations Stalled\"\t"
-                            "\"Multiplications With Weight Zero Count Total\"\n"};
+                            "\"Multiplications With Weight Zero Count Total\"\t"
+                            "\"Activation Unit Cycles\"\t"
+                            "\"Verification Time [s]\"\n"};
     }
 
+    /**
+     * @brief   Add a log entry. Thread safe, so that several MPUs
+     *          running concurrently can share one logger.
+     */
+
     void addMpuStatisticsLogEntry(MpuStatisticsLogEntry&& mpuStatisticsLogEntry)
     {
+        std::lock_guard<std::mutex> lock(m_mutex);
         m_mpuStatisticsLogEntryVector.emplace_back(mpuStatisticsLogEntry);
     }
 
@@ -134,6 +143,8 @@ private:
 
     std::ofstream m_outputFileStream;
 
+    std::mutex m_mutex;
+
     std::vector<MpuStatisticsLogEntry> m_mpuStatisticsLogEntryVector;
 
     const std::string m_outputFilenameString;
@@ -119,6 +119,24 @@ public:
         return m_updateWeightCurrent;
     }
 
+    /**
+     * @brief               Set the activation and partial sum registers
+     *                      to the state reached after multiple iterations
+     *                      computed at once by the systolic array
+     * @param activation    The activation register value
+     * @param sum           The partial sum register value
+     */
+
+    void setRegisters(const ActivationDatatype activation,
+                        const SumDatatype sum)
+    {
+        m_activationCurrent = activation;
+        m_activationNext = activation;
+
+        m_sumCurrent = sum;
+        m_sumNext = sum;
+    }
+
     /**
      * @brief
      */
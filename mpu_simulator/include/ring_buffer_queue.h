@@ -0,0 +1,213 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        ring_buffer_queue.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef RING_BUFFER_QUEUE_H
+#define RING_BUFFER_QUEUE_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+#include "mpu_exception.h"
+
+/**
+ * @class       RingBufferQueue
+ * @brief       Fixed capacity FIFO queue of the requests in flight in
+ *              a functional unit, implemented as a ring buffer. Requests
+ *              are retired from the front in O(1). As in hardware, the
+ *              capacity is fixed at construction, pushing to a full queue
+ *              throws an MpuException. The queue also records occupancy
+ *              statistics: the occupancy after each push, from which the
+ *              maximum and mean occupancy are derived.
+ * @tparam T    The request datatype, has to be default constructible
+ */
+
+template<typename T> class RingBufferQueue
+{
+
+public:
+
+    /**
+     * @brief           RingBufferQueue constructor
+     * @param capacity  The maximum number of requests in the queue
+     */
+
+    explicit RingBufferQueue(const size_t capacity): m_capacity{capacity},
+                                                        m_bufferArray(capacity)
+    {
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0UL;
+    }
+
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * @brief       Access the request at the given position,
+     *              position 0 being the front of the queue
+     * @param index The position of the request
+     */
+
+    T& operator[](const size_t index)
+    {
+        return m_bufferArray[getBufferIndex(index)];
+    }
+
+    const T& operator[](const size_t index) const
+    {
+        return m_bufferArray[getBufferIndex(index)];
+    }
+
+    T& front()
+    {
+        return m_bufferArray[m_headIndex];
+    }
+
+    void push_back(const T& element)
+    {
+        if(m_size == m_capacity)
+        {
+            throw MpuException("Ring buffer queue capacity of " +
+                                    std::to_string(m_capacity) +
+                                    " requests exceeded");
+        }
+
+        m_bufferArray[getBufferIndex(m_size)] = element;
+
+        ++m_size;
+
+        ++m_pushCount;
+        m_occupancySum += m_size;
+
+        if(m_occupancyMax < m_size)
+        {
+            m_occupancyMax = m_size;
+        }
+    }
+
+    /**
+     * @brief   Retire the request at the front of the queue
+     */
+
+    void pop_front()
+    {
+        m_headIndex = getBufferIndex(1UL);
+        --m_size;
+    }
+
+    /**
+     * @brief       Retire the request at the given position. Requests
+     *              completing out of order are rare, so the requests
+     *              behind it are moved forward to keep the queue order.
+     * @param index The position of the request
+     */
+
+    void erase(const size_t index)
+    {
+        if(index == 0UL)
+        {
+            pop_front();
+            return;
+        }
+
+        for(size_t position{index}; position < (m_size - 1UL); ++position)
+        {
+            (*this)[position] = (*this)[position + 1UL];
+        }
+
+        --m_size;
+    }
+
+    void clear()
+    {
+        m_headIndex = 0UL;
+        m_size = 0UL;
+    }
+
+    size_t getPushCount() const
+    {
+        return m_pushCount;
+    }
+
+    size_t getOccupancyMax() const
+    {
+        return m_occupancyMax;
+    }
+
+    /**
+     * @brief   Get the mean occupancy of the queue
+     *          seen by the pushed requests
+     */
+
+    double getOccupancyMean() const
+    {
+        return (m_pushCount != 0UL) ? static_cast<double>(m_occupancySum)/
+                                            static_cast<double>(m_pushCount) : 0.0;
+    }
+
+    void resetOccupancyStatistics()
+    {
+        m_pushCount = 0UL;
+        m_occupancySum = 0UL;
+        m_occupancyMax = 0UL;
+    }
+
+private:
+
+    size_t getBufferIndex(const size_t index) const
+    {
+        const size_t bufferIndex{m_headIndex + index};
+
+        return (bufferIndex < m_capacity) ? bufferIndex :
+                                            (bufferIndex - m_capacity);
+    }
+
+    const size_t m_capacity;
+
+    std::vector<T> m_bufferArray;
+
+    size_t m_headIndex{0UL};
+    size_t m_size{0UL};
+
+    size_t m_pushCount{0UL};
+    size_t m_occupancySum{0UL};
+    size_t m_occupancyMax{0UL};
+
+};
+
+#endif
@@ -31,23 +31,73 @@
 
 #include <numeric>
 #include <vector>
+#include <algorithm>
 #include <memory>
 #include <climits>
+#include <cmath>
+#include <cassert>
+#include <atomic>
 
 #include <omp.h>
 
+#include "mpu_exception.h"
 #include "processing_element.h"
-#include "processing_element_top_border.h"
-#include "processing_element_left_border.h"
-#include "processing_element_center.h"
 #include "activation_fifo.h"
-#include "accumulator_array.h"
+#include "worker_team.h"
 
 //#define SYSTOLIC_ARRAY_DEBUG SYSTOLIC_ARRAY_DEBUG
 
+/**
+ * @enum    SystolicArrayEngine
+ * @brief   Selects the simulation engine used to model the systolic array.
+ *          ProcessingElements models every PE as an individual object
+ *          connected to its neighbors by pointers, StructureOfArrays
+ *          keeps the state of all PEs in contiguous per-register planes.
+ *          Both engines produce identical results and execution metrics.
+ */
+
+enum class SystolicArrayEngine
+{
+    ProcessingElements,
+    StructureOfArrays
+};
+
+/**
+ * @enum    SteadyStateExecutionMode
+ * @brief   Selects how the systolic array advances a batch of steady state
+ *          iterations. DeskewedGemm computes the partial sums leaving the
+ *          bottom row by a blocked matrix multiplication of the deskewed
+ *          activation streams. TemporalTiling steps the PE registers, with
+ *          each worker advancing its stripe of rows by a tile of several
+ *          iterations at a time, staying behind the stripe above. Both
+ *          modes produce identical results and execution metrics.
+ */
+
+enum class SteadyStateExecutionMode
+{
+    DeskewedGemm,
+    TemporalTiling
+};
+
+/**
+ * @struct  SystolicArrayCounters
+ * @brief   Data movements and multiplications with weight
+ *          zero counted by a worker while computing its rows
+ */
+
+struct SystolicArrayCounters
+{
+    size_t intraPeDataMovements;
+    size_t interPeDataMovements;
+    size_t multiplicationsWithWeightZeroCount;
+};
+
 /**
  * @class                       SystolicArray
- * @brief                       
+ * @brief                       Abstract base class of the systolic array engines. Owns the
+ *                              activation FIFOs and the execution metrics shared by all
+ *                              engines and implements the iteration sequence common to
+ *                              them. The engine specific PE state is handled by subclasses.
  * @tparam WeightDatatype       
  * @tparam ActivationDatatype   
  * @tparam SumDatatype          
@@ -73,91 +123,119 @@ public:
                     const size_t activationFifoDepth): m_width{width},
                                                         m_height{height},
                                                         m_activationFifoDepth{activationFifoDepth},
-                                                        m_pePtrArray(m_height),
-                                                        m_peDiagonalsArray(m_width + m_height - 1),
-                                                        m_rowIntraPeDataMovementCountArray(m_height),
-                                                        m_rowInterPeDataMovementCountArray(m_height),
-                                                        m_multiplicationsWithWeightZeroCountArray(m_height)
+                                                        m_computeRowsTask(this),
+                                                        m_temporalTilingTask(this)
     {
+        setWorkerCount(static_cast<size_t>(omp_get_max_threads()));
 
         for(size_t heightCount{0}; heightCount < m_height; ++heightCount)
         {
             m_activationFifoArray.emplace_back(ActivationFifo<ActivationDatatype>{m_activationFifoDepth});
         }
+    }
 
-        m_pePtrArray.at(0).emplace_back(std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                                            ActivationDatatype,
-                                                                            SumDatatype>>{
-                                                         new ProcessingElementLeftBorder<WeightDatatype,
-                                                                                            ActivationDatatype,
-                                                                                            SumDatatype>(
-                                                                                        PEPosition(0, 0), nullptr,
-                                                                                        &(m_activationFifoArray.at(0)))});
+    virtual ~SystolicArray() = default;
 
-        for(size_t heightCount{1}; heightCount < m_height; ++heightCount)
-        {
-            m_pePtrArray.at(heightCount).emplace_back(std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                                                        ActivationDatatype,
-                                                                                        SumDatatype>>{
-                                                                       new ProcessingElementLeftBorder<WeightDatatype,
-                                                                                                        ActivationDatatype,
-                                                                                                        SumDatatype>(
-                                                                                                        PEPosition(0, heightCount),
-                                                                                                        m_pePtrArray.at(heightCount - 1).at(0).get(),
-                                                                                                        &(m_activationFifoArray.at(heightCount)))});
-        }
+    size_t getWidth() const
+    {
+        return m_width;
+    }
 
-        for(size_t widthCount = 1; widthCount < m_width; widthCount++)
-        {
-            m_pePtrArray.at(0).emplace_back(std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                                                ActivationDatatype,
-                                                                                SumDatatype>>{
-                                                             new ProcessingElementTopBorder<WeightDatatype,
-                                                                                            ActivationDatatype,
-                                                                                            SumDatatype>(
-                                                                                        PEPosition(widthCount, 0),
-                                                                                        m_pePtrArray.at(0).at(widthCount - 1).get())});
-        }
+    size_t getHeight() const
+    {
+        return m_height;
+    }
 
-        for(size_t heightCount{1}; heightCount < m_height; ++heightCount)
+    size_t getActivationFifoDepth() const
+    {
+        return m_activationFifoDepth;
+    }
+
+    /**
+     * @brief               Set the number of workers computing the rows of the
+     *                      systolic array in each iteration. Each worker computes
+     *                      a fixed stripe of consecutive rows. The number is
+     *                      limited to the array height. By default, the maximum
+     *                      number of OpenMP threads is used.
+     * @param workerCount   The number of workers, including the calling thread
+     */
+
+    void setWorkerCount(const size_t workerCount)
+    {
+        const size_t workerCountLimited{std::min(std::max(workerCount, 1UL), m_height)};
+
+        if(m_workerTeamPtr && (m_workerTeamPtr->getWorkerCount() == workerCountLimited))
         {
-            for(size_t widthCount{1}; widthCount < m_width; ++widthCount)
-            {
-                m_pePtrArray.at(heightCount).emplace_back(std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                                                            ActivationDatatype,
-                                                                                            SumDatatype>>{
-                                                                        new ProcessingElementCenter<WeightDatatype,
-                                                                                                    ActivationDatatype,
-                                                                                                    SumDatatype>(
-                                                                                        PEPosition(widthCount, heightCount),
-                                                                                        m_pePtrArray.at(heightCount).at(widthCount - 1).get(),
-                                                                                        m_pePtrArray.at(heightCount - 1).at(widthCount).get())});
-            }
+            return;
         }
 
-        for(size_t columnCount{0}; columnCount < m_height; ++columnCount)
+        m_workerTeamPtr.reset();
+
+        m_workerTeamPtr.reset(new WorkerTeam(workerCountLimited));
+        m_workerCounterArrayPtr.reset(new CacheLinePaddedArray<SystolicArrayCounters>(workerCountLimited));
+        m_temporalTileProgressArrayPtr.reset(new CacheLinePaddedArray<TemporalTileProgress>(workerCountLimited));
+    }
+
+    size_t getWorkerCount() const
+    {
+        return m_workerTeamPtr->getWorkerCount();
+    }
+
+    void setSteadyStateExecutionMode(const SteadyStateExecutionMode steadyStateExecutionMode)
+    {
+        m_steadyStateExecutionMode = steadyStateExecutionMode;
+    }
+
+    SteadyStateExecutionMode getSteadyStateExecutionMode() const
+    {
+        return m_steadyStateExecutionMode;
+    }
+
+    /**
+     * @brief                   Set the number of iterations a worker advances its
+     *                          stripe of rows by between two synchronizations with
+     *                          its neighbors in the TemporalTiling steady state
+     *                          execution mode
+     * @param tileIterations    The number of iterations, at least 1
+     */
+
+    void setTemporalTileIterations(const size_t tileIterations)
+    {
+        if(!tileIterations)
         {
-            for(size_t rowCount{0}; rowCount < m_width; ++rowCount)
-            {
-                m_peDiagonalsArray.at(rowCount + columnCount).push_back(
-                                                                m_pePtrArray.at(columnCount).at(rowCount).get());
-            }
+            throw MpuException("Temporal tile iteration count must be at least 1");
         }
+
+        m_temporalTileIterations = tileIterations;
     }
 
-    size_t getWidth() const
+    size_t getTemporalTileIterations() const
     {
-        return m_width;
+        return m_temporalTileIterations;
     }
 
-    size_t getHeight() const
+    /**
+     * @brief                       Enable or disable the functional simulation of the
+     *                              PE data registers. With functional simulation disabled,
+     *                              only the valid, update weight, and FIFO input enable
+     *                              signals are simulated, and the weights are only read to
+     *                              count multiplications with weight zero. The activation
+     *                              and partial sum registers are not computed, so the partial
+     *                              sums leaving the bottom row are undefined, while all
+     *                              execution metrics are unchanged. Engines not supporting
+     *                              this may still compute the data registers. Functional
+     *                              simulation is enabled by default.
+     * @param functionalSimulation  The value of the flag
+     */
+
+    void setFunctionalSimulation(const bool functionalSimulation)
     {
-        return m_height;
+        m_functionalSimulation = functionalSimulation;
     }
 
-    size_t getActivationFifoDepth() const
+    bool getFunctionalSimulation() const
     {
-        return m_activationFifoDepth;
+        return m_functionalSimulation;
     }
 
     size_t getIterationCount() const
@@ -237,20 +315,22 @@ public:
         m_multiplicationsWithWeightZeroCountTotal = 0UL;
     }
 
-    std::vector<ProcessingElement<WeightDatatype,
-                                    ActivationDatatype,
-                                    SumDatatype>*> getDiagonal(const size_t diagonal)
-    {
-        assert(diagonal < (m_width + m_height - 1));
-
-        return m_peDiagonalsArray.at(diagonal);
-    }
+    /**
+     * @brief                                   Add execution metrics determined without running
+     *                                          the systolic array, used by the analytical
+     *                                          simulation mode of the MPU
+     * @param intraPeDataMovements              The data movements within PEs
+     * @param interPeDataMovements              The data movements between PEs
+     * @param multiplicationsWithWeightZero     The multiplications with a weight of zero
+     */
 
-    std::vector<std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                    ActivationDatatype,
-                                                    SumDatatype>>>* getBottomPePtrRowPtr()
+    void addExecutionMetrics(const size_t intraPeDataMovements,
+                                const size_t interPeDataMovements,
+                                const size_t multiplicationsWithWeightZero)
     {
-        return &(*(m_pePtrArray.rbegin()));
+        m_rowIntraPeDataMovementsTotal += intraPeDataMovements;
+        m_rowInterPeDataMovementsTotal += interPeDataMovements;
+        m_multiplicationsWithWeightZeroCountTotal += multiplicationsWithWeightZero;
     }
 
     std::vector<ActivationFifo<ActivationDatatype>>* getActivationFifoArrayPtr()
@@ -258,63 +338,101 @@ public:
         return &m_activationFifoArray;
     }
 
-    void storeWeight(const PEPosition& position,
-                            const WeightDatatype value)
-    {
-        m_pePtrArray.at(position.y).at(position.x)->storeWeight(value);
-    }
-
     void resetIterationCount()
     {
         m_iterationCount = 0;
     }
-    
+
     /**
-     * @brief               
-     * @param updateWeights 
+     * @brief           Store a weight in the currently inactive
+     *                  weight register of the PE at the given position
+     * @param position  The position of the PE
+     * @param value     The weight value
      */
 
-    void setUpdateWeightsSignal(const bool updateWeights)
-    {
-        dynamic_cast<ProcessingElementLeftBorder<WeightDatatype,
-                                                    ActivationDatatype,
-                                                    SumDatatype>*>(
-                                                        m_pePtrArray.at(0).at(0).get())->setUpdateWeightSignal(updateWeights);
-    }
+    virtual void storeWeight(const PEPosition& position,
+                                const WeightDatatype value) = 0;
 
     /**
-     * @deprecated
+     * @brief                   Store the weights of a diagonal of PEs in the
+     *                          currently inactive weight registers. The weights
+     *                          are gathered from a strided source, the PEs of the
+     *                          diagonal outside of the active rows store a weight
+     *                          of zero.
+     * @param diagonal          The diagonal, the sum of the x and y position
+     *                          of its PEs
+     * @param rowStart          The first row of the diagonal
+     * @param rowActiveStart    The first row of the PEs storing a weight
+     *                          from the source
+     * @param rowActiveEnd      The row after the last row of the PEs storing
+     *                          a weight from the source
+     * @param rowEnd            The row after the last row of the diagonal
+     * @param weightPtr         The weight of the PE in row rowActiveStart
+     * @param weightStride      The distance of the weights of PEs in
+     *                          consecutive rows in the source
      */
-    
-    void updateAllWeights()
+
+    virtual void storeWeightDiagonal(const size_t diagonal,
+                                        const size_t rowStart,
+                                        const size_t rowActiveStart,
+                                        const size_t rowActiveEnd,
+                                        const size_t rowEnd,
+                                        const WeightDatatype* weightPtr,
+                                        const size_t weightStride)
     {
-        for(size_t rowCount{0}; rowCount < m_height; ++rowCount)
+        for(size_t rowCount{rowStart}; rowCount < rowActiveStart; ++rowCount)
         {
-            for(size_t columnCount{0}; columnCount < m_width; ++columnCount)
-            {
-                m_pePtrArray.at(rowCount).at(columnCount)->updateWeight();
-            }
+            storeWeight(PEPosition(diagonal - rowCount, rowCount), WeightDatatype(0));
+        }
+
+        for(size_t rowCount{rowActiveStart}; rowCount < rowActiveEnd; ++rowCount)
+        {
+            storeWeight(PEPosition(diagonal - rowCount, rowCount), *weightPtr);
+            weightPtr += weightStride;
+        }
+
+        for(size_t rowCount{rowActiveEnd}; rowCount < rowEnd; ++rowCount)
+        {
+            storeWeight(PEPosition(diagonal - rowCount, rowCount), WeightDatatype(0));
         }
     }
+    
+    /**
+     * @brief               
+     * @param updateWeights 
+     */
+
+    virtual void setUpdateWeightsSignal(const bool updateWeights) = 0;
 
     /**
      * @brief
      */
-    
-    void readUpdateWeightSignals()
-    {
-        for(std::vector<std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                            ActivationDatatype,
-                                                            SumDatatype>>>& pePtrRow : m_pePtrArray)
-        {
-            for(std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                    ActivationDatatype,
-                                                    SumDatatype>>& pePtr : pePtrRow)
-            {
-                pePtr->readUpdateWeightSignals();
-            }
-        }
-    }
+
+    virtual void readUpdateWeightSignals() = 0;
+
+    /**
+     * @brief           Get the partial sum register value of the PE
+     *                  in the given column of the bottom row
+     * @param column    The column of the PE
+     */
+
+    virtual SumDatatype getBottomRowSum(const size_t column) const = 0;
+
+    /**
+     * @brief           Get the valid signal of the PE in the
+     *                  given column of the bottom row
+     * @param column    The column of the PE
+     */
+
+    virtual bool bottomRowHasValidSignal(const size_t column) const = 0;
+
+    /**
+     * @brief           Get the update weight signal of the PE in
+     *                  the given column of the bottom row
+     * @param column    The column of the PE
+     */
+
+    virtual bool bottomRowHasUpdateWeightSignal(const size_t column) const = 0;
 
     /**
      * @brief
@@ -322,76 +440,58 @@ public:
     
     void runIteration()
     {
-        if(m_iterationCount < m_height)
-        {
-            dynamic_cast<ProcessingElementLeftBorder<WeightDatatype,
-                                                        ActivationDatatype,
-                                                        SumDatatype>*>(
-                                                            m_pePtrArray.at(m_iterationCount).at(0).get())->enableFifoInput(true);
-        }
+        /* The FIFO input enable signal of every row is
+         * written in each iteration, so that engines
+         * can double buffer it. The input of the row
+         * selected by the iteration count is enabled,
+         * and the input of every row whose FIFO runs
+         * empty in the next iteration is disabled. */
 
         for(size_t activationFifoCount{0}; activationFifoCount < m_activationFifoArray.size();
                                                                                 activationFifoCount++)
         {
-            if(m_activationFifoArray.at(activationFifoCount).isEmptyNextIteration())
+            bool fifoInputEnabledNext{(activationFifoCount == m_iterationCount) ||
+                                                fifoInputEnabled(activationFifoCount)};
+
+            /* A FIFO only runs empty if it is read in this iteration,
+             * so a FIFO holding a single activation, as for single
+             * row activation matrix blocks, is still enabled */
+
+            if(fifoInputEnabled(activationFifoCount) &&
+                    m_activationFifoArray.at(activationFifoCount).isEmptyNextIteration())
             {
-                dynamic_cast<ProcessingElementLeftBorder<WeightDatatype, ActivationDatatype, SumDatatype>*>(
-                                             m_pePtrArray.at(activationFifoCount).at(0).get())->enableFifoInput(false);
+                fifoInputEnabledNext = false;
 
 #ifdef SYSTOLIC_ARRAY_DEBUG
                 std::cout << "FIFO " << activationFifoCount
                             << " empty in next iteration" << std::endl;
 #endif
             }
+
+            enableFifoInput(activationFifoCount, fifoInputEnabledNext);
         }
 
         readUpdateWeightSignals();
 
-        std::fill(m_rowIntraPeDataMovementCountArray.begin(),
-                    m_rowIntraPeDataMovementCountArray.end(),
-                    typename std::iterator_traits<std::vector<size_t>::
-                                                    iterator>::value_type{});
-
-        std::fill(m_rowInterPeDataMovementCountArray.begin(),
-                    m_rowInterPeDataMovementCountArray.end(),
-                    typename std::iterator_traits<std::vector<size_t>::
-                                                    iterator>::value_type{});
-        
-        std::fill(m_multiplicationsWithWeightZeroCountArray.begin(),
-                    m_multiplicationsWithWeightZeroCountArray.end(),
-                    typename std::iterator_traits<std::vector<size_t>::
-                                                    iterator>::value_type{});
+        CacheLinePaddedArray<SystolicArrayCounters>& workerCounterArray{*m_workerCounterArrayPtr};
 
-        #pragma omp parallel for
-        for(size_t rowCount = 0; rowCount < m_height; ++rowCount)
+        for(size_t workerCount{0}; workerCount < workerCounterArray.size(); ++workerCount)
         {
-            for(std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                    ActivationDatatype,
-                                                    SumDatatype>>& pePtr : m_pePtrArray.at(rowCount))
-            {
-                pePtr->computeSum(m_rowIntraPeDataMovementCountArray.at(rowCount),
-                                    m_rowInterPeDataMovementCountArray.at(rowCount),
-                                    m_multiplicationsWithWeightZeroCountArray.at(rowCount));
-            }
+            workerCounterArray[workerCount] = SystolicArrayCounters{};
         }
 
-        m_rowIntraPeDataMovementsTotal += std::accumulate(
-                                                m_rowIntraPeDataMovementCountArray.begin(),
-                                                m_rowIntraPeDataMovementCountArray.end(),
-                                                typename std::iterator_traits<std::vector<size_t>::
-                                                                                iterator>::value_type{});
-
-        m_rowInterPeDataMovementsTotal += std::accumulate(
-                                                m_rowInterPeDataMovementCountArray.begin(),
-                                                m_rowInterPeDataMovementCountArray.end(),
-                                                typename std::iterator_traits<std::vector<size_t>::
-                                                                                iterator>::value_type{});
-        
-        m_multiplicationsWithWeightZeroCountTotal +=
-                                        std::accumulate(m_multiplicationsWithWeightZeroCountArray.begin(),
-                                                            m_multiplicationsWithWeightZeroCountArray.end(),
-                                                            typename std::iterator_traits<std::vector<size_t>::
-                                                                                                iterator>::value_type{});
+        prepareComputeRows();
+
+        m_workerTeamPtr->run(m_computeRowsTask);
+
+        for(size_t workerCount{0}; workerCount < workerCounterArray.size(); ++workerCount)
+        {
+            m_rowIntraPeDataMovementsTotal += workerCounterArray[workerCount].intraPeDataMovements;
+            m_rowInterPeDataMovementsTotal += workerCounterArray[workerCount].interPeDataMovements;
+
+            m_multiplicationsWithWeightZeroCountTotal +=
+                            workerCounterArray[workerCount].multiplicationsWithWeightZeroCount;
+        }
     }
 
     /**
@@ -400,40 +500,167 @@ public:
     
     void updateState()
     {
-        for(std::vector<std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                            ActivationDatatype,
-                                                            SumDatatype>>>& pePtrRow : m_pePtrArray)
+        updateProcessingElementStates();
+
+        ++m_iterationCount;
+    }
+
+    /**
+     * @brief   Check if the systolic array is in steady state, in which
+     *          every PE computes in every iteration and the PE state only
+     *          depends on the activations streamed through the FIFOs and
+     *          the stored weights. This is the case if all PEs hold a valid
+     *          signal and no update weight signal, the FIFO inputs of all
+     *          rows are enabled, and every FIFO holds enough activations
+     *          to neither run empty nor full while one activation is
+     *          pushed and popped per iteration.
+     */
+
+    bool isInSteadyState() const
+    {
+        if(m_iterationCount < m_height)
         {
-            for(std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                    ActivationDatatype,
-                                                    SumDatatype>>& pePtr : pePtrRow)
+            return false;
+        }
+
+        for(const ActivationFifo<ActivationDatatype>& activationFifo : m_activationFifoArray)
+        {
+            if((activationFifo.getContentSize() < 1UL) ||
+                    ((activationFifo.getContentSize() + 2UL) > activationFifo.getSize()))
             {
-                pePtr->updateState();
+                return false;
             }
         }
 
-        ++m_iterationCount;
+        return hasSteadyStateSignals();
     }
 
-private:
+    /**
+     * @brief                       Advance the systolic array in steady state by the given
+     *                              number of iterations at once, using the selected steady
+     *                              state execution mode. Each FIFO is pushed and popped once
+     *                              per iteration.
+     * @param iterations            The number of iterations, at least the array height
+     * @param fifoInputArray        The values pushed to the FIFOs, iterations
+     *                              consecutive values per FIFO
+     * @param bottomRowSumArray     Receives the partial sums of the bottom row present at the
+     *                              start of each iteration, width consecutive values per iteration
+     */
+
+    void runIterationsSteadyState(const size_t iterations,
+                                    const std::vector<ActivationDatatype>& fifoInputArray,
+                                    std::vector<SumDatatype>& bottomRowSumArray)
+    {
+        assert(iterations >= m_height);
+
+        if(!m_functionalSimulation)
+        {
+            runIterationsSteadyStateTimingOnly(iterations,
+                                                fifoInputArray,
+                                                bottomRowSumArray);
+        }
+
+        else if(m_steadyStateExecutionMode == SteadyStateExecutionMode::TemporalTiling)
+        {
+            runIterationsSteadyStateTemporalTiling(iterations,
+                                                    fifoInputArray,
+                                                    bottomRowSumArray);
+        }
+
+        else
+        {
+            runIterationsSteadyStateDeskewedGemm(iterations,
+                                                    fifoInputArray,
+                                                    bottomRowSumArray);
+        }
+    }
+
+protected:
+
+    /**
+     * @brief   Check if all PEs hold a valid signal and no update
+     *          weight signal, no update weight signal is about to
+     *          be set, and the FIFO inputs of all rows are enabled
+     */
+
+    virtual bool hasSteadyStateSignals() const = 0;
+
+    /**
+     * @brief                   Read the active weight, activation, and partial sum
+     *                          registers of all PEs into row-major arrays
+     * @param weightArray       Receives the active weights
+     * @param activationArray   Receives the activations
+     * @param sumArray          Receives the partial sums
+     */
+
+    virtual void readProcessingElementRegisters(std::vector<WeightDatatype>& weightArray,
+                                                    std::vector<ActivationDatatype>& activationArray,
+                                                    std::vector<SumDatatype>& sumArray) const = 0;
+
+    /**
+     * @brief                   Write the activation and partial sum registers
+     *                          of all PEs from row-major arrays
+     * @param activationArray   The activations
+     * @param sumArray          The partial sums
+     */
+
+    virtual void writeProcessingElementRegisters(const std::vector<ActivationDatatype>& activationArray,
+                                                    const std::vector<SumDatatype>& sumArray) = 0;
+
+
+    /**
+     * @brief       Get the current FIFO input enable signal
+     *              of the left border PE in the given row
+     * @param row   The row of the PE
+     */
+
+    virtual bool fifoInputEnabled(const size_t row) const = 0;
+
+    /**
+     * @brief           Set the FIFO input enable signal of the
+     *                  left border PE in the given row
+     * @param row       The row of the PE
+     * @param enabled   The value of the enable signal
+     */
+
+    virtual void enableFifoInput(const size_t row,
+                                    const bool enabled) = 0;
+
+    /**
+     * @brief   Prepare the engine state accessed by all workers
+     *          in computeRows(). Called once per iteration before
+     *          the workers start computing the rows.
+     */
+
+    virtual void prepareComputeRows() = 0;
+
+    /**
+     * @brief           Compute the next state of all PEs in the rows
+     *                  [rowBegin, rowEnd) and add their data movements
+     *                  and multiplications with weight zero to the given
+     *                  counters. Called concurrently for disjoint row
+     *                  ranges by the workers of the systolic array.
+     * @param rowBegin  The first row
+     * @param rowEnd    The end of the row range
+     * @param counters  The counters of the calling worker
+     */
+
+    virtual void computeRows(const size_t rowBegin,
+                                const size_t rowEnd,
+                                SystolicArrayCounters& counters) = 0;
+
+    /**
+     * @brief   Commit the next state of all PEs
+     */
+
+    virtual void updateProcessingElementStates() = 0;
 
     const size_t m_width;
     const size_t m_height;
     const size_t m_activationFifoDepth;
 
-    std::vector<std::vector<std::unique_ptr<ProcessingElement<WeightDatatype,
-                                                                ActivationDatatype,
-                                                                SumDatatype>>>> m_pePtrArray;
-    std::vector<std::vector<ProcessingElement<WeightDatatype,
-                                                ActivationDatatype,
-                                                SumDatatype>*>> m_peDiagonalsArray;
     std::vector<ActivationFifo<ActivationDatatype>> m_activationFifoArray;
 
-    std::vector<size_t> m_rowIntraPeDataMovementCountArray;
-    std::vector<size_t> m_rowInterPeDataMovementCountArray;
-
-    std::vector<size_t> m_multiplicationsWithWeightZeroCountArray;
-    
     size_t m_rowIntraPeDataMovementsTotal{0UL};
     size_t m_rowInterPeDataMovementsTotal{0UL};
     
@@ -441,6 +668,564 @@ private:
 
     size_t m_iterationCount{0UL};
 
+    bool m_functionalSimulation{true};
+
+private:
+
+    /**
+     * @brief                       Steady state execution without functional simulation.
+     *                              Only the FIFOs are advanced, as their fill levels
+     *                              determine the control signals. The execution metrics
+     *                              follow from the array dimensions and the active weights,
+     *                              the partial sums of the bottom row are set to zero.
+     * @param iterations            The number of iterations, at least the array height
+     * @param fifoInputArray        The values pushed to the FIFOs
+     * @param bottomRowSumArray     Receives the partial sums of the bottom row
+     */
+
+    void runIterationsSteadyStateTimingOnly(const size_t iterations,
+                                                const std::vector<ActivationDatatype>& fifoInputArray,
+                                                std::vector<SumDatatype>& bottomRowSumArray)
+    {
+        const size_t width{m_width};
+        const size_t height{m_height};
+
+        readProcessingElementRegisters(m_steadyStateWeightArray,
+                                        m_steadyStateActivationArray,
+                                        m_steadyStateSumArray);
+
+        m_steadyStateStreamArray.resize(iterations);
+
+        for(size_t rowCount{0}; rowCount < height; ++rowCount)
+        {
+            m_activationFifoArray[rowCount].pushPop(fifoInputArray.data() +
+                                                            rowCount*iterations,
+                                                        m_steadyStateStreamArray.data(),
+                                                        iterations);
+        }
+
+        bottomRowSumArray.assign(iterations*width, SumDatatype{});
+
+        const size_t weightZeroCount{static_cast<size_t>(
+                                        std::count(m_steadyStateWeightArray.begin(),
+                                                    m_steadyStateWeightArray.end(),
+                                                    WeightDatatype{}))};
+
+        m_rowIntraPeDataMovementsTotal += iterations*3UL*width*height;
+        m_rowInterPeDataMovementsTotal += iterations*width*(2UL*height - 1UL);
+        m_multiplicationsWithWeightZeroCountTotal += iterations*weightZeroCount;
+
+        m_iterationCount += iterations;
+    }
+
+    /**
+     * @brief                       Steady state execution mode DeskewedGemm. Instead of stepping
+     *                              the PEs, the partial sums leaving the bottom row in each iteration
+     *                              are computed by a blocked matrix multiplication of the deskewed
+     *                              activation streams with the stored weights, and the final PE state
+     *                              is reconstructed from the streams. The summation order of each
+     *                              partial sum is the same as in the PEs, so the results are
+     *                              identical to those of stepping the PEs.
+     * @param iterations            The number of iterations, at least the array height
+     * @param fifoInputArray        The values pushed to the FIFOs
+     * @param bottomRowSumArray     Receives the partial sums of the bottom row
+     */
+
+    void runIterationsSteadyStateDeskewedGemm(const size_t iterations,
+                                                const std::vector<ActivationDatatype>& fifoInputArray,
+                                                std::vector<SumDatatype>& bottomRowSumArray)
+    {
+        const size_t width{m_width};
+        const size_t height{m_height};
+
+        /* The activation stream of a row consists of the activations
+         * held by the PEs of the row at the start, from right to left,
+         * followed by the activations popped from the row's FIFO. The
+         * PE in column x processes stream element e + width - x in
+         * iteration e. */
+
+        const size_t streamLength{width + iterations};
+
+        readProcessingElementRegisters(m_steadyStateWeightArray,
+                                        m_steadyStateActivationArray,
+                                        m_steadyStateSumArray);
+
+        m_steadyStateStreamArray.resize(height*streamLength);
+
+        for(size_t rowCount{0}; rowCount < height; ++rowCount)
+        {
+            ActivationDatatype* const streamPtr{m_steadyStateStreamArray.data() +
+                                                                rowCount*streamLength};
+
+            for(size_t columnCount{0}; columnCount < width; ++columnCount)
+            {
+                streamPtr[width - 1 - columnCount] =
+                        m_steadyStateActivationArray[rowCount*width + columnCount];
+            }
+
+            m_activationFifoArray[rowCount].pushPop(fifoInputArray.data() +
+                                                            rowCount*iterations,
+                                                        streamPtr + width, iterations);
+        }
+
+        const ActivationDatatype* const streamPtr{m_steadyStateStreamArray.data()};
+        const WeightDatatype* const weightPtr{m_steadyStateWeightArray.data()};
+
+        bottomRowSumArray.resize(iterations*width);
+
+        SumDatatype* const bottomRowSumPtr{bottomRowSumArray.data()};
+
+        /* The partial sums leaving the array in the first height
+         * iterations were partially accumulated before */
+
+        for(size_t iterationCount{0}; iterationCount < height; ++iterationCount)
+        {
+            for(size_t columnCount{0}; columnCount < width; ++columnCount)
+            {
+                SumDatatype sum{m_steadyStateSumArray[(height - 1 - iterationCount)*width +
+                                                                                columnCount]};
+
+                for(size_t rowCount{height - iterationCount}; rowCount < height; ++rowCount)
+                {
+                    sum = streamPtr[rowCount*streamLength + iterationCount +
+                                        width + rowCount - height - columnCount]*
+                                weightPtr[rowCount*width + columnCount] + sum;
+                }
+
+                bottomRowSumPtr[iterationCount*width + columnCount] = sum;
+            }
+        }
+
+        /* The partial sum leaving column x in iteration i >= height
+         * is the dot product of the weights of the column with the
+         * stream elements i - x - height + width + y of the rows y.
+         * Deskewing the streams by the row index turns these into
+         * rows d = i - x - height + width - 1 of a dense matrix, which
+         * is multiplied with the weights in blocks of rows. */
+
+        const size_t deskewedRows{iterations + width - height - 1};
+
+        m_steadyStateDeskewedSumArray.resize(deskewedRows*width);
+
+        SumDatatype* const deskewedSumPtr{m_steadyStateDeskewedSumArray.data()};
+
+        const size_t deskewedRowBlockSize{16UL};
+
+        #pragma omp parallel for
+        for(size_t rowBlockStart = 0; rowBlockStart < deskewedRows;
+                                        rowBlockStart += deskewedRowBlockSize)
+        {
+            const size_t rowBlockEnd{std::min(rowBlockStart + deskewedRowBlockSize,
+                                                                        deskewedRows)};
+
+            for(size_t rowCount{0}; rowCount < height; ++rowCount)
+            {
+                const WeightDatatype* const weightRowPtr{weightPtr + rowCount*width};
+
+                for(size_t deskewedRow{rowBlockStart}; deskewedRow < rowBlockEnd; ++deskewedRow)
+                {
+                    const ActivationDatatype activation{streamPtr[rowCount*streamLength +
+                                                                        deskewedRow + 1 + rowCount]};
+
+                    SumDatatype* const sumPtr{deskewedSumPtr + deskewedRow*width};
+
+                    if(rowCount == 0)
+                    {
+                        for(size_t columnCount{0}; columnCount < width; ++columnCount)
+                        {
+                            sumPtr[columnCount] = activation*weightRowPtr[columnCount];
+                        }
+                    }
+
+                    else
+                    {
+                        for(size_t columnCount{0}; columnCount < width; ++columnCount)
+                        {
+                            sumPtr[columnCount] = activation*weightRowPtr[columnCount] +
+                                                                        sumPtr[columnCount];
+                        }
+                    }
+                }
+            }
+        }
+
+        for(size_t iterationCount{height}; iterationCount < iterations; ++iterationCount)
+        {
+            for(size_t columnCount{0}; columnCount < width; ++columnCount)
+            {
+                bottomRowSumPtr[iterationCount*width + columnCount] =
+                            deskewedSumPtr[(iterationCount + width - 1 - height - columnCount)*width +
+                                                                                        columnCount];
+            }
+        }
+
+        /* PE state after the last iteration */
+
+        size_t weightZeroCount{0UL};
+
+        for(size_t rowCount{0}; rowCount < height; ++rowCount)
+        {
+            for(size_t columnCount{0}; columnCount < width; ++columnCount)
+            {
+                const size_t streamIndex{iterations + width - 1 - columnCount - rowCount};
+
+                SumDatatype sum = streamPtr[streamIndex]*weightPtr[columnCount];
+
+                for(size_t upperRowCount{1}; upperRowCount <= rowCount; ++upperRowCount)
+                {
+                    sum = streamPtr[upperRowCount*streamLength + streamIndex + upperRowCount]*
+                                weightPtr[upperRowCount*width + columnCount] + sum;
+                }
+
+                m_steadyStateActivationArray[rowCount*width + columnCount] =
+                                streamPtr[rowCount*streamLength + iterations + width - 1 - columnCount];
+
+                m_steadyStateSumArray[rowCount*width + columnCount] = sum;
+
+                if(!weightPtr[rowCount*width + columnCount])
+                {
+                    ++weightZeroCount;
+                }
+            }
+        }
+
+        writeProcessingElementRegisters(m_steadyStateActivationArray,
+                                            m_steadyStateSumArray);
+
+        m_rowIntraPeDataMovementsTotal += iterations*3UL*width*height;
+        m_rowInterPeDataMovementsTotal += iterations*width*(2UL*height - 1UL);
+        m_multiplicationsWithWeightZeroCountTotal += iterations*weightZeroCount;
+
+        m_iterationCount += iterations;
+    }
+
+    /**
+     * @brief                       Steady state execution mode TemporalTiling. Row r of the array
+     *                              in iteration i only depends on row r - 1 and on its own state in
+     *                              iteration i - 1. Each worker therefore steps the PE registers of
+     *                              its stripe of rows by a tile of iterations without synchronizing,
+     *                              as soon as the worker of the stripe above has published the partial
+     *                              sums leaving that stripe during the same tile. Within a tile, the
+     *                              rows of a stripe are stepped from the bottom to the top and the
+     *                              columns from the right to the left, so the registers are updated
+     *                              in place. The boundary rows are exchanged through double buffered
+     *                              tile buffers, so a worker can run at most one tile ahead of the
+     *                              worker below it.
+     * @param iterations            The number of iterations
+     * @param fifoInputArray        The values pushed to the FIFOs
+     * @param bottomRowSumArray     Receives the partial sums of the bottom row
+     */
+
+    void runIterationsSteadyStateTemporalTiling(const size_t iterations,
+                                                    const std::vector<ActivationDatatype>& fifoInputArray,
+                                                    std::vector<SumDatatype>& bottomRowSumArray)
+    {
+        const size_t width{m_width};
+        const size_t height{m_height};
+
+        readProcessingElementRegisters(m_steadyStateWeightArray,
+                                        m_steadyStateActivationArray,
+                                        m_steadyStateSumArray);
+
+        /* Here, the stream of a row only holds the
+         * activations popped from the row's FIFO */
+
+        m_steadyStateStreamArray.resize(height*iterations);
+
+        for(size_t rowCount{0}; rowCount < height; ++rowCount)
+        {
+            m_activationFifoArray[rowCount].pushPop(fifoInputArray.data() + rowCount*iterations,
+                                                        m_steadyStateStreamArray.data() +
+                                                                        rowCount*iterations,
+                                                        iterations);
+        }
+
+        bottomRowSumArray.resize(iterations*width);
+
+        const size_t workerCount{m_workerTeamPtr->getWorkerCount()};
+
+        m_temporalTileBoundaryArray.resize(workerCount*2UL*m_temporalTileIterations*width);
+
+        CacheLinePaddedArray<TemporalTileProgress>& progressArray{*m_temporalTileProgressArrayPtr};
+
+        for(size_t workerIndex{0}; workerIndex < workerCount; ++workerIndex)
+        {
+            progressArray[workerIndex].iterationsPublished.store(0UL, std::memory_order_relaxed);
+            progressArray[workerIndex].iterationsConsumed.store(0UL, std::memory_order_relaxed);
+        }
+
+        m_temporalTilingTask.setIterations(iterations, bottomRowSumArray.data());
+
+        m_workerTeamPtr->run(m_temporalTilingTask);
+
+        size_t weightZeroCount{0UL};
+
+        for(const WeightDatatype weight : m_steadyStateWeightArray)
+        {
+            if(!weight)
+            {
+                ++weightZeroCount;
+            }
+        }
+
+        writeProcessingElementRegisters(m_steadyStateActivationArray,
+                                            m_steadyStateSumArray);
+
+        m_rowIntraPeDataMovementsTotal += iterations*3UL*width*height;
+        m_rowInterPeDataMovementsTotal += iterations*width*(2UL*height - 1UL);
+        m_multiplicationsWithWeightZeroCountTotal += iterations*weightZeroCount;
+
+        m_iterationCount += iterations;
+    }
+
+    /**
+     * @brief                       Step the PE registers of a stripe of rows by the given
+     *                              iterations in steady state. Used by the TemporalTiling
+     *                              steady state execution mode.
+     * @param rowBegin              The first row of the stripe
+     * @param rowEnd                The end of the stripe
+     * @param iterationBegin        The first iteration
+     * @param iterationEnd          The end of the iterations
+     * @param upperBoundarySumPtr   The partial sums of the row above the stripe at the start
+     *                              of each iteration, width consecutive values per iteration.
+     *                              Not used for the top stripe.
+     * @param lowerBoundarySumPtr   Receives the partial sums of the bottom row of the stripe
+     *                              at the start of each iteration
+     */
+
+    void stepStripeSteadyState(const size_t rowBegin,
+                                const size_t rowEnd,
+                                const size_t iterationBegin,
+                                const size_t iterationEnd,
+                                const SumDatatype* const upperBoundarySumPtr,
+                                SumDatatype* const lowerBoundarySumPtr)
+    {
+        const size_t width{m_width};
+        const size_t iterations{m_temporalTilingTask.getIterations()};
+
+        for(size_t iterationCount{iterationBegin}; iterationCount < iterationEnd; ++iterationCount)
+        {
+            const size_t tileIteration{iterationCount - iterationBegin};
+
+            std::copy(m_steadyStateSumArray.begin() + (rowEnd - 1UL)*width,
+                        m_steadyStateSumArray.begin() + rowEnd*width,
+                        lowerBoundarySumPtr + tileIteration*width);
+
+            for(size_t rowCount{rowEnd}; rowCount-- > rowBegin;)
+            {
+                ActivationDatatype* const activationPtr{m_steadyStateActivationArray.data() +
+                                                                                rowCount*width};
+
+                SumDatatype* const __restrict__ sumPtr{m_steadyStateSumArray.data() + rowCount*width};
+
+                const WeightDatatype* const __restrict__ weightPtr{m_steadyStateWeightArray.data() +
+                                                                                        rowCount*width};
+
+                std::copy_backward(activationPtr, activationPtr + width - 1UL,
+                                                    activationPtr + width);
+
+                activationPtr[0] = m_steadyStateStreamArray[rowCount*iterations + iterationCount];
+
+                if(rowCount == 0)
+                {
+                    for(size_t columnCount{0}; columnCount < width; ++columnCount)
+                    {
+                        sumPtr[columnCount] = activationPtr[columnCount]*weightPtr[columnCount];
+                    }
+                }
+
+                else
+                {
+                    const SumDatatype* const __restrict__ upperSumPtr{(rowCount == rowBegin) ?
+                                                                    upperBoundarySumPtr + tileIteration*width :
+                                                                    sumPtr - width};
+
+                    for(size_t columnCount{0}; columnCount < width; ++columnCount)
+                    {
+                        sumPtr[columnCount] = activationPtr[columnCount]*weightPtr[columnCount] +
+                                                                            upperSumPtr[columnCount];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @struct  TemporalTileProgress
+     * @brief   The iterations a worker has published the partial sums
+     *          leaving its stripe for, and the iterations it has consumed
+     *          the partial sums entering its stripe from the stripe above for
+     */
+
+    struct TemporalTileProgress
+    {
+        std::atomic<size_t> iterationsPublished;
+        std::atomic<size_t> iterationsConsumed;
+    };
+
+    /**
+     * @class   TemporalTilingTask
+     * @brief   Worker team task stepping the stripe of rows of each
+     *          worker through the steady state iterations tile by tile
+     */
+
+    class TemporalTilingTask: public WorkerTeamTask
+    {
+
+    public:
+
+        explicit TemporalTilingTask(SystolicArray* const systolicArrayPtr): m_systolicArrayPtr{systolicArrayPtr}
+        {
+        }
+
+        void setIterations(const size_t iterations,
+                            SumDatatype* const bottomRowSumPtr)
+        {
+            m_iterations = iterations;
+            m_bottomRowSumPtr = bottomRowSumPtr;
+        }
+
+        size_t getIterations() const
+        {
+            return m_iterations;
+        }
+
+        void runWorker(const size_t workerIndex,
+                        const size_t workerCount) final
+        {
+            SystolicArray& systolicArray{*m_systolicArrayPtr};
+
+            const size_t width{systolicArray.m_width};
+            const size_t height{systolicArray.m_height};
+            const size_t tileIterations{systolicArray.m_temporalTileIterations};
+            const size_t tileSize{tileIterations*width};
+
+            const size_t rowBegin{(workerIndex*height)/workerCount};
+            const size_t rowEnd{((workerIndex + 1UL)*height)/workerCount};
+
+            CacheLinePaddedArray<TemporalTileProgress>& progressArray{
+                                                *systolicArray.m_temporalTileProgressArrayPtr};
+
+            SumDatatype* const boundaryPtr{systolicArray.m_temporalTileBoundaryArray.data()};
+
+            for(size_t iterationBegin{0UL}; iterationBegin < m_iterations;
+                                                    iterationBegin += tileIterations)
+            {
+                const size_t iterationEnd{std::min(iterationBegin + tileIterations, m_iterations)};
+                const size_t tileBufferIndex{(iterationBegin/tileIterations) & 1UL};
+
+                const bool bottomStripe{workerIndex == (workerCount - 1UL)};
+
+                /* Wait for the partial sums entering the stripe during
+                 * this tile, and until the worker below has consumed
+                 * the tile buffer written two tiles ago */
+
+                if(workerIndex != 0UL)
+                {
+                    const std::atomic<size_t>& iterationsPublishedUpper{
+                                                    progressArray[workerIndex - 1UL].iterationsPublished};
+
+                    spinWaitUntil([&iterationsPublishedUpper, iterationEnd]() {
+                        return iterationsPublishedUpper.load(std::memory_order_acquire) >= iterationEnd;
+                    });
+                }
+
+                if(!bottomStripe)
+                {
+                    const std::atomic<size_t>& iterationsConsumedLower{
+                                                    progressArray[workerIndex].iterationsConsumed};
+
+                    spinWaitUntil([&iterationsConsumedLower, iterationBegin, tileIterations]() {
+                        return (iterationsConsumedLower.load(std::memory_order_acquire) +
+                                                                tileIterations) >= iterationBegin;
+                    });
+                }
+
+                const SumDatatype* const upperBoundarySumPtr{(workerIndex != 0UL) ?
+                                                    boundaryPtr + ((workerIndex - 1UL)*2UL +
+                                                                    tileBufferIndex)*tileSize :
+                                                    nullptr};
+
+                SumDatatype* const lowerBoundarySumPtr{bottomStripe ?
+                                                    m_bottomRowSumPtr + iterationBegin*width :
+                                                    boundaryPtr + (workerIndex*2UL +
+                                                                    tileBufferIndex)*tileSize};
+
+                systolicArray.stepStripeSteadyState(rowBegin, rowEnd,
+                                                        iterationBegin, iterationEnd,
+                                                        upperBoundarySumPtr,
+                                                        lowerBoundarySumPtr);
+
+                progressArray[workerIndex].iterationsPublished.store(iterationEnd,
+                                                                        std::memory_order_release);
+
+                if(workerIndex != 0UL)
+                {
+                    progressArray[workerIndex - 1UL].iterationsConsumed.store(iterationEnd,
+                                                                        std::memory_order_release);
+                }
+            }
+        }
+
+    private:
+
+        SystolicArray* const m_systolicArrayPtr;
+
+        size_t m_iterations{0UL};
+        SumDatatype* m_bottomRowSumPtr{nullptr};
+
+    };
+
+    /**
+     * @class   ComputeRowsTask
+     * @brief   Worker team task computing the stripe of rows
+     *          of each worker in an iteration
+     */
+
+    class ComputeRowsTask: public WorkerTeamTask
+    {
+
+    public:
+
+        explicit ComputeRowsTask(SystolicArray* const systolicArrayPtr): m_systolicArrayPtr{systolicArrayPtr}
+        {
+        }
+
+        void runWorker(const size_t workerIndex,
+                        const size_t workerCount) final
+        {
+            const size_t height{m_systolicArrayPtr->m_height};
+
+            m_systolicArrayPtr->computeRows((workerIndex*height)/workerCount,
+                                                ((workerIndex + 1UL)*height)/workerCount,
+                                                (*m_systolicArrayPtr->m_workerCounterArrayPtr)[workerIndex]);
+        }
+
+    private:
+
+        SystolicArray* const m_systolicArrayPtr;
+
+    };
+
+    ComputeRowsTask m_computeRowsTask;
+    TemporalTilingTask m_temporalTilingTask;
+
+    std::unique_ptr<WorkerTeam> m_workerTeamPtr;
+    std::unique_ptr<CacheLinePaddedArray<SystolicArrayCounters>> m_workerCounterArrayPtr;
+    std::unique_ptr<CacheLinePaddedArray<TemporalTileProgress>> m_temporalTileProgressArrayPtr;
+
+    SteadyStateExecutionMode m_steadyStateExecutionMode{SteadyStateExecutionMode::DeskewedGemm};
+
+    size_t m_temporalTileIterations{64UL};
+
+    std::vector<SumDatatype> m_temporalTileBoundaryArray;
+
+    std::vector<WeightDatatype> m_steadyStateWeightArray;
+    std::vector<ActivationDatatype> m_steadyStateActivationArray;
+    std::vector<SumDatatype> m_steadyStateSumArray;
+    std::vector<ActivationDatatype> m_steadyStateStreamArray;
+    std::vector<SumDatatype> m_steadyStateDeskewedSumArray;
+
 };
 
 #endif
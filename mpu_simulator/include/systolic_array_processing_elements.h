@@ -0,0 +1,314 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        systolic_array_processing_elements.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2019-2020
+ * @copyright   MIT License
+ */
+
+#ifndef SYSTOLIC_ARRAY_PROCESSING_ELEMENTS_H
+#define SYSTOLIC_ARRAY_PROCESSING_ELEMENTS_H
+
+#include <vector>
+#include <memory>
+
+#include "systolic_array.h"
+#include "processing_element.h"
+#include "processing_element_top_border.h"
+#include "processing_element_left_border.h"
+#include "processing_element_center.h"
+#include "activation_fifo.h"
+
+/**
+ * @class                       SystolicArrayProcessingElements
+ * @brief                       Systolic array engine modelling every PE as an individual
+ *                              ProcessingElement subclass object connected to its
+ *                              neighbors by pointers
+ * @tparam WeightDatatype       
+ * @tparam ActivationDatatype   
+ * @tparam SumDatatype          
+ */
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype> class SystolicArrayProcessingElements: public SystolicArray<WeightDatatype,
+                                                                                                ActivationDatatype,
+                                                                                                SumDatatype>
+{
+
+public:
+    
+    
+    /**
+     * @brief
+     * @param width
+     * @param height
+     * @param activationFifoDepth
+     */
+
+    SystolicArrayProcessingElements(const size_t width,
+                                        const size_t height,
+                                        const size_t activationFifoDepth):
+                                                    SystolicArray<WeightDatatype,
+                                                                    ActivationDatatype,
+                                                                    SumDatatype>::SystolicArray(width,
+                                                                                                height,
+                                                                                                activationFifoDepth),
+                                                    m_pePtrArray(height)
+    {
+
+        m_pePtrArray.at(0).emplace_back(std::unique_ptr<ProcessingElement<WeightDatatype,
+                                                                            ActivationDatatype,
+                                                                            SumDatatype>>{
+                                                         new ProcessingElementLeftBorder<WeightDatatype,
+                                                                                            ActivationDatatype,
+                                                                                            SumDatatype>(
+                                                                                        PEPosition(0, 0), nullptr,
+                                                                                        &(this->m_activationFifoArray.at(0)))});
+
+        for(size_t heightCount{1}; heightCount < this->m_height; ++heightCount)
+        {
+            m_pePtrArray.at(heightCount).emplace_back(std::unique_ptr<ProcessingElement<WeightDatatype,
+                                                                                        ActivationDatatype,
+                                                                                        SumDatatype>>{
+                                                                       new ProcessingElementLeftBorder<WeightDatatype,
+                                                                                                        ActivationDatatype,
+                                                                                                        SumDatatype>(
+                                                                                                        PEPosition(0, heightCount),
+                                                                                                        m_pePtrArray.at(heightCount - 1).at(0).get(),
+                                                                                                        &(this->m_activationFifoArray.at(heightCount)))});
+        }
+
+        for(size_t widthCount = 1; widthCount < this->m_width; widthCount++)
+        {
+            m_pePtrArray.at(0).emplace_back(std::unique_ptr<ProcessingElement<WeightDatatype,
+                                                                                ActivationDatatype,
+                                                                                SumDatatype>>{
+                                                             new ProcessingElementTopBorder<WeightDatatype,
+                                                                                            ActivationDatatype,
+                                                                                            SumDatatype>(
+                                                                                        PEPosition(widthCount, 0),
+                                                                                        m_pePtrArray.at(0).at(widthCount - 1).get())});
+        }
+
+        for(size_t heightCount{1}; heightCount < this->m_height; ++heightCount)
+        {
+            for(size_t widthCount{1}; widthCount < this->m_width; ++widthCount)
+            {
+                m_pePtrArray.at(heightCount).emplace_back(std::unique_ptr<ProcessingElement<WeightDatatype,
+                                                                                            ActivationDatatype,
+                                                                                            SumDatatype>>{
+                                                                        new ProcessingElementCenter<WeightDatatype,
+                                                                                                    ActivationDatatype,
+                                                                                                    SumDatatype>(
+                                                                                        PEPosition(widthCount, heightCount),
+                                                                                        m_pePtrArray.at(heightCount).at(widthCount - 1).get(),
+                                                                                        m_pePtrArray.at(heightCount - 1).at(widthCount).get())});
+            }
+        }
+    }
+
+    void storeWeight(const PEPosition& position,
+                            const WeightDatatype value) final
+    {
+        m_pePtrArray.at(position.y).at(position.x)->storeWeight(value);
+    }
+    
+    /**
+     * @brief               
+     * @param updateWeights 
+     */
+
+    void setUpdateWeightsSignal(const bool updateWeights) final
+    {
+        dynamic_cast<ProcessingElementLeftBorder<WeightDatatype,
+                                                    ActivationDatatype,
+                                                    SumDatatype>*>(
+                                                        m_pePtrArray.at(0).at(0).get())->setUpdateWeightSignal(updateWeights);
+    }
+
+    /**
+     * @brief
+     */
+    
+    void readUpdateWeightSignals() final
+    {
+        for(std::vector<std::unique_ptr<ProcessingElement<WeightDatatype,
+                                                            ActivationDatatype,
+                                                            SumDatatype>>>& pePtrRow : m_pePtrArray)
+        {
+            for(std::unique_ptr<ProcessingElement<WeightDatatype,
+                                                    ActivationDatatype,
+                                                    SumDatatype>>& pePtr : pePtrRow)
+            {
+                pePtr->readUpdateWeightSignals();
+            }
+        }
+    }
+
+    SumDatatype getBottomRowSum(const size_t column) const final
+    {
+        return m_pePtrArray.back()[column]->getSum();
+    }
+
+    bool bottomRowHasValidSignal(const size_t column) const final
+    {
+        return m_pePtrArray.back()[column]->hasValidSignal();
+    }
+
+    bool bottomRowHasUpdateWeightSignal(const size_t column) const final
+    {
+        return m_pePtrArray.back()[column]->hasUpdateWeightSignal();
+    }
+
+protected:
+
+    bool fifoInputEnabled(const size_t row) const final
+    {
+        return dynamic_cast<const ProcessingElementLeftBorder<WeightDatatype,
+                                                                ActivationDatatype,
+                                                                SumDatatype>*>(
+                                                                    m_pePtrArray.at(row).at(0).get())->fifoInputEnabled();
+    }
+
+    void enableFifoInput(const size_t row,
+                            const bool enabled) final
+    {
+        dynamic_cast<ProcessingElementLeftBorder<WeightDatatype,
+                                                    ActivationDatatype,
+                                                    SumDatatype>*>(
+                                                        m_pePtrArray.at(row).at(0).get())->enableFifoInput(enabled);
+    }
+
+    bool hasSteadyStateSignals() const final
+    {
+        for(size_t rowCount{0}; rowCount < this->m_height; ++rowCount)
+        {
+            if(!fifoInputEnabled(rowCount))
+            {
+                return false;
+            }
+
+            for(const std::unique_ptr<ProcessingElement<WeightDatatype,
+                                                        ActivationDatatype,
+                                                        SumDatatype>>& pePtr : m_pePtrArray.at(rowCount))
+            {
+                if(!pePtr->hasValidSignal() || pePtr->hasUpdateWeightSignal())
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    void readProcessingElementRegisters(std::vector<WeightDatatype>& weightArray,
+                                            std::vector<ActivationDatatype>& activationArray,
+                                            std::vector<SumDatatype>& sumArray) const final
+    {
+        weightArray.resize(this->m_width*this->m_height);
+        activationArray.resize(this->m_width*this->m_height);
+        sumArray.resize(this->m_width*this->m_height);
+
+        for(size_t rowCount{0}; rowCount < this->m_height; ++rowCount)
+        {
+            for(size_t columnCount{0}; columnCount < this->m_width; ++columnCount)
+            {
+                const size_t index{rowCount*this->m_width + columnCount};
+
+                weightArray[index] = m_pePtrArray[rowCount][columnCount]->loadWeight();
+                activationArray[index] = m_pePtrArray[rowCount][columnCount]->getActivation();
+                sumArray[index] = m_pePtrArray[rowCount][columnCount]->getSum();
+            }
+        }
+    }
+
+    void writeProcessingElementRegisters(const std::vector<ActivationDatatype>& activationArray,
+                                            const std::vector<SumDatatype>& sumArray) final
+    {
+        for(size_t rowCount{0}; rowCount < this->m_height; ++rowCount)
+        {
+            for(size_t columnCount{0}; columnCount < this->m_width; ++columnCount)
+            {
+                const size_t index{rowCount*this->m_width + columnCount};
+
+                m_pePtrArray[rowCount][columnCount]->setRegisters(activationArray[index],
+                                                                    sumArray[index]);
+            }
+        }
+    }
+
+    void prepareComputeRows() final
+    {
+    }
+
+    /**
+     * @brief
+     */
+    
+    void computeRows(const size_t rowBegin,
+                        const size_t rowEnd,
+                        SystolicArrayCounters& counters) final
+    {
+        for(size_t rowCount{rowBegin}; rowCount < rowEnd; ++rowCount)
+        {
+            for(std::unique_ptr<ProcessingElement<WeightDatatype,
+                                                    ActivationDatatype,
+                                                    SumDatatype>>& pePtr : m_pePtrArray[rowCount])
+            {
+                pePtr->computeSum(counters.intraPeDataMovements,
+                                    counters.interPeDataMovements,
+                                    counters.multiplicationsWithWeightZeroCount);
+            }
+        }
+    }
+
+    /**
+     * @brief
+     */
+    
+    void updateProcessingElementStates() final
+    {
+        for(std::vector<std::unique_ptr<ProcessingElement<WeightDatatype,
+                                                            ActivationDatatype,
+                                                            SumDatatype>>>& pePtrRow : m_pePtrArray)
+        {
+            for(std::unique_ptr<ProcessingElement<WeightDatatype,
+                                                    ActivationDatatype,
+                                                    SumDatatype>>& pePtr : pePtrRow)
+            {
+                pePtr->updateState();
+            }
+        }
+    }
+
+private:
+
+    std::vector<std::vector<std::unique_ptr<ProcessingElement<WeightDatatype,
+                                                                ActivationDatatype,
+                                                                SumDatatype>>>> m_pePtrArray;
+
+};
+
+#endif
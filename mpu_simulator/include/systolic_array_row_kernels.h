@@ -0,0 +1,473 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        systolic_array_row_kernels.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef SYSTOLIC_ARRAY_ROW_KERNELS_H
+#define SYSTOLIC_ARRAY_ROW_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/* Comment in to always use the row kernels compiled for
+ * the baseline instruction set of the build */
+
+//#define SYSTOLIC_ARRAY_ROW_KERNELS_NO_DISPATCH SYSTOLIC_ARRAY_ROW_KERNELS_NO_DISPATCH
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+                                !defined(SYSTOLIC_ARRAY_ROW_KERNELS_NO_DISPATCH)
+#define SYSTOLIC_ARRAY_ROW_KERNELS_X86_DISPATCH SYSTOLIC_ARRAY_ROW_KERNELS_X86_DISPATCH
+#endif
+
+/**
+ * @enum    RowKernelInstructionSet
+ * @brief   The instruction set a systolic array row kernel
+ *          is compiled for. Baseline uses the instruction
+ *          set the simulator is built for.
+ */
+
+enum class RowKernelInstructionSet
+{
+    Baseline,
+    Sse42,
+    Avx2,
+    Avx512
+};
+
+/**
+ * @struct                      SystolicArrayRowOperands
+ * @brief                       Pointers to the first element of a row of the
+ *                              structure of arrays systolic array planes
+ *                              processed by a row kernel. The pointers to the
+ *                              upper row are not used for the top row.
+ * @tparam WeightDatatype
+ * @tparam ActivationDatatype
+ * @tparam SumDatatype
+ */
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype> struct SystolicArrayRowOperands
+{
+    const ActivationDatatype* activationCurrentPtr;
+    const std::uint8_t* validCurrentPtr;
+
+    const SumDatatype* sumUpperCurrentPtr;
+    const std::uint8_t* validUpperCurrentPtr;
+
+    const WeightDatatype* weightRegister0Ptr;
+    const WeightDatatype* weightRegister1Ptr;
+    const std::uint8_t* weightRegisterReadSelectBitPtr;
+
+    ActivationDatatype* activationNextPtr;
+    SumDatatype* sumNextPtr;
+    std::uint8_t* validNextPtr;
+};
+
+/**
+ * @struct  SystolicArrayRowCounts
+ * @brief   The number of PEs computing in a row step, and the
+ *          number of these PEs multiplying with a weight of zero
+ */
+
+struct SystolicArrayRowCounts
+{
+    size_t validCount;
+    size_t weightZeroCount;
+};
+
+/**
+ * @brief                       Compute the next state of the PEs in the columns
+ *                              [columnBegin, columnEnd) of a row, excluding the
+ *                              left border column. A PE receives a valid signal
+ *                              if its left neighbor, and for rows below the top row
+ *                              also its upper neighbor, holds one. All operands are
+ *                              loaded unconditionally so the loop body contains no
+ *                              control flow and is vectorized by the compiler: the
+ *                              weight register select and the activation and partial
+ *                              sum registers of PEs not receiving a valid signal
+ *                              become vector blends, and weight zero multiplications
+ *                              are counted using vector compares of the weights.
+ * @tparam TopRow               Selects the top row variant without upper neighbors
+ * @param columnBegin           The first column, at least 1
+ * @param columnEnd             The end of the column range
+ */
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype,
+            bool TopRow> inline __attribute__((always_inline))
+SystolicArrayRowCounts computeSystolicArrayRow(const ActivationDatatype* const __restrict__ activationCurrentPtr,
+                                                    const std::uint8_t* const __restrict__ validCurrentPtr,
+                                                    const SumDatatype* const __restrict__ sumUpperCurrentPtr,
+                                                    const std::uint8_t* const __restrict__ validUpperCurrentPtr,
+                                                    const WeightDatatype* const __restrict__ weightRegister0Ptr,
+                                                    const WeightDatatype* const __restrict__ weightRegister1Ptr,
+                                                    const std::uint8_t* const __restrict__ weightRegisterReadSelectBitPtr,
+                                                    ActivationDatatype* const __restrict__ activationNextPtr,
+                                                    SumDatatype* const __restrict__ sumNextPtr,
+                                                    std::uint8_t* const __restrict__ validNextPtr,
+                                                    const size_t columnBegin,
+                                                    const size_t columnEnd)
+{
+    size_t validCount{0UL};
+    size_t weightZeroCount{0UL};
+
+    for(size_t column = columnBegin; column < columnEnd; ++column)
+    {
+        const std::uint8_t valid = TopRow ? validCurrentPtr[column - 1] :
+                                            static_cast<std::uint8_t>(validCurrentPtr[column - 1] &
+                                                                        validUpperCurrentPtr[column]);
+
+        const ActivationDatatype activation = activationCurrentPtr[column - 1];
+
+        const WeightDatatype weightRegister0{weightRegister0Ptr[column]};
+        const WeightDatatype weightRegister1{weightRegister1Ptr[column]};
+
+        const WeightDatatype weight = weightRegisterReadSelectBitPtr[column] ?
+                                                        weightRegister1 : weightRegister0;
+
+        const SumDatatype sum = TopRow ? static_cast<SumDatatype>(activation*weight) :
+                                            static_cast<SumDatatype>(activation*weight +
+                                                                        sumUpperCurrentPtr[column]);
+
+        const ActivationDatatype activationNext{activationNextPtr[column]};
+        const SumDatatype sumNext{sumNextPtr[column]};
+
+        validNextPtr[column] = valid;
+
+        activationNextPtr[column] = valid ? activation : activationNext;
+        sumNextPtr[column] = valid ? sum : sumNext;
+
+        validCount += valid;
+        weightZeroCount += valid & static_cast<std::uint8_t>(weight == 0);
+    }
+
+    return SystolicArrayRowCounts{validCount, weightZeroCount};
+}
+
+/**
+ * @brief                       Unpack the row operands into the restrict qualified
+ *                              parameters of the row loop, so the compiler does not
+ *                              need run-time alias checks between the planes. For
+ *                              arrays of a width known at compile time, the step of a
+ *                              complete row is compiled with constant column bounds,
+ *                              so that the loop is vectorized without remainder
+ *                              handling or unrolled completely.
+ * @tparam FixedColumnEnd       The array width if known at compile time, otherwise zero
+ * @param operands              The row of the planes
+ * @param columnBegin           The first column, at least 1
+ * @param columnEnd             The end of the column range
+ */
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype,
+            bool TopRow,
+            size_t FixedColumnEnd> inline __attribute__((always_inline))
+SystolicArrayRowCounts computeSystolicArrayRow(const SystolicArrayRowOperands<WeightDatatype,
+                                                                                ActivationDatatype,
+                                                                                SumDatatype>& operands,
+                                                    const size_t columnBegin,
+                                                    const size_t columnEnd)
+{
+    if(FixedColumnEnd && (columnBegin == 1UL) && (columnEnd == FixedColumnEnd))
+    {
+        return computeSystolicArrayRow<WeightDatatype,
+                                        ActivationDatatype,
+                                        SumDatatype,
+                                        TopRow>(operands.activationCurrentPtr,
+                                                    operands.validCurrentPtr,
+                                                    operands.sumUpperCurrentPtr,
+                                                    operands.validUpperCurrentPtr,
+                                                    operands.weightRegister0Ptr,
+                                                    operands.weightRegister1Ptr,
+                                                    operands.weightRegisterReadSelectBitPtr,
+                                                    operands.activationNextPtr,
+                                                    operands.sumNextPtr,
+                                                    operands.validNextPtr,
+                                                    1UL,
+                                                    FixedColumnEnd);
+    }
+
+    return computeSystolicArrayRow<WeightDatatype,
+                                    ActivationDatatype,
+                                    SumDatatype,
+                                    TopRow>(operands.activationCurrentPtr,
+                                                operands.validCurrentPtr,
+                                                operands.sumUpperCurrentPtr,
+                                                operands.validUpperCurrentPtr,
+                                                operands.weightRegister0Ptr,
+                                                operands.weightRegister1Ptr,
+                                                operands.weightRegisterReadSelectBitPtr,
+                                                operands.activationNextPtr,
+                                                operands.sumNextPtr,
+                                                operands.validNextPtr,
+                                                columnBegin,
+                                                columnEnd);
+}
+
+/**
+ * @brief                       Compute the next valid signals of the PEs in the columns
+ *                              [columnBegin, columnEnd) of a row without functional
+ *                              simulation. The activation and partial sum registers are
+ *                              not accessed, the weights are only read to count the
+ *                              multiplications with weight zero.
+ * @tparam TopRow               Selects the top row variant without upper neighbors
+ * @param operands              The row of the planes
+ * @param columnBegin           The first column, at least 1
+ * @param columnEnd             The end of the column range
+ */
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype,
+            bool TopRow> inline
+SystolicArrayRowCounts computeSystolicArrayRowSignals(const SystolicArrayRowOperands<WeightDatatype,
+                                                                                        ActivationDatatype,
+                                                                                        SumDatatype>& operands,
+                                                        const size_t columnBegin,
+                                                        const size_t columnEnd)
+{
+    const std::uint8_t* const __restrict__ validCurrentPtr{operands.validCurrentPtr};
+    const std::uint8_t* const __restrict__ validUpperCurrentPtr{operands.validUpperCurrentPtr};
+    const WeightDatatype* const __restrict__ weightRegister0Ptr{operands.weightRegister0Ptr};
+    const WeightDatatype* const __restrict__ weightRegister1Ptr{operands.weightRegister1Ptr};
+    const std::uint8_t* const __restrict__ weightRegisterReadSelectBitPtr{
+                                                    operands.weightRegisterReadSelectBitPtr};
+    std::uint8_t* const __restrict__ validNextPtr{operands.validNextPtr};
+
+    size_t validCount{0UL};
+    size_t weightZeroCount{0UL};
+
+    for(size_t column = columnBegin; column < columnEnd; ++column)
+    {
+        const std::uint8_t valid = TopRow ? validCurrentPtr[column - 1] :
+                                            static_cast<std::uint8_t>(validCurrentPtr[column - 1] &
+                                                                        validUpperCurrentPtr[column]);
+
+        const WeightDatatype weight = weightRegisterReadSelectBitPtr[column] ?
+                                                        weightRegister1Ptr[column] :
+                                                        weightRegister0Ptr[column];
+
+        validNextPtr[column] = valid;
+
+        validCount += valid;
+        weightZeroCount += valid & static_cast<std::uint8_t>(weight == 0);
+    }
+
+    return SystolicArrayRowCounts{validCount, weightZeroCount};
+}
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype,
+            bool TopRow,
+            size_t FixedColumnEnd>
+SystolicArrayRowCounts computeSystolicArrayRowBaseline(const SystolicArrayRowOperands<WeightDatatype,
+                                                                                        ActivationDatatype,
+                                                                                        SumDatatype>& operands,
+                                                            const size_t columnBegin,
+                                                            const size_t columnEnd)
+{
+    return computeSystolicArrayRow<WeightDatatype,
+                                    ActivationDatatype,
+                                    SumDatatype,
+                                    TopRow,
+                                    FixedColumnEnd>(operands, columnBegin, columnEnd);
+}
+
+#ifdef SYSTOLIC_ARRAY_ROW_KERNELS_X86_DISPATCH
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype,
+            bool TopRow,
+            size_t FixedColumnEnd> __attribute__((target("sse4.2")))
+SystolicArrayRowCounts computeSystolicArrayRowSse42(const SystolicArrayRowOperands<WeightDatatype,
+                                                                                    ActivationDatatype,
+                                                                                    SumDatatype>& operands,
+                                                        const size_t columnBegin,
+                                                        const size_t columnEnd)
+{
+    return computeSystolicArrayRow<WeightDatatype,
+                                    ActivationDatatype,
+                                    SumDatatype,
+                                    TopRow,
+                                    FixedColumnEnd>(operands, columnBegin, columnEnd);
+}
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype,
+            bool TopRow,
+            size_t FixedColumnEnd> __attribute__((target("avx2")))
+SystolicArrayRowCounts computeSystolicArrayRowAvx2(const SystolicArrayRowOperands<WeightDatatype,
+                                                                                    ActivationDatatype,
+                                                                                    SumDatatype>& operands,
+                                                        const size_t columnBegin,
+                                                        const size_t columnEnd)
+{
+    return computeSystolicArrayRow<WeightDatatype,
+                                    ActivationDatatype,
+                                    SumDatatype,
+                                    TopRow,
+                                    FixedColumnEnd>(operands, columnBegin, columnEnd);
+}
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype,
+            bool TopRow,
+            size_t FixedColumnEnd> __attribute__((target("avx512f,avx512bw")))
+SystolicArrayRowCounts computeSystolicArrayRowAvx512(const SystolicArrayRowOperands<WeightDatatype,
+                                                                                    ActivationDatatype,
+                                                                                    SumDatatype>& operands,
+                                                        const size_t columnBegin,
+                                                        const size_t columnEnd)
+{
+    return computeSystolicArrayRow<WeightDatatype,
+                                    ActivationDatatype,
+                                    SumDatatype,
+                                    TopRow,
+                                    FixedColumnEnd>(operands, columnBegin, columnEnd);
+}
+
+#endif
+
+/**
+ * @brief   Get the widest instruction set supported by
+ *          both the build and the CPU running the simulator
+ */
+
+inline RowKernelInstructionSet getRowKernelInstructionSetSupported()
+{
+#ifdef SYSTOLIC_ARRAY_ROW_KERNELS_X86_DISPATCH
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    {
+        return RowKernelInstructionSet::Avx512;
+    }
+
+    if(__builtin_cpu_supports("avx2"))
+    {
+        return RowKernelInstructionSet::Avx2;
+    }
+
+    if(__builtin_cpu_supports("sse4.2"))
+    {
+        return RowKernelInstructionSet::Sse42;
+    }
+#endif
+
+    return RowKernelInstructionSet::Baseline;
+}
+
+/**
+ * @class                       SystolicArrayRowKernel
+ * @brief                       Row kernel selected at runtime for the given instruction set.
+ *                              Instruction sets not available in the build fall back to
+ *                              the baseline kernel.
+ * @tparam WeightDatatype
+ * @tparam ActivationDatatype
+ * @tparam SumDatatype
+ * @tparam TopRow               Selects the top row variant without upper neighbors
+ * @tparam FixedColumnEnd       The array width if known at compile time, otherwise zero
+ */
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype,
+            bool TopRow,
+            size_t FixedColumnEnd = 0UL> class SystolicArrayRowKernel
+{
+
+public:
+
+    using KernelPtr = SystolicArrayRowCounts (*)(const SystolicArrayRowOperands<WeightDatatype,
+                                                                                ActivationDatatype,
+                                                                                SumDatatype>&,
+                                                    const size_t,
+                                                    const size_t);
+
+    explicit SystolicArrayRowKernel(const RowKernelInstructionSet instructionSet):
+                                                            m_kernelPtr{selectKernel(instructionSet)}
+    {
+    }
+
+    SystolicArrayRowCounts operator()(const SystolicArrayRowOperands<WeightDatatype,
+                                                                        ActivationDatatype,
+                                                                        SumDatatype>& operands,
+                                        const size_t columnBegin,
+                                        const size_t columnEnd) const
+    {
+        return m_kernelPtr(operands, columnBegin, columnEnd);
+    }
+
+private:
+
+    static KernelPtr selectKernel(const RowKernelInstructionSet instructionSet)
+    {
+        switch(instructionSet)
+        {
+#ifdef SYSTOLIC_ARRAY_ROW_KERNELS_X86_DISPATCH
+            case RowKernelInstructionSet::Avx512:
+                return &computeSystolicArrayRowAvx512<WeightDatatype,
+                                                        ActivationDatatype,
+                                                        SumDatatype,
+                                                        TopRow,
+                                                        FixedColumnEnd>;
+
+            case RowKernelInstructionSet::Avx2:
+                return &computeSystolicArrayRowAvx2<WeightDatatype,
+                                                        ActivationDatatype,
+                                                        SumDatatype,
+                                                        TopRow,
+                                                        FixedColumnEnd>;
+
+            case RowKernelInstructionSet::Sse42:
+                return &computeSystolicArrayRowSse42<WeightDatatype,
+                                                        ActivationDatatype,
+                                                        SumDatatype,
+                                                        TopRow,
+                                                        FixedColumnEnd>;
+#endif
+
+            default:
+                return &computeSystolicArrayRowBaseline<WeightDatatype,
+                                                        ActivationDatatype,
+                                                        SumDatatype,
+                                                        TopRow,
+                                                        FixedColumnEnd>;
+        }
+    }
+
+    KernelPtr m_kernelPtr;
+
+};
+
+#endif
@@ -0,0 +1,826 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        systolic_array_structure_of_arrays.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef SYSTOLIC_ARRAY_STRUCTURE_OF_ARRAYS_H
+#define SYSTOLIC_ARRAY_STRUCTURE_OF_ARRAYS_H
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+
+#include "systolic_array.h"
+#include "activation_fifo.h"
+#include "clocked_register_array.h"
+#include "systolic_array_row_kernels.h"
+
+/**
+ * @struct  ActiveColumnRange
+ * @brief   Half-open range [begin, end) of the columns of a systolic
+ *          array row containing all PEs whose signal is set in a signal
+ *          plane. All signals of the row outside of the range are cleared.
+ *          An empty range is represented by begin == end == 0.
+ */
+
+struct ActiveColumnRange
+{
+
+    ActiveColumnRange() = default;
+
+    ActiveColumnRange(const size_t begin,
+                        const size_t end): begin{begin},
+                                            end{end}
+    {
+    }
+
+    size_t begin{0UL};
+    size_t end{0UL};
+
+    bool empty() const
+    {
+        return begin >= end;
+    }
+};
+
+/**
+ * @class                       SystolicArrayStructureOfArrays
+ * @brief                       Systolic array engine keeping the registers of all PEs in
+ *                              contiguous row-major planes of width*height elements instead
+ *                              of individual PE objects. The PEs of a row are stepped by a
+ *                              branchless vectorized row kernel, compiled for several x86
+ *                              instruction sets and selected at runtime, without virtual
+ *                              dispatch or neighbor pointer chasing. All clocked planes are double buffered, so the
+ *                              state update at the end of a cycle only swaps buffers.
+ *                              As a PE can only receive a valid or update weight signal
+ *                              if its left or upper neighbor held it in the previous cycle,
+ *                              the signals travel through the array as diagonal wavefronts.
+ *                              For both signal planes, the engine tracks the range of columns
+ *                              holding the signal in each row, and only computes and commits
+ *                              the PEs the wavefront can reach in the next cycle. PEs outside
+ *                              of the wavefronts are skipped during fill, drain and for
+ *                              matrices smaller than the array.
+ *                              The PE behavior, and therefore the results and all
+ *                              execution metrics, are identical to those of
+ *                              SystolicArrayProcessingElements.
+ *                              The engine can be specialized for a fixed geometry known
+ *                              at compile time. The planes are then held in std::arrays
+ *                              and all loops over the rows and columns of the array have
+ *                              constant trip counts, so that the row kernels step complete
+ *                              rows without remainder handling.
+ * @tparam WeightDatatype       
+ * @tparam ActivationDatatype   
+ * @tparam SumDatatype          
+ * @tparam FixedWidth           The width of the array if fixed at compile time, otherwise zero
+ * @tparam FixedHeight          The height of the array if fixed at compile time, otherwise zero
+ */
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype,
+            size_t FixedWidth = 0UL,
+            size_t FixedHeight = 0UL> class SystolicArrayStructureOfArrays: public SystolicArray<WeightDatatype,
+                                                                                                    ActivationDatatype,
+                                                                                                    SumDatatype>
+{
+
+public:
+    
+    /**
+     * @brief
+     * @param width
+     * @param height
+     * @param activationFifoDepth
+     */
+
+    SystolicArrayStructureOfArrays(const size_t width,
+                                    const size_t height,
+                                    const size_t activationFifoDepth):
+                                                SystolicArray<WeightDatatype,
+                                                                ActivationDatatype,
+                                                                SumDatatype>::SystolicArray(width,
+                                                                                            height,
+                                                                                            activationFifoDepth),
+                                                m_sumArray(width*height),
+                                                m_activationArray(width*height),
+                                                m_validSignalArray(width*height),
+                                                m_updateWeightSignalArray(width*height),
+                                                m_validColumnRangeArray(height),
+                                                m_updateWeightColumnRangeArray(height),
+                                                m_fifoInputEnabledArray(height),
+                                                m_rowKernelInstructionSet{getRowKernelInstructionSetSupported()},
+                                                m_topRowKernel(m_rowKernelInstructionSet),
+                                                m_centerRowKernel(m_rowKernelInstructionSet)
+    {
+        static_assert((FixedWidth == 0UL) == (FixedHeight == 0UL),
+                        "Either both or none of the array dimensions have to be fixed");
+
+        if(FixedWidth && ((width != FixedWidth) || (height != FixedHeight)))
+        {
+            throw MpuException("Systolic array dimensions differ from the fixed geometry");
+        }
+
+        RegisterStorage<WeightDatatype, PlaneSize>::resize(m_weightRegister0Array, width*height);
+        RegisterStorage<WeightDatatype, PlaneSize>::resize(m_weightRegister1Array, width*height);
+        RegisterStorage<std::uint8_t, PlaneSize>::resize(m_weightRegisterReadSelectBitArray, width*height);
+    }
+
+    RowKernelInstructionSet getRowKernelInstructionSet() const
+    {
+        return m_rowKernelInstructionSet;
+    }
+
+    void storeWeight(const PEPosition& position,
+                            const WeightDatatype value) final
+    {
+        const size_t index{position.y*planeWidth() + position.x};
+
+        if(m_weightRegisterReadSelectBitArray[index])
+        {
+            m_weightRegister0Array[index] = value;
+        }
+
+        else
+        {
+            m_weightRegister1Array[index] = value;
+        }
+    }
+
+    /**
+     * @brief   Store the weights of a diagonal of PEs directly to the weight
+     *          register planes. Consecutive PEs of a diagonal are width - 1
+     *          elements apart in the planes.
+     */
+
+    void storeWeightDiagonal(const size_t diagonal,
+                                const size_t rowStart,
+                                const size_t rowActiveStart,
+                                const size_t rowActiveEnd,
+                                const size_t rowEnd,
+                                const WeightDatatype* weightPtr,
+                                const size_t weightStride) final
+    {
+        const size_t indexStride{planeWidth() - 1UL};
+
+        const std::uint8_t* const readSelectBitPtr{m_weightRegisterReadSelectBitArray.data()};
+
+        WeightDatatype* const weightRegisterPtrArray[2]{m_weightRegister1Array.data(),
+                                                            m_weightRegister0Array.data()};
+
+        size_t index{rowStart*planeWidth() + diagonal - rowStart};
+
+        for(size_t rowCount{rowStart}; rowCount < rowActiveStart; ++rowCount)
+        {
+            weightRegisterPtrArray[readSelectBitPtr[index]][index] = WeightDatatype(0);
+            index += indexStride;
+        }
+
+        for(size_t rowCount{rowActiveStart}; rowCount < rowActiveEnd; ++rowCount)
+        {
+            weightRegisterPtrArray[readSelectBitPtr[index]][index] = *weightPtr;
+            weightPtr += weightStride;
+            index += indexStride;
+        }
+
+        for(size_t rowCount{rowActiveEnd}; rowCount < rowEnd; ++rowCount)
+        {
+            weightRegisterPtrArray[readSelectBitPtr[index]][index] = WeightDatatype(0);
+            index += indexStride;
+        }
+    }
+    
+    /**
+     * @brief               
+     * @param updateWeights 
+     */
+
+    void setUpdateWeightsSignal(const bool updateWeights) final
+    {
+        m_updateWeightSignalUpperLeftNext = updateWeights;
+    }
+
+    /**
+     * @brief   Propagate the update weight signals. The left border
+     *          PEs read the signal of their upper neighbor, the top
+     *          border PEs the signal of their left neighbor, and the
+     *          center PEs the conjunction of both. Only the PEs of
+     *          each row the update weight wavefront can reach are
+     *          computed. The signal of the upper left PE is set by
+     *          setUpdateWeightsSignal() and committed together with
+     *          the weight register read select bit toggles in
+     *          updateProcessingElementStates().
+     */
+    
+    void readUpdateWeightSignals() final
+    {
+        const size_t width{planeWidth()};
+
+        const std::uint8_t* const updateWeightCurrentPtr{
+                                    m_updateWeightSignalArray.current().data()};
+
+        std::uint8_t* const updateWeightNextPtr{
+                                    m_updateWeightSignalArray.next().data()};
+
+        const ActiveColumnRange* const rangeCurrentPtr{
+                                    m_updateWeightColumnRangeArray.current().data()};
+
+        ActiveColumnRange* const rangeNextPtr{
+                                    m_updateWeightColumnRangeArray.next().data()};
+
+        for(size_t rowCount{0}; rowCount < planeHeight(); ++rowCount)
+        {
+            const size_t rowOffset{rowCount*width};
+
+            const ActiveColumnRange rangeRow{rangeCurrentPtr[rowCount]};
+
+            ActiveColumnRange rangeWritten;
+
+            if(rowCount == 0)
+            {
+                rangeWritten = reachableColumns(rangeRow, ActiveColumnRange{0UL, width});
+            }
+
+            else
+            {
+                const ActiveColumnRange rangeUpper{rangeCurrentPtr[rowCount - 1]};
+
+                rangeWritten = reachableColumns(rangeRow, rangeUpper);
+
+                if(!rangeUpper.empty() && (rangeUpper.begin == 0))
+                {
+                    rangeWritten.begin = 0UL;
+                    rangeWritten.end = std::max(rangeWritten.end, 1UL);
+                }
+            }
+
+            clearOutsideOfRange(updateWeightNextPtr + rowOffset,
+                                    rangeNextPtr[rowCount], rangeWritten);
+
+            ActiveColumnRange rangeNext;
+
+            for(size_t columnCount{rangeWritten.begin};
+                                columnCount < rangeWritten.end; ++columnCount)
+            {
+                const size_t index{rowOffset + columnCount};
+
+                std::uint8_t updateWeight;
+
+                if(rowCount == 0)
+                {
+                    updateWeight = updateWeightCurrentPtr[index - 1];
+                }
+
+                else if(columnCount == 0)
+                {
+                    updateWeight = updateWeightCurrentPtr[index - width];
+                }
+
+                else
+                {
+                    updateWeight = updateWeightCurrentPtr[index - 1] &
+                                    updateWeightCurrentPtr[index - width];
+                }
+
+                updateWeightNextPtr[index] = updateWeight;
+
+                if(updateWeight)
+                {
+                    extendRange(rangeNext, columnCount);
+                }
+            }
+
+            rangeNextPtr[rowCount] = rangeNext;
+        }
+    }
+
+    /**
+     * @brief           Get the partial sum register value of the PE
+     *                  in the given column of the bottom row. The
+     *                  value is only defined while the valid signal
+     *                  of the PE is set.
+     * @param column    The column of the PE
+     */
+
+    SumDatatype getBottomRowSum(const size_t column) const final
+    {
+        return m_sumArray.current()[(planeHeight() - 1)*planeWidth() + column];
+    }
+
+    bool bottomRowHasValidSignal(const size_t column) const final
+    {
+        return m_validSignalArray.current()[(planeHeight() - 1)*planeWidth() + column];
+    }
+
+    bool bottomRowHasUpdateWeightSignal(const size_t column) const final
+    {
+        return m_updateWeightSignalArray.current()[(planeHeight() - 1)*planeWidth() + column];
+    }
+
+protected:
+
+    bool fifoInputEnabled(const size_t row) const final
+    {
+        return m_fifoInputEnabledArray.current()[row];
+    }
+
+    void enableFifoInput(const size_t row,
+                            const bool enabled) final
+    {
+        m_fifoInputEnabledArray.next()[row] = enabled;
+    }
+
+    bool hasSteadyStateSignals() const final
+    {
+        if(m_updateWeightSignalUpperLeftNext)
+        {
+            return false;
+        }
+
+        for(size_t rowCount{0}; rowCount < planeHeight(); ++rowCount)
+        {
+            if(!m_fifoInputEnabledArray.current()[rowCount] ||
+                    !m_updateWeightColumnRangeArray.current()[rowCount].empty())
+            {
+                return false;
+            }
+        }
+
+        const typename SignalPlane::Storage& validCurrent{m_validSignalArray.current()};
+
+        return std::all_of(validCurrent.begin(), validCurrent.end(),
+                                [](const std::uint8_t valid){return valid != 0;});
+    }
+
+    void readProcessingElementRegisters(std::vector<WeightDatatype>& weightArray,
+                                            std::vector<ActivationDatatype>& activationArray,
+                                            std::vector<SumDatatype>& sumArray) const final
+    {
+        weightArray.resize(planeWidth()*planeHeight());
+
+        for(size_t index{0}; index < weightArray.size(); ++index)
+        {
+            weightArray[index] = loadWeight(index);
+        }
+
+        activationArray.assign(m_activationArray.current().begin(),
+                                m_activationArray.current().end());
+
+        sumArray.assign(m_sumArray.current().begin(),
+                            m_sumArray.current().end());
+    }
+
+    /**
+     * @brief   Write the activation and partial sum planes. As all
+     *          elements are written, the planes are committed by
+     *          swapping buffers like in a regular iteration.
+     */
+
+    void writeProcessingElementRegisters(const std::vector<ActivationDatatype>& activationArray,
+                                            const std::vector<SumDatatype>& sumArray) final
+    {
+        std::copy(activationArray.begin(), activationArray.end(),
+                                                m_activationArray.next().begin());
+
+        std::copy(sumArray.begin(), sumArray.end(),
+                                                m_sumArray.next().begin());
+
+        m_activationArray.update();
+        m_sumArray.update();
+    }
+
+    /**
+     * @brief   Mark the planes written by the workers as written
+     *          in this iteration, as next() must not be called
+     *          concurrently
+     */
+
+    void prepareComputeRows() final
+    {
+        m_sumNextPtr = m_sumArray.next().data();
+        m_activationNextPtr = m_activationArray.next().data();
+        m_validNextPtr = m_validSignalArray.next().data();
+        m_validRangeNextPtr = m_validColumnRangeArray.next().data();
+    }
+
+    /**
+     * @brief   Compute the next state of all PEs in the rows the valid
+     *          signal wavefront can reach. The valid signal plane is
+     *          written for these PEs, the partial sum and activation
+     *          planes only for PEs receiving valid inputs.
+     */
+    
+    void computeRows(const size_t rowBegin,
+                        const size_t rowEnd,
+                        SystolicArrayCounters& counters) final
+    {
+        for(size_t rowCount{rowBegin}; rowCount < rowEnd; ++rowCount)
+        {
+            computeRow(rowCount, m_sumNextPtr,
+                            m_activationNextPtr,
+                            m_validNextPtr,
+                            m_validRangeNextPtr,
+                            counters);
+        }
+    }
+
+    /**
+     * @brief   Commit the next state of all PEs by swapping the
+     *          double buffered planes. In cycles without computation
+     *          or update weight signal propagation, the signals still
+     *          set in the next state buffers are cleared explicitly.
+     *          The weight register read select bits of the PEs
+     *          receiving an update weight signal are toggled.
+     */
+    
+    void updateProcessingElementStates() final
+    {
+        if(!m_validSignalArray.nextWritten())
+        {
+            clearNextSignals(m_validSignalArray,
+                                m_validColumnRangeArray);
+        }
+
+        if(!m_updateWeightSignalArray.nextWritten())
+        {
+            clearNextSignals(m_updateWeightSignalArray,
+                                m_updateWeightColumnRangeArray);
+        }
+
+        std::uint8_t* const updateWeightNextPtr{
+                                    m_updateWeightSignalArray.next().data()};
+
+        typename RangeArray::Storage& updateWeightRangeNext{
+                                    m_updateWeightColumnRangeArray.next()};
+
+        updateWeightNextPtr[0] = m_updateWeightSignalUpperLeftNext;
+
+        if(m_updateWeightSignalUpperLeftNext)
+        {
+            updateWeightRangeNext[0].begin = 0UL;
+            updateWeightRangeNext[0].end = std::max(updateWeightRangeNext[0].end, 1UL);
+        }
+
+        m_updateWeightSignalUpperLeftNext = false;
+
+        for(size_t rowCount{0}; rowCount < planeHeight(); ++rowCount)
+        {
+            const size_t rowOffset{rowCount*planeWidth()};
+
+            for(size_t index{rowOffset + updateWeightRangeNext[rowCount].begin};
+                        index < rowOffset + updateWeightRangeNext[rowCount].end; ++index)
+            {
+                m_weightRegisterReadSelectBitArray[index] ^=
+                                        updateWeightNextPtr[index];
+            }
+        }
+
+        m_sumArray.update();
+        m_activationArray.update();
+        m_validSignalArray.update();
+        m_updateWeightSignalArray.update();
+        m_validColumnRangeArray.update();
+        m_updateWeightColumnRangeArray.update();
+        m_fifoInputEnabledArray.update();
+    }
+
+private:
+
+    static constexpr size_t PlaneSize{FixedWidth*FixedHeight};
+
+    using SignalPlane = ClockedRegisterArray<std::uint8_t, PlaneSize>;
+    using RangeArray = ClockedRegisterArray<ActiveColumnRange, FixedHeight>;
+
+    /**
+     * @brief   Get the width of the array, a compile
+     *          time constant for fixed geometries
+     */
+
+    size_t planeWidth() const
+    {
+        return FixedWidth ? FixedWidth : this->m_width;
+    }
+
+    /**
+     * @brief   Get the height of the array, a compile
+     *          time constant for fixed geometries
+     */
+
+    size_t planeHeight() const
+    {
+        return FixedHeight ? FixedHeight : this->m_height;
+    }
+
+    /**
+     * @brief               Get the range of columns of a row a signal wavefront
+     *                      can reach from the left neighbors in the same row and
+     *                      the upper neighbors in the row above. The left border
+     *                      column is not included.
+     * @param rangeRow      The signal column range of the row
+     * @param rangeUpper    The signal column range of the row above
+     */
+
+    ActiveColumnRange reachableColumns(const ActiveColumnRange& rangeRow,
+                                        const ActiveColumnRange& rangeUpper) const
+    {
+        if(rangeRow.empty() || rangeUpper.empty())
+        {
+            return ActiveColumnRange{};
+        }
+
+        const size_t begin{std::max(rangeRow.begin + 1, std::max(rangeUpper.begin, 1UL))};
+        const size_t end{std::min(rangeRow.end + 1, std::min(rangeUpper.end, planeWidth()))};
+
+        return (begin < end) ? ActiveColumnRange{begin, end} :
+                                ActiveColumnRange{};
+    }
+
+    static void extendRange(ActiveColumnRange& range,
+                                const size_t column)
+    {
+        if(range.empty())
+        {
+            range.begin = column;
+        }
+
+        range.end = column + 1;
+    }
+
+    /**
+     * @brief               Clear the signals of a row in a next state buffer
+     *                      set two cycles before that are not rewritten in the
+     *                      current cycle
+     * @param rowPtr        The row in the next state buffer
+     * @param rangeStale    The signal column range of the row in the buffer
+     * @param rangeWritten  The columns written in the current cycle
+     */
+
+    static void clearOutsideOfRange(std::uint8_t* const rowPtr,
+                                        const ActiveColumnRange& rangeStale,
+                                        const ActiveColumnRange& rangeWritten)
+    {
+        if(rangeWritten.empty())
+        {
+            std::fill(rowPtr + rangeStale.begin, rowPtr + rangeStale.end, 0);
+            return;
+        }
+
+        std::fill(rowPtr + rangeStale.begin,
+                    rowPtr + std::max(rangeStale.begin,
+                                        std::min(rangeStale.end, rangeWritten.begin)), 0);
+
+        std::fill(rowPtr + std::min(rangeStale.end,
+                                        std::max(rangeStale.begin, rangeWritten.end)),
+                    rowPtr + rangeStale.end, 0);
+    }
+
+    /**
+     * @brief               Clear all signals of a signal plane in the
+     *                      next state in a cycle it was not computed in
+     * @param signalArray   The signal plane
+     * @param rangeArray    The signal column ranges of the plane
+     */
+
+    void clearNextSignals(SignalPlane& signalArray,
+                            RangeArray& rangeArray)
+    {
+        std::uint8_t* const signalNextPtr{signalArray.next().data()};
+        ActiveColumnRange* const rangeNextPtr{rangeArray.next().data()};
+
+        for(size_t rowCount{0}; rowCount < planeHeight(); ++rowCount)
+        {
+            clearOutsideOfRange(signalNextPtr + rowCount*planeWidth(),
+                                    rangeNextPtr[rowCount], ActiveColumnRange{});
+
+            rangeNextPtr[rowCount] = ActiveColumnRange{};
+        }
+    }
+
+    WeightDatatype loadWeight(const size_t index) const
+    {
+        return m_weightRegisterReadSelectBitArray[index] ?
+                                            m_weightRegister1Array[index] :
+                                            m_weightRegister0Array[index];
+    }
+
+    /**
+     * @brief                   Compute the next state of the PEs in a row
+     *                          the valid signal wavefront can reach
+     * @param row               The row
+     * @param sumNextPtr        The next state partial sum plane
+     * @param activationNextPtr The next state activation plane
+     * @param validNextPtr      The next state valid signal plane
+     * @param validRangeNextPtr The next state valid signal column ranges
+     * @param counters          The counters of the calling worker
+     */
+
+    void computeRow(const size_t row,
+                        SumDatatype* const sumNextPtr,
+                        ActivationDatatype* const activationNextPtr,
+                        std::uint8_t* const validNextPtr,
+                        ActiveColumnRange* const validRangeNextPtr,
+                        SystolicArrayCounters& counters)
+    {
+        const size_t width{planeWidth()};
+        const size_t rowOffset{row*width};
+
+        const SumDatatype* const sumCurrentPtr{m_sumArray.current().data()};
+        const ActivationDatatype* const activationCurrentPtr{m_activationArray.current().data()};
+        const std::uint8_t* const validCurrentPtr{m_validSignalArray.current().data()};
+        const ActiveColumnRange* const validRangeCurrentPtr{m_validColumnRangeArray.current().data()};
+
+        size_t intraPeDataMovements{0UL};
+        size_t interPeDataMovements{0UL};
+        size_t weightZeroCount{0UL};
+
+        const bool validLeftBorder{m_fifoInputEnabledArray.current()[row] &&
+                                    ((row == 0) || validCurrentPtr[rowOffset - width])};
+
+        ActiveColumnRange rangeWritten{reachableColumns(validRangeCurrentPtr[row],
+                                                            (row == 0) ? ActiveColumnRange{0UL, width} :
+                                                                            validRangeCurrentPtr[row - 1])};
+
+        if(validLeftBorder)
+        {
+            rangeWritten.begin = 0UL;
+            rangeWritten.end = std::max(rangeWritten.end, 1UL);
+        }
+
+        clearOutsideOfRange(validNextPtr + rowOffset,
+                                validRangeNextPtr[row], rangeWritten);
+
+        ActiveColumnRange rangeNext;
+
+        if(validLeftBorder)
+        {
+            validNextPtr[rowOffset] = true;
+
+            extendRange(rangeNext, 0UL);
+
+            const ActivationDatatype activation{
+                                this->m_activationFifoArray[row].pop()};
+
+            const WeightDatatype weight{loadWeight(rowOffset)};
+
+            intraPeDataMovements += 3UL;
+            interPeDataMovements += (row != 0) ? 2UL : 1UL;
+
+            if(this->m_functionalSimulation)
+            {
+                SumDatatype sum = activation*weight;
+
+                if(row != 0)
+                {
+                    sum += sumCurrentPtr[rowOffset - width];
+                }
+
+                activationNextPtr[rowOffset] = activation;
+                sumNextPtr[rowOffset] = sum;
+            }
+
+            if(!weight)
+            {
+                ++weightZeroCount;
+            }
+        }
+
+        const size_t columnBegin{std::max(rangeWritten.begin, 1UL)};
+
+        const SystolicArrayRowOperands<WeightDatatype,
+                                        ActivationDatatype,
+                                        SumDatatype> operands{activationCurrentPtr + rowOffset,
+                                                                validCurrentPtr + rowOffset,
+                                                                (row == 0) ? nullptr :
+                                                                    sumCurrentPtr + rowOffset - width,
+                                                                (row == 0) ? nullptr :
+                                                                    validCurrentPtr + rowOffset - width,
+                                                                m_weightRegister0Array.data() + rowOffset,
+                                                                m_weightRegister1Array.data() + rowOffset,
+                                                                m_weightRegisterReadSelectBitArray.data() +
+                                                                                                rowOffset,
+                                                                activationNextPtr + rowOffset,
+                                                                sumNextPtr + rowOffset,
+                                                                validNextPtr + rowOffset};
+
+        SystolicArrayRowCounts rowCounts;
+
+        if(!this->m_functionalSimulation)
+        {
+            rowCounts = (row == 0) ? computeSystolicArrayRowSignals<WeightDatatype,
+                                                                    ActivationDatatype,
+                                                                    SumDatatype, true>(operands, columnBegin,
+                                                                                        rangeWritten.end) :
+                                        computeSystolicArrayRowSignals<WeightDatatype,
+                                                                        ActivationDatatype,
+                                                                        SumDatatype, false>(operands, columnBegin,
+                                                                                            rangeWritten.end);
+        }
+
+        else
+        {
+            rowCounts = (row == 0) ? m_topRowKernel(operands, columnBegin,
+                                                        rangeWritten.end) :
+                                        m_centerRowKernel(operands, columnBegin,
+                                                            rangeWritten.end);
+        }
+
+        if(rowCounts.validCount)
+        {
+            /* The kernel does not track the column range of the
+             * valid signals, it is determined from the outermost
+             * valid signals written */
+
+            size_t columnFirstValid{columnBegin};
+
+            while(!validNextPtr[rowOffset + columnFirstValid])
+            {
+                ++columnFirstValid;
+            }
+
+            size_t columnLastValid{rangeWritten.end - 1};
+
+            while(!validNextPtr[rowOffset + columnLastValid])
+            {
+                --columnLastValid;
+            }
+
+            extendRange(rangeNext, columnFirstValid);
+            extendRange(rangeNext, columnLastValid);
+        }
+
+        intraPeDataMovements += 3UL*rowCounts.validCount;
+        interPeDataMovements += ((row == 0) ? 1UL : 2UL)*rowCounts.validCount;
+        weightZeroCount += rowCounts.weightZeroCount;
+
+        validRangeNextPtr[row] = rangeNext;
+
+        counters.intraPeDataMovements += intraPeDataMovements;
+        counters.interPeDataMovements += interPeDataMovements;
+        counters.multiplicationsWithWeightZeroCount += weightZeroCount;
+    }
+
+    typename RegisterStorage<WeightDatatype, PlaneSize>::Type m_weightRegister0Array;
+    typename RegisterStorage<WeightDatatype, PlaneSize>::Type m_weightRegister1Array;
+
+    /* Only toggled for PEs receiving an update weight
+     * signal when committing a cycle, so it does not
+     * need to be double buffered */
+
+    typename RegisterStorage<std::uint8_t, PlaneSize>::Type m_weightRegisterReadSelectBitArray;
+
+    ClockedRegisterArray<SumDatatype, PlaneSize> m_sumArray;
+    ClockedRegisterArray<ActivationDatatype, PlaneSize> m_activationArray;
+
+    SignalPlane m_validSignalArray;
+    SignalPlane m_updateWeightSignalArray;
+
+    RangeArray m_validColumnRangeArray;
+    RangeArray m_updateWeightColumnRangeArray;
+
+    ClockedRegisterArray<std::uint8_t, FixedHeight> m_fifoInputEnabledArray;
+
+    bool m_updateWeightSignalUpperLeftNext{false};
+
+    SumDatatype* m_sumNextPtr{nullptr};
+    ActivationDatatype* m_activationNextPtr{nullptr};
+    std::uint8_t* m_validNextPtr{nullptr};
+    ActiveColumnRange* m_validRangeNextPtr{nullptr};
+
+    const RowKernelInstructionSet m_rowKernelInstructionSet;
+
+    const SystolicArrayRowKernel<WeightDatatype,
+                                    ActivationDatatype,
+                                    SumDatatype, true,
+                                    FixedWidth> m_topRowKernel;
+
+    const SystolicArrayRowKernel<WeightDatatype,
+                                    ActivationDatatype,
+                                    SumDatatype, false,
+                                    FixedWidth> m_centerRowKernel;
+
+};
+
+#endif
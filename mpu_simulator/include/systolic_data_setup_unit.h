@@ -30,10 +30,13 @@
 #define SYSTOLIC_DATA_SETUP_UNIT_H
 
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <cstdint>
 
 #include "activation_fifo.h"
+#include "clocked_register_array.h"
 
 //#define SYSTOLIC_DATA_SETUP_UNIT_DEBUG SYSTOLIC_DATA_SETUP_UNIT_DEBUG
 
@@ -62,22 +65,14 @@ public:
     SystolicDataSetupUnit(std::vector<ActivationFifo<Datatype>>* const activationFifoArrayPtr):
                                                                             m_activationFifoArrayPtr{activationFifoArrayPtr},
                                                                             m_activationFifoArraySize{m_activationFifoArrayPtr->size()},
-                                                                            m_rowPtrArray0Current(m_activationFifoArraySize),
-                                                                            m_rowPtrArray0Next(m_activationFifoArraySize),
-                                                                            m_rowPtrArray1Current(m_activationFifoArraySize),
-                                                                            m_rowPtrArray1Next(m_activationFifoArraySize),
-                                                                            m_blockPtrArray0Current(m_activationFifoArraySize),
-                                                                            m_blockPtrArray0Next(m_activationFifoArraySize),
-                                                                            m_blockPtrArray1Current(m_activationFifoArraySize),
-                                                                            m_blockPtrArray1Next(m_activationFifoArraySize),
-                                                                            m_matrixReadRepetitionCountArray0Current(m_activationFifoArraySize),
-                                                                            m_matrixReadRepetitionCountArray0Next(m_activationFifoArraySize),
-                                                                            m_matrixReadRepetitionCountArray1Current(m_activationFifoArraySize),
-                                                                            m_matrixReadRepetitionCountArray1Next(m_activationFifoArraySize),
-                                                                            m_busyArray0Current(m_activationFifoArraySize),
-                                                                            m_busyArray0Next(m_activationFifoArraySize),
-                                                                            m_busyArray1Current(m_activationFifoArraySize),
-                                                                            m_busyArray1Next(m_activationFifoArraySize)
+                                                                            m_rowPtrArray0(m_activationFifoArraySize),
+                                                                            m_rowPtrArray1(m_activationFifoArraySize),
+                                                                            m_blockPtrArray0(m_activationFifoArraySize),
+                                                                            m_blockPtrArray1(m_activationFifoArraySize),
+                                                                            m_matrixReadRepetitionCountArray0(m_activationFifoArraySize),
+                                                                            m_matrixReadRepetitionCountArray1(m_activationFifoArraySize),
+                                                                            m_busyArray0(m_activationFifoArraySize),
+                                                                            m_busyArray1(m_activationFifoArraySize)
     {
     }
 
@@ -152,20 +147,14 @@ public:
          * also have to be duplicated to allow for
          * simultaneous reading of two arrays. The row
          * pointer counters are modelled by
-         * m_rowPtrArray0Current, m_rowPtrArray0Next,
-         * m_rowPtrArray1Current, and m_rowPtrArray1Next.
+         * m_rowPtrArray0 and m_rowPtrArray1.
          * The block counter registers are modelled by
-         * m_blockPtrArray0Current, m_blockPtrArray0Next,
-         * m_blockPtrArray1Current and
-         * m_blockPtrArray1Next.
+         * m_blockPtrArray0 and m_blockPtrArray1.
          * The read repetition counters are modelled by
-         * m_matrixReadRepetitionCountArray0Current,
-         * m_matrixReadRepetitionCountArray0Next,
-         * m_matrixReadRepetitionCountArray1Current, and
-         * m_matrixReadRepetitionCountArray1 next.
+         * m_matrixReadRepetitionCountArray0 and
+         * m_matrixReadRepetitionCountArray1.
          * The busy flag bits are modelled by
-         * m_busyArray0Current, m_busyArray0Next,
-         * m_busyArray1Current, and m_busyArray1Next.
+         * m_busyArray0 and m_busyArray1.
          * The minimum bitwidths for these registers are
          * calculated using the maximum value they assume
          * during execution. These maximum values can be
@@ -289,11 +278,7 @@ public:
 
                 m_matrix0ReadBusyNext = true;
 
-                for(size_t elementCount = 0; elementCount < m_activationFifoArraySize;
-                                                                            ++elementCount)
-                {
-                    m_busyArray0Next.at(elementCount) = true;
-                }
+                m_busyArray0.fillNext(true);
 
 #ifdef SYSTOLIC_DATA_SETUP_UNIT_DEBUG
                 std::cout << "Set input for matrix 0" << std::endl;
@@ -343,11 +328,7 @@ public:
 
                 m_matrix1ReadBusyNext = true;
 
-                for(size_t elementCount = 0; elementCount < m_activationFifoArraySize;
-                                                                            ++elementCount)
-                {
-                    m_busyArray1Next.at(elementCount) = true;
-                }
+                m_busyArray1.fillNext(true);
 
 #ifdef SYSTOLIC_DATA_SETUP_UNIT_DEBUG
                 std::cout << "Set input for matrix 1" << std::endl;
@@ -356,28 +337,177 @@ public:
         }
     }
 
-    void resetCounters(const bool matrixSelectBit)
+    /**
+     * @brief                       Update the maximum register values and the load count
+     *                              as if the given matrix was added using addInputMatrix()
+     *                              and read completely, without reading it. Used by the
+     *                              analytical simulation mode of the MPU.
+     * @param matrixWidth           The width of the matrix
+     * @param matrixHeight          The height of the matrix
+     * @param matrixReadRepetitions The number of times the matrix is read
+     * @param matrixSelectBit       The matrix register set the matrix is stored to
+     */
+
+    void addInputMatrixMetrics(const size_t matrixWidth,
+                                    const size_t matrixHeight,
+                                    const size_t matrixReadRepetitions,
+                                    const bool matrixSelectBit)
     {
-        if(matrixSelectBit == ::matrix0)
+        const size_t blocks = std::ceil(static_cast<float>(matrixWidth)/
+                                            static_cast<float>(m_activationFifoArraySize));
+
+        m_matrixWidthMax = std::max(m_matrixWidthMax, matrixWidth);
+        m_matrixHeightMax = std::max(m_matrixHeightMax, matrixHeight);
+        m_blocksMax = std::max(m_blocksMax, blocks);
+        m_idleRowsMax = std::max(m_idleRowsMax, blocks*m_activationFifoArraySize - matrixWidth);
+
+        /* Only the repetition count register of matrix 1
+         * is taken into account by addInputMatrix() */
+
+        if(matrixSelectBit == ::matrix1)
         {
-            for(size_t elementCount{0}; elementCount < m_activationFifoArraySize;
-                                                                        ++elementCount)
+            m_matrixReadRepetitionsMax = std::max(m_matrixReadRepetitionsMax,
+                                                    matrixReadRepetitions);
+        }
+
+        m_loadCount += matrixWidth*matrixHeight*matrixReadRepetitions;
+    }
+
+    /**
+     * @brief   Get the number of iterations the SDSU keeps pushing one row
+     *          of the same matrix block to every activation FIFO in, without
+     *          any row pointer wrapping around. Returns zero if the SDSU is
+     *          not streaming a single matrix to all activation FIFOs.
+     */
+
+    size_t getSteadyStateIterationsMax() const
+    {
+        if(!m_activeCurrent)
+        {
+            return 0UL;
+        }
+
+        const bool matrixSelectBit{getStreamingMatrixSelectBit()};
+
+        const ClockedBitArray& busyArray{(matrixSelectBit == ::matrix0) ?
+                                                        m_busyArray0 : m_busyArray1};
+
+        const std::vector<std::uint32_t>& rowPtrArray{(matrixSelectBit == ::matrix0) ?
+                                                        m_rowPtrArray0.current() :
+                                                        m_rowPtrArray1.current()};
+
+        const size_t matrixHeight{(matrixSelectBit == ::matrix0) ?
+                                                        m_matrix0HeightCurrent :
+                                                        m_matrix1HeightCurrent};
+
+        size_t iterationsMax{matrixHeight};
+
+        for(size_t activationFifoCount{0}; activationFifoCount < m_activationFifoArraySize;
+                                                                            ++activationFifoCount)
+        {
+            if(!busyArray.current(activationFifoCount))
             {
-                m_blockPtrArray0Next.at(elementCount) = 0;
-                m_rowPtrArray0Next.at(elementCount) = 0;
-                m_matrixReadRepetitionCountArray0Next.at(elementCount) = 0;
+                return 0UL;
             }
+
+            /* The row pointer wraps around in the
+             * iteration the last row is pushed in */
+
+            iterationsMax = std::min(iterationsMax, matrixHeight - 1UL -
+                                                        rowPtrArray[activationFifoCount]);
         }
 
-        else
+        return iterationsMax;
+    }
+
+    /**
+     * @brief                   Advance the SDSU by the given number of iterations
+     *                          of steady state operation as determined by
+     *                          getSteadyStateIterationsMax(), without pushing to
+     *                          the activation FIFOs
+     * @param iterations        The number of iterations
+     * @param fifoInputArray    Receives the values pushed to the activation FIFOs,
+     *                          iterations consecutive values per FIFO
+     */
+
+    void streamSteadyState(const size_t iterations,
+                                std::vector<Datatype>& fifoInputArray)
+    {
+        const bool matrixSelectBit{getStreamingMatrixSelectBit()};
+
+        ClockedRegisterArray<std::uint32_t>& rowPtrArray{(matrixSelectBit == ::matrix0) ?
+                                                            m_rowPtrArray0 :
+                                                            m_rowPtrArray1};
+
+        const std::vector<std::uint32_t>& blockPtrArray{(matrixSelectBit == ::matrix0) ?
+                                                            m_blockPtrArray0.current() :
+                                                            m_blockPtrArray1.current()};
+
+        const Datatype* const matrixPtr{(matrixSelectBit == ::matrix0) ?
+                                                    m_matrixPtr0Current : m_matrixPtr1Current};
+
+        const size_t matrixWidth{(matrixSelectBit == ::matrix0) ?
+                                            m_matrix0WidthCurrent : m_matrix1WidthCurrent};
+
+        const size_t blocks{(matrixSelectBit == ::matrix0) ?
+                                            m_blocksArray0Current : m_blocksArray1Current};
+
+        const size_t idleRowsLastBlock{(matrixSelectBit == ::matrix0) ?
+                                                    m_idleRowsLastBlock0Current :
+                                                    m_idleRowsLastBlock1Current};
+
+        fifoInputArray.resize(m_activationFifoArraySize*iterations);
+
+        std::vector<std::uint32_t>& rowPtrArrayNext{rowPtrArray.next()};
+
+        for(size_t activationFifoCount{0}; activationFifoCount < m_activationFifoArraySize;
+                                                                            ++activationFifoCount)
         {
-            for(size_t elementCount{0}; elementCount < m_activationFifoArraySize;
-                                                                        ++elementCount)
+            const size_t rowPtr{rowPtrArray.current()[activationFifoCount]};
+
+            const size_t idleRows{(blockPtrArray[activationFifoCount] !=
+                                                    (blocks - 1)) ? 0UL : idleRowsLastBlock};
+
+            Datatype* const fifoInputPtr{fifoInputArray.data() +
+                                                activationFifoCount*iterations};
+
+            if(activationFifoCount >= idleRows)
             {
-                m_blockPtrArray1Next.at(elementCount) = 0;
-                m_rowPtrArray1Next.at(elementCount) = 0;
-                m_matrixReadRepetitionCountArray1Next.at(elementCount) = 0;
+                const Datatype* const columnPtr{matrixPtr +
+                                                    blockPtrArray[activationFifoCount]*
+                                                    m_activationFifoArraySize +
+                                                    activationFifoCount - idleRows};
+
+                for(size_t iterationCount{0}; iterationCount < iterations; ++iterationCount)
+                {
+                    fifoInputPtr[iterationCount] = columnPtr[(rowPtr + iterationCount)*matrixWidth];
+                }
+
+                m_loadCount += iterations;
             }
+
+            else
+            {
+                std::fill(fifoInputPtr, fifoInputPtr + iterations, Datatype{0});
+            }
+
+            rowPtrArrayNext[activationFifoCount] = static_cast<std::uint32_t>(rowPtr + iterations);
+        }
+
+        rowPtrArray.update();
+    }
+
+    void resetCounters(const bool matrixSelectBit)
+    {
+        for(ClockedRegisterArray<std::uint32_t>* const counterArrayPtr :
+                    {(matrixSelectBit == ::matrix0) ? &m_blockPtrArray0 : &m_blockPtrArray1,
+                        (matrixSelectBit == ::matrix0) ? &m_rowPtrArray0 : &m_rowPtrArray1,
+                        (matrixSelectBit == ::matrix0) ? &m_matrixReadRepetitionCountArray0 :
+                                                            &m_matrixReadRepetitionCountArray1})
+        {
+            std::vector<std::uint32_t>& counterArrayNext{counterArrayPtr->next()};
+
+            std::fill(counterArrayNext.begin(), counterArrayNext.end(), 0U);
         }
     }
 
@@ -389,10 +519,23 @@ public:
     {
         if(m_activeCurrent)
         {
+            /* All per-FIFO counters and busy flags are held as
+             * a whole, counters not advanced in this iteration
+             * keep their current value. */
+
+            m_rowPtrArray0.holdAll();
+            m_rowPtrArray1.holdAll();
+            m_blockPtrArray0.holdAll();
+            m_blockPtrArray1.holdAll();
+            m_matrixReadRepetitionCountArray0.holdAll();
+            m_matrixReadRepetitionCountArray1.holdAll();
+            m_busyArray0.holdAll();
+            m_busyArray1.holdAll();
+
             for(size_t activationFifoCount = 0; activationFifoCount < m_activationFifoArraySize;
                                                                                 ++activationFifoCount)
             {
-                if(!(m_activationFifoArrayPtr->at(activationFifoCount).isFull()))
+                if(!((*m_activationFifoArrayPtr)[activationFifoCount].isFull()))
                 {
                     if(!m_matrix1PrecedentCurrent)
                     {
@@ -420,24 +563,14 @@ public:
                 }
             }
 
-            m_matrix0ReadBusyNext = false;
-
-            for(const bool& element : m_busyArray0Next)
-            {
-                m_matrix0ReadBusyNext |= element;
-            }
+            m_matrix0ReadBusyNext = m_busyArray0.anyNext();
 
             if(!m_matrix0ReadBusyNext)
             {
                 resetCounters(::matrix0);
             }
 
-            m_matrix1ReadBusyNext = false;
-
-            for(const bool& element : m_busyArray1Next)
-            {
-                m_matrix1ReadBusyNext |= element;
-            }
+            m_matrix1ReadBusyNext = m_busyArray1.anyNext();
 
             if(!m_matrix1ReadBusyNext)
             {
@@ -489,30 +622,17 @@ public:
 
     void updateState()
     {
-        for(size_t elementCount{0}; elementCount < m_activationFifoArraySize;
-                                                                    ++elementCount)
-        {
-            m_blockPtrArray0Current.at(elementCount) =
-                                m_blockPtrArray0Next.at(elementCount);
-            m_blockPtrArray1Current.at(elementCount) =
-                                m_blockPtrArray1Next.at(elementCount);
-
-            m_rowPtrArray0Current.at(elementCount) =
-                                m_rowPtrArray0Next.at(elementCount);
-            m_rowPtrArray1Current.at(elementCount) =
-                                m_rowPtrArray1Next.at(elementCount);
-
-            m_busyArray0Current.at(elementCount) =
-                                m_busyArray0Next.at(elementCount);
-            m_busyArray1Current.at(elementCount) =
-                                m_busyArray1Next.at(elementCount);
-
-            m_matrixReadRepetitionCountArray0Current.at(elementCount) =
-                                    m_matrixReadRepetitionCountArray0Next.at(elementCount);
-
-            m_matrixReadRepetitionCountArray1Current.at(elementCount) =
-                                    m_matrixReadRepetitionCountArray1Next.at(elementCount);
-        }
+        m_blockPtrArray0.update();
+        m_blockPtrArray1.update();
+
+        m_rowPtrArray0.update();
+        m_rowPtrArray1.update();
+
+        m_busyArray0.update();
+        m_busyArray1.update();
+
+        m_matrixReadRepetitionCountArray0.update();
+        m_matrixReadRepetitionCountArray1.update();
 
         m_matrixPtr0Current = m_matrixPtr0Next;
         m_matrixPtr1Current = m_matrixPtr1Next;
@@ -551,6 +671,23 @@ public:
 
 private:
     
+    /**
+     * @brief   Get the select bit of the matrix read in the
+     *          current iteration. This is the precedent matrix
+     *          if it is still being read, the other matrix
+     *          otherwise.
+     */
+
+    bool getStreamingMatrixSelectBit() const
+    {
+        const bool precedentMatrixReadBusy{m_matrix1PrecedentCurrent ?
+                                                    m_matrix1ReadBusyCurrent :
+                                                    m_matrix0ReadBusyCurrent};
+
+        return precedentMatrixReadBusy ? m_matrix1PrecedentCurrent :
+                                                !m_matrix1PrecedentCurrent;
+    }
+
     /**
      * @brief                       
      * @param activationFifoCount   
@@ -559,21 +696,19 @@ private:
 
     bool runIterationMatrix0(const size_t activationFifoCount)
     {
-        if(m_busyArray0Current.at(activationFifoCount))
+        if(m_busyArray0.current(activationFifoCount))
         {
 
-            const size_t idleRows{(m_blockPtrArray0Current.at(activationFifoCount) !=
+            const size_t idleRows{(m_blockPtrArray0.current()[activationFifoCount] !=
                                                                 (m_blocksArray0Current - 1)) ? 0UL :
                                                                                                 m_idleRowsLastBlock0Current};
             if(activationFifoCount >= idleRows)
             {
 
-                m_activationFifoArrayPtr->at(activationFifoCount).push(m_matrixPtr0Current[
-                                                                            m_blockPtrArray0Current.at(
-                                                                            activationFifoCount)*
+                (*m_activationFifoArrayPtr)[activationFifoCount].push(m_matrixPtr0Current[
+                                                                            m_blockPtrArray0.current()[activationFifoCount]*
                                                                             m_activationFifoArraySize +
-                                                                            m_rowPtrArray0Current.at(
-                                                                            activationFifoCount)*
+                                                                            m_rowPtrArray0.current()[activationFifoCount]*
                                                                             m_matrix0WidthCurrent +
                                                                             activationFifoCount -
                                                                             idleRows]);
@@ -583,40 +718,40 @@ private:
 
             else
             {
-                m_activationFifoArrayPtr->at(activationFifoCount).push(Datatype{0});
+                (*m_activationFifoArrayPtr)[activationFifoCount].push(Datatype{0});
             }
 
-            if(m_rowPtrArray0Current.at(activationFifoCount) < (m_matrix0HeightCurrent - 1))
+            if(m_rowPtrArray0.current()[activationFifoCount] < (m_matrix0HeightCurrent - 1))
             {
-                m_rowPtrArray0Next.at(activationFifoCount) =
-                                        m_rowPtrArray0Current.at(activationFifoCount) + 1;
+                m_rowPtrArray0.next()[activationFifoCount] =
+                                        m_rowPtrArray0.current()[activationFifoCount] + 1;
             }
 
             else
             {
-                m_rowPtrArray0Next.at(activationFifoCount) = 0;
+                m_rowPtrArray0.next()[activationFifoCount] = 0;
 
-                if(m_blockPtrArray0Current.at(activationFifoCount) <
+                if(m_blockPtrArray0.current()[activationFifoCount] <
                                                     (m_blocksArray0Current - 1))
                 {
-                    m_blockPtrArray0Next.at(activationFifoCount) =
-                                            m_blockPtrArray0Current.at(activationFifoCount) + 1;
+                    m_blockPtrArray0.next()[activationFifoCount] =
+                                            m_blockPtrArray0.current()[activationFifoCount] + 1;
                 }
 
                 else
                 {
-                    if(m_matrixReadRepetitionCountArray0Current.at(activationFifoCount) <
+                    if(m_matrixReadRepetitionCountArray0.current()[activationFifoCount] <
                                                             (m_matrixReadRepetitions0Current - 1))
                     {
-                        m_blockPtrArray0Next.at(activationFifoCount) = 0;
+                        m_blockPtrArray0.next()[activationFifoCount] = 0;
 
-                        m_matrixReadRepetitionCountArray0Next.at(activationFifoCount) =
-                                        m_matrixReadRepetitionCountArray0Current.at(activationFifoCount) + 1;
+                        m_matrixReadRepetitionCountArray0.next()[activationFifoCount] =
+                                        m_matrixReadRepetitionCountArray0.current()[activationFifoCount] + 1;
                     }
 
                     else
                     {
-                        m_busyArray0Next.at(activationFifoCount) = false;
+                        m_busyArray0.setNext(activationFifoCount, false);
                     }
                 }
             }
@@ -638,22 +773,20 @@ private:
 
     bool runIterationMatrix1(const size_t activationFifoCount)
     {
-        if(m_busyArray1Current.at(activationFifoCount))
+        if(m_busyArray1.current(activationFifoCount))
         {
 
-            const size_t idleRows{(m_blockPtrArray1Current.at(activationFifoCount) !=
+            const size_t idleRows{(m_blockPtrArray1.current()[activationFifoCount] !=
                                                                 (m_blocksArray1Current - 1)) ? 0UL :
                                                                                                 m_idleRowsLastBlock1Current};
 
             if(activationFifoCount >= idleRows)
             {
 
-                m_activationFifoArrayPtr->at(activationFifoCount).push(m_matrixPtr1Current[
-                                                                            m_blockPtrArray1Current.at(
-                                                                            activationFifoCount)*
+                (*m_activationFifoArrayPtr)[activationFifoCount].push(m_matrixPtr1Current[
+                                                                            m_blockPtrArray1.current()[activationFifoCount]*
                                                                             m_activationFifoArraySize +
-                                                                            m_rowPtrArray1Current.at(
-                                                                            activationFifoCount)*
+                                                                            m_rowPtrArray1.current()[activationFifoCount]*
                                                                             m_matrix1WidthCurrent +
                                                                             activationFifoCount -
                                                                             idleRows]);
@@ -663,40 +796,40 @@ private:
 
             else
             {
-                m_activationFifoArrayPtr->at(activationFifoCount).push(Datatype{0});
+                (*m_activationFifoArrayPtr)[activationFifoCount].push(Datatype{0});
             }
 
-            if(m_rowPtrArray1Current.at(activationFifoCount) < (m_matrix1HeightCurrent - 1))
+            if(m_rowPtrArray1.current()[activationFifoCount] < (m_matrix1HeightCurrent - 1))
             {
-                m_rowPtrArray1Next.at(activationFifoCount) =
-                                        m_rowPtrArray1Current.at(activationFifoCount) + 1;
+                m_rowPtrArray1.next()[activationFifoCount] =
+                                        m_rowPtrArray1.current()[activationFifoCount] + 1;
             }
 
             else
             {
-                m_rowPtrArray1Next.at(activationFifoCount) = 0;
+                m_rowPtrArray1.next()[activationFifoCount] = 0;
 
-                if(m_blockPtrArray1Current.at(activationFifoCount) <
+                if(m_blockPtrArray1.current()[activationFifoCount] <
                                                     (m_blocksArray1Current - 1))
                 {
-                    m_blockPtrArray1Next.at(activationFifoCount) =
-                                            m_blockPtrArray1Current.at(activationFifoCount) + 1;
+                    m_blockPtrArray1.next()[activationFifoCount] =
+                                            m_blockPtrArray1.current()[activationFifoCount] + 1;
                 }
 
                 else
                 {
-                    if(m_matrixReadRepetitionCountArray1Current.at(activationFifoCount) <
+                    if(m_matrixReadRepetitionCountArray1.current()[activationFifoCount] <
                                                             (m_matrixReadRepetitions1Current - 1))
                     {
-                        m_blockPtrArray1Next.at(activationFifoCount) = 0;
+                        m_blockPtrArray1.next()[activationFifoCount] = 0;
 
-                        m_matrixReadRepetitionCountArray1Next.at(activationFifoCount) =
-                                        m_matrixReadRepetitionCountArray1Current.at(activationFifoCount) + 1;
+                        m_matrixReadRepetitionCountArray1.next()[activationFifoCount] =
+                                        m_matrixReadRepetitionCountArray1.current()[activationFifoCount] + 1;
                     }
 
                     else
                     {
-                        m_busyArray1Next.at(activationFifoCount) = false;
+                        m_busyArray1.setNext(activationFifoCount, false);
                     }
                 }
             }
@@ -714,25 +847,20 @@ private:
 
     const size_t m_activationFifoArraySize;
 
-    std::vector<size_t> m_rowPtrArray0Current;
-    std::vector<size_t> m_rowPtrArray0Next;
-    std::vector<size_t> m_rowPtrArray1Current;
-    std::vector<size_t> m_rowPtrArray1Next;
-
-    std::vector<size_t> m_blockPtrArray0Current;
-    std::vector<size_t> m_blockPtrArray0Next;
-    std::vector<size_t> m_blockPtrArray1Current;
-    std::vector<size_t> m_blockPtrArray1Next;
-
-    std::vector<size_t> m_matrixReadRepetitionCountArray0Current;
-    std::vector<size_t> m_matrixReadRepetitionCountArray0Next;
-    std::vector<size_t> m_matrixReadRepetitionCountArray1Current;
-    std::vector<size_t> m_matrixReadRepetitionCountArray1Next;
-
-    std::vector<bool> m_busyArray0Current;
-    std::vector<bool> m_busyArray0Next;
-    std::vector<bool> m_busyArray1Current;
-    std::vector<bool> m_busyArray1Next;
+    /* The per-FIFO counters are stored in 32 bit registers,
+     * the per-FIFO busy flags as bit planes */
+
+    ClockedRegisterArray<std::uint32_t> m_rowPtrArray0;
+    ClockedRegisterArray<std::uint32_t> m_rowPtrArray1;
+
+    ClockedRegisterArray<std::uint32_t> m_blockPtrArray0;
+    ClockedRegisterArray<std::uint32_t> m_blockPtrArray1;
+
+    ClockedRegisterArray<std::uint32_t> m_matrixReadRepetitionCountArray0;
+    ClockedRegisterArray<std::uint32_t> m_matrixReadRepetitionCountArray1;
+
+    ClockedBitArray m_busyArray0;
+    ClockedBitArray m_busyArray1;
 
     const Datatype* m_matrixPtr0Current{nullptr};
     const Datatype* m_matrixPtr0Next{nullptr};
@@ -0,0 +1,389 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        unified_buffer_allocator.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef UNIFIED_BUFFER_ALLOCATOR_H
+#define UNIFIED_BUFFER_ALLOCATOR_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include <iterator>
+#include <cstddef>
+#include <cassert>
+
+#include "mpu_exception.h"
+
+/**
+ * @struct  UnifiedBufferSegmentRelocation
+ * @brief   Describes the move of an allocated segment
+ *          during the compaction of the unified buffer
+ */
+
+struct UnifiedBufferSegmentRelocation
+{
+    UnifiedBufferSegmentRelocation(const size_t addressOld,
+                                    const size_t addressNew,
+                                    const size_t sizeByte): addressOld{addressOld},
+                                                                addressNew{addressNew},
+                                                                sizeByte{sizeByte}
+    {
+    }
+
+    const size_t addressOld;
+    const size_t addressNew;
+    const size_t sizeByte;
+};
+
+/**
+ * @class   UnifiedBufferAllocator
+ * @brief   Segment table allocator for the address space of the MPU
+ *          unified buffer. Allocated and free segments are kept in
+ *          separate tables ordered by address. Allocations are placed
+ *          first fit into the free segments, and otherwise appended
+ *          at the end of the used address range. Freed segments are
+ *          coalesced with their free neighbours, a free segment at the
+ *          end of the used address range shrinks the range instead.
+ *          Allocated segments never move, except on an explicit
+ *          compaction, which the owner of the buffer contents has to
+ *          replay using the returned relocations. Segment sizes are
+ *          rounded up to SegmentAlignmentByte, so that every segment of
+ *          a buffer aligned to SegmentAlignmentByte, see mpusim::UnifiedBuffer,
+ *          is suitably aligned for any matrix datatype and for aligned
+ *          vector loads, regardless of the sizes of the other segments.
+ */
+
+class UnifiedBufferAllocator
+{
+
+public:
+
+    static constexpr size_t SegmentAlignmentByte{64UL};
+
+    /**
+     * @brief               UnifiedBufferAllocator constructor
+     * @param sizeByteMax   The size of the managed address space
+     */
+
+    explicit UnifiedBufferAllocator(const size_t sizeByteMax): m_sizeByteMax{sizeByteMax}
+    {
+    }
+
+    /**
+     * @brief           Get the size of the segment allocated
+     *                  for the given number of bytes
+     * @param sizeByte  The requested size
+     * @return          The requested size rounded up
+     *                  to SegmentAlignmentByte
+     */
+
+    static size_t getSegmentSizeByte(const size_t sizeByte)
+    {
+        return (sizeByte + SegmentAlignmentByte - 1UL) &
+                                    ~(SegmentAlignmentByte - 1UL);
+    }
+
+    /**
+     * @brief               Allocate a segment
+     * @param sizeByteMin   The size of the segment, has to be non-zero,
+     *                      rounded up to SegmentAlignmentByte
+     * @param address       Set to the address of the segment on success
+     * @return              False if no free segment or space at the end
+     *                      of the used address range is large enough
+     */
+
+    bool allocate(const size_t sizeByteMin, size_t& address)
+    {
+        assert(sizeByteMin != 0UL);
+
+        const size_t sizeByte{getSegmentSizeByte(sizeByteMin)};
+
+        for(auto freeSegmentIterator = m_freeSegmentMap.begin();
+                        freeSegmentIterator != m_freeSegmentMap.end();
+                                                    ++freeSegmentIterator)
+        {
+            if(freeSegmentIterator->second >= sizeByte)
+            {
+                address = freeSegmentIterator->first;
+
+                const size_t sizeByteRemaining{freeSegmentIterator->second - sizeByte};
+
+                m_freeSegmentMap.erase(freeSegmentIterator);
+
+                if(sizeByteRemaining != 0UL)
+                {
+                    m_freeSegmentMap.emplace(address + sizeByte,
+                                                    sizeByteRemaining);
+                }
+
+                m_segmentMap.emplace(address, sizeByte);
+                m_allocatedSizeByte += sizeByte;
+
+                return true;
+            }
+        }
+
+        if((m_end + sizeByte) > m_sizeByteMax)
+        {
+            return false;
+        }
+
+        address = m_end;
+
+        m_segmentMap.emplace(address, sizeByte);
+        m_allocatedSizeByte += sizeByte;
+
+        m_end += sizeByte;
+
+        return true;
+    }
+
+    /**
+     * @brief           Free the segment at the given address
+     * @param address   The address of an allocated segment
+     */
+
+    void deallocate(const size_t address)
+    {
+        const auto segmentIterator = m_segmentMap.find(address);
+
+        if(segmentIterator == m_segmentMap.end())
+        {
+            throw MpuException("Unified buffer allocator: No segment "
+                                "allocated at address " +
+                                std::to_string(address));
+        }
+
+        const size_t sizeByte{segmentIterator->second};
+
+        m_segmentMap.erase(segmentIterator);
+        m_allocatedSizeByte -= sizeByte;
+
+        release(address, sizeByte);
+    }
+
+    /**
+     * @brief               Resize the segment at the given address in place.
+     *                      Shrinking always succeeds, growing succeeds if the
+     *                      segment is followed by a large enough free segment
+     *                      or by the end of the used address range.
+     * @param address       The address of an allocated segment
+     * @param sizeByteMin   The new size of the segment, has to be non-zero,
+     *                      rounded up to SegmentAlignmentByte
+     * @return              False if the segment could not be grown in place
+     */
+
+    bool resize(const size_t address, const size_t sizeByteMin)
+    {
+        assert(sizeByteMin != 0UL);
+
+        const size_t sizeByte{getSegmentSizeByte(sizeByteMin)};
+
+        const auto segmentIterator = m_segmentMap.find(address);
+
+        if(segmentIterator == m_segmentMap.end())
+        {
+            throw MpuException("Unified buffer allocator: No segment "
+                                "allocated at address " +
+                                std::to_string(address));
+        }
+
+        const size_t sizeByteOld{segmentIterator->second};
+
+        if(sizeByte <= sizeByteOld)
+        {
+            if(sizeByte < sizeByteOld)
+            {
+                segmentIterator->second = sizeByte;
+                m_allocatedSizeByte -= sizeByteOld - sizeByte;
+
+                release(address + sizeByte, sizeByteOld - sizeByte);
+            }
+
+            return true;
+        }
+
+        const size_t growth{sizeByte - sizeByteOld};
+        const size_t segmentEnd{address + sizeByteOld};
+
+        if(segmentEnd == m_end)
+        {
+            if((m_end + growth) > m_sizeByteMax)
+            {
+                return false;
+            }
+
+            m_end += growth;
+        }
+
+        else
+        {
+            const auto freeSegmentIterator = m_freeSegmentMap.find(segmentEnd);
+
+            if((freeSegmentIterator == m_freeSegmentMap.end()) ||
+                                (freeSegmentIterator->second < growth))
+            {
+                return false;
+            }
+
+            const size_t sizeByteRemaining{freeSegmentIterator->second - growth};
+
+            m_freeSegmentMap.erase(freeSegmentIterator);
+
+            if(sizeByteRemaining != 0UL)
+            {
+                m_freeSegmentMap.emplace(segmentEnd + growth,
+                                                sizeByteRemaining);
+            }
+        }
+
+        segmentIterator->second = sizeByte;
+        m_allocatedSizeByte += growth;
+
+        return true;
+    }
+
+    /**
+     * @brief   Move all allocated segments to the start of the
+     *          address space, keeping their order, so that the
+     *          free space forms a single range at the end
+     * @return  The moves of the relocated segments in ascending
+     *          address order. Every segment moves to a lower
+     *          address, so replaying the moves in this order
+     *          never overwrites a segment that has not moved yet.
+     */
+
+    std::vector<UnifiedBufferSegmentRelocation> compact()
+    {
+        std::vector<UnifiedBufferSegmentRelocation> relocationArray;
+
+        std::map<size_t, size_t> segmentMapCompacted;
+
+        size_t address{0UL};
+
+        for(const auto& segment : m_segmentMap)
+        {
+            if(segment.first != address)
+            {
+                relocationArray.emplace_back(segment.first,
+                                                address,
+                                                segment.second);
+            }
+
+            segmentMapCompacted.emplace_hint(segmentMapCompacted.end(),
+                                                    address, segment.second);
+
+            address += segment.second;
+        }
+
+        m_segmentMap.swap(segmentMapCompacted);
+        m_freeSegmentMap.clear();
+
+        m_end = address;
+
+        return relocationArray;
+    }
+
+    /**
+     * @brief   Get the end of the used address range,
+     *          the highest end address of all allocated segments
+     */
+
+    size_t getEnd() const
+    {
+        return m_end;
+    }
+
+    size_t getAllocatedSizeByte() const
+    {
+        return m_allocatedSizeByte;
+    }
+
+    size_t getFreeSegmentCount() const
+    {
+        return m_freeSegmentMap.size();
+    }
+
+    void reset()
+    {
+        m_segmentMap.clear();
+        m_freeSegmentMap.clear();
+
+        m_end = 0UL;
+        m_allocatedSizeByte = 0UL;
+    }
+
+private:
+
+    void release(size_t address, size_t sizeByte)
+    {
+        auto nextFreeSegmentIterator = m_freeSegmentMap.lower_bound(address);
+
+        if(nextFreeSegmentIterator != m_freeSegmentMap.begin())
+        {
+            const auto previousFreeSegmentIterator = std::prev(nextFreeSegmentIterator);
+
+            if((previousFreeSegmentIterator->first +
+                        previousFreeSegmentIterator->second) == address)
+            {
+                address = previousFreeSegmentIterator->first;
+                sizeByte += previousFreeSegmentIterator->second;
+
+                m_freeSegmentMap.erase(previousFreeSegmentIterator);
+            }
+        }
+
+        if((nextFreeSegmentIterator != m_freeSegmentMap.end()) &&
+                    (nextFreeSegmentIterator->first == (address + sizeByte)))
+        {
+            sizeByte += nextFreeSegmentIterator->second;
+
+            m_freeSegmentMap.erase(nextFreeSegmentIterator);
+        }
+
+        if((address + sizeByte) == m_end)
+        {
+            m_end = address;
+        }
+
+        else
+        {
+            m_freeSegmentMap.emplace(address, sizeByte);
+        }
+    }
+
+    const size_t m_sizeByteMax;
+
+    std::map<size_t, size_t> m_segmentMap;
+    std::map<size_t, size_t> m_freeSegmentMap;
+
+    size_t m_end{0UL};
+    size_t m_allocatedSizeByte{0UL};
+
+};
+
+#endif
@@ -29,12 +29,14 @@
 #ifndef WEIGHT_FIFO_H
 #define WEIGHT_FIFO_H
 
+#include <vector>
 #include <algorithm>
 #include <iostream>
 #include <cmath>
 #include <cstdint>
 
 #include "systolic_array.h"
+#include "ring_buffer_queue.h"
 
 /**
  * @struct  WeightUpdateRequest
@@ -48,18 +50,37 @@
 struct WeightUpdateRequest
 {
 
+    WeightUpdateRequest() = default;
+
     WeightUpdateRequest(const size_t blockCoordinateX,
                             const size_t blockCoordinateY): blockCoordinateX{blockCoordinateX},
                                                                 blockCoordinateY{blockCoordinateY}
     {
     }
 
-    size_t blockCoordinateX;
-    size_t blockCoordinateY;
+    size_t blockCoordinateX{0UL};
+    size_t blockCoordinateY{0UL};
 
     size_t diagonalsUpdated{0UL};
 };
 
+/**
+ * @struct  WeightDiagonalLoad
+ * @brief   Precomputed load of a PE diagonal for one kind of weight
+ *          matrix block: The rows of the diagonal loading weights from
+ *          the weight matrix, as well as the offset of the weight of the
+ *          first of these PEs relative to the first element of the block.
+ *          The PEs of the diagonal outside of these rows are masked, as
+ *          they lie outside of the weight matrix in edge blocks.
+ */
+
+struct WeightDiagonalLoad
+{
+    size_t rowActiveStart{0UL};
+    size_t rowActiveEnd{0UL};
+    size_t sourceOffset{0UL};
+};
+
 /**
  * @class                       WeightFetcher
  * @brief                       Functional unit responsible for storing weight matrix tiles
@@ -88,8 +109,20 @@ public:
                                                             m_systolicArrayWidth{m_systolicArrayPtr->getWidth()},
                                                             m_systolicArrayHeight{m_systolicArrayPtr->getHeight()},
                                                             m_systolicArrayDiagonals{m_systolicArrayWidth +
-                                                                                            m_systolicArrayHeight - 1}
+                                                                                            m_systolicArrayHeight - 1},
+                                                            m_concurrentLoadsPerColumnArray(m_systolicArrayWidth),
+                                                            m_diagonalRowStartArray(m_systolicArrayDiagonals),
+                                                            m_diagonalRowEndArray(m_systolicArrayDiagonals),
+                                                            m_diagonalLoadArray(blockKindCount*m_systolicArrayDiagonals),
+                                                            m_weightUpdateRequestQueue(m_systolicArrayDiagonals + 1)
     {
+        for(size_t diagonal{0}; diagonal < m_systolicArrayDiagonals; ++diagonal)
+        {
+            m_diagonalRowStartArray[diagonal] = (diagonal < m_systolicArrayWidth) ? 0UL :
+                                                        (diagonal - m_systolicArrayWidth + 1);
+
+            m_diagonalRowEndArray[diagonal] = std::min(diagonal + 1, m_systolicArrayHeight);
+        }
     } 
 
     size_t getDiagonalCountBitwidthRequiredMin() const
@@ -152,6 +185,22 @@ public:
         return m_concurrentLoadCountPerColumnMax;
     }
 
+    size_t getWeightUpdateRequestQueueLengthMax() const
+    {
+        return m_weightUpdateRequestQueueLengthMax;
+    }
+
+    /**
+     * @brief   Get the mean length of the update request queue seen by
+     *          the requests issued since the data movement counters were
+     *          last reset, including the request itself
+     */
+
+    double getWeightUpdateRequestQueueOccupancyMean() const
+    {
+        return m_weightUpdateRequestQueue.getOccupancyMean();
+    }
+
     size_t getControlRegisterBits(const size_t unifiedBufferSize) const
     {
         /* To calculate the number of control bits
@@ -212,6 +261,36 @@ public:
         m_loadCount = 0UL;
         m_concurrentLoadCountMax = 0UL;
         m_concurrentLoadCountPerColumnMax = 0UL;
+
+        m_weightUpdateRequestQueue.resetOccupancyStatistics();
+    }
+
+    /**
+     * @brief                                   Add data movement metrics and update the maximum
+     *                                          update request queue length with values determined
+     *                                          without running the weight fetcher, used by the
+     *                                          analytical simulation mode of the MPU
+     * @param loadCount                         The weight loads from the unified buffer
+     * @param concurrentLoadsMax                The maximum loads in a single iteration
+     * @param concurrentLoadsPerColumnMax       The maximum loads per column in a single iteration
+     * @param weightUpdateRequestQueueLengthMax The maximum length of the update request queue
+     */
+
+    void addDataMovementMetrics(const size_t loadCount,
+                                    const size_t concurrentLoadsMax,
+                                    const size_t concurrentLoadsPerColumnMax,
+                                    const size_t weightUpdateRequestQueueLengthMax)
+    {
+        m_loadCount += loadCount;
+
+        m_concurrentLoadCountMax = std::max(m_concurrentLoadCountMax,
+                                                concurrentLoadsMax);
+
+        m_concurrentLoadCountPerColumnMax = std::max(m_concurrentLoadCountPerColumnMax,
+                                                        concurrentLoadsPerColumnMax);
+
+        m_weightUpdateRequestQueueLengthMax = std::max(m_weightUpdateRequestQueueLengthMax,
+                                                        weightUpdateRequestQueueLengthMax);
     }
 
     void resetMaxRegisterValues()
@@ -303,6 +382,8 @@ public:
         {
             m_idleRowsLastBlockMax = m_idleRowsLastBlockNext;
         }
+
+        compileDiagonalLoads();
     }
     
     /**
@@ -317,7 +398,7 @@ public:
         assert(blockX < m_blocksXCurrent);
         assert(blockY < m_blocksYCurrent);
 
-        m_weightUpdateRequestQueue.emplace_back(
+        m_weightUpdateRequestQueue.push_back(
                                     WeightUpdateRequest(blockX,
                                                             blockY));
 
@@ -342,50 +423,48 @@ public:
     {
         size_t concurrentLoadCount{0UL};
 
-        std::vector<size_t> concurrentLoadsPerColumn(m_systolicArrayWidth);
+        std::fill(m_concurrentLoadsPerColumnArray.begin(),
+                    m_concurrentLoadsPerColumnArray.end(), 0UL);
+
+        for(size_t requestCount{0}; requestCount < m_weightUpdateRequestQueue.size(); ++requestCount)
+        {
+            WeightUpdateRequest& weightUpdateRequest{m_weightUpdateRequestQueue[requestCount]};
 
-        for(WeightUpdateRequest& weightUpdateRequest :
-                                                m_weightUpdateRequestQueue)
-        {   
+            const size_t diagonal{weightUpdateRequest.diagonalsUpdated};
 
-            const size_t activeColumns{(weightUpdateRequest.blockCoordinateX !=
-                                                            (m_blocksXCurrent - 1)) ? m_systolicArrayWidth :
-                                                                                m_activeColumnsLastBlockCurrent};
+            const bool lastBlockX{weightUpdateRequest.blockCoordinateX == (m_blocksXCurrent - 1)};
+            const bool lastBlockY{weightUpdateRequest.blockCoordinateY == (m_blocksYCurrent - 1)};
 
-           const size_t idleRows{(weightUpdateRequest.blockCoordinateY !=
-                                                            (m_blocksYCurrent - 1)) ? 0UL :
-                                                                           m_idleRowsLastBlockNext};
+            const WeightDiagonalLoad& diagonalLoad{m_diagonalLoadArray[
+                                                        getBlockKind(lastBlockX, lastBlockY)*
+                                                                m_systolicArrayDiagonals + diagonal]};
 
-            for(ProcessingElement<WeightDatatype,
-                                    ActivationDatatype,
-                                    AccumulatorDatatype>* pePtr : m_systolicArrayPtr->getDiagonal(
-                                                                            weightUpdateRequest.diagonalsUpdated))
+            const size_t blockOffset{weightUpdateRequest.blockCoordinateY*
+                                        m_systolicArrayHeight*m_matrixWidthCurrent +
+                                        weightUpdateRequest.blockCoordinateX*
+                                        m_systolicArrayWidth};
+
+            m_systolicArrayPtr->storeWeightDiagonal(diagonal,
+                                                        m_diagonalRowStartArray[diagonal],
+                                                        diagonalLoad.rowActiveStart,
+                                                        diagonalLoad.rowActiveEnd,
+                                                        m_diagonalRowEndArray[diagonal],
+                                                        m_matrixPtrCurrent + blockOffset +
+                                                                    diagonalLoad.sourceOffset,
+                                                        m_matrixWidthCurrent - 1);
+
+            const size_t diagonalLoadCount{diagonalLoad.rowActiveEnd -
+                                                diagonalLoad.rowActiveStart};
+
+            m_loadCount += diagonalLoadCount;
+            concurrentLoadCount += diagonalLoadCount;
+
+            for(size_t rowCount{diagonalLoad.rowActiveStart};
+                            rowCount < diagonalLoad.rowActiveEnd; ++rowCount)
             {
-                if((pePtr->getPosition().x < activeColumns) &&
-                                (pePtr->getPosition().y >= idleRows))
-                {
-                    pePtr->storeWeight(m_matrixPtrCurrent[(weightUpdateRequest.blockCoordinateY*
-                                                                m_systolicArrayHeight +
-                                                                pePtr->getPosition().y -
-                                                                idleRows)*
-                                                                m_matrixWidthCurrent +
-                                                                weightUpdateRequest.blockCoordinateX*
-                                                                m_systolicArrayWidth +
-                                                                pePtr->getPosition().x]);
-
-                    ++m_loadCount;
-                    ++concurrentLoadCount;
-                    ++concurrentLoadsPerColumn.at(pePtr->getPosition().x);
-
-                }
-
-                else
-                {
-                    pePtr->storeWeight(WeightDatatype(0));
-                }
+                ++m_concurrentLoadsPerColumnArray[diagonal - rowCount];
             }
 
-
             weightUpdateRequest.diagonalsUpdated++;
 
         }
@@ -396,7 +475,7 @@ public:
         }
 
         for(const size_t& columnConcurrentLoadCount :
-                                    concurrentLoadsPerColumn)
+                                    m_concurrentLoadsPerColumnArray)
         {
             if(m_concurrentLoadCountPerColumnMax <
                                     columnConcurrentLoadCount)
@@ -405,16 +484,14 @@ public:
             }
         }
 
-        size_t count{0UL};
+        /* All requests update one diagonal per iteration,
+         * so they complete in the order they were issued */
 
-        for(auto it{m_weightUpdateRequestQueue.begin()}; it < m_weightUpdateRequestQueue.end(); ++it)
+        while(!m_weightUpdateRequestQueue.empty() &&
+                (m_weightUpdateRequestQueue.front().diagonalsUpdated ==
+                                                    m_systolicArrayDiagonals))
         {
-            if(it->diagonalsUpdated == m_systolicArrayDiagonals)
-            {
-                m_weightUpdateRequestQueue.erase(it);
-            }
-
-            ++count;
+            m_weightUpdateRequestQueue.pop_front();
         }
     }
 
@@ -448,6 +525,63 @@ public:
 
 private:
 
+    /* Kinds of weight matrix blocks, as blocks in the last block
+     * column can have inactive columns and blocks in the last
+     * block row can have idle rows */
+
+    static constexpr size_t blockKindCount{4UL};
+
+    static size_t getBlockKind(const bool lastBlockX,
+                                const bool lastBlockY)
+    {
+        return (lastBlockX ? 1UL : 0UL) + (lastBlockY ? 2UL : 0UL);
+    }
+
+    /**
+     * @brief   Compile the diagonal loads of all block kinds of
+     *          the weight matrix set with setInput(). The weights
+     *          of a diagonal are width - 1 elements apart in the
+     *          weight matrix, so that loading a diagonal is a
+     *          strided gather of its active rows.
+     */
+
+    void compileDiagonalLoads()
+    {
+        for(size_t blockKind{0}; blockKind < blockKindCount; ++blockKind)
+        {
+            const size_t activeColumns{(blockKind & 1UL) ? m_activeColumnsLastBlockNext :
+                                                                        m_systolicArrayWidth};
+
+            const size_t idleRows{(blockKind & 2UL) ? m_idleRowsLastBlockNext : 0UL};
+
+            for(size_t diagonal{0}; diagonal < m_systolicArrayDiagonals; ++diagonal)
+            {
+                WeightDiagonalLoad& diagonalLoad{m_diagonalLoadArray[blockKind*
+                                                                        m_systolicArrayDiagonals +
+                                                                        diagonal]};
+
+                /* A PE at position (diagonal - row, row) is active if its
+                 * column is below the active columns and its row is not
+                 * below the idle rows */
+
+                const size_t rowEnd{m_diagonalRowEndArray[diagonal]};
+
+                const size_t rowActiveStart{std::min(std::max({m_diagonalRowStartArray[diagonal],
+                                                                idleRows,
+                                                                (diagonal < activeColumns) ? 0UL :
+                                                                        (diagonal - activeColumns + 1)}),
+                                                        rowEnd)};
+
+                diagonalLoad.rowActiveStart = rowActiveStart;
+                diagonalLoad.rowActiveEnd = rowEnd;
+
+                diagonalLoad.sourceOffset = (rowActiveStart != rowEnd) ?
+                                                    ((rowActiveStart - idleRows)*m_matrixWidthNext +
+                                                                        diagonal - rowActiveStart) : 0UL;
+            }
+        }
+    }
+
     SystolicArray<WeightDatatype,
                         ActivationDatatype,
                         AccumulatorDatatype>* const m_systolicArrayPtr;
@@ -456,7 +590,23 @@ private:
     const size_t m_systolicArrayHeight;
     const size_t m_systolicArrayDiagonals;
 
-    std::vector<WeightUpdateRequest> m_weightUpdateRequestQueue;
+    /* Per iteration load counts, allocated once so that
+     * runIteration() does not perform heap allocations */
+
+    std::vector<size_t> m_concurrentLoadsPerColumnArray;
+
+    /* Rows of the PE diagonals and the diagonal loads of each block
+     * kind, recompiled for every weight matrix in setInput() */
+
+    std::vector<size_t> m_diagonalRowStartArray;
+    std::vector<size_t> m_diagonalRowEndArray;
+
+    std::vector<WeightDiagonalLoad> m_diagonalLoadArray;
+
+    /* A request is issued at most once per iteration and completes
+     * after updating all diagonals, which bounds the queue length */
+
+    RingBufferQueue<WeightUpdateRequest> m_weightUpdateRequestQueue;
 
     size_t m_weightUpdateRequestQueueLengthMax{0UL};
 
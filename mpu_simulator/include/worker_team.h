@@ -0,0 +1,342 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        worker_team.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef WORKER_TEAM_H
+#define WORKER_TEAM_H
+
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/* Assumed size of a cache line in bytes. Counters written
+ * by different threads are placed at least this far apart. */
+
+constexpr size_t workerTeamCacheLineSize{64UL};
+
+/**
+ * @class       CacheLinePaddedArray
+ * @brief       Fixed size array placing each element at the start of
+ *              its own cache line, so that elements written by different
+ *              threads do not share a cache line
+ * @tparam T    The element datatype, has to be trivially destructible
+ */
+
+template<typename T> class CacheLinePaddedArray
+{
+
+    static_assert(std::is_trivially_destructible<T>::value,
+                    "CacheLinePaddedArray element datatype has "
+                    "to be trivially destructible");
+
+public:
+
+    /**
+     * @brief       CacheLinePaddedArray constructor. The elements
+     *              are value initialized.
+     * @param size  The number of elements
+     */
+
+    explicit CacheLinePaddedArray(const size_t size): m_size{size},
+                                                        m_bufferArray((size + 1UL)*m_slotSize)
+    {
+        const std::uintptr_t bufferAddress{reinterpret_cast<std::uintptr_t>(m_bufferArray.data())};
+
+        const std::uintptr_t slotAddressFirst{(bufferAddress + workerTeamCacheLineSize - 1UL) &
+                                                        ~static_cast<std::uintptr_t>(
+                                                                    workerTeamCacheLineSize - 1UL)};
+
+        m_slotPtr = m_bufferArray.data() + (slotAddressFirst - bufferAddress);
+
+        for(size_t elementCount{0}; elementCount < m_size; ++elementCount)
+        {
+            new(m_slotPtr + elementCount*m_slotSize) T{};
+        }
+    }
+
+    CacheLinePaddedArray(const CacheLinePaddedArray&) = delete;
+    CacheLinePaddedArray& operator=(const CacheLinePaddedArray&) = delete;
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    T& operator[](const size_t index)
+    {
+        return *reinterpret_cast<T*>(m_slotPtr + index*m_slotSize);
+    }
+
+    const T& operator[](const size_t index) const
+    {
+        return *reinterpret_cast<const T*>(m_slotPtr + index*m_slotSize);
+    }
+
+private:
+
+    static constexpr size_t m_slotSize{((sizeof(T) + workerTeamCacheLineSize - 1UL)/
+                                                workerTeamCacheLineSize)*workerTeamCacheLineSize};
+
+    const size_t m_size;
+
+    std::vector<unsigned char> m_bufferArray;
+    unsigned char* m_slotPtr;
+
+};
+
+/* Number of times a waiting thread polls before
+ * it starts yielding its core between polls */
+
+constexpr size_t workerTeamSpinCountMax{4096UL};
+
+/**
+ * @brief           Busy wait until a condition holds. After spinning
+ *                  for a while, the calling thread yields its core
+ *                  between polls, so that oversubscribed teams still
+ *                  make progress.
+ * @param condition Callable returning true once the wait is over
+ */
+
+template<typename Condition> void spinWaitUntil(const Condition& condition)
+{
+    size_t spinCount{0UL};
+
+    while(!condition())
+    {
+        if(++spinCount >= workerTeamSpinCountMax)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @class   SenseReversingBarrier
+ * @brief   Centralized barrier for a fixed number of threads. The last
+ *          thread to arrive resets the arrival counter and flips the
+ *          global sense, releasing the threads spinning on it. As every
+ *          thread keeps its own local sense, the barrier can be reused
+ *          immediately without a second synchronization round.
+ */
+
+class SenseReversingBarrier
+{
+
+public:
+
+    /**
+     * @brief               SenseReversingBarrier constructor
+     * @param threadCount   The number of threads synchronizing on the barrier
+     */
+
+    explicit SenseReversingBarrier(const size_t threadCount): m_threadCount{threadCount},
+                                                                m_arrivalCountRemaining{threadCount},
+                                                                m_sense{false}
+    {
+    }
+
+    /**
+     * @brief               Wait until all threads arrived at the barrier
+     * @param localSense    The local sense of the calling thread, initially
+     *                      false and not modified outside of this function
+     */
+
+    void wait(bool& localSense)
+    {
+        localSense = !localSense;
+
+        if(m_arrivalCountRemaining.fetch_sub(1UL, std::memory_order_acq_rel) == 1UL)
+        {
+            m_arrivalCountRemaining.store(m_threadCount, std::memory_order_relaxed);
+            m_sense.store(localSense, std::memory_order_release);
+        }
+
+        else
+        {
+            const bool localSenseConst{localSense};
+
+            spinWaitUntil([this, localSenseConst]() {
+                return m_sense.load(std::memory_order_acquire) == localSenseConst;
+            });
+        }
+    }
+
+private:
+
+    const size_t m_threadCount;
+
+    std::atomic<size_t> m_arrivalCountRemaining;
+    std::atomic<bool> m_sense;
+
+};
+
+/**
+ * @class   WorkerTeamTask
+ * @brief   Interface of the work distributed over a WorkerTeam
+ */
+
+class WorkerTeamTask
+{
+
+public:
+
+    virtual ~WorkerTeamTask() = default;
+
+    /**
+     * @brief               Run the share of the work of a worker
+     * @param workerIndex   The index of the worker in [0, workerCount)
+     * @param workerCount   The number of workers in the team
+     */
+
+    virtual void runWorker(const size_t workerIndex,
+                            const size_t workerCount) = 0;
+
+};
+
+/**
+ * @class   WorkerTeam
+ * @brief   Persistent team of worker threads. The thread calling run()
+ *          acts as worker 0, the other workers are started once at
+ *          construction and wait on a sense reversing barrier between
+ *          tasks. Compared to opening an OpenMP parallel region for
+ *          every task, this avoids the fork/join overhead for tasks
+ *          that are only a few microseconds long, like simulating
+ *          a single cycle of the systolic array. A team of a single
+ *          worker runs all tasks on the calling thread without
+ *          any synchronization.
+ */
+
+class WorkerTeam
+{
+
+public:
+
+    /**
+     * @brief               WorkerTeam constructor
+     * @param workerCount   The number of workers including the calling
+     *                      thread, at least 1
+     */
+
+    explicit WorkerTeam(const size_t workerCount): m_workerCount{std::max(workerCount, 1UL)},
+                                                    m_barrier(m_workerCount)
+    {
+        for(size_t workerIndex{1}; workerIndex < m_workerCount; ++workerIndex)
+        {
+            m_threadArray.emplace_back(&WorkerTeam::runWorkerLoop, this, workerIndex);
+        }
+    }
+
+    WorkerTeam(const WorkerTeam&) = delete;
+    WorkerTeam& operator=(const WorkerTeam&) = delete;
+
+    ~WorkerTeam()
+    {
+        if(m_workerCount > 1UL)
+        {
+            m_shutdown = true;
+
+            m_barrier.wait(m_localSense);
+
+            for(std::thread& thread : m_threadArray)
+            {
+                thread.join();
+            }
+        }
+    }
+
+    size_t getWorkerCount() const
+    {
+        return m_workerCount;
+    }
+
+    /**
+     * @brief       Run a task on all workers and wait until
+     *              every worker has completed its share
+     * @param task  The task
+     */
+
+    void run(WorkerTeamTask& task)
+    {
+        if(m_workerCount == 1UL)
+        {
+            task.runWorker(0UL, 1UL);
+            return;
+        }
+
+        m_taskPtr = &task;
+
+        m_barrier.wait(m_localSense);
+
+        task.runWorker(0UL, m_workerCount);
+
+        m_barrier.wait(m_localSense);
+    }
+
+private:
+
+    void runWorkerLoop(const size_t workerIndex)
+    {
+        bool localSense{false};
+
+        while(true)
+        {
+            m_barrier.wait(localSense);
+
+            /* The task pointer and the shutdown flag are written
+             * by worker 0 before it arrives at the barrier, so
+             * they are visible to all workers released from it */
+
+            if(m_shutdown)
+            {
+                break;
+            }
+
+            m_taskPtr->runWorker(workerIndex, m_workerCount);
+
+            m_barrier.wait(localSense);
+        }
+    }
+
+    const size_t m_workerCount;
+
+    SenseReversingBarrier m_barrier;
+
+    bool m_localSense{false};
+    bool m_shutdown{false};
+
+    WorkerTeamTask* m_taskPtr{nullptr};
+
+    std::vector<std::thread> m_threadArray;
+
+};
+
+#endif
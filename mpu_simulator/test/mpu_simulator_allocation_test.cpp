@@ -0,0 +1,219 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        mpu_simulator_allocation_test.cpp
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2019-2020
+ * @copyright   MIT License
+ */
+
+#include <vector>
+#include <random>
+#include <iostream>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <atomic>
+#include <new>
+
+#include "matrix_processing_unit.h"
+
+/* Counting allocator: The replaced global operator new counts
+ * every heap allocation of this executable, so that the test
+ * can check that the simulated cycles are allocation free.
+ * The test has an executable of its own, as the replacement
+ * applies to the whole program. */
+
+static std::atomic<size_t> heapAllocationCount{0UL};
+
+void* operator new(std::size_t size)
+{
+    ++heapAllocationCount;
+
+    void* const ptr{std::malloc((size != 0UL) ? size : 1UL)};
+
+    if(ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+/* GCC flags the std::free() of memory from operator new after
+ * inlining the replaced operator delete into its callers */
+
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic pop
+#endif
+
+int main(int argc, char** argv)
+{
+
+    using WeightDatatype = int8_t;
+    using ActivationDatatype = int8_t;
+    using AccumulatorDatatype = int32_t;
+
+    constexpr size_t systolicArrayWidth{24UL};
+    constexpr size_t systolicArrayHeight{16UL};
+    constexpr size_t accumulatorArrayHeight{64UL};
+    constexpr size_t activationFifoDepth{4UL};
+    constexpr size_t unifiedBufferSizeByte{256UL*1024UL*1024UL};
+
+    std::default_random_engine rng(0UL);
+
+    std::normal_distribution<float> matrixValueDistribution(0.0F, 8.0F);
+
+    std::vector<ActivationDatatype> activationMatrix;
+    std::vector<WeightDatatype> weightMatrix;
+
+    bool heapAllocationCheckPassed{true};
+
+    std::cout << "MPU allocation test: Heap allocations in the simulated cycles" << std::endl;
+
+    /* After a warm-up multiplication of each shape, the number of heap
+     * allocations of a multiplication must not depend on its number of
+     * simulated cycles, for both engines with and without steady state
+     * iteration skipping. The result verification is disabled, as it
+     * allocates the reference result matrix. */
+
+    const size_t heapAllocationTestSizeN{50UL};
+    const size_t heapAllocationTestSizeK{40UL};
+
+    const size_t heapAllocationTestSizeMShort{accumulatorArrayHeight/2UL};
+    const size_t heapAllocationTestSizeMLong{4UL*accumulatorArrayHeight};
+
+    for(size_t elementCount{0}; elementCount < heapAllocationTestSizeK*heapAllocationTestSizeN; ++elementCount)
+    {
+        weightMatrix.emplace_back(static_cast<WeightDatatype>(
+                                            matrixValueDistribution(rng)));
+    }
+
+    for(size_t elementCount{0}; elementCount < heapAllocationTestSizeMLong*heapAllocationTestSizeK; ++elementCount)
+    {
+        activationMatrix.emplace_back(static_cast<ActivationDatatype>(
+                                                    matrixValueDistribution(rng)));
+    }
+
+    for(const SystolicArrayEngine systolicArrayEngine : {SystolicArrayEngine::StructureOfArrays,
+                                                            SystolicArrayEngine::ProcessingElements})
+    {
+        for(const bool steadyStateSkipping : {false, true})
+        {
+            MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitHeapAllocation(
+                                                                                                    systolicArrayWidth,
+                                                                                                    systolicArrayHeight,
+                                                                                                    activationFifoDepth,
+                                                                                                    accumulatorArrayHeight,
+                                                                                                    unifiedBufferSizeByte,
+                                                                                                    systolicArrayEngine);
+
+            matrixProcessingUnitHeapAllocation.setSteadyStateSkipping(steadyStateSkipping);
+            matrixProcessingUnitHeapAllocation.setVerificationPolicy(MpuVerificationPolicy::Off);
+
+            size_t iterationsTotal{0UL};
+
+            matrixProcessingUnitHeapAllocation.registerLogEntryAvailableCallback(
+                                    [&iterationsTotal](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+                iterationsTotal = mpuStatisticsLogEntry.getIterationsTotal();
+            });
+
+            matrixProcessingUnitHeapAllocation.storeWeightMatrix("heap_allocation_test",
+                                                                    weightMatrix.data(),
+                                                                    heapAllocationTestSizeK,
+                                                                    heapAllocationTestSizeN);
+
+            size_t heapAllocationCountArray[2];
+            size_t iterationCountArray[2];
+
+            for(const size_t sizeM : {heapAllocationTestSizeMShort, heapAllocationTestSizeMLong})
+            {
+                matrixProcessingUnitHeapAllocation.storeActivationMatrix(activationMatrix.data(),
+                                                                            sizeM, heapAllocationTestSizeK);
+
+                matrixProcessingUnitHeapAllocation.runMultiplication("heap_allocation_test");
+            }
+
+            for(size_t shapeCount{0UL}; shapeCount < 2UL; ++shapeCount)
+            {
+                const size_t sizeM{(shapeCount == 0UL) ? heapAllocationTestSizeMShort :
+                                                            heapAllocationTestSizeMLong};
+
+                matrixProcessingUnitHeapAllocation.storeActivationMatrix(activationMatrix.data(),
+                                                                            sizeM, heapAllocationTestSizeK);
+
+                const size_t iterationsTotalStart{iterationsTotal};
+                const size_t heapAllocationCountStart{heapAllocationCount};
+
+                matrixProcessingUnitHeapAllocation.runMultiplication("heap_allocation_test");
+
+                heapAllocationCountArray[shapeCount] = heapAllocationCount - heapAllocationCountStart;
+                iterationCountArray[shapeCount] = iterationsTotal - iterationsTotalStart;
+            }
+
+            std::cout << "Heap allocations: " << heapAllocationCountArray[0]
+                        << " in " << iterationCountArray[0] << " iterations, "
+                        << heapAllocationCountArray[1] << " in "
+                        << iterationCountArray[1] << " iterations" << std::endl;
+
+            if((heapAllocationCountArray[1] != heapAllocationCountArray[0]) ||
+                                (iterationCountArray[1] <= iterationCountArray[0]))
+            {
+                std::cout << "Heap allocations in the simulated cycles" << std::endl;
+
+                heapAllocationCheckPassed = false;
+            }
+        }
+    }
+
+    std::cout << "================================ SUMMARY ================================\n\n";
+
+    if(heapAllocationCheckPassed)
+    {
+        std::cout << "Allocation test: Allocation free simulated cycles\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Allocation test: Allocation free simulated cycles\t\tFAILED\n\n";
+    }
+
+    if(!heapAllocationCheckPassed)
+    {
+        return -1;
+    }
+
+    else
+    {
+        return 0;
+    }
+}
@@ -0,0 +1,226 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        mpu_simulator_benchmark.cpp
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+
+#include "matrix_processing_unit.h"
+
+/* Measures the number of simulated cycles per second of the cycle
+ * accurate simulation for an increasing number of systolic array
+ * workers and of the tile parallel simulation for an increasing
+ * number of MPU replicas. Steady state iteration skipping is
+ * disabled, so that every cycle is simulated.
+ *
+ * Usage: mpusim_benchmark [systolic array size] [worker count max]
+ *
+ * The worker count max also bounds the replica count and defaults
+ * to the number of hardware threads. */
+
+int main(int argc, char** argv)
+{
+
+    using WeightDatatype = int8_t;
+    using ActivationDatatype = int8_t;
+    using AccumulatorDatatype = int32_t;
+
+    const size_t systolicArraySize{(argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 128UL};
+
+    const size_t workerCountMax{(argc > 2) ? std::strtoul(argv[2], nullptr, 10) :
+                                        std::max(static_cast<size_t>(
+                                                    std::thread::hardware_concurrency()), 1UL)};
+
+    constexpr size_t accumulatorArrayHeight{4096UL};
+    constexpr size_t activationFifoDepth{8UL};
+    constexpr size_t unifiedBufferSizeByte{256UL*1024UL*1024UL};
+
+    const size_t sizeM{2048UL};
+    const size_t sizeN{2UL*systolicArraySize};
+    const size_t sizeK{2UL*systolicArraySize};
+
+    std::default_random_engine rng(0UL);
+
+    std::uniform_int_distribution<int> matrixValueDistribution(-16, 16);
+
+    std::vector<ActivationDatatype> activationMatrix(sizeM*sizeK);
+    std::vector<WeightDatatype> weightMatrix(sizeK*sizeN);
+
+    for(ActivationDatatype& activation : activationMatrix)
+    {
+        activation = static_cast<ActivationDatatype>(matrixValueDistribution(rng));
+    }
+
+    for(WeightDatatype& weight : weightMatrix)
+    {
+        weight = static_cast<WeightDatatype>(matrixValueDistribution(rng));
+    }
+
+    std::stringstream resultTableStringStream;
+
+    resultTableStringStream << std::left << std::setw(20) << "Engine"
+                                << std::setw(10) << "Workers"
+                                << std::setw(16) << "Cycles"
+                                << std::setw(16) << "Time [s]"
+                                << std::setw(16) << "Cycles/s"
+                                << "Speedup\n";
+
+    for(const SystolicArrayEngine systolicArrayEngine : {SystolicArrayEngine::StructureOfArrays,
+                                                            SystolicArrayEngine::ProcessingElements})
+    {
+        const std::string engineNameString{(systolicArrayEngine ==
+                                                SystolicArrayEngine::StructureOfArrays) ?
+                                                        "StructureOfArrays" : "ProcessingElements"};
+
+        double cyclesPerSecondSingleWorker{0.0};
+
+        for(size_t workerCount{1UL}; workerCount <= workerCountMax; ++workerCount)
+        {
+            MatrixProcessingUnit<WeightDatatype,
+                                    ActivationDatatype,
+                                    AccumulatorDatatype> matrixProcessingUnit(systolicArraySize,
+                                                                                systolicArraySize,
+                                                                                activationFifoDepth,
+                                                                                accumulatorArrayHeight,
+                                                                                unifiedBufferSizeByte,
+                                                                                systolicArrayEngine);
+
+            matrixProcessingUnit.setSteadyStateSkipping(false);
+            matrixProcessingUnit.setSystolicArrayWorkerCount(workerCount);
+
+            size_t iterationsTotal{0UL};
+
+            matrixProcessingUnit.registerLogEntryAvailableCallback(
+                                    [&iterationsTotal](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+                iterationsTotal = mpuStatisticsLogEntry.getIterationsTotal();
+            });
+
+            matrixProcessingUnit.storeActivationMatrix(activationMatrix.data(),
+                                                            sizeM, sizeK);
+
+            matrixProcessingUnit.storeWeightMatrix("benchmark",
+                                                        weightMatrix.data(),
+                                                        sizeK, sizeN);
+
+            const std::chrono::steady_clock::time_point timeStart{std::chrono::steady_clock::now()};
+
+            matrixProcessingUnit.runMultiplication("benchmark");
+
+            const double seconds{std::chrono::duration<double>(
+                                        std::chrono::steady_clock::now() - timeStart).count()};
+
+            const double cyclesPerSecond{static_cast<double>(iterationsTotal)/seconds};
+
+            if(workerCount == 1UL)
+            {
+                cyclesPerSecondSingleWorker = cyclesPerSecond;
+            }
+
+            resultTableStringStream << std::left << std::setw(20) << engineNameString
+                                        << std::setw(10) << matrixProcessingUnit.getSystolicArrayWorkerCount()
+                                        << std::setw(16) << iterationsTotal
+                                        << std::setw(16) << seconds
+                                        << std::setw(16) << cyclesPerSecond
+                                        << cyclesPerSecond/cyclesPerSecondSingleWorker << '\n';
+        }
+    }
+
+    /* Tile parallel simulation, distributing the time windows of
+     * the multiplication over an increasing number of MPU replicas.
+     * The smaller accumulator array height splits the activation
+     * matrix into several row blocks to distribute. */
+
+    const size_t tileParallelAccumulatorArrayHeight{std::max(256UL, 2UL*systolicArraySize)};
+
+    double cyclesPerSecondSingleReplica{0.0};
+
+    for(size_t replicaCount{1UL}; replicaCount <= workerCountMax; ++replicaCount)
+    {
+        MatrixProcessingUnit<WeightDatatype,
+                                ActivationDatatype,
+                                AccumulatorDatatype> matrixProcessingUnit(systolicArraySize,
+                                                                            systolicArraySize,
+                                                                            activationFifoDepth,
+                                                                            tileParallelAccumulatorArrayHeight,
+                                                                            unifiedBufferSizeByte);
+
+        matrixProcessingUnit.setSteadyStateSkipping(false);
+        matrixProcessingUnit.setSimulationMode(MpuSimulationMode::TileParallel);
+        matrixProcessingUnit.setTileReplicaCount(replicaCount);
+
+        size_t iterationsTotal{0UL};
+
+        matrixProcessingUnit.registerLogEntryAvailableCallback(
+                                [&iterationsTotal](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+            iterationsTotal = mpuStatisticsLogEntry.getIterationsTotal();
+        });
+
+        matrixProcessingUnit.storeActivationMatrix(activationMatrix.data(),
+                                                        sizeM, sizeK);
+
+        matrixProcessingUnit.storeWeightMatrix("benchmark",
+                                                    weightMatrix.data(),
+                                                    sizeK, sizeN);
+
+        const std::chrono::steady_clock::time_point timeStart{std::chrono::steady_clock::now()};
+
+        matrixProcessingUnit.runMultiplication("benchmark");
+
+        const double seconds{std::chrono::duration<double>(
+                                    std::chrono::steady_clock::now() - timeStart).count()};
+
+        const double cyclesPerSecond{static_cast<double>(iterationsTotal)/seconds};
+
+        if(replicaCount == 1UL)
+        {
+            cyclesPerSecondSingleReplica = cyclesPerSecond;
+        }
+
+        resultTableStringStream << std::left << std::setw(20) << "TileParallel"
+                                    << std::setw(10) << matrixProcessingUnit.getTileReplicaCount()
+                                    << std::setw(16) << iterationsTotal
+                                    << std::setw(16) << seconds
+                                    << std::setw(16) << cyclesPerSecond
+                                    << cyclesPerSecond/cyclesPerSecondSingleReplica << '\n';
+    }
+
+    std::cout << "\nSystolic array " << systolicArraySize << "x" << systolicArraySize
+                << ", multiplication " << sizeM << "x" << sizeK << " * "
+                << sizeK << "x" << sizeN << "\n\n"
+                << resultTableStringStream.str() << std::endl;
+
+    return 0;
+}
@@ -31,268 +31,2305 @@
 #include <chrono>
 #include <iostream>
 #include <cstddef>
+#include <cstdint>
 #include <cmath>
+#include <limits>
+#include <string>
+#include <algorithm>
+#include <utility>
+#include <functional>
+#include <deque>
+#include <cassert>
 
 #include "matrix_processing_unit.h"
+#include "fixed_geometry_matrix_processing_unit.h"
+#include "weight_fetcher.h"
+#include "ring_buffer_queue.h"
+#include "clocked_register_array.h"
+#include "activation_fifo.h"
+#include "unified_buffer_allocator.h"
 #include "mpu_statistics_logger.h"
 
-int main(int argc, char** argv)
+/**
+ * @brief                               Multiply random matrices on a reference MPU and on
+ *                                      MPUs that differ from it only in how they simulate
+ *                                      the multiplications, which have to produce the result
+ *                                      matrices and execution metrics of the reference MPU.
+ *                                      Registers the log entry callbacks of all MPUs.
+ * @param matrixProcessingUnitReference The reference MPU
+ * @param matrixProcessingUnitPtrArray  The MPUs compared against the reference MPU
+ * @param multiplicationCount           The number of multiplications
+ * @param sizeMDistribution             The distribution of the activation matrix height
+ * @param sizeNDistribution             The distribution of the weight matrix width
+ * @param sizeKDistribution             The distribution of the common matrix dimension
+ * @param matrixValueDistribution       The distribution of the matrix elements
+ * @param rng                           The random number generator
+ * @param weightMatrixNamePrefix        The prefix of the names of the weight matrices
+ * @param differenceString              Describes how the MPUs differ in the failure messages
+ * @param configureMultiplication       Called with the index of each multiplication
+ *                                      before running it
+ * @return                              False if a result matrix or the execution
+ *                                      metrics of an MPU differ
+ */
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename AccumulatorDatatype>
+static bool checkMultiplicationEquivalence(MatrixProcessingUnit<WeightDatatype,
+                                                                    ActivationDatatype,
+                                                                    AccumulatorDatatype>& matrixProcessingUnitReference,
+                                            const std::vector<MatrixProcessingUnit<WeightDatatype,
+                                                                                    ActivationDatatype,
+                                                                                    AccumulatorDatatype>*>& matrixProcessingUnitPtrArray,
+                                            const size_t multiplicationCount,
+                                            std::uniform_int_distribution<size_t>& sizeMDistribution,
+                                            std::uniform_int_distribution<size_t>& sizeNDistribution,
+                                            std::uniform_int_distribution<size_t>& sizeKDistribution,
+                                            std::normal_distribution<float>& matrixValueDistribution,
+                                            std::default_random_engine& rng,
+                                            const std::string& weightMatrixNamePrefix,
+                                            const std::string& differenceString,
+                                            const std::function<void(size_t)>& configureMultiplication =
+                                                                                std::function<void(size_t)>())
 {
+    std::string logEntryStringReference;
+    std::vector<std::string> logEntryStringArray(matrixProcessingUnitPtrArray.size());
+
+    matrixProcessingUnitReference.registerLogEntryAvailableCallback(
+                            [&logEntryStringReference](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+        logEntryStringReference = mpuStatisticsLogEntry.getExecutionMetricsString();
+    });
+
+    for(size_t mpuCount{0}; mpuCount < matrixProcessingUnitPtrArray.size(); ++mpuCount)
+    {
+        std::string* const logEntryStringPtr{&logEntryStringArray[mpuCount]};
+
+        matrixProcessingUnitPtrArray[mpuCount]->registerLogEntryAvailableCallback(
+                                [logEntryStringPtr](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+            *logEntryStringPtr = mpuStatisticsLogEntry.getExecutionMetricsString();
+        });
+    }
+
+    std::vector<ActivationDatatype> activationMatrix;
+    std::vector<WeightDatatype> weightMatrix;
+    std::vector<AccumulatorDatatype> resultMatrixReference;
+    std::vector<AccumulatorDatatype> resultMatrix;
+
+    bool testPassed{true};
+
+    for(size_t multiplication{0}; multiplication < multiplicationCount; ++multiplication)
+    {
+        const size_t sizeM{sizeMDistribution(rng)};
+        const size_t sizeN{sizeNDistribution(rng)};
+        const size_t sizeK{sizeKDistribution(rng)};
+
+        std::cout << "Multiplication " << multiplication + 1 << ": "
+                    << sizeM << "x" << sizeK << " * "
+                    << sizeK << "x" << sizeN << std::endl;
+
+        activationMatrix.clear();
+
+        for(size_t elementCount{0}; elementCount < sizeM*sizeK; ++elementCount)
+        {
+            activationMatrix.emplace_back(static_cast<ActivationDatatype>(
+                                                        matrixValueDistribution(rng)));
+        }
+
+        weightMatrix.clear();
+
+        for(size_t elementCount{0}; elementCount < sizeK*sizeN; ++elementCount)
+        {
+            weightMatrix.emplace_back(static_cast<WeightDatatype>(
+                                                matrixValueDistribution(rng)));
+        }
+
+        if(configureMultiplication)
+        {
+            configureMultiplication(multiplication);
+        }
+
+        const std::string weightMatrixNameString{weightMatrixNamePrefix + std::to_string(multiplication)};
 
+        resultMatrixReference.clear();
+        resultMatrixReference.resize(sizeM*sizeN);
+
+        matrixProcessingUnitReference.storeActivationMatrix(activationMatrix.data(), sizeM, sizeK);
+        matrixProcessingUnitReference.storeWeightMatrix(weightMatrixNameString, weightMatrix.data(), sizeK, sizeN);
+        matrixProcessingUnitReference.runMultiplication(weightMatrixNameString);
+        matrixProcessingUnitReference.loadResultMatrix(resultMatrixReference.data(), resultMatrixReference.size());
+
+        for(size_t mpuCount{0}; mpuCount < matrixProcessingUnitPtrArray.size(); ++mpuCount)
+        {
+            MatrixProcessingUnit<WeightDatatype,
+                                    ActivationDatatype,
+                                    AccumulatorDatatype>& matrixProcessingUnit{*matrixProcessingUnitPtrArray[mpuCount]};
+
+            resultMatrix.clear();
+            resultMatrix.resize(sizeM*sizeN);
+
+            matrixProcessingUnit.storeActivationMatrix(activationMatrix.data(), sizeM, sizeK);
+            matrixProcessingUnit.storeWeightMatrix(weightMatrixNameString, weightMatrix.data(), sizeK, sizeN);
+            matrixProcessingUnit.runMultiplication(weightMatrixNameString);
+            matrixProcessingUnit.loadResultMatrix(resultMatrix.data(), resultMatrix.size());
+
+            if(logEntryStringArray[mpuCount] != logEntryStringReference)
+            {
+                std::cout << "Execution metrics " << differenceString << " differ:\n"
+                            << logEntryStringReference
+                            << logEntryStringArray[mpuCount];
+
+                testPassed = false;
+            }
+
+            if(resultMatrix != resultMatrixReference)
+            {
+                std::cout << "Result matrix " << differenceString << " differs" << std::endl;
+
+                testPassed = false;
+            }
+        }
+    }
+
+    return testPassed;
+}
+
+/**
+ * @brief   Regression test for activation matrices with a single row
+ *          last block. Every combination of single and multiple pass
+ *          multiplications and of single and multiple weight matrix
+ *          column blocks is multiplied with the cycle accurate simulation
+ *          of both systolic array engines and with the analytical model,
+ *          which have to produce identical results and execution metrics.
+ *          Accumulator array heights smaller than twice the systolic array
+ *          height have to be rejected.
+ * @return  False if the test failed
+ */
+
+static bool testSingleRowActivationMatrixBlocks()
+{
     using WeightDatatype = int8_t;
     using ActivationDatatype = int8_t;
     using AccumulatorDatatype = int32_t;
 
-    constexpr size_t systolicArrayWidth{64UL};
-    constexpr size_t systolicArrayHeight{64UL};
-    constexpr size_t accumulatorArrayHeight{256UL};
+    constexpr size_t systolicArrayWidth{24UL};
+    constexpr size_t systolicArrayHeight{16UL};
+    constexpr size_t accumulatorArrayHeight{2UL*systolicArrayHeight};
+    constexpr size_t activationFifoDepth{4UL};
+    constexpr size_t unifiedBufferSizeByte{16UL*1024UL*1024UL};
 
-    constexpr size_t activationFifoDepth{8UL};
-    constexpr size_t unifiedBufferSizeByte{3UL*1024UL*1024UL*1024UL};
+    bool testPassed{true};
 
-    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnit(
+    try
+    {
+        MatrixProcessingUnit<WeightDatatype,
+                                ActivationDatatype,
+                                AccumulatorDatatype> matrixProcessingUnitBufferTooSmall(
+                                                                            systolicArrayWidth,
+                                                                            systolicArrayHeight,
+                                                                            activationFifoDepth,
+                                                                            accumulatorArrayHeight - 2UL,
+                                                                            unifiedBufferSizeByte);
+
+        std::cout << "Accumulator array buffer smaller than systolic array height accepted" << std::endl;
+
+        testPassed = false;
+    }
+
+    catch(const MpuException&)
+    {
+    }
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitStructureOfArrays(
                                                                                             systolicArrayWidth,
                                                                                             systolicArrayHeight,
                                                                                             activationFifoDepth,
                                                                                             accumulatorArrayHeight,
-                                                                                            unifiedBufferSizeByte);
+                                                                                            unifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
 
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitProcessingElements(
+                                                                                            systolicArrayWidth,
+                                                                                            systolicArrayHeight,
+                                                                                            activationFifoDepth,
+                                                                                            accumulatorArrayHeight,
+                                                                                            unifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::ProcessingElements);
 
-    matrixProcessingUnit.setDebugFlag(true);
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitAnalytical(
+                                                                                            systolicArrayWidth,
+                                                                                            systolicArrayHeight,
+                                                                                            activationFifoDepth,
+                                                                                            accumulatorArrayHeight,
+                                                                                            unifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
 
-    MpuStatisticsLogger mpuStatisticsLogger("test", sizeof(WeightDatatype),
-                                                sizeof(ActivationDatatype),
-                                                sizeof(AccumulatorDatatype));
+    matrixProcessingUnitProcessingElements.setSteadyStateSkipping(false);
+    matrixProcessingUnitAnalytical.setSimulationMode(MpuSimulationMode::Analytical);
 
-    matrixProcessingUnit.registerLogEntryAvailableCallback(
-                            [&mpuStatisticsLogger](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
-        mpuStatisticsLogger.addMpuStatisticsLogEntry(std::move(mpuStatisticsLogEntry));
+    std::string logEntryStringStructureOfArrays;
+    std::string logEntryStringProcessingElements;
+    std::string logEntryStringAnalytical;
+
+    matrixProcessingUnitStructureOfArrays.registerLogEntryAvailableCallback(
+                            [&logEntryStringStructureOfArrays](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+        logEntryStringStructureOfArrays = mpuStatisticsLogEntry.getExecutionMetricsString();
     });
 
-    std::default_random_engine rng(static_cast<unsigned long>(
-                                    std::chrono::duration_cast<std::chrono::milliseconds>(
-                                    std::chrono::time_point_cast<std::chrono::milliseconds>(
-                                    std::chrono::high_resolution_clock::now()).time_since_epoch()).count()));
+    matrixProcessingUnitProcessingElements.registerLogEntryAvailableCallback(
+                            [&logEntryStringProcessingElements](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+        logEntryStringProcessingElements = mpuStatisticsLogEntry.getExecutionMetricsString();
+    });
 
-    std::uniform_int_distribution<size_t> matrixDimensionDistribution(1UL, 8192UL);
+    matrixProcessingUnitAnalytical.registerLogEntryAvailableCallback(
+                            [&logEntryStringAnalytical](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+        logEntryStringAnalytical = mpuStatisticsLogEntry.getExecutionMetricsString();
+    });
+
+    std::default_random_engine rng(0UL);
     std::normal_distribution<float> matrixValueDistribution(0.0F, 8.0F);
 
     std::vector<ActivationDatatype> activationMatrix;
     std::vector<WeightDatatype> weightMatrix;
+    std::vector<AccumulatorDatatype> resultMatrixReference;
     std::vector<AccumulatorDatatype> resultMatrix;
 
-    size_t multiplicationCount{0UL};
-    
-    bool sanityCheckPassedDynamic{true};
-    bool sanityCheckPassedStatic{true};
+    /* Single row activation matrices, and activation matrices with a
+     * single row last block following one and two complete blocks */
 
-    std::cout << "MPU test 0: Dynamic unified buffer resize" << std::endl;
+    for(const size_t sizeM : {1UL, accumulatorArrayHeight/2UL + 1UL, accumulatorArrayHeight + 1UL})
+    {
+        for(const size_t sizeK : {systolicArrayHeight/2UL, systolicArrayHeight,
+                                        5UL*systolicArrayHeight/2UL})
+        {
+            for(const size_t sizeN : {systolicArrayWidth/2UL, 2UL*systolicArrayWidth + 2UL})
+            {
+                std::cout << "Multiplication: " << sizeM << "x" << sizeK
+                            << " * " << sizeK << "x" << sizeN << std::endl;
 
-    for(size_t memoryManagementUnitTestCount{0UL}; memoryManagementUnitTestCount < 16UL;
-                                                                    ++memoryManagementUnitTestCount)
+                activationMatrix.clear();
+
+                for(size_t elementCount{0}; elementCount < sizeM*sizeK; ++elementCount)
+                {
+                    activationMatrix.emplace_back(static_cast<ActivationDatatype>(
+                                                                matrixValueDistribution(rng)));
+                }
+
+                weightMatrix.clear();
+
+                for(size_t elementCount{0}; elementCount < sizeK*sizeN; ++elementCount)
+                {
+                    weightMatrix.emplace_back(static_cast<WeightDatatype>(
+                                                        matrixValueDistribution(rng)));
+                }
+
+                const std::string weightMatrixNameString{"single_row_test_" +
+                                                            std::to_string(sizeM) + "_" +
+                                                            std::to_string(sizeK) + "_" +
+                                                            std::to_string(sizeN)};
+
+                for(MatrixProcessingUnit<WeightDatatype,
+                                            ActivationDatatype,
+                                            AccumulatorDatatype>* matrixProcessingUnitPtr :
+                                                            {&matrixProcessingUnitStructureOfArrays,
+                                                                &matrixProcessingUnitProcessingElements,
+                                                                &matrixProcessingUnitAnalytical})
+                {
+                    matrixProcessingUnitPtr->storeActivationMatrix(activationMatrix.data(),
+                                                                        sizeM, sizeK);
+
+                    matrixProcessingUnitPtr->storeWeightMatrix(weightMatrixNameString,
+                                                                    weightMatrix.data(),
+                                                                    sizeK, sizeN);
+
+                    try
+                    {
+                        matrixProcessingUnitPtr->runMultiplication(weightMatrixNameString);
+                    }
+
+                    catch(const MpuException& mpuException)
+                    {
+                        std::cout << "Multiplication failed: " << mpuException.what() << std::endl;
+
+                        testPassed = false;
+                    }
+
+                    resultMatrix.clear();
+                    resultMatrix.resize(sizeM*sizeN);
+
+                    matrixProcessingUnitPtr->loadResultMatrix(resultMatrix.data(),
+                                                                resultMatrix.size());
+
+                    if(matrixProcessingUnitPtr == &matrixProcessingUnitStructureOfArrays)
+                    {
+                        resultMatrixReference = resultMatrix;
+                    }
+
+                    else if(resultMatrix != resultMatrixReference)
+                    {
+                        std::cout << "Result matrices differ" << std::endl;
+
+                        testPassed = false;
+                    }
+                }
+
+                if((logEntryStringStructureOfArrays != logEntryStringProcessingElements) ||
+                        (logEntryStringStructureOfArrays != logEntryStringAnalytical))
+                {
+                    std::cout << "Execution metrics differ:\n"
+                                << logEntryStringStructureOfArrays
+                                << logEntryStringProcessingElements
+                                << logEntryStringAnalytical;
+
+                    testPassed = false;
+                }
+            }
+        }
+    }
+
+    return testPassed;
+}
+
+/**
+ * @class   WeightRecordingSystolicArray
+ * @brief   Systolic array stub for the weight fetcher unit check.
+ *          Records the weight stored to every PE and the number of
+ *          stores to it, all other engine operations are no-ops.
+ */
+
+template<typename WeightDatatype,
+            typename ActivationDatatype,
+            typename SumDatatype> class WeightRecordingSystolicArray: public SystolicArray<WeightDatatype,
+                                                                                            ActivationDatatype,
+                                                                                            SumDatatype>
+{
+
+public:
+
+    WeightRecordingSystolicArray(const size_t width,
+                                    const size_t height): SystolicArray<WeightDatatype,
+                                                                            ActivationDatatype,
+                                                                            SumDatatype>(width, height, 2UL),
+                                                            m_weightArray(width*height),
+                                                            m_storeCountArray(width*height)
     {
-        ++multiplicationCount;
+    }
 
-        std::cout << "Multiplication " << multiplicationCount << std::endl;
+    void storeWeight(const PEPosition& position,
+                        const WeightDatatype value) final
+    {
+        assert((position.x < this->getWidth()) && (position.y < this->getHeight()));
 
-        size_t sizeM;
-        size_t sizeN;
-        size_t sizeK;
+        m_weightArray[position.y*this->getWidth() + position.x] = value;
+        ++m_storeCountArray[position.y*this->getWidth() + position.x];
+    }
 
-        do
+    void clearRecordedWeights()
+    {
+        std::fill(m_weightArray.begin(), m_weightArray.end(), WeightDatatype(0));
+        std::fill(m_storeCountArray.begin(), m_storeCountArray.end(), 0UL);
+    }
+
+    WeightDatatype getRecordedWeight(const size_t x, const size_t y) const
+    {
+        return m_weightArray[y*this->getWidth() + x];
+    }
+
+    size_t getRecordedStoreCount(const size_t x, const size_t y) const
+    {
+        return m_storeCountArray[y*this->getWidth() + x];
+    }
+
+    void setUpdateWeightsSignal(const bool) final {}
+    void readUpdateWeightSignals() final {}
+
+    SumDatatype getBottomRowSum(const size_t) const final { return SumDatatype(0); }
+    bool bottomRowHasValidSignal(const size_t) const final { return false; }
+    bool bottomRowHasUpdateWeightSignal(const size_t) const final { return false; }
+
+private:
+
+    bool hasSteadyStateSignals() const final { return false; }
+
+    void readProcessingElementRegisters(std::vector<WeightDatatype>&,
+                                            std::vector<ActivationDatatype>&,
+                                            std::vector<SumDatatype>&) const final {}
+
+    void writeProcessingElementRegisters(const std::vector<ActivationDatatype>&,
+                                            const std::vector<SumDatatype>&) final {}
+
+    bool fifoInputEnabled(const size_t) const final { return false; }
+    void enableFifoInput(const size_t, const bool) final {}
+
+    void prepareComputeRows() final {}
+    void computeRows(const size_t, const size_t, SystolicArrayCounters&) final {}
+    void updateProcessingElementStates() final {}
+
+    std::vector<WeightDatatype> m_weightArray;
+    std::vector<size_t> m_storeCountArray;
+};
+
+/**
+ * @brief   Unit check of the precomputed diagonal load tables of the
+ *          weight fetcher. Every block of weight matrices with and
+ *          without inactive columns and idle rows in their last blocks
+ *          is loaded into a recording systolic array, which has to hold
+ *          the block weights, zero weights in the inactive PEs, and a
+ *          single store per PE after one iteration per diagonal.
+ * @return  False if the test failed
+ */
+
+static bool testWeightFetcherDiagonalLoads()
+{
+    using WeightDatatype = int16_t;
+
+    constexpr size_t systolicArrayWidth{5UL};
+    constexpr size_t systolicArrayHeight{3UL};
+    constexpr size_t systolicArrayDiagonals{systolicArrayWidth + systolicArrayHeight - 1UL};
+
+    const std::vector<std::pair<size_t, size_t>> matrixSizeArray{{5UL, 3UL}, {10UL, 6UL},
+                                                                    {1UL, 1UL}, {3UL, 2UL},
+                                                                    {7UL, 4UL}, {12UL, 8UL},
+                                                                    {5UL, 7UL}, {11UL, 3UL}};
+
+    WeightRecordingSystolicArray<WeightDatatype, int8_t, int32_t> systolicArray(systolicArrayWidth,
+                                                                                    systolicArrayHeight);
+
+    WeightFetcher<WeightDatatype, int8_t, int32_t> weightFetcher(&systolicArray);
+
+    bool testPassed{true};
+
+    for(const std::pair<size_t, size_t>& matrixSize : matrixSizeArray)
+    {
+        const size_t matrixWidth{matrixSize.first};
+        const size_t matrixHeight{matrixSize.second};
+
+        std::vector<WeightDatatype> weightMatrix(matrixWidth*matrixHeight);
+
+        for(size_t element{0}; element < weightMatrix.size(); ++element)
         {
-            sizeM = matrixDimensionDistribution(rng);
-            sizeN = matrixDimensionDistribution(rng);
-            sizeK = matrixDimensionDistribution(rng);
+            weightMatrix[element] = static_cast<WeightDatatype>(element + 1UL);
         }
 
-        while((sizeM*sizeN*sizeK > (1UL << 24)) ||
-                            ((sizeN > systolicArrayWidth) &&
-                                (sizeK <= systolicArrayHeight)));
+        weightFetcher.setInput(weightMatrix.data(), matrixWidth, matrixHeight);
+        weightFetcher.updateState();
 
-        const size_t sizeMConst{sizeM};
-        const size_t sizeNConst{sizeN};
-        const size_t sizeKConst{sizeK};
+        const size_t blockCountX{weightFetcher.getBlockCountX()};
+        const size_t blockCountY{weightFetcher.getBlockCountY()};
 
-        activationMatrix.clear();
+        const size_t idleRowsLastBlock{blockCountY*systolicArrayHeight - matrixHeight};
 
-        for(size_t rowCount{0}; rowCount < sizeMConst; ++rowCount)
+        for(size_t blockY{0}; blockY < blockCountY; ++blockY)
         {
-            for(size_t columnCount{0}; columnCount < sizeKConst; ++columnCount)
+            for(size_t blockX{0}; blockX < blockCountX; ++blockX)
             {
-                activationMatrix.emplace_back(static_cast<ActivationDatatype>(
-                                                            matrixValueDistribution(rng)));
+                systolicArray.clearRecordedWeights();
+
+                weightFetcher.updateWeights(blockX, blockY);
+
+                size_t iterationCount{0UL};
+
+                do
+                {
+                    weightFetcher.runIteration();
+                    weightFetcher.updateState();
+
+                    ++iterationCount;
+                }
+                while(weightFetcher.hasBusySignal() &&
+                            (iterationCount <= systolicArrayDiagonals));
+
+                if(iterationCount != systolicArrayDiagonals)
+                {
+                    std::cout << "Weight fetcher took " << iterationCount
+                                << " iterations to load block (" << blockX
+                                << ", " << blockY << ") of a " << matrixHeight
+                                << "x" << matrixWidth << " matrix" << std::endl;
+
+                    testPassed = false;
+                }
+
+                const size_t idleRows{(blockY == (blockCountY - 1UL)) ? idleRowsLastBlock : 0UL};
+
+                for(size_t y{0}; y < systolicArrayHeight; ++y)
+                {
+                    for(size_t x{0}; x < systolicArrayWidth; ++x)
+                    {
+                        const size_t column{blockX*systolicArrayWidth + x};
+
+                        const WeightDatatype weightExpected{((column < matrixWidth) && (y >= idleRows)) ?
+                                                    weightMatrix[(blockY*systolicArrayHeight + y - idleRows)*
+                                                                                    matrixWidth + column] :
+                                                    WeightDatatype(0)};
+
+                        if((systolicArray.getRecordedWeight(x, y) != weightExpected) ||
+                                    (systolicArray.getRecordedStoreCount(x, y) != 1UL))
+                        {
+                            std::cout << "Weight fetcher stored " << systolicArray.getRecordedWeight(x, y)
+                                        << " in " << systolicArray.getRecordedStoreCount(x, y)
+                                        << " stores to PE (" << x << ", " << y << ") for block ("
+                                        << blockX << ", " << blockY << ") of a " << matrixHeight
+                                        << "x" << matrixWidth << " matrix, expected "
+                                        << weightExpected << std::endl;
+
+                            testPassed = false;
+                        }
+                    }
+                }
             }
         }
+    }
 
-        weightMatrix.clear();
+    return testPassed;
+}
 
-        for(size_t rowCount{0}; rowCount < sizeKConst; ++rowCount)
+/**
+ * @brief   Unit check of the ring buffer request queue. A random
+ *          sequence of pushes, retirements from the front and out
+ *          of order retirements wraps around the buffer several
+ *          times and is replayed on a std::deque, which has to hold
+ *          the same requests in the same order after every operation.
+ *          The occupancy statistics are checked against the occupancy
+ *          of the reference queue, pushing to a full queue has to throw.
+ * @return  False if the test failed
+ */
+
+static bool testRingBufferQueue()
+{
+    constexpr size_t capacity{5UL};
+    constexpr size_t operationCount{2000UL};
+
+    RingBufferQueue<size_t> ringBufferQueue(capacity);
+    std::deque<size_t> referenceQueue;
+
+    std::default_random_engine rng(0UL);
+    std::uniform_int_distribution<size_t> operationDistribution(0UL, 9UL);
+
+    size_t pushCount{0UL};
+    size_t occupancySum{0UL};
+    size_t occupancyMax{0UL};
+
+    bool testPassed{true};
+
+    for(size_t operation{0}; operation < operationCount; ++operation)
+    {
+        const size_t operationKind{operationDistribution(rng)};
+
+        /* Pushes are more frequent than retirements,
+         * so that the queue is regularly full */
+
+        if((operationKind < 6UL) && (referenceQueue.size() < capacity))
         {
-            for(size_t columnCount{0}; columnCount < sizeNConst; ++columnCount)
+            ringBufferQueue.push_back(operation);
+            referenceQueue.push_back(operation);
+
+            ++pushCount;
+            occupancySum += referenceQueue.size();
+            occupancyMax = std::max(occupancyMax, referenceQueue.size());
+        }
+
+        else if((operationKind < 6UL) && (referenceQueue.size() == capacity))
+        {
+            try
             {
-                weightMatrix.emplace_back(static_cast<WeightDatatype>(
+                ringBufferQueue.push_back(operation);
+
+                std::cout << "Push to full ring buffer queue accepted" << std::endl;
+
+                testPassed = false;
+            }
+
+            catch(const MpuException&)
+            {
+            }
+        }
+
+        else if((operationKind < 9UL) && !referenceQueue.empty())
+        {
+            ringBufferQueue.pop_front();
+            referenceQueue.pop_front();
+        }
+
+        else if(!referenceQueue.empty())
+        {
+            const size_t index{operation % referenceQueue.size()};
+
+            ringBufferQueue.erase(index);
+            referenceQueue.erase(referenceQueue.begin() + index);
+        }
+
+        bool queueEqual{(ringBufferQueue.size() == referenceQueue.size()) &&
+                            (ringBufferQueue.empty() == referenceQueue.empty())};
+
+        for(size_t index{0}; queueEqual && (index < referenceQueue.size()); ++index)
+        {
+            queueEqual = (ringBufferQueue[index] == referenceQueue[index]);
+        }
+
+        if(queueEqual && !referenceQueue.empty())
+        {
+            queueEqual = (ringBufferQueue.front() == referenceQueue.front());
+        }
+
+        if(!queueEqual)
+        {
+            std::cout << "Ring buffer queue differs from reference queue after operation "
+                        << operation << std::endl;
+
+            return false;
+        }
+    }
+
+    if((ringBufferQueue.capacity() != capacity) ||
+            (ringBufferQueue.getPushCount() != pushCount) ||
+            (ringBufferQueue.getOccupancyMax() != occupancyMax) ||
+            (std::abs(ringBufferQueue.getOccupancyMean() -
+                        static_cast<double>(occupancySum)/
+                        static_cast<double>(pushCount)) > 1e-9))
+    {
+        std::cout << "Ring buffer queue occupancy statistics: " << ringBufferQueue.getPushCount()
+                    << " pushes, maximum " << ringBufferQueue.getOccupancyMax() << ", mean "
+                    << ringBufferQueue.getOccupancyMean() << ", expected " << pushCount
+                    << " pushes, maximum " << occupancyMax << ", mean "
+                    << static_cast<double>(occupancySum)/static_cast<double>(pushCount) << std::endl;
+
+        testPassed = false;
+    }
+
+    /* Clearing keeps the statistics, resetting them
+     * returns all of them to zero */
+
+    ringBufferQueue.clear();
+
+    if(!ringBufferQueue.empty() || (ringBufferQueue.getPushCount() != pushCount))
+    {
+        std::cout << "Ring buffer queue not empty or statistics lost after clear()" << std::endl;
+
+        testPassed = false;
+    }
+
+    ringBufferQueue.resetOccupancyStatistics();
+
+    if((ringBufferQueue.getPushCount() != 0UL) ||
+            (ringBufferQueue.getOccupancyMax() != 0UL) ||
+            (ringBufferQueue.getOccupancyMean() != 0.0))
+    {
+        std::cout << "Ring buffer queue occupancy statistics not reset" << std::endl;
+
+        testPassed = false;
+    }
+
+    /* A queue filled to capacity after the clear
+     * starts at the front of the buffer again */
+
+    for(size_t element{0}; element < capacity; ++element)
+    {
+        ringBufferQueue.push_back(element);
+    }
+
+    for(size_t element{0}; element < capacity; ++element)
+    {
+        if(ringBufferQueue[element] != element)
+        {
+            std::cout << "Ring buffer queue refilled after clear() holds "
+                        << ringBufferQueue[element] << " at position "
+                        << element << std::endl;
+
+            testPassed = false;
+        }
+    }
+
+    if((ringBufferQueue.getOccupancyMax() != capacity) ||
+            (ringBufferQueue.getOccupancyMean() != 3.0))
+    {
+        std::cout << "Ring buffer queue occupancy statistics wrong after refill" << std::endl;
+
+        testPassed = false;
+    }
+
+    return testPassed;
+}
+
+/**
+ * @brief   Unit check of the word operations of the clocked bit array.
+ *          Arrays with sizes below, at, and above multiples of the word
+ *          size are clocked with random holdAll(), fillNext(), setNext()
+ *          and whole word writes, and with cycles without writes, which
+ *          have to keep the current state. The bits, the packed words
+ *          including the zero bits past the size of the array, and the
+ *          any() reductions are checked against a std::vector<bool>
+ *          reference of the current and the next state.
+ * @return  False if the test failed
+ */
+
+static bool testClockedBitArray()
+{
+    constexpr size_t cycleCount{400UL};
+
+    const std::vector<size_t> sizeArray{1UL, 63UL, 64UL, 65UL, 130UL, 200UL};
+
+    std::default_random_engine rng(0UL);
+    std::uniform_int_distribution<size_t> operationDistribution(0UL, 4UL);
+    std::uniform_int_distribution<std::uint64_t> wordDistribution;
+    std::bernoulli_distribution bitDistribution(0.05);
+
+    bool testPassed{true};
+
+    for(const size_t size : sizeArray)
+    {
+        ClockedBitArray clockedBitArray(size);
+
+        std::vector<bool> currentReference(size, false);
+        std::vector<bool> nextReference(size, false);
+
+        const size_t wordBits{ClockedBitArray::wordBits};
+
+        if(clockedBitArray.wordCount() != ((size + wordBits - 1UL)/wordBits))
+        {
+            std::cout << "Clocked bit array of size " << size << " has "
+                        << clockedBitArray.wordCount() << " words" << std::endl;
+
+            testPassed = false;
+        }
+
+        for(size_t cycle{0}; cycle < cycleCount; ++cycle)
+        {
+            const size_t operationKind{operationDistribution(rng)};
+
+            bool nextWritten{true};
+
+            switch(operationKind)
+            {
+                /* Hold the current state and flip a few bits */
+
+                case 0:
+                {
+                    clockedBitArray.holdAll();
+                    nextReference = currentReference;
+
+                    for(size_t index{0}; index < size; ++index)
+                    {
+                        if(bitDistribution(rng))
+                        {
+                            clockedBitArray.setNext(index, !currentReference[index]);
+                            nextReference[index] = !currentReference[index];
+                        }
+                    }
+
+                    break;
+                }
+
+                /* Fill the next state and clear or set a few bits */
+
+                case 1:
+                case 2:
+                {
+                    const bool value{operationKind == 1UL};
+
+                    clockedBitArray.fillNext(value);
+                    std::fill(nextReference.begin(), nextReference.end(), value);
+
+                    for(size_t index{0}; index < size; ++index)
+                    {
+                        if(bitDistribution(rng))
+                        {
+                            clockedBitArray.setNext(index, !value);
+                            nextReference[index] = !value;
+                        }
+                    }
+
+                    break;
+                }
+
+                /* Write whole words, masking the bits past
+                 * the size of the array in the last word */
+
+                case 3:
+                {
+                    std::uint64_t* const nextWordPtr{clockedBitArray.nextWords()};
+
+                    for(size_t word{0}; word < clockedBitArray.wordCount(); ++word)
+                    {
+                        const size_t wordSize{std::min(wordBits, size - word*wordBits)};
+
+                        const std::uint64_t wordMask{(wordSize == wordBits) ? ~std::uint64_t{0} :
+                                                        ((std::uint64_t{1} << wordSize) - 1UL)};
+
+                        nextWordPtr[word] = wordDistribution(rng) & wordMask;
+
+                        for(size_t bit{0}; bit < wordSize; ++bit)
+                        {
+                            nextReference[word*wordBits + bit] = (nextWordPtr[word] >> bit) & 1UL;
+                        }
+                    }
+
+                    break;
+                }
+
+                /* No write, the update has to keep the current state */
+
+                default:
+                {
+                    nextWritten = false;
+                    break;
+                }
+            }
+
+            if(nextWritten)
+            {
+                bool anyNextReference{false};
+
+                for(size_t index{0}; index < size; ++index)
+                {
+                    anyNextReference = anyNextReference || nextReference[index];
+
+                    if(clockedBitArray.next(index) != nextReference[index])
+                    {
+                        std::cout << "Clocked bit array of size " << size << " next bit "
+                                    << index << " differs in cycle " << cycle << std::endl;
+
+                        testPassed = false;
+                    }
+                }
+
+                if(clockedBitArray.anyNext() != anyNextReference)
+                {
+                    std::cout << "Clocked bit array of size " << size
+                                << " anyNext() differs in cycle " << cycle << std::endl;
+
+                    testPassed = false;
+                }
+
+                currentReference = nextReference;
+            }
+
+            clockedBitArray.update();
+
+            bool anyCurrentReference{false};
+
+            for(size_t index{0}; index < size; ++index)
+            {
+                anyCurrentReference = anyCurrentReference || currentReference[index];
+
+                const bool wordBit{((clockedBitArray.currentWords()[index/wordBits] >>
+                                                        (index % wordBits)) & 1UL) != 0UL};
+
+                if((clockedBitArray.current(index) != currentReference[index]) ||
+                                                (wordBit != currentReference[index]))
+                {
+                    std::cout << "Clocked bit array of size " << size << " current bit "
+                                << index << " differs in cycle " << cycle << std::endl;
+
+                    testPassed = false;
+                }
+            }
+
+            if(size % wordBits)
+            {
+                const std::uint64_t tailWord{clockedBitArray.currentWords()[clockedBitArray.wordCount() - 1UL]};
+
+                if(tailWord >> (size % wordBits))
+                {
+                    std::cout << "Clocked bit array of size " << size
+                                << " has bits past its size set in cycle "
+                                << cycle << std::endl;
+
+                    testPassed = false;
+                }
+            }
+
+            if(clockedBitArray.anyCurrent() != anyCurrentReference)
+            {
+                std::cout << "Clocked bit array of size " << size
+                            << " anyCurrent() differs in cycle " << cycle << std::endl;
+
+                testPassed = false;
+            }
+
+            if(!testPassed)
+            {
+                return false;
+            }
+        }
+    }
+
+    return testPassed;
+}
+
+/**
+ * @brief   Unit check of the bulk activation FIFO streaming. FIFOs of
+ *          power of two and other sizes are driven with a random sequence
+ *          of single pushes, single pops and pushPop() calls of random
+ *          length, starting from empty, partially filled and full FIFOs
+ *          and wrapping around the ring buffer. A reference FIFO executes
+ *          each pushPop() as one push() and pop() per iteration and has
+ *          to pop the same values and report the same content size and
+ *          state after every operation.
+ * @return  False if the test failed
+ */
+
+static bool testActivationFifoPushPop()
+{
+    constexpr size_t operationCount{3000UL};
+    constexpr size_t pushPopCountMax{20UL};
+
+    const std::vector<size_t> sizeArray{2UL, 3UL, 4UL, 5UL, 8UL, 9UL};
+
+    std::default_random_engine rng(0UL);
+    std::uniform_int_distribution<size_t> operationDistribution(0UL, 3UL);
+    std::uniform_int_distribution<size_t> pushPopCountDistribution(0UL, pushPopCountMax);
+
+    std::vector<int32_t> inputArray(pushPopCountMax);
+    std::vector<int32_t> outputArray(pushPopCountMax);
+    std::vector<int32_t> outputReferenceArray(pushPopCountMax);
+
+    int32_t value{0};
+
+    bool testPassed{true};
+
+    for(const size_t size : sizeArray)
+    {
+        ActivationFifo<int32_t> activationFifo(size);
+        ActivationFifo<int32_t> activationFifoReference(size);
+
+        for(size_t operation{0}; operation < operationCount; ++operation)
+        {
+            const size_t operationKind{operationDistribution(rng)};
+
+            if(operationKind == 0UL)
+            {
+                activationFifo.push(value);
+                activationFifoReference.push(value);
+
+                ++value;
+            }
+
+            else if((operationKind == 1UL) && !activationFifoReference.isEmpty())
+            {
+                if(activationFifo.pop() != activationFifoReference.pop())
+                {
+                    std::cout << "Activation FIFO of size " << size
+                                << " popped a different value in operation "
+                                << operation << std::endl;
+
+                    testPassed = false;
+                }
+            }
+
+            else
+            {
+                const size_t count{pushPopCountDistribution(rng)};
+
+                for(size_t iterationCount{0}; iterationCount < count; ++iterationCount)
+                {
+                    inputArray[iterationCount] = value;
+                    ++value;
+
+                    activationFifoReference.push(inputArray[iterationCount]);
+                    outputReferenceArray[iterationCount] = activationFifoReference.pop();
+                }
+
+                activationFifo.pushPop(inputArray.data(), outputArray.data(), count);
+
+                if(!std::equal(outputArray.begin(), outputArray.begin() + count,
+                                                    outputReferenceArray.begin()))
+                {
+                    std::cout << "Activation FIFO of size " << size
+                                << " pushPop() of " << count << " values popped"
+                                << " different values in operation "
+                                << operation << std::endl;
+
+                    testPassed = false;
+                }
+            }
+
+            if((activationFifo.getContentSize() != activationFifoReference.getContentSize()) ||
+                    (activationFifo.isEmpty() != activationFifoReference.isEmpty()) ||
+                    (activationFifo.isFull() != activationFifoReference.isFull()) ||
+                    (activationFifo.isEmptyNextIteration() !=
+                                    activationFifoReference.isEmptyNextIteration()) ||
+                    (activationFifo.getContentSize() >= size))
+            {
+                std::cout << "Activation FIFO of size " << size
+                            << " holds " << activationFifo.getContentSize()
+                            << " values in operation " << operation
+                            << ", expected " << activationFifoReference.getContentSize()
+                            << std::endl;
+
+                testPassed = false;
+            }
+
+            if(!testPassed)
+            {
+                return false;
+            }
+        }
+
+        /* Drain both FIFOs, the values left have to be identical */
+
+        while(!activationFifoReference.isEmpty())
+        {
+            if(activationFifo.pop() != activationFifoReference.pop())
+            {
+                std::cout << "Activation FIFO of size " << size
+                            << " holds different values after the last operation"
+                            << std::endl;
+
+                return false;
+            }
+        }
+    }
+
+    return testPassed;
+}
+
+int main(int argc, char** argv)
+{
+
+    using WeightDatatype = int8_t;
+    using ActivationDatatype = int8_t;
+    using AccumulatorDatatype = int32_t;
+
+    constexpr size_t systolicArrayWidth{64UL};
+    constexpr size_t systolicArrayHeight{64UL};
+    constexpr size_t accumulatorArrayHeight{256UL};
+
+    constexpr size_t activationFifoDepth{8UL};
+    constexpr size_t unifiedBufferSizeByte{3UL*1024UL*1024UL*1024UL};
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnit(
+                                                                                            systolicArrayWidth,
+                                                                                            systolicArrayHeight,
+                                                                                            activationFifoDepth,
+                                                                                            accumulatorArrayHeight,
+                                                                                            unifiedBufferSizeByte);
+
+
+    matrixProcessingUnit.setDebugFlag(true);
+
+    MpuStatisticsLogger mpuStatisticsLogger("test", sizeof(WeightDatatype),
+                                                sizeof(ActivationDatatype),
+                                                sizeof(AccumulatorDatatype));
+
+    matrixProcessingUnit.registerLogEntryAvailableCallback(
+                            [&mpuStatisticsLogger](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+        mpuStatisticsLogger.addMpuStatisticsLogEntry(std::move(mpuStatisticsLogEntry));
+    });
+
+    /* The seed is printed so that failures with random
+     * matrix sizes and values can be reproduced */
+
+    const unsigned long rngSeed{static_cast<unsigned long>(
+                                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    std::chrono::time_point_cast<std::chrono::milliseconds>(
+                                    std::chrono::high_resolution_clock::now()).time_since_epoch()).count())};
+
+    std::cout << "Random number generator seed: " << rngSeed << std::endl;
+
+    std::default_random_engine rng(rngSeed);
+
+    std::uniform_int_distribution<size_t> matrixDimensionDistribution(1UL, 8192UL);
+    std::normal_distribution<float> matrixValueDistribution(0.0F, 8.0F);
+
+    std::vector<ActivationDatatype> activationMatrix;
+    std::vector<WeightDatatype> weightMatrix;
+    std::vector<AccumulatorDatatype> resultMatrix;
+
+    size_t multiplicationCount{0UL};
+    
+    bool sanityCheckPassedDynamic{true};
+    bool sanityCheckPassedStatic{true};
+    bool engineCheckPassed{true};
+    bool analyticalCheckPassed{true};
+    bool steadyStateCheckPassed{true};
+    bool workerTeamCheckPassed{true};
+    bool tileParallelCheckPassed{true};
+    bool singleRowBlockCheckPassed{true};
+    bool verificationPolicyCheckPassed{true};
+    bool weightFetcherCheckPassed{true};
+    bool ringBufferQueueCheckPassed{true};
+    bool drainModeCheckPassed{true};
+    bool clockedBitArrayCheckPassed{true};
+    bool activationFifoCheckPassed{true};
+    bool decoupledCheckPassed{true};
+    bool fixedGeometryCheckPassed{true};
+    bool unifiedBufferAllocationCheckPassed{true};
+    bool zeroCopyCheckPassed{true};
+
+    std::cout << "MPU test 0: Dynamic unified buffer resize" << std::endl;
+
+    for(size_t memoryManagementUnitTestCount{0UL}; memoryManagementUnitTestCount < 16UL;
+                                                                    ++memoryManagementUnitTestCount)
+    {
+        ++multiplicationCount;
+
+        std::cout << "Multiplication " << multiplicationCount << std::endl;
+
+        size_t sizeM;
+        size_t sizeN;
+        size_t sizeK;
+
+        do
+        {
+            sizeM = matrixDimensionDistribution(rng);
+            sizeN = matrixDimensionDistribution(rng);
+            sizeK = matrixDimensionDistribution(rng);
+        }
+
+        while((sizeM*sizeN*sizeK > (1UL << 24)) ||
+                            ((sizeN > systolicArrayWidth) &&
+                                (sizeK <= systolicArrayHeight)));
+
+        const size_t sizeMConst{sizeM};
+        const size_t sizeNConst{sizeN};
+        const size_t sizeKConst{sizeK};
+
+        activationMatrix.clear();
+
+        for(size_t rowCount{0}; rowCount < sizeMConst; ++rowCount)
+        {
+            for(size_t columnCount{0}; columnCount < sizeKConst; ++columnCount)
+            {
+                activationMatrix.emplace_back(static_cast<ActivationDatatype>(
+                                                            matrixValueDistribution(rng)));
+            }
+        }
+
+        weightMatrix.clear();
+
+        for(size_t rowCount{0}; rowCount < sizeKConst; ++rowCount)
+        {
+            for(size_t columnCount{0}; columnCount < sizeNConst; ++columnCount)
+            {
+                weightMatrix.emplace_back(static_cast<WeightDatatype>(
+                                                    matrixValueDistribution(rng)));
+            }
+        }
+
+        matrixProcessingUnit.storeActivationMatrix(activationMatrix.data(),
+                                                        sizeMConst, sizeKConst);
+
+        const std::string weightMatrixNameString{"test" + std::to_string(multiplicationCount)};
+
+        matrixProcessingUnit.storeWeightMatrix(weightMatrixNameString,
+                                                    weightMatrix.data(),
+                                                    sizeKConst, sizeNConst);
+
+        matrixProcessingUnit.runMultiplication(weightMatrixNameString);
+
+        resultMatrix.clear();
+        resultMatrix.resize(sizeMConst*sizeNConst);
+
+        matrixProcessingUnit.loadResultMatrix(resultMatrix.data(),
+                                                resultMatrix.size());
+
+        Eigen::Map<const RMatrix<ActivationDatatype>> matrixAEigen(
+                                                            activationMatrix.data(),
+                                                                    sizeMConst, sizeKConst);
+
+        Eigen::Map<const RMatrix<WeightDatatype>> matrixBEigen(
+                                                        weightMatrix.data(),
+                                                                sizeKConst, sizeNConst);
+
+        const RMatrix<AccumulatorDatatype> matrixCEigen{matrixAEigen.template cast<AccumulatorDatatype>()*
+                                                        matrixBEigen.template cast<AccumulatorDatatype>()};
+
+        for(size_t rowCount{0}; rowCount < sizeMConst; ++rowCount)
+        {
+            for(size_t columnCount{0}; columnCount < sizeNConst; ++columnCount)
+            {
+                if(resultMatrix[rowCount*sizeNConst + columnCount] !=
+                                    matrixCEigen(rowCount, columnCount))
+                {
+                    std::cout << "Systolic array output incorrect at ("
+                                << columnCount << ", " << rowCount
+                                << "): Expected value: "
+                                << matrixCEigen(rowCount, columnCount)
+                                << " actual value: "
+                                << resultMatrix[rowCount*sizeNConst + columnCount] << std::endl;
+
+                    sanityCheckPassedDynamic = false;
+                }
+            }
+        }
+    }
+
+    matrixProcessingUnit.printUnifiedBufferLayout();
+
+    matrixProcessingUnit.resetMemoryManagementUnit();
+    matrixProcessingUnit.setUnifiedBufferDynamicResize(false);
+    matrixProcessingUnit.resetIterationCounts();
+    matrixProcessingUnit.resetDataMovementAndFootprintMetrics();
+
+    multiplicationCount = 0UL;
+
+    std::cout << "MPU test 1: Static unified buffer size" << std::endl;
+
+    for(size_t memoryManagementUnitTestCount{0UL}; memoryManagementUnitTestCount < 16UL;
+                                                                    ++memoryManagementUnitTestCount)
+    {
+        ++multiplicationCount;
+
+        std::cout << "Multiplication " << multiplicationCount << std::endl;
+
+        size_t sizeM;
+        size_t sizeN;
+        size_t sizeK;
+
+        do
+        {
+            sizeM = matrixDimensionDistribution(rng);
+            sizeN = matrixDimensionDistribution(rng);
+            sizeK = matrixDimensionDistribution(rng);
+        }
+
+        while((sizeM*sizeN*sizeK > (1UL << 24)) ||
+                            ((sizeN <= systolicArrayWidth) !=
+                                (sizeK <= systolicArrayHeight)));
+
+        const size_t sizeMConst{sizeM};
+        const size_t sizeNConst{sizeN};
+        const size_t sizeKConst{sizeK};
+
+        activationMatrix.clear();
+
+        for(size_t rowCount{0}; rowCount < sizeMConst; ++rowCount)
+        {
+            for(size_t columnCount{0}; columnCount < sizeKConst; ++columnCount)
+            {
+                activationMatrix.emplace_back(static_cast<ActivationDatatype>(
+                                                            matrixValueDistribution(rng)));
+            }
+        }
+
+        weightMatrix.clear();
+
+        for(size_t rowCount{0}; rowCount < sizeKConst; ++rowCount)
+        {
+            for(size_t columnCount{0}; columnCount < sizeNConst; ++columnCount)
+            {
+                weightMatrix.emplace_back(static_cast<WeightDatatype>(
+                                                    matrixValueDistribution(rng)));
+            }
+        }
+
+        matrixProcessingUnit.storeActivationMatrix(activationMatrix.data(),
+                                                        sizeMConst, sizeKConst);
+
+        const std::string weightMatrixNameString{"test" + std::to_string(multiplicationCount)};
+
+        matrixProcessingUnit.storeWeightMatrix(weightMatrixNameString,
+                                                    weightMatrix.data(),
+                                                    sizeKConst, sizeNConst);
+
+        matrixProcessingUnit.runMultiplication(weightMatrixNameString);
+
+        resultMatrix.clear();
+        resultMatrix.resize(sizeMConst*sizeNConst);
+
+        matrixProcessingUnit.loadResultMatrix(resultMatrix.data(),
+                                                resultMatrix.size());
+
+        Eigen::Map<const RMatrix<ActivationDatatype>> matrixAEigen(
+                                                            activationMatrix.data(),
+                                                                        sizeMConst, sizeKConst);
+
+        Eigen::Map<const RMatrix<WeightDatatype>> matrixBEigen(
+                                                        weightMatrix.data(),
+                                                                sizeKConst, sizeNConst);
+
+        const RMatrix<AccumulatorDatatype> matrixCEigen{matrixAEigen.template cast<AccumulatorDatatype>()*
+                                                        matrixBEigen.template cast<AccumulatorDatatype>()};
+
+        for(size_t rowCount{0}; rowCount < sizeM; ++rowCount)
+        {
+            for(size_t columnCount{0}; columnCount < sizeN; ++columnCount)
+            {
+                if(resultMatrix[rowCount*sizeN + columnCount] !=
+                                    matrixCEigen(rowCount, columnCount))
+                {
+                    std::cout << "Systolic array output incorrect at ("
+                                << columnCount << ", " << rowCount
+                                << "): Expected value: "
+                                << matrixCEigen(rowCount, columnCount)
+                                << " actual value: "
+                                << resultMatrix[rowCount*sizeN + columnCount] << std::endl;
+
+                    sanityCheckPassedStatic = false;
+                }
+            }
+        }
+    }
+    
+    matrixProcessingUnit.printUnifiedBufferLayout();
+    
+    std::cout << "MPU test 2: Systolic array engine equivalence" << std::endl;
+
+    constexpr size_t engineTestSystolicArrayWidth{24UL};
+    constexpr size_t engineTestSystolicArrayHeight{16UL};
+    constexpr size_t engineTestAccumulatorArrayHeight{64UL};
+    constexpr size_t engineTestActivationFifoDepth{4UL};
+    constexpr size_t engineTestUnifiedBufferSizeByte{256UL*1024UL*1024UL};
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitProcessingElements(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::ProcessingElements);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitStructureOfArrays(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    std::uniform_int_distribution<size_t> engineTestMatrixDimensionDistribution(1UL, 512UL);
+
+    engineCheckPassed = checkMultiplicationEquivalence(matrixProcessingUnitProcessingElements,
+                                                       {&matrixProcessingUnitStructureOfArrays},
+                                                       16UL,
+                                                       engineTestMatrixDimensionDistribution,
+                                                       engineTestMatrixDimensionDistribution,
+                                                       engineTestMatrixDimensionDistribution,
+                                                       matrixValueDistribution, rng,
+                                                       "engine_test",
+                                                       "of the systolic array engines");
+
+    std::cout << "MPU test 3: Analytical model equivalence" << std::endl;
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitCycleAccurate(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitAnalytical(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    matrixProcessingUnitAnalytical.setSimulationMode(MpuSimulationMode::Analytical);
+
+    analyticalCheckPassed = checkMultiplicationEquivalence(matrixProcessingUnitCycleAccurate,
+                                                           {&matrixProcessingUnitAnalytical},
+                                                           16UL,
+                                                           engineTestMatrixDimensionDistribution,
+                                                           engineTestMatrixDimensionDistribution,
+                                                           engineTestMatrixDimensionDistribution,
+                                                           matrixValueDistribution, rng,
+                                                           "analytical_test",
+                                                           "of the analytical model");
+
+    std::cout << "MPU test 4: Steady state iteration skipping" << std::endl;
+
+    constexpr size_t steadyStateTestAccumulatorArrayHeight{512UL};
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitStepped(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            steadyStateTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitSkippingStructureOfArrays(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            steadyStateTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitSkippingProcessingElements(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            steadyStateTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::ProcessingElements);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitSkippingTemporalTiling(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            steadyStateTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    matrixProcessingUnitStepped.setSteadyStateSkipping(false);
+
+    matrixProcessingUnitSkippingTemporalTiling.setSteadyStateExecutionMode(
+                                                    SteadyStateExecutionMode::TemporalTiling);
+    matrixProcessingUnitSkippingTemporalTiling.setSystolicArrayWorkerCount(3UL);
+    matrixProcessingUnitSkippingTemporalTiling.setTemporalTileIterations(16UL);
+
+    std::uniform_int_distribution<size_t> steadyStateTestRowCountDistribution(256UL, 2048UL);
+    std::uniform_int_distribution<size_t> steadyStateTestMatrixDimensionDistribution(1UL, 128UL);
+
+    steadyStateCheckPassed = checkMultiplicationEquivalence(matrixProcessingUnitStepped,
+                                                            {&matrixProcessingUnitSkippingStructureOfArrays,
+                                                             &matrixProcessingUnitSkippingProcessingElements,
+                                                             &matrixProcessingUnitSkippingTemporalTiling},
+                                                            8UL,
+                                                            steadyStateTestRowCountDistribution,
+                                                            steadyStateTestMatrixDimensionDistribution,
+                                                            steadyStateTestMatrixDimensionDistribution,
+                                                            matrixValueDistribution, rng,
+                                                            "steady_state_test",
+                                                            "with steady state skipping");
+
+    std::cout << "MPU test 5: Systolic array worker teams" << std::endl;
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitSingleWorker(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitWorkerTeamStructureOfArrays(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitWorkerTeamProcessingElements(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::ProcessingElements);
+
+    for(MatrixProcessingUnit<WeightDatatype,
+                                ActivationDatatype,
+                                AccumulatorDatatype>* matrixProcessingUnitPtr :
+                                                {&matrixProcessingUnitSingleWorker,
+                                                    &matrixProcessingUnitWorkerTeamStructureOfArrays,
+                                                    &matrixProcessingUnitWorkerTeamProcessingElements})
+    {
+        matrixProcessingUnitPtr->setSteadyStateSkipping(false);
+    }
+
+    matrixProcessingUnitSingleWorker.setSystolicArrayWorkerCount(1UL);
+    matrixProcessingUnitWorkerTeamStructureOfArrays.setSystolicArrayWorkerCount(3UL);
+    matrixProcessingUnitWorkerTeamProcessingElements.setSystolicArrayWorkerCount(5UL);
+
+    std::uniform_int_distribution<size_t> workerTeamTestMatrixDimensionDistribution(2UL, 128UL);
+
+    workerTeamCheckPassed = checkMultiplicationEquivalence(matrixProcessingUnitSingleWorker,
+                                                           {&matrixProcessingUnitWorkerTeamStructureOfArrays,
+                                                            &matrixProcessingUnitWorkerTeamProcessingElements},
+                                                           8UL,
+                                                           workerTeamTestMatrixDimensionDistribution,
+                                                           workerTeamTestMatrixDimensionDistribution,
+                                                           workerTeamTestMatrixDimensionDistribution,
+                                                           matrixValueDistribution, rng,
+                                                           "worker_team_test",
+                                                           "with worker teams");
+
+    std::cout << "MPU test 6: Tile parallel simulation" << std::endl;
+
+    /* A small accumulator array height splits the activation matrix
+     * into many row blocks, so that the multiplications are partitioned
+     * into several time windows simulated on the MPU replicas. The
+     * buffer height is the smallest one allowed, the systolic array
+     * height. */
+
+    constexpr size_t tileParallelTestAccumulatorArrayHeight{32UL};
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitTileSerial(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            tileParallelTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitTileParallel(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            tileParallelTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    matrixProcessingUnitTileParallel.setSimulationMode(MpuSimulationMode::TileParallel);
+    matrixProcessingUnitTileParallel.setTileReplicaCount(3UL);
+
+    std::uniform_int_distribution<size_t> tileParallelTestMatrixDimensionDistribution(2UL, 128UL);
+
+    tileParallelCheckPassed = checkMultiplicationEquivalence(matrixProcessingUnitTileSerial,
+                                                             {&matrixProcessingUnitTileParallel},
+                                                             8UL,
+                                                             tileParallelTestMatrixDimensionDistribution,
+                                                             tileParallelTestMatrixDimensionDistribution,
+                                                             tileParallelTestMatrixDimensionDistribution,
+                                                             matrixValueDistribution, rng,
+                                                             "tile_parallel_test",
+                                                             "with tile parallel simulation");
+
+    std::cout << "MPU test 7: Single row activation matrix blocks" << std::endl;
+
+    singleRowBlockCheckPassed = testSingleRowActivationMatrixBlocks();
+
+    std::cout << "MPU test 8: Result verification policies" << std::endl;
+
+    /* Every policy has to accept the correct results of the cycle accurate
+     * simulation without changing the execution metrics. Only the disabled
+     * verification is guaranteed to report a verification time of zero. */
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitVerificationFull(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitVerificationFreivalds(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitVerificationSampledTiles(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitVerificationOff(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    matrixProcessingUnitVerificationFreivalds.setVerificationPolicy(MpuVerificationPolicy::Freivalds);
+    matrixProcessingUnitVerificationFreivalds.setVerificationRounds(4UL);
+
+    matrixProcessingUnitVerificationSampledTiles.setVerificationPolicy(MpuVerificationPolicy::SampledTiles);
+    matrixProcessingUnitVerificationSampledTiles.setVerificationRounds(3UL);
+
+    matrixProcessingUnitVerificationOff.setVerificationPolicy(MpuVerificationPolicy::Off);
+
+    std::string logEntryStringVerificationFull;
+    std::string logEntryStringVerificationFreivalds;
+    std::string logEntryStringVerificationSampledTiles;
+    std::string logEntryStringVerificationOff;
+
+    double verificationTimeSecondsOff{0.0};
+
+    matrixProcessingUnitVerificationFull.registerLogEntryAvailableCallback(
+                            [&logEntryStringVerificationFull](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+        logEntryStringVerificationFull = mpuStatisticsLogEntry.getExecutionMetricsString();
+    });
+
+    matrixProcessingUnitVerificationFreivalds.registerLogEntryAvailableCallback(
+                            [&logEntryStringVerificationFreivalds](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+        logEntryStringVerificationFreivalds = mpuStatisticsLogEntry.getExecutionMetricsString();
+    });
+
+    matrixProcessingUnitVerificationSampledTiles.registerLogEntryAvailableCallback(
+                            [&logEntryStringVerificationSampledTiles](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+        logEntryStringVerificationSampledTiles = mpuStatisticsLogEntry.getExecutionMetricsString();
+    });
+
+    matrixProcessingUnitVerificationOff.registerLogEntryAvailableCallback(
+                            [&logEntryStringVerificationOff,
+                                &verificationTimeSecondsOff](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+        logEntryStringVerificationOff = mpuStatisticsLogEntry.getExecutionMetricsString();
+        verificationTimeSecondsOff = mpuStatisticsLogEntry.getVerificationTimeSeconds();
+    });
+
+    std::uniform_int_distribution<size_t> verificationTestMatrixDimensionDistribution(2UL, 128UL);
+
+    std::vector<AccumulatorDatatype> resultMatrixVerification;
+
+    for(size_t verificationTestCount{0UL}; verificationTestCount < 4UL; ++verificationTestCount)
+    {
+        const size_t sizeM{verificationTestMatrixDimensionDistribution(rng)};
+        const size_t sizeN{verificationTestMatrixDimensionDistribution(rng)};
+        const size_t sizeK{verificationTestMatrixDimensionDistribution(rng)};
+
+        std::cout << "Multiplication " << verificationTestCount + 1 << ": "
+                    << sizeM << "x" << sizeK << " * "
+                    << sizeK << "x" << sizeN << std::endl;
+
+        activationMatrix.clear();
+
+        for(size_t elementCount{0}; elementCount < sizeM*sizeK; ++elementCount)
+        {
+            activationMatrix.emplace_back(static_cast<ActivationDatatype>(
+                                                        matrixValueDistribution(rng)));
+        }
+
+        weightMatrix.clear();
+
+        for(size_t elementCount{0}; elementCount < sizeK*sizeN; ++elementCount)
+        {
+            weightMatrix.emplace_back(static_cast<WeightDatatype>(
+                                                matrixValueDistribution(rng)));
+        }
+
+        const std::string weightMatrixNameString{"verification_test" + std::to_string(verificationTestCount)};
+
+        resultMatrix.clear();
+        resultMatrix.resize(sizeM*sizeN);
+
+        for(MatrixProcessingUnit<WeightDatatype,
+                                    ActivationDatatype,
+                                    AccumulatorDatatype>* matrixProcessingUnitPtr :
+                                                    {&matrixProcessingUnitVerificationFull,
+                                                        &matrixProcessingUnitVerificationFreivalds,
+                                                        &matrixProcessingUnitVerificationSampledTiles,
+                                                        &matrixProcessingUnitVerificationOff})
+        {
+            matrixProcessingUnitPtr->storeActivationMatrix(activationMatrix.data(),
+                                                                sizeM, sizeK);
+
+            matrixProcessingUnitPtr->storeWeightMatrix(weightMatrixNameString,
+                                                            weightMatrix.data(),
+                                                            sizeK, sizeN);
+
+            try
+            {
+                matrixProcessingUnitPtr->runMultiplication(weightMatrixNameString);
+            }
+
+            catch(const MpuException& mpuException)
+            {
+                std::cout << "Verification of correct result failed: "
+                            << mpuException.what() << std::endl;
+
+                verificationPolicyCheckPassed = false;
+            }
+
+            resultMatrixVerification.clear();
+            resultMatrixVerification.resize(sizeM*sizeN);
+
+            matrixProcessingUnitPtr->loadResultMatrix(resultMatrixVerification.data(),
+                                                            resultMatrixVerification.size());
+
+            if(matrixProcessingUnitPtr == &matrixProcessingUnitVerificationFull)
+            {
+                resultMatrix = resultMatrixVerification;
+            }
+
+            else if(resultMatrix != resultMatrixVerification)
+            {
+                std::cout << "Result matrix with verification policy differs" << std::endl;
+
+                verificationPolicyCheckPassed = false;
+            }
+        }
+
+        if((logEntryStringVerificationFull != logEntryStringVerificationFreivalds) ||
+                (logEntryStringVerificationFull != logEntryStringVerificationSampledTiles) ||
+                (logEntryStringVerificationFull != logEntryStringVerificationOff))
+        {
+            std::cout << "Execution metrics with verification policies differ:\n"
+                        << logEntryStringVerificationFull
+                        << logEntryStringVerificationFreivalds
+                        << logEntryStringVerificationSampledTiles
+                        << logEntryStringVerificationOff;
+
+            verificationPolicyCheckPassed = false;
+        }
+
+        if(verificationTimeSecondsOff != 0.0)
+        {
+            std::cout << "Verification time reported with verification disabled" << std::endl;
+
+            verificationPolicyCheckPassed = false;
+        }
+    }
+
+    /* The products of the Freivalds verification exceed the range of the
+     * accumulator datatype for saturated operands, so that the check has
+     * to hold for sums wrapping around */
+
+    {
+        constexpr size_t sizeM{8UL};
+        constexpr size_t sizeN{1024UL};
+        constexpr size_t sizeK{512UL};
+
+        std::cout << "Multiplication with overflowing Freivalds sums: "
+                    << sizeM << "x" << sizeK << " * "
+                    << sizeK << "x" << sizeN << std::endl;
+
+        activationMatrix.assign(sizeM*sizeK, std::numeric_limits<ActivationDatatype>::min());
+        weightMatrix.assign(sizeK*sizeN, std::numeric_limits<WeightDatatype>::max());
+
+        const std::string weightMatrixNameString{"verification_test_overflow"};
+
+        matrixProcessingUnitVerificationFreivalds.storeActivationMatrix(activationMatrix.data(),
+                                                                            sizeM, sizeK);
+
+        matrixProcessingUnitVerificationFreivalds.storeWeightMatrix(weightMatrixNameString,
+                                                                        weightMatrix.data(),
+                                                                        sizeK, sizeN);
+
+        try
+        {
+            matrixProcessingUnitVerificationFreivalds.runMultiplication(weightMatrixNameString);
+        }
+
+        catch(const MpuException& mpuException)
+        {
+            std::cout << "Verification of correct result with overflowing sums failed: "
+                        << mpuException.what() << std::endl;
+
+            verificationPolicyCheckPassed = false;
+        }
+    }
+
+    std::cout << "MPU test 9: Weight fetcher diagonal loads" << std::endl;
+
+    weightFetcherCheckPassed = testWeightFetcherDiagonalLoads();
+
+    std::cout << "MPU test 10: Ring buffer queue" << std::endl;
+
+    ringBufferQueueCheckPassed = testRingBufferQueue();
+
+    std::cout << "MPU test 11: Accumulator array drain modes" << std::endl;
+
+    /* Result matrices with a short last activation matrix row block
+     * and a single weight matrix row block contain tiles that are
+     * read diagonally in both drain modes, next to tiles copied
+     * row by row in RowBlock drain mode. */
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitDrainDiagonal(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitDrainRowBlock(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    matrixProcessingUnitDrainDiagonal.setAccumulatorArrayDrainMode(AccumulatorArrayDrainMode::Diagonal);
+    matrixProcessingUnitDrainRowBlock.setAccumulatorArrayDrainMode(AccumulatorArrayDrainMode::RowBlock);
+
+    std::uniform_int_distribution<size_t> drainModeTestRowCountDistribution(1UL, 512UL);
+    std::uniform_int_distribution<size_t> drainModeTestInnerDimensionDistribution(1UL, 2UL*engineTestSystolicArrayHeight);
+
+    drainModeCheckPassed = checkMultiplicationEquivalence(matrixProcessingUnitDrainDiagonal,
+                                                          {&matrixProcessingUnitDrainRowBlock},
+                                                          8UL,
+                                                          drainModeTestRowCountDistribution,
+                                                          drainModeTestRowCountDistribution,
+                                                          drainModeTestInnerDimensionDistribution,
+                                                          matrixValueDistribution, rng,
+                                                          "drain_mode_test",
+                                                          "of the accumulator array drain modes");
+
+    std::cout << "MPU test 12: Clocked bit array word operations" << std::endl;
+
+    clockedBitArrayCheckPassed = testClockedBitArray();
+
+    std::cout << "MPU test 13: Activation FIFO bulk streaming" << std::endl;
+
+    activationFifoCheckPassed = testActivationFifoPushPop();
+
+    std::cout << "MPU test 14: Decoupled simulation" << std::endl;
+
+    /* The timing pass of the decoupled simulation has to reproduce
+     * the execution metrics of the cycle accurate simulation without
+     * simulating the data registers of the systolic array. The
+     * functional pass alternates between running concurrently
+     * and after the timing pass. */
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitCoupled(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitDecoupled(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    matrixProcessingUnitDecoupled.setSimulationMode(MpuSimulationMode::Decoupled);
+
+    std::uniform_int_distribution<size_t> decoupledTestMatrixDimensionDistribution(1UL, 256UL);
+
+    decoupledCheckPassed = checkMultiplicationEquivalence(matrixProcessingUnitCoupled,
+                                                          {&matrixProcessingUnitDecoupled},
+                                                          8UL,
+                                                          decoupledTestMatrixDimensionDistribution,
+                                                          decoupledTestMatrixDimensionDistribution,
+                                                          decoupledTestMatrixDimensionDistribution,
+                                                          matrixValueDistribution, rng,
+                                                          "decoupled_test",
+                                                          "with decoupled simulation",
+                                                          [&matrixProcessingUnitDecoupled](const size_t multiplication){
+        matrixProcessingUnitDecoupled.setDecoupledFunctionalPassConcurrent((multiplication % 2UL) == 0UL);
+    });
+
+    std::cout << "MPU test 15: Fixed geometry MPU" << std::endl;
+
+    /* The MPU specialized for the engine test geometry has to behave
+     * exactly like the structure of arrays engine of runtime geometry */
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitRuntimeGeometry(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    FixedGeometryMatrixProcessingUnit<WeightDatatype,
+                                        ActivationDatatype,
+                                        AccumulatorDatatype,
+                                        engineTestSystolicArrayWidth,
+                                        engineTestSystolicArrayHeight,
+                                        engineTestActivationFifoDepth> matrixProcessingUnitFixedGeometry(
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte);
+
+    std::uniform_int_distribution<size_t> fixedGeometryTestMatrixDimensionDistribution(1UL, 256UL);
+
+    fixedGeometryCheckPassed = checkMultiplicationEquivalence(matrixProcessingUnitRuntimeGeometry,
+                                                              {&matrixProcessingUnitFixedGeometry},
+                                                              8UL,
+                                                              fixedGeometryTestMatrixDimensionDistribution,
+                                                              fixedGeometryTestMatrixDimensionDistribution,
+                                                              fixedGeometryTestMatrixDimensionDistribution,
+                                                              matrixValueDistribution, rng,
+                                                              "fixed_geometry_test",
+                                                              "of the fixed geometry MPU");
+
+    std::cout << "MPU test 16: Unified buffer allocation" << std::endl;
+
+    /* Freed segments have to be reused first fit and coalesced,
+     * compaction has to keep the order of the allocated segments.
+     * Segment sizes are rounded up to the segment alignment. */
+
+    static_assert(UnifiedBufferAllocator::SegmentAlignmentByte == 64UL,
+                    "The allocator test assumes a segment alignment of 64 byte");
+
+    UnifiedBufferAllocator unifiedBufferAllocator(1024UL);
+
+    size_t segmentAddressA;
+    size_t segmentAddressB;
+    size_t segmentAddressC;
+    size_t segmentAddressD;
+    size_t segmentAddressE;
+
+    unifiedBufferAllocator.allocate(256UL, segmentAddressA);
+    unifiedBufferAllocator.allocate(192UL, segmentAddressB);
+    unifiedBufferAllocator.allocate(256UL, segmentAddressC);
+
+    unifiedBufferAllocator.deallocate(segmentAddressB);
+    unifiedBufferAllocator.allocate(64UL, segmentAddressD);
+
+    if((segmentAddressD != segmentAddressB) ||
+            (unifiedBufferAllocator.getEnd() != 704UL) ||
+            (unifiedBufferAllocator.getAllocatedSizeByte() != 576UL))
+    {
+        std::cout << "Unified buffer allocator did not reuse freed segment" << std::endl;
+
+        unifiedBufferAllocationCheckPassed = false;
+    }
+
+    unifiedBufferAllocator.deallocate(segmentAddressA);
+
+    if(unifiedBufferAllocator.resize(segmentAddressC, 768UL) ||
+                !unifiedBufferAllocator.resize(segmentAddressD, 96UL) ||
+                (unifiedBufferAllocator.getAllocatedSizeByte() != 384UL) ||
+                (unifiedBufferAllocator.getFreeSegmentCount() != 2UL))
+    {
+        std::cout << "Unified buffer allocator in place resize incorrect" << std::endl;
+
+        unifiedBufferAllocationCheckPassed = false;
+    }
+
+    const std::vector<UnifiedBufferSegmentRelocation> relocationArray{
+                                                    unifiedBufferAllocator.compact()};
+
+    if((relocationArray.size() != 2UL) ||
+            (relocationArray[0].addressOld != segmentAddressD) ||
+            (relocationArray[0].addressNew != 0UL) ||
+            (relocationArray[1].addressOld != segmentAddressC) ||
+            (relocationArray[1].addressNew != 128UL) ||
+            (unifiedBufferAllocator.getEnd() != 384UL) ||
+            (unifiedBufferAllocator.getFreeSegmentCount() != 0UL))
+    {
+        std::cout << "Unified buffer allocator compaction incorrect" << std::endl;
+
+        unifiedBufferAllocationCheckPassed = false;
+    }
+
+    unifiedBufferAllocator.allocate(1UL, segmentAddressE);
+
+    if((segmentAddressE != 384UL) ||
+            (unifiedBufferAllocator.getEnd() != 448UL) ||
+            (UnifiedBufferAllocator::getSegmentSizeByte(65UL) != 128UL))
+    {
+        std::cout << "Unified buffer allocator segment size not aligned" << std::endl;
+
+        unifiedBufferAllocationCheckPassed = false;
+    }
+
+    /* Interleaving stores of weight matrices with activation and
+     * result matrices of changing size in a unified buffer exactly
+     * as large as the peak of the stored segments fragments the unified
+     * buffer, all stored matrices have to stay intact regardless */
+
+    constexpr size_t allocationTestMultiplicationCount{16UL};
+    constexpr size_t allocationTestSizeK{32UL};
+
+    std::uniform_int_distribution<size_t> allocationTestMatrixDimensionDistribution(1UL, 64UL);
+
+    std::vector<size_t> allocationTestSizeMArray;
+    std::vector<size_t> allocationTestSizeNArray;
+    std::vector<size_t> allocationTestWeightMatrixIndexArray;
+
+    size_t allocationTestUnifiedBufferSizeByte{0UL};
+
+    size_t weightMatrixSpaceSizeByte{0UL};
+    size_t weightMatrixSegmentsSizeByte{0UL};
+    size_t combinedActivationAndResultMatrixSpacesSizeMaxByte{0UL};
+
+    size_t resultMatrixSizeByte{0UL};
+
+    for(size_t allocationTestCount{0UL}; allocationTestCount <
+                            allocationTestMultiplicationCount; ++allocationTestCount)
+    {
+        allocationTestSizeMArray.emplace_back(allocationTestMatrixDimensionDistribution(rng));
+        allocationTestSizeNArray.emplace_back(allocationTestMatrixDimensionDistribution(rng));
+
+        /* Multiply with the new and with a randomly chosen earlier weight matrix */
+
+        std::uniform_int_distribution<size_t> weightMatrixIndexDistribution(0UL, allocationTestCount);
+
+        allocationTestWeightMatrixIndexArray.emplace_back(allocationTestCount);
+        allocationTestWeightMatrixIndexArray.emplace_back(weightMatrixIndexDistribution(rng));
+
+        const size_t activationMatrixSizeByte{allocationTestSizeMArray.back()*
+                                                allocationTestSizeK*sizeof(ActivationDatatype)};
+
+        const size_t weightMatrixSizeByte{allocationTestSizeK*
+                                            allocationTestSizeNArray.back()*
+                                            sizeof(WeightDatatype)};
+
+        weightMatrixSpaceSizeByte += weightMatrixSizeByte;
+        weightMatrixSegmentsSizeByte += UnifiedBufferAllocator::getSegmentSizeByte(weightMatrixSizeByte);
+
+        allocationTestUnifiedBufferSizeByte = std::max(allocationTestUnifiedBufferSizeByte,
+                                                        weightMatrixSegmentsSizeByte +
+                                                        UnifiedBufferAllocator::getSegmentSizeByte(
+                                                                        activationMatrixSizeByte) +
+                                                        UnifiedBufferAllocator::getSegmentSizeByte(
+                                                                        resultMatrixSizeByte));
+
+        for(size_t weightMatrixIndexCount{allocationTestWeightMatrixIndexArray.size() - 2UL};
+                                weightMatrixIndexCount < allocationTestWeightMatrixIndexArray.size();
+                                                                            ++weightMatrixIndexCount)
+        {
+            resultMatrixSizeByte = allocationTestSizeMArray.back()*
+                                    allocationTestSizeNArray[allocationTestWeightMatrixIndexArray[
+                                                                        weightMatrixIndexCount]]*
+                                    sizeof(AccumulatorDatatype);
+
+            combinedActivationAndResultMatrixSpacesSizeMaxByte =
+                                std::max(combinedActivationAndResultMatrixSpacesSizeMaxByte,
+                                            activationMatrixSizeByte + resultMatrixSizeByte);
+
+            allocationTestUnifiedBufferSizeByte = std::max(allocationTestUnifiedBufferSizeByte,
+                                                            weightMatrixSegmentsSizeByte +
+                                                            UnifiedBufferAllocator::getSegmentSizeByte(
+                                                                            activationMatrixSizeByte) +
+                                                            UnifiedBufferAllocator::getSegmentSizeByte(
+                                                                            resultMatrixSizeByte));
+        }
+    }
+
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitAllocationTest(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            allocationTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
+
+    matrixProcessingUnitAllocationTest.registerLogEntryAvailableCallback(
+                                                        [](MpuStatisticsLogEntry&&){});
+
+    matrixProcessingUnitAllocationTest.setUnifiedBufferDynamicResize(false);
+
+    std::vector<std::vector<WeightDatatype>> allocationTestWeightMatrixArray;
+
+    for(size_t allocationTestCount{0UL}; allocationTestCount <
+                            allocationTestMultiplicationCount; ++allocationTestCount)
+    {
+        const size_t sizeM{allocationTestSizeMArray[allocationTestCount]};
+        const size_t sizeN{allocationTestSizeNArray[allocationTestCount]};
+
+        activationMatrix.clear();
+
+        for(size_t elementCount{0}; elementCount < sizeM*allocationTestSizeK; ++elementCount)
+        {
+            activationMatrix.emplace_back(static_cast<ActivationDatatype>(
+                                                        matrixValueDistribution(rng)));
+        }
+
+        allocationTestWeightMatrixArray.emplace_back();
+
+        for(size_t elementCount{0}; elementCount < allocationTestSizeK*sizeN; ++elementCount)
+        {
+            allocationTestWeightMatrixArray.back().emplace_back(
+                                            static_cast<WeightDatatype>(
                                                     matrixValueDistribution(rng)));
-            }
         }
 
-        matrixProcessingUnit.storeActivationMatrix(activationMatrix.data(),
-                                                        sizeMConst, sizeKConst);
+        matrixProcessingUnitAllocationTest.storeActivationMatrix(activationMatrix.data(),
+                                                                    sizeM, allocationTestSizeK);
 
-        const std::string weightMatrixNameString{"test" + std::to_string(multiplicationCount)};
+        matrixProcessingUnitAllocationTest.storeWeightMatrix("allocation_test" +
+                                                                std::to_string(allocationTestCount),
+                                                            allocationTestWeightMatrixArray.back().data(),
+                                                            allocationTestSizeK, sizeN);
 
-        matrixProcessingUnit.storeWeightMatrix(weightMatrixNameString,
-                                                    weightMatrix.data(),
-                                                    sizeKConst, sizeNConst);
+        for(const size_t weightMatrixIndex : {allocationTestWeightMatrixIndexArray[2UL*allocationTestCount],
+                                                allocationTestWeightMatrixIndexArray[2UL*allocationTestCount + 1UL]})
+        {
+            const size_t sizeNWeightMatrix{allocationTestSizeNArray[weightMatrixIndex]};
 
-        matrixProcessingUnit.runMultiplication(weightMatrixNameString);
+            matrixProcessingUnitAllocationTest.runMultiplication("allocation_test" +
+                                                                    std::to_string(weightMatrixIndex));
 
-        resultMatrix.clear();
-        resultMatrix.resize(sizeMConst*sizeNConst);
+            resultMatrix.clear();
+            resultMatrix.resize(sizeM*sizeNWeightMatrix);
 
-        matrixProcessingUnit.loadResultMatrix(resultMatrix.data(),
-                                                resultMatrix.size());
+            matrixProcessingUnitAllocationTest.loadResultMatrix(resultMatrix.data(),
+                                                                    resultMatrix.size());
 
-        Eigen::Map<const RMatrix<ActivationDatatype>> matrixAEigen(
-                                                            activationMatrix.data(),
-                                                                    sizeMConst, sizeKConst);
+            Eigen::Map<const RMatrix<ActivationDatatype>> matrixAEigen(
+                                                                activationMatrix.data(),
+                                                                        sizeM, allocationTestSizeK);
 
-        Eigen::Map<const RMatrix<WeightDatatype>> matrixBEigen(
-                                                        weightMatrix.data(),
-                                                                sizeKConst, sizeNConst);
+            Eigen::Map<const RMatrix<WeightDatatype>> matrixBEigen(
+                                                            allocationTestWeightMatrixArray[weightMatrixIndex].data(),
+                                                                    allocationTestSizeK, sizeNWeightMatrix);
 
-        const RMatrix<AccumulatorDatatype> matrixCEigen{matrixAEigen.template cast<AccumulatorDatatype>()*
-                                                        matrixBEigen.template cast<AccumulatorDatatype>()};
+            const RMatrix<AccumulatorDatatype> matrixCEigen{matrixAEigen.template cast<AccumulatorDatatype>()*
+                                                            matrixBEigen.template cast<AccumulatorDatatype>()};
 
-        for(size_t rowCount{0}; rowCount < sizeMConst; ++rowCount)
-        {
-            for(size_t columnCount{0}; columnCount < sizeNConst; ++columnCount)
+            for(size_t rowCount{0}; rowCount < sizeM; ++rowCount)
             {
-                if(resultMatrix[rowCount*sizeNConst + columnCount] !=
-                                    matrixCEigen(rowCount, columnCount))
+                for(size_t columnCount{0}; columnCount < sizeNWeightMatrix; ++columnCount)
                 {
-                    std::cout << "Systolic array output incorrect at ("
-                                << columnCount << ", " << rowCount
-                                << "): Expected value: "
-                                << matrixCEigen(rowCount, columnCount)
-                                << " actual value: "
-                                << resultMatrix[rowCount*sizeNConst + columnCount] << std::endl;
-
-                    sanityCheckPassedDynamic = false;
+                    if(resultMatrix[rowCount*sizeNWeightMatrix + columnCount] !=
+                                                matrixCEigen(rowCount, columnCount))
+                    {
+                        unifiedBufferAllocationCheckPassed = false;
+                    }
                 }
             }
         }
     }
 
-    matrixProcessingUnit.printUnifiedBufferLayout();
+    if(!unifiedBufferAllocationCheckPassed)
+    {
+        std::cout << "Result matrix incorrect after unified buffer allocation" << std::endl;
+    }
 
-    matrixProcessingUnit.resetMemoryManagementUnit();
-    matrixProcessingUnit.setUnifiedBufferDynamicResize(false);
-    matrixProcessingUnit.resetIterationCounts();
-    matrixProcessingUnit.resetDataMovementAndFootprintMetrics();
+    if(matrixProcessingUnitAllocationTest.getUnifiedBufferSizeMinByte() !=
+                                        (weightMatrixSpaceSizeByte +
+                                            combinedActivationAndResultMatrixSpacesSizeMaxByte))
+    {
+        std::cout << "Unified buffer footprint incorrect: Expected "
+                    << weightMatrixSpaceSizeByte +
+                            combinedActivationAndResultMatrixSpacesSizeMaxByte
+                    << " byte, actual "
+                    << matrixProcessingUnitAllocationTest.getUnifiedBufferSizeMinByte()
+                    << " byte" << std::endl;
 
-    multiplicationCount = 0UL;
+        unifiedBufferAllocationCheckPassed = false;
+    }
 
-    std::cout << "MPU test 1: Static unified buffer size" << std::endl;
+    std::cout << "MPU test 17: Zero-copy operand and result views" << std::endl;
 
-    for(size_t memoryManagementUnitTestCount{0UL}; memoryManagementUnitTestCount < 16UL;
-                                                                    ++memoryManagementUnitTestCount)
-    {
-        ++multiplicationCount;
+    /* Writing the operands in place and reading the result in place
+     * has to behave exactly like copying them in and out, including
+     * the unified buffer footprint */
 
-        std::cout << "Multiplication " << multiplicationCount << std::endl;
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitCopy(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
 
-        size_t sizeM;
-        size_t sizeN;
-        size_t sizeK;
+    MatrixProcessingUnit<WeightDatatype, ActivationDatatype, AccumulatorDatatype> matrixProcessingUnitZeroCopy(
+                                                                                            engineTestSystolicArrayWidth,
+                                                                                            engineTestSystolicArrayHeight,
+                                                                                            engineTestActivationFifoDepth,
+                                                                                            engineTestAccumulatorArrayHeight,
+                                                                                            engineTestUnifiedBufferSizeByte,
+                                                                                            SystolicArrayEngine::StructureOfArrays);
 
-        do
+    std::string logEntryStringCopy;
+    std::string logEntryStringZeroCopy;
+
+    matrixProcessingUnitCopy.registerLogEntryAvailableCallback(
+                            [&logEntryStringCopy](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+        logEntryStringCopy = mpuStatisticsLogEntry.getExecutionMetricsString();
+    });
+
+    matrixProcessingUnitZeroCopy.registerLogEntryAvailableCallback(
+                            [&logEntryStringZeroCopy](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+        logEntryStringZeroCopy = mpuStatisticsLogEntry.getExecutionMetricsString();
+    });
+
+    std::uniform_int_distribution<size_t> zeroCopyTestMatrixDimensionDistribution(1UL, 128UL);
+
+    /* The views follow segments of odd byte sizes, as the weight
+     * matrices are int8, and still have to be aligned */
+
+    const auto isSegmentAligned = [](const void* const matrixViewPtr)
+    {
+        if(reinterpret_cast<std::uintptr_t>(matrixViewPtr) %
+                            UnifiedBufferAllocator::SegmentAlignmentByte)
         {
-            sizeM = matrixDimensionDistribution(rng);
-            sizeN = matrixDimensionDistribution(rng);
-            sizeK = matrixDimensionDistribution(rng);
+            std::cout << "Matrix view not aligned to the unified buffer "
+                            "segment alignment" << std::endl;
+
+            return false;
         }
 
-        while((sizeM*sizeN*sizeK > (1UL << 24)) ||
-                            ((sizeN <= systolicArrayWidth) !=
-                                (sizeK <= systolicArrayHeight)));
+        return true;
+    };
 
-        const size_t sizeMConst{sizeM};
-        const size_t sizeNConst{sizeN};
-        const size_t sizeKConst{sizeK};
+    for(size_t zeroCopyTestCount{0UL}; zeroCopyTestCount < 8UL; ++zeroCopyTestCount)
+    {
+        const size_t sizeM{zeroCopyTestMatrixDimensionDistribution(rng)};
+        const size_t sizeN{zeroCopyTestMatrixDimensionDistribution(rng)};
+        const size_t sizeK{zeroCopyTestMatrixDimensionDistribution(rng)};
 
         activationMatrix.clear();
 
-        for(size_t rowCount{0}; rowCount < sizeMConst; ++rowCount)
+        for(size_t elementCount{0}; elementCount < sizeM*sizeK; ++elementCount)
         {
-            for(size_t columnCount{0}; columnCount < sizeKConst; ++columnCount)
-            {
-                activationMatrix.emplace_back(static_cast<ActivationDatatype>(
-                                                            matrixValueDistribution(rng)));
-            }
+            activationMatrix.emplace_back(static_cast<ActivationDatatype>(
+                                                        matrixValueDistribution(rng)));
         }
 
         weightMatrix.clear();
 
-        for(size_t rowCount{0}; rowCount < sizeKConst; ++rowCount)
+        for(size_t elementCount{0}; elementCount < sizeK*sizeN; ++elementCount)
         {
-            for(size_t columnCount{0}; columnCount < sizeNConst; ++columnCount)
-            {
-                weightMatrix.emplace_back(static_cast<WeightDatatype>(
-                                                    matrixValueDistribution(rng)));
-            }
+            weightMatrix.emplace_back(static_cast<WeightDatatype>(
+                                                matrixValueDistribution(rng)));
         }
 
-        matrixProcessingUnit.storeActivationMatrix(activationMatrix.data(),
-                                                        sizeMConst, sizeKConst);
-
-        const std::string weightMatrixNameString{"test" + std::to_string(multiplicationCount)};
+        const std::string weightMatrixNameString{"zero_copy_test" + std::to_string(zeroCopyTestCount)};
 
-        matrixProcessingUnit.storeWeightMatrix(weightMatrixNameString,
+        matrixProcessingUnitCopy.storeWeightMatrix(weightMatrixNameString,
                                                     weightMatrix.data(),
-                                                    sizeKConst, sizeNConst);
+                                                    sizeK, sizeN);
 
-        matrixProcessingUnit.runMultiplication(weightMatrixNameString);
+        matrixProcessingUnitCopy.storeActivationMatrix(activationMatrix.data(),
+                                                        sizeM, sizeK);
+
+        matrixProcessingUnitCopy.runMultiplication(weightMatrixNameString);
+
+        WeightDatatype* const weightMatrixView{
+                    matrixProcessingUnitZeroCopy.allocateWeightMatrix(weightMatrixNameString,
+                                                                        sizeK, sizeN)};
+
+        std::copy(weightMatrix.begin(), weightMatrix.end(), weightMatrixView);
+
+        if(!isSegmentAligned(weightMatrixView))
+        {
+            zeroCopyCheckPassed = false;
+        }
+
+        ActivationDatatype* const activationMatrixView{
+                    matrixProcessingUnitZeroCopy.allocateActivationMatrix(sizeM, sizeK)};
+
+        std::copy(activationMatrix.begin(), activationMatrix.end(), activationMatrixView);
+
+        if(!isSegmentAligned(activationMatrixView))
+        {
+            zeroCopyCheckPassed = false;
+        }
+
+        matrixProcessingUnitZeroCopy.runMultiplication(weightMatrixNameString);
 
         resultMatrix.clear();
-        resultMatrix.resize(sizeMConst*sizeNConst);
+        resultMatrix.resize(sizeM*sizeN);
 
-        matrixProcessingUnit.loadResultMatrix(resultMatrix.data(),
-                                                resultMatrix.size());
+        matrixProcessingUnitCopy.loadResultMatrix(resultMatrix.data(),
+                                                    resultMatrix.size());
 
-        Eigen::Map<const RMatrix<ActivationDatatype>> matrixAEigen(
-                                                            activationMatrix.data(),
-                                                                        sizeMConst, sizeKConst);
+        const AccumulatorDatatype* const resultMatrixView{
+                                    matrixProcessingUnitZeroCopy.getResultMatrixView()};
 
-        Eigen::Map<const RMatrix<WeightDatatype>> matrixBEigen(
-                                                        weightMatrix.data(),
-                                                                sizeKConst, sizeNConst);
+        if(!std::equal(resultMatrix.begin(), resultMatrix.end(), resultMatrixView))
+        {
+            std::cout << "Result matrix view differs from loaded result matrix" << std::endl;
 
-        const RMatrix<AccumulatorDatatype> matrixCEigen{matrixAEigen.template cast<AccumulatorDatatype>()*
-                                                        matrixBEigen.template cast<AccumulatorDatatype>()};
+            zeroCopyCheckPassed = false;
+        }
 
-        for(size_t rowCount{0}; rowCount < sizeM; ++rowCount)
+        if(!isSegmentAligned(resultMatrixView))
         {
-            for(size_t columnCount{0}; columnCount < sizeN; ++columnCount)
-            {
-                if(resultMatrix[rowCount*sizeN + columnCount] !=
-                                    matrixCEigen(rowCount, columnCount))
-                {
-                    std::cout << "Systolic array output incorrect at ("
-                                << columnCount << ", " << rowCount
-                                << "): Expected value: "
-                                << matrixCEigen(rowCount, columnCount)
-                                << " actual value: "
-                                << resultMatrix[rowCount*sizeN + columnCount] << std::endl;
+            zeroCopyCheckPassed = false;
+        }
 
-                    sanityCheckPassedStatic = false;
-                }
-            }
+        if(logEntryStringCopy != logEntryStringZeroCopy)
+        {
+            std::cout << "Execution metrics of zero-copy multiplication differ:\n"
+                        << logEntryStringCopy
+                        << logEntryStringZeroCopy;
+
+            zeroCopyCheckPassed = false;
+        }
+
+        if(matrixProcessingUnitCopy.getUnifiedBufferSizeMinByte() !=
+                            matrixProcessingUnitZeroCopy.getUnifiedBufferSizeMinByte())
+        {
+            std::cout << "Unified buffer footprint of zero-copy multiplication differs" << std::endl;
+
+            zeroCopyCheckPassed = false;
         }
     }
-    
-    matrixProcessingUnit.printUnifiedBufferLayout();
-    
+
     std::cout << "================================ SUMMARY ================================\n\n";
     
     if(sanityCheckPassedDynamic)
@@ -315,7 +2352,175 @@ int main(int argc, char** argv)
         std::cout << "Test 1: Matrix multiplication using static dynamic buffer size\t\tFAILED\n\n";
     }
     
-    if(!(sanityCheckPassedDynamic && sanityCheckPassedStatic))
+    if(engineCheckPassed)
+    {
+        std::cout << "Test 2: Equivalence of the systolic array engines\t\tPASSED\n\n";
+    }
+    
+    else
+    {
+        std::cout << "Test 2: Equivalence of the systolic array engines\t\tFAILED\n\n";
+    }
+    
+    if(analyticalCheckPassed)
+    {
+        std::cout << "Test 3: Equivalence of the analytical model and the cycle engine\t\tPASSED\n\n";
+    }
+    
+    else
+    {
+        std::cout << "Test 3: Equivalence of the analytical model and the cycle engine\t\tFAILED\n\n";
+    }
+    
+    if(steadyStateCheckPassed)
+    {
+        std::cout << "Test 4: Equivalence of steady state iteration skipping\t\tPASSED\n\n";
+    }
+    
+    else
+    {
+        std::cout << "Test 4: Equivalence of steady state iteration skipping\t\tFAILED\n\n";
+    }
+    
+    if(workerTeamCheckPassed)
+    {
+        std::cout << "Test 5: Equivalence of systolic array worker teams\t\tPASSED\n\n";
+    }
+    
+    else
+    {
+        std::cout << "Test 5: Equivalence of systolic array worker teams\t\tFAILED\n\n";
+    }
+    
+    if(tileParallelCheckPassed)
+    {
+        std::cout << "Test 6: Equivalence of tile parallel simulation\t\tPASSED\n\n";
+    }
+    
+    else
+    {
+        std::cout << "Test 6: Equivalence of tile parallel simulation\t\tFAILED\n\n";
+    }
+
+    if(singleRowBlockCheckPassed)
+    {
+        std::cout << "Test 7: Single row activation matrix blocks\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 7: Single row activation matrix blocks\t\tFAILED\n\n";
+    }
+
+    if(verificationPolicyCheckPassed)
+    {
+        std::cout << "Test 8: Result verification policies\t\tPASSED\n\n";
+    }
+    
+    else
+    {
+        std::cout << "Test 8: Result verification policies\t\tFAILED\n\n";
+    }
+
+    if(weightFetcherCheckPassed)
+    {
+        std::cout << "Test 9: Weight fetcher diagonal loads\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 9: Weight fetcher diagonal loads\t\tFAILED\n\n";
+    }
+
+    if(ringBufferQueueCheckPassed)
+    {
+        std::cout << "Test 10: Ring buffer queue\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 10: Ring buffer queue\t\tFAILED\n\n";
+    }
+
+    if(drainModeCheckPassed)
+    {
+        std::cout << "Test 11: Equivalence of the accumulator array drain modes\t\tPASSED\n\n";
+    }
+    
+    else
+    {
+        std::cout << "Test 11: Equivalence of the accumulator array drain modes\t\tFAILED\n\n";
+    }
+
+    if(clockedBitArrayCheckPassed)
+    {
+        std::cout << "Test 12: Clocked bit array word operations\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 12: Clocked bit array word operations\t\tFAILED\n\n";
+    }
+
+    if(activationFifoCheckPassed)
+    {
+        std::cout << "Test 13: Activation FIFO bulk streaming\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 13: Activation FIFO bulk streaming\t\tFAILED\n\n";
+    }
+
+    if(decoupledCheckPassed)
+    {
+        std::cout << "Test 14: Equivalence of decoupled simulation\t\tPASSED\n\n";
+    }
+    
+    else
+    {
+        std::cout << "Test 14: Equivalence of decoupled simulation\t\tFAILED\n\n";
+    }
+
+    if(fixedGeometryCheckPassed)
+    {
+        std::cout << "Test 15: Equivalence of the fixed geometry MPU\t\tPASSED\n\n";
+    }
+    
+    else
+    {
+        std::cout << "Test 15: Equivalence of the fixed geometry MPU\t\tFAILED\n\n";
+    }
+
+    if(unifiedBufferAllocationCheckPassed)
+    {
+        std::cout << "Test 16: Unified buffer segment allocation\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 16: Unified buffer segment allocation\t\tFAILED\n\n";
+    }
+
+    if(zeroCopyCheckPassed)
+    {
+        std::cout << "Test 17: Zero-copy operand and result views\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 17: Zero-copy operand and result views\t\tFAILED\n\n";
+    }
+    
+    if(!(sanityCheckPassedDynamic && sanityCheckPassedStatic &&
+                engineCheckPassed && analyticalCheckPassed &&
+                steadyStateCheckPassed && workerTeamCheckPassed &&
+                tileParallelCheckPassed && singleRowBlockCheckPassed &&
+                verificationPolicyCheckPassed && weightFetcherCheckPassed &&
+                ringBufferQueueCheckPassed && drainModeCheckPassed &&
+                clockedBitArrayCheckPassed && activationFifoCheckPassed &&
+                decoupledCheckPassed && fixedGeometryCheckPassed &&
+                unifiedBufferAllocationCheckPassed && zeroCopyCheckPassed))
     {
         return -1;
     }
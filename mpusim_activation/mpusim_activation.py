@@ -0,0 +1,35 @@
+# Copyright (c) 2020 Computing Systems Group
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+from tensorflow.python.keras import activations
+from tensorflow.python.ops import nn
+
+__all__ = ['get_mpusim_activation']
+
+def get_mpusim_activation(activation):
+    """
+    Get the name of the MPU activation unit function equivalent
+    to `activation`, or None if it cannot be fused into the op.
+    """
+    if activation is None or activation is activations.linear:
+        return 'none'
+    if activation is nn.relu or activation is activations.relu:
+        return 'relu'
+    if activation is nn.relu6:
+        return 'relu6'
+    return None
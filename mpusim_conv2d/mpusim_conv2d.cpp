@@ -90,6 +90,8 @@ public:
                         float* outputData,
                         int outputHeight,
                         int outputWidth,
+                        const float* biasVector,
+                        const ActivationFunction activationFunction,
                         const std::string& logFileOutputDirString,
                         const std::string& modelNameString)
     {
@@ -148,7 +150,9 @@ public:
                                                     outputData,
                                                     logFileOutputDirString,
                                                     modelNameString,
-                                                    opKernelStringSlashesReplacedWithUnderscores);
+                                                    opKernelStringSlashesReplacedWithUnderscores,
+                                                    biasVector,
+                                                    activationFunction);
             
             
             return;
@@ -186,7 +190,9 @@ public:
                                                     outputData,
                                                     logFileOutputDirString,
                                                     modelNameString,
-                                                    opKernelStringSlashesReplacedWithUnderscores);
+                                                    opKernelStringSlashesReplacedWithUnderscores,
+                                                    biasVector,
+                                                    activationFunction);
 
             return;
         }
@@ -334,17 +340,19 @@ public:
                                                 outputData,
                                                 logFileOutputDirString,
                                                 modelNameString,
-                                                opKernelStringSlashesReplacedWithUnderscores);
+                                                opKernelStringSlashesReplacedWithUnderscores,
+                                                biasVector,
+                                                activationFunction);
 
     }
 };
 
-class MpuSimConv2D : public BinaryOp<float>
+class MpuSimConv2D : public OpKernel
 {
 
 public:
 
-    explicit MpuSimConv2D(OpKernelConstruction* opKernelConstruction): BinaryOp<float>(opKernelConstruction)
+    explicit MpuSimConv2D(OpKernelConstruction* opKernelConstruction): OpKernel(opKernelConstruction)
     {
         OP_REQUIRES_OK(opKernelConstruction, opKernelConstruction->GetAttr("strides", &m_strides));
 
@@ -392,6 +400,18 @@ public:
         OP_REQUIRES_OK(opKernelConstruction, opKernelConstruction->GetAttr(
                                                                 "accumulatorArrayHeight",
                                                                 &m_accumulatorArrayHeight));
+
+        // The attribute constraint can only state the minimum of the
+        // accumulator array height, the MPU requires at least twice
+        // the systolic array height
+
+        OP_REQUIRES(opKernelConstruction,
+                        m_accumulatorArrayHeight >= 2*m_systolicArrayHeight,
+                        errors::InvalidArgument(
+                                    "MpuSimConv2D accumulator array height ",
+                                    m_accumulatorArrayHeight,
+                                    " must be at least twice the systolic array height ",
+                                    m_systolicArrayHeight));
         
         OP_REQUIRES_OK(opKernelConstruction, opKernelConstruction->GetAttr(
                                                                 "modelName",
@@ -399,6 +419,20 @@ public:
         OP_REQUIRES_OK(opKernelConstruction, opKernelConstruction->GetAttr(
                                                                 "logFileOutputDir",
                                                                 &m_logFileOutputDirString));
+
+        int64 numArgs;
+        std::string activationString;
+
+        OP_REQUIRES_OK(opKernelConstruction, opKernelConstruction->GetAttr("num_args", &numArgs));
+        OP_REQUIRES(opKernelConstruction, numArgs <= 1, errors::InvalidArgument(
+                                    "MpuSimConv2D takes at most one fused argument, the bias vector"));
+
+        m_useBias = (numArgs == 1);
+
+        OP_REQUIRES_OK(opKernelConstruction, opKernelConstruction->GetAttr("activation",
+                                                                            &activationString));
+
+        m_activationFunction = getActivationFunctionFromString(activationString);
         
 //         std::cout << "Added mpusim-conv2d operation\n\tActivations size: "
 //                     << m_activationsDatatypeSizeByte << " byte\tWeights size: "
@@ -494,6 +528,22 @@ public:
         TensorShape outputShape{ShapeFromFormat(m_dataFormat, batch,
                                                     outputRows, outputCols, outputDepth)};
 
+        /* The optional bias holds one value per output channel,
+         * it is added by the MPU activation unit on result readout. */
+
+        const float* biasVector{nullptr};
+
+        if(m_useBias)
+        {
+            const Tensor& bias{opKernelContext->input(2)};
+
+            OP_REQUIRES(opKernelContext, (bias.dims() == 1) && (bias.dim_size(0) == outputDepth),
+                            errors::InvalidArgument("bias must be 1-dimensional with one value "
+                                                        "per output channel: ", bias.shape().DebugString()));
+
+            biasVector = bias.flat<float>().data();
+        }
+
         /* Output tensor is of the following
          * dimensions: [ in_batch, out_rows, out_cols, out_depth ] */
 
@@ -525,6 +575,7 @@ public:
                                 batch, inputRows,  inputCols, inputDepth, filter.flat<float>().data(),
                                 filterRows, filterCols, outputDepth, strideRows, strideCols, m_padding,
                                 output->flat<float>().data(),  outputRows, outputCols,
+                                biasVector, m_activationFunction,
                                 m_logFileOutputDirString, m_modelNameString);
     }
 
@@ -546,6 +597,9 @@ private:
     int64 m_activationFifoDepth;
     int64 m_accumulatorArrayHeight;
 
+    bool m_useBias;
+    ActivationFunction m_activationFunction;
+
     TF_DISALLOW_COPY_AND_ASSIGN(MpuSimConv2D);
 };
 
@@ -553,6 +607,7 @@ private:
 REGISTER_OP("MpuSimConv2D")
                 .Input("input: T")
                 .Input("filter: T")
+                .Input("args: num_args * T")
                 .Output("output: T")
                 .Attr("T: {float}")
                 .Attr("activationsDatatypeSizeByte: int >= 1")
@@ -568,6 +623,8 @@ REGISTER_OP("MpuSimConv2D")
                 .Attr(GetPaddingAttrString())
                 .Attr(GetConvnetDataFormatAttrString())
                 .Attr("dilations: list(int) = [1, 1, 1, 1]")
+                .Attr("num_args: int >= 0")
+                .Attr("activation: {'none', 'relu', 'relu6'} = 'none'")
                 .SetShapeFn(shape_inference::Conv2DShape);
 
 REGISTER_KERNEL_BUILDER(Name("MpuSimConv2D") \
@@ -34,6 +34,8 @@ from tensorpack.utils.argtools import get_data_format, shape2d, shape4d, log_onc
 from tensorpack.models.common import VariableHolder, layer_register
 from tensorpack.models.tflayer import convert_to_tflayer_args, rename_get_variable
 
+from mpusim_activation.mpusim_activation import get_mpusim_activation
+
 mpu_sim_conv2d_lib = tf.load_op_library('../../bin/build_mpusim_conv2d_release/mpusim-conv2d.so')
 
 __all__ = ['mpusim_conv2d']
@@ -119,9 +121,15 @@ def mpusim_conv2d(
     if use_bias:
         b = tf.get_variable('b', [out_channel], initializer=bias_initializer)
 
+    # The bias and ReLU/ReLU6 activations are applied by the
+    # MPU activation unit when reading out the results
+    mpusim_activation = get_mpusim_activation(activation)
+    kwargs['activation'] = mpusim_activation or 'none'
+
     if split == 1:
         conv = mpu_sim_conv2d_lib.mpu_sim_conv2d(inputs,
                                                     W,
+                                                    [b] if use_bias else [],
                                                     activations_datatype_size_byte,
                                                     weights_datatype_size_byte,
                                                     results_datatype_size_byte,
@@ -138,8 +146,10 @@ def mpusim_conv2d(
         
         inputs = tf.split(inputs, split, channel_axis)
         kernels = tf.split(W, split, 3)
+        biases = tf.split(b, split, 0) if use_bias else [None] * split
         outputs = [mpu_sim_conv2d_lib.mpu_sim_conv2d(input_block,
                                                         kernel_block,
+                                                        [bias_block] if use_bias else [],
                                                         activations_datatype_size_byte,
                                                         weights_datatype_size_byte,
                                                         results_datatype_size_byte,
@@ -152,11 +162,11 @@ def mpusim_conv2d(
                                                         stride,
                                                         padding.upper(),
                                                         **kwargs)
-                    for input_block, kernel_block in zip(inputs, kernels)]
+                    for input_block, kernel_block, bias_block in zip(inputs, kernels, biases)]
         conv = tf.concat(outputs, channel_axis)
 
-    ret = tf.nn.bias_add(conv, b, data_format=data_format) if use_bias else conv
-    if activation is not None:
+    ret = conv
+    if mpusim_activation is None:
         ret = activation(ret)
     ret = tf.identity(ret, name='output')
 
@@ -37,6 +37,14 @@ from tensorpack.models.tflayer import convert_to_tflayer_args, rename_get_variab
 @ops.RegisterGradient("MpuSimConv2D")
 def _MpuSimConv2DGrad(op, grad):
   """Gradient function for MpuSimConv2D."""
+  # Backpropagate through the activation function and bias
+  # applied by the MPU activation unit
+  activation = op.get_attr("activation")
+  if activation in (b"relu", "relu"):
+    grad = gen_nn_ops.relu_grad(grad, op.outputs[0])
+  elif activation in (b"relu6", "relu6"):
+    grad = gen_nn_ops.relu6_grad(grad, op.outputs[0])
+
   dilations = op.get_attr("dilations")
   strides = op.get_attr("strides")
   padding = op.get_attr("padding")
@@ -49,7 +57,7 @@ def _MpuSimConv2DGrad(op, grad):
   # to use the nn_ops functions, we would have to convert `padding` and
   # `explicit_paddings` into a single `padding` parameter, increasing overhead
   # in Eager mode.
-  return [
+  grads = [
       nn_ops.conv2d_backprop_input(
           shape_0,
           op.inputs[1],
@@ -69,3 +77,6 @@ def _MpuSimConv2DGrad(op, grad):
           use_cudnn_on_gpu=False,
           data_format=data_format)
   ]
+  if op.get_attr("num_args") == 1:
+    grads.append(gen_nn_ops.bias_add_grad(grad, data_format=data_format))
+  return grads
@@ -95,6 +95,7 @@ def mpusim_depthwise_conv2d(input,
                 
                     channel_output = mpu_sim_conv2d_lib.mpu_sim_conv2d(input_block,
                                                                         kernel_block,
+                                                                        [],
                                                                         activations_datatype_size_byte,
                                                                         weights_datatype_size_byte,
                                                                         results_datatype_size_byte,
@@ -51,6 +51,8 @@ from tensorflow.python.util.tf_export import tf_export
 from tensorflow.python.layers import base
 from tensorflow.python.ops import init_ops
 
+from mpusim_activation.mpusim_activation import get_mpusim_activation
+
 mpu_sim_mat_mul_lib = tf.load_op_library('../../bin/build_mpusim_mat_mul_release/mpusim-mat-mul.so')
 
 class mpusim_fc_base(Layer):
@@ -140,8 +142,13 @@ class mpusim_fc_base(Layer):
             raise ValueError('mpusim_fc_base only supports tensors of rank <= 2')
         else:
             
+            # The bias and ReLU/ReLU6 activations are applied by the
+            # MPU activation unit when reading out the results
+            mpusim_activation = get_mpusim_activation(self.activation)
+
             outputs = mpu_sim_mat_mul_lib.mpu_sim_mat_mul(inputs,
                                                             self.kernel,
+                                                            [self.bias] if self.use_bias else [],
                                                             activations_datatype_size_byte=self.activations_datatype_size_byte,
                                                             weights_datatype_size_byte=self.weights_datatype_size_byte,
                                                             results_datatype_size_byte=self.results_datatype_size_byte,
@@ -150,11 +157,10 @@ class mpusim_fc_base(Layer):
                                                             activation_fifo_depth=self.activation_fifo_depth,
                                                             accumulator_array_height=self.accumulator_array_height,
                                                             log_file_output_dir=self.log_file_output_dir,
-                                                            model_name=self.model_name)
+                                                            model_name=self.model_name,
+                                                            activation=mpusim_activation or 'none')
 
-        if self.use_bias:
-            outputs = nn.bias_add(outputs, self.bias)
-        if self.activation is not None:
+        if mpusim_activation is None:
             return self.activation(outputs)
         return outputs
 
@@ -48,6 +48,8 @@ struct MpuSimMatMulFunctor
                         const float* matrixA,
                         const float* matrixB,
                         float* matrixC,
+                        const float* biasVector,
+                        const ActivationFunction activationFunction,
                         const std::string& logFileOutputDirString,
                         const std::string& modelNameString)
     {
@@ -78,7 +80,9 @@ struct MpuSimMatMulFunctor
                                                     matrixC,
                                                     logFileOutputDirString,
                                                     modelNameString,
-                                                    opKernelStringSlashesReplacedWithUnderscores);
+                                                    opKernelStringSlashesReplacedWithUnderscores,
+                                                    biasVector,
+                                                    activationFunction);
     }
 };
 
@@ -127,6 +131,18 @@ public:
         OP_REQUIRES_OK(opKernelConstruction, opKernelConstruction->GetAttr(
                                                                 "accumulator_array_height",
                                                                 &m_accumulatorArrayHeight));
+
+        // The attribute constraint can only state the minimum of the
+        // accumulator array height, the MPU requires at least twice
+        // the systolic array height
+
+        OP_REQUIRES(opKernelConstruction,
+                        m_accumulatorArrayHeight >= 2*m_systolicArrayHeight,
+                        errors::InvalidArgument(
+                                    "mpu_sim_mat_mul accumulator array height ",
+                                    m_accumulatorArrayHeight,
+                                    " must be at least twice the systolic array height ",
+                                    m_systolicArrayHeight));
         
         OP_REQUIRES_OK(opKernelConstruction, opKernelConstruction->GetAttr(
                                                                 "model_name",
@@ -134,6 +150,25 @@ public:
         OP_REQUIRES_OK(opKernelConstruction, opKernelConstruction->GetAttr(
                                                                 "log_file_output_dir",
                                                                 &m_logFileOutputDirString));
+
+        int64 numArgs;
+        std::string activationString;
+
+        OP_REQUIRES_OK(opKernelConstruction, opKernelConstruction->GetAttr(
+                                                                "num_args",
+                                                                &numArgs));
+        OP_REQUIRES(opKernelConstruction, numArgs <= 1,
+                        errors::InvalidArgument(
+                                    "mpu_sim_mat_mul takes at most one "
+                                    "fused argument, the bias vector"));
+
+        m_useBias = (numArgs == 1);
+
+        OP_REQUIRES_OK(opKernelConstruction, opKernelConstruction->GetAttr(
+                                                                "activation",
+                                                                &activationString));
+
+        m_activationFunction = getActivationFunctionFromString(activationString);
                                                                                                                                 
         std::cout << "Added mpu_sim_mat_mul operation\n\tActivations size: "
                     << m_activationsDatatypeSizeByte << " byte\tWeights size: "
@@ -185,6 +220,28 @@ public:
         TensorShape outShape({tensorA.dim_size(dimARemaining),
                                     tensorB.dim_size(dimBRemaining)});
             
+        const float* biasVector{nullptr};
+
+        if(m_useBias)
+        {
+            const Tensor& tensorBias = opKernelContext->input(2);
+
+            OP_REQUIRES(opKernelContext,
+                            TensorShapeUtils::IsVector(tensorBias.shape()),
+                            errors::InvalidArgument(
+                                        "Bias is not a vector. Instead it has shape ",
+                                        tensorBias.shape().DebugString()));
+
+            OP_REQUIRES(opKernelContext,
+                            tensorBias.dim_size(0) == tensorB.dim_size(1),
+                            errors::InvalidArgument(
+                                "Bias size-incompatible: Bias: ",
+                                tensorBias.shape().DebugString(),
+                                ", In[1]: ", tensorB.shape().DebugString()));
+
+            biasVector = tensorBias.flat<float>().data();
+        }
+
         Tensor* tensorC{nullptr};
 
         OP_REQUIRES_OK(opKernelContext, opKernelContext->allocate_output(0, outShape, &tensorC));
@@ -233,6 +290,8 @@ public:
                                 tensorA.flat<float>().data(),
                                 tensorB.flat<float>().data(),
                                 tensorC->flat<float>().data(),
+                                biasVector,
+                                m_activationFunction,
                                 m_logFileOutputDirString,
                                 m_modelNameString);
     }
@@ -250,11 +309,15 @@ public:
     int64 m_systolicArrayWidth;
     int64 m_activationFifoDepth;
     int64 m_accumulatorArrayHeight;
+
+    bool m_useBias;
+    ActivationFunction m_activationFunction;
 };
 
 REGISTER_OP("MpuSimMatMul")
     .Input("a: T")
     .Input("b: T")
+    .Input("args: num_args * T")
     .Output("product: T")
     .Attr("T: {float}")
     .Attr("transpose_a: bool = false")
@@ -268,6 +331,8 @@ REGISTER_OP("MpuSimMatMul")
     .Attr("accumulator_array_height: int >= 4")
     .Attr("log_file_output_dir: string")
     .Attr("model_name: string")
+    .Attr("num_args: int >= 0")
+    .Attr("activation: {'none', 'relu', 'relu6'} = 'none'")
     .SetShapeFn(shape_inference::MatMulShape);
   
 REGISTER_KERNEL_BUILDER(Name("MpuSimMatMul") \
@@ -29,11 +29,20 @@ from tensorflow.python.framework import tensor_util
 from tensorflow.python.ops import array_ops
 from tensorflow.python.ops import gen_array_ops
 from tensorflow.python.ops import gen_math_ops
+from tensorflow.python.ops import gen_nn_ops
 from tensorflow.python.ops import math_ops
 
 @ops.RegisterGradient("MpuSimMatMul")
 def _MpuSimMatMulGrad(op, grad):
     """Gradient for MpuSimMatMul."""
+    # Backpropagate through the activation function and bias
+    # applied by the MPU activation unit
+    activation = op.get_attr("activation")
+    if activation in (b"relu", "relu"):
+        grad = gen_nn_ops.relu_grad(grad, op.outputs[0])
+    elif activation in (b"relu6", "relu6"):
+        grad = gen_nn_ops.relu6_grad(grad, op.outputs[0])
+
     try:
         skip_input_indices = op.skip_input_indices
         if skip_input_indices is not None:
@@ -61,5 +70,7 @@ def _MpuSimMatMulGrad(op, grad):
     elif t_a and t_b:
         grad_a = gen_math_ops.mat_mul(b, grad, transpose_a=True, transpose_b=True)
         grad_b = gen_math_ops.mat_mul(grad, a, transpose_a=True, transpose_b=True)
+    if op.get_attr("num_args") == 1:
+        return grad_a, grad_b, gen_nn_ops.bias_add_grad(grad)
     return grad_a, grad_b
 
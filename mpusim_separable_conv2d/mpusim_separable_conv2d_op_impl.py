@@ -92,6 +92,7 @@ def mpusim_separable_conv2d_impl(input,
             kernels = tf.split(depthwise_filter, channels, 3)
             outputs = [mpu_sim_conv2d_lib.mpu_sim_conv2d(input_block,
                                                             kernel_block,
+                                                            [],
                                                             activations_datatype_size_byte,
                                                             weights_datatype_size_byte,
                                                             results_datatype_size_byte,
@@ -118,6 +119,7 @@ def mpusim_separable_conv2d_impl(input,
 
         return mpu_sim_conv2d_lib.mpu_sim_conv2d(depthwise,
                                                     pointwise_filter,
+                                                    [],
                                                     activations_datatype_size_byte,
                                                     weights_datatype_size_byte,
                                                     results_datatype_size_byte,
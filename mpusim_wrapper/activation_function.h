@@ -0,0 +1,76 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        activation_function.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef ACTIVATION_FUNCTION_H
+#define ACTIVATION_FUNCTION_H
+
+#include <stdexcept>
+#include <string>
+
+/**
+ * @enum    ActivationFunction
+ * @brief   Activation function applied by the activation unit
+ *          after the accumulators when reading out the results
+ */
+
+enum class ActivationFunction
+{
+    None,
+    Relu,
+    Relu6
+};
+
+/**
+ * @brief                           Get the activation function from the
+ *                                  string used in the TensorFlow op attributes
+ * @param activationFunctionString  One of "none", "relu", or "relu6"
+ */
+
+inline ActivationFunction getActivationFunctionFromString(
+                                        const std::string& activationFunctionString)
+{
+    if(activationFunctionString == "none")
+    {
+        return ActivationFunction::None;
+    }
+
+    if(activationFunctionString == "relu")
+    {
+        return ActivationFunction::Relu;
+    }
+
+    if(activationFunctionString == "relu6")
+    {
+        return ActivationFunction::Relu6;
+    }
+
+    throw std::invalid_argument("MpuSim Wrapper: Unsupported activation function \"" +
+                                                        activationFunctionString + "\"");
+}
+
+#endif
@@ -0,0 +1,343 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        mpu_instance_cache.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef MPU_INSTANCE_CACHE_H
+#define MPU_INSTANCE_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+#include <cstddef>
+
+#include "activation_function.h"
+
+/**
+ * @struct  MpuConfiguration
+ * @brief   The full configuration of an MPU instance,
+ *          used as the key of the MPU instance cache
+ */
+
+struct MpuConfiguration
+{
+    bool operator==(const MpuConfiguration& other) const
+    {
+        return (weightsDatatypeSizeByte == other.weightsDatatypeSizeByte) &&
+                (activationsDatatypeSizeByte == other.activationsDatatypeSizeByte) &&
+                (resultsDatatypeSizeByte == other.resultsDatatypeSizeByte) &&
+                (systolicArrayHeight == other.systolicArrayHeight) &&
+                (systolicArrayWidth == other.systolicArrayWidth) &&
+                (activationFifoDepth == other.activationFifoDepth) &&
+                (accumulatorArrayHeight == other.accumulatorArrayHeight);
+    }
+
+    size_t weightsDatatypeSizeByte;
+    size_t activationsDatatypeSizeByte;
+    size_t resultsDatatypeSizeByte;
+
+    size_t systolicArrayHeight;
+    size_t systolicArrayWidth;
+    size_t activationFifoDepth;
+    size_t accumulatorArrayHeight;
+};
+
+struct MpuConfigurationHash
+{
+    size_t operator()(const MpuConfiguration& mpuConfiguration) const
+    {
+        const std::hash<size_t> hash;
+
+        size_t seed{0UL};
+
+        for(const size_t value : {mpuConfiguration.weightsDatatypeSizeByte,
+                                    mpuConfiguration.activationsDatatypeSizeByte,
+                                    mpuConfiguration.resultsDatatypeSizeByte,
+                                    mpuConfiguration.systolicArrayHeight,
+                                    mpuConfiguration.systolicArrayWidth,
+                                    mpuConfiguration.activationFifoDepth,
+                                    mpuConfiguration.accumulatorArrayHeight})
+        {
+            seed ^= hash(value) + 0x9e3779b97f4a7c15UL + (seed << 6) + (seed >> 2);
+        }
+
+        return seed;
+    }
+};
+
+/**
+ * @class   MpuInstanceHandle
+ * @brief   Type-erased handle of an MPU instance of any
+ *          combination of parameter datatypes
+ */
+
+class MpuInstanceHandle
+{
+
+public:
+
+    virtual ~MpuInstanceHandle() = default;
+
+    /**
+     * @brief                       Quantize the operands, run the multiplication,
+     *                              and scale the results back to floating point,
+     *                              adding the bias and applying the activation function
+     * @param sizeM                 The rows of the activation matrix
+     * @param sizeN                 The columns of the weight matrix
+     * @param sizeK                 The columns of the activation matrix
+     * @param activationMatrix      The row major activation matrix
+     * @param weightMatrix          The row major weight matrix
+     * @param resultMatrix          The row major result matrix
+     * @param operationNameString   The string identifier of the weight matrix
+     * @param biasVector            The bias of each result column, nullptr for none
+     * @param activationFunction    The activation function applied to the results
+     */
+
+    virtual void runMultiplication(const size_t sizeM,
+                                    const size_t sizeN,
+                                    const size_t sizeK,
+                                    const float* const activationMatrix,
+                                    const float* const weightMatrix,
+                                    float* const resultMatrix,
+                                    const std::string& operationNameString,
+                                    const float* const biasVector,
+                                    const ActivationFunction activationFunction) = 0;
+
+    virtual void printUnifiedBufferLayout() const = 0;
+
+    virtual std::string getStatisticsString() const = 0;
+
+    /**
+     * @brief   Get the number of multiplications that reused the quantized
+     *          weight matrix resident in the unified buffer
+     */
+
+    virtual size_t getQuantizedWeightMatrixHitCount() const = 0;
+
+    /**
+     * @brief   Get the number of multiplications that had to
+     *          quantize their weight matrix into the unified buffer
+     */
+
+    virtual size_t getQuantizedWeightMatrixMissCount() const = 0;
+
+};
+
+/**
+ * @class   MpuInstanceCache
+ * @brief   Bounded pool of idle MPU instances keyed by their full
+ *          configuration. Callers check an instance out for the
+ *          duration of a multiplication and check it back in afterwards,
+ *          so concurrent callers never share an instance. When a
+ *          configuration is requested by more callers at once than it
+ *          has idle instances, the missing ones are created by the caller,
+ *          so the pool may hold several instances of one configuration.
+ *          When more than the capacity of instances is idle, checking an
+ *          instance in evicts the least recently used idle ones, destroying
+ *          them together with the weight matrices resident in their unified
+ *          buffers. All member functions are thread safe.
+ */
+
+class MpuInstanceCache final
+{
+
+public:
+
+    explicit MpuInstanceCache(const size_t capacity): m_capacity{capacity}
+    {
+    }
+
+    MpuInstanceCache(const MpuInstanceCache& other) = delete;
+    MpuInstanceCache& operator=(const MpuInstanceCache& other) = delete;
+
+    /**
+     * @brief                   Remove an idle instance of the
+     *                          given configuration from the pool
+     * @param mpuConfiguration  The configuration of the instance
+     * @return                  The instance, nullptr if no idle instance
+     *                          of the configuration is available
+     */
+
+    std::unique_ptr<MpuInstanceHandle> checkOut(const MpuConfiguration& mpuConfiguration)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const auto entryMapIterator = m_entryMap.find(mpuConfiguration);
+
+        if(entryMapIterator == m_entryMap.end())
+        {
+            ++m_missCount;
+            return nullptr;
+        }
+
+        ++m_hitCount;
+
+        const auto entryListIterator = entryMapIterator->second;
+
+        std::unique_ptr<MpuInstanceHandle> mpuInstancePtr{
+                                        std::move(entryListIterator->second)};
+
+        m_entryMap.erase(entryMapIterator);
+        m_entryList.erase(entryListIterator);
+
+        return mpuInstancePtr;
+    }
+
+    /**
+     * @brief                   Return an instance to the pool as the most
+     *                          recently used idle one, evicting the least
+     *                          recently used idle instances beyond the capacity
+     * @param mpuConfiguration  The configuration of the instance
+     * @param mpuInstancePtr    The instance
+     * @return                  The number of evicted instances
+     */
+
+    size_t checkIn(const MpuConfiguration& mpuConfiguration,
+                        std::unique_ptr<MpuInstanceHandle>&& mpuInstancePtr)
+    {
+        // Destroy evicted instances only after releasing the lock,
+        // as freeing their unified buffers can take a while
+
+        std::list<Entry> entryListEvicted;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_entryList.emplace_front(mpuConfiguration, std::move(mpuInstancePtr));
+        m_entryMap.emplace(mpuConfiguration, m_entryList.begin());
+
+        while(m_entryList.size() > m_capacity)
+        {
+            const auto entryListIteratorLast = std::prev(m_entryList.end());
+
+            eraseFromEntryMap(entryListIteratorLast);
+
+            entryListEvicted.splice(entryListEvicted.end(),
+                                        m_entryList, entryListIteratorLast);
+
+            ++m_evictionCount;
+        }
+
+        return entryListEvicted.size();
+    }
+
+    /**
+     * @brief           Call the given function for every idle
+     *                  instance, most recently used first
+     * @param function  The function, taking a const reference
+     *                  to an MpuInstanceHandle
+     */
+
+    template<typename Function> void forEach(Function function) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for(const Entry& entry : m_entryList)
+        {
+            function(static_cast<const MpuInstanceHandle&>(*entry.second));
+        }
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entryList.size();
+    }
+
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    size_t getHitCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_hitCount;
+    }
+
+    size_t getMissCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_missCount;
+    }
+
+    size_t getEvictionCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_evictionCount;
+    }
+
+    std::string getStatisticsString() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return "MPU instance cache: Hits: " + std::to_string(m_hitCount) +
+                    "\tMisses: " + std::to_string(m_missCount) +
+                    "\tEvictions: " + std::to_string(m_evictionCount) +
+                    "\tIdle instances: " + std::to_string(m_entryList.size()) +
+                    "/" + std::to_string(m_capacity);
+    }
+
+private:
+
+    using Entry = std::pair<const MpuConfiguration, std::unique_ptr<MpuInstanceHandle>>;
+
+    void eraseFromEntryMap(const std::list<Entry>::iterator entryListIterator)
+    {
+        const auto entryMapRange = m_entryMap.equal_range(entryListIterator->first);
+
+        for(auto entryMapIterator = entryMapRange.first;
+                    entryMapIterator != entryMapRange.second; ++entryMapIterator)
+        {
+            if(entryMapIterator->second == entryListIterator)
+            {
+                m_entryMap.erase(entryMapIterator);
+                return;
+            }
+        }
+    }
+
+    const size_t m_capacity;
+
+    mutable std::mutex m_mutex;
+
+    std::list<Entry> m_entryList;
+
+    std::unordered_multimap<MpuConfiguration,
+                            std::list<Entry>::iterator,
+                            MpuConfigurationHash> m_entryMap;
+
+    size_t m_hitCount{0UL};
+    size_t m_missCount{0UL};
+    size_t m_evictionCount{0UL};
+
+};
+
+#endif
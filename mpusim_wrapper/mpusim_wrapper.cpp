@@ -27,195 +27,24 @@
  */
 
 #include <stdexcept>
+#include <unordered_map>
 #include <algorithm>
 #include <numeric>
 #include <limits>
 #include <type_traits>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <cmath>
 #include <climits>
 
 #include "mpusim_wrapper.h"
-
-#define CONSTRUCT_AND_CONFIGURE_MPU(mpuPtr, WeightsDatatype, ActivationsDatatype, ResultsDatatype) \
-mpuPtr = new MatrixProcessingUnit<WeightsDatatype, ActivationsDatatype, ResultsDatatype>(\
-                                                                                systolicArrayWidth,\
-                                                                                systolicArrayHeight,\
-                                                                                activationFifoDepth,\
-                                                                                accumulatorArrayHeight,\
-                                                                                unifiedBufferSizeMaxByte);\
-mpuPtr->setDebugFlag(true);\
-mpuPtr->registerLogEntryAvailableCallback([this](MpuStatisticsLogEntry&& mpuStatisticsLogEntry){\
-    m_mpuStatisticsLoggerPtr->addMpuStatisticsLogEntry(std::move(mpuStatisticsLogEntry));\
-})
-
-#define QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(mpuPtr, WeightsDatatype, ActivationsDatatype, ResultsDatatype)\
-if(!matrixNeedsPadding)\
-{\
-    WeightsDatatype* const weightMatrixQuantized{\
-                            reinterpret_cast<WeightsDatatype*>(quantizationBufferPtr)};\
-    const size_t weightMatrixSizeByte{sizeN*sizeK*sizeof(WeightsDatatype)};\
-    quantizeLinear(weightMatrix, weightMatrixQuantized, sizeK*sizeN);\
-    mpuPtr->storeWeightMatrix(operationNameString,\
-                                weightMatrixQuantized,\
-                                sizeK, sizeN);\
-    ActivationsDatatype* const activationMatrixQuantized{\
-                                    reinterpret_cast<ActivationsDatatype*>(\
-                                                            quantizationBufferPtr +\
-                                                            weightMatrixSizeByte)};\
-    const size_t activationMatrixSizeByte{sizeM*sizeK*\
-                                            sizeof(ActivationsDatatype)};\
-    double activationMatrixMeanUnquantized;\
-    double activationMatrixStdDevUnquantized;\
-    getMeanAndStdDev(activationMatrix, sizeM*sizeK,\
-                        activationMatrixMeanUnquantized,\
-                        activationMatrixStdDevUnquantized);\
-    std::cout << "Raw activations: Mean: " << activationMatrixMeanUnquantized\
-                << "\tStdDev: " << activationMatrixStdDevUnquantized << std::endl;\
-    const float scaleFactorResults{1.0F/quantizeLinear(activationMatrix,\
-                                                        activationMatrixQuantized,\
-                                                        sizeM*sizeK)};\
-    double activationMatrixMeanQuantized;\
-    double activationMatrixStdDevQuantized;\
-    getMeanAndStdDev(activationMatrixQuantized, sizeM*sizeK,\
-                                activationMatrixMeanQuantized,\
-                                activationMatrixStdDevQuantized);\
-    std::cout << "Quantized activations: Mean: " << activationMatrixMeanQuantized\
-                    << "\tStdDev: " << activationMatrixStdDevQuantized << std::endl;\
-    mpuPtr->storeActivationMatrix(activationMatrixQuantized, sizeM, sizeK);\
-    mpuPtr->runMultiplication(operationNameString);\
-    mpuPtr->loadResultMatrix(reinterpret_cast<ResultsDatatype*>(\
-                                                        quantizationBufferPtr +\
-                                                        weightMatrixSizeByte +\
-                                                        activationMatrixSizeByte),\
-                                                        sizeM*sizeN);\
-    scaleToFactor(reinterpret_cast<ResultsDatatype*>(\
-                                            quantizationBufferPtr +\
-                                            weightMatrixSizeByte +\
-                                            activationMatrixSizeByte),\
-                                            resultMatrix,\
-                                            scaleFactorResults,\
-                                            sizeM*sizeN);\
-}\
-else\
-{\
-    WeightsDatatype* const weightMatrixQuantized{\
-                            reinterpret_cast<WeightsDatatype*>(quantizationBufferPtr)};\
-    const size_t weightMatrixSizeByte{sizeNPadded*sizeKPadded*sizeof(WeightsDatatype)};\
-    quantizeLinearAndPad(weightMatrix,\
-                            weightMatrixQuantized,\
-                            sizeK,\
-                            sizeN,\
-                            sizeKPadded,\
-                            sizeNPadded);\
-    mpuPtr->storeWeightMatrix(operationNameString,\
-                                weightMatrixQuantized,\
-                                sizeKPadded, sizeNPadded);\
-    ActivationsDatatype* const activationMatrixQuantized{\
-                                    reinterpret_cast<ActivationsDatatype*>(\
-                                                            quantizationBufferPtr +\
-                                                            weightMatrixSizeByte)};\
-    const size_t activationMatrixSizeByte{sizeM*sizeKPadded*\
-                                            sizeof(ActivationsDatatype)};\
-    double activationMatrixMeanUnquantized;\
-    double activationMatrixStdDevUnquantized;\
-    getMeanAndStdDev(activationMatrix, sizeM*sizeK,\
-                        activationMatrixMeanUnquantized,\
-                        activationMatrixStdDevUnquantized);\
-    std::cout << "Raw activations: Mean: " << activationMatrixMeanUnquantized\
-                << "\tStdDev: " << activationMatrixStdDevUnquantized << std::endl;\
-    const float scaleFactorResults{1.0F/quantizeLinearAndPad(activationMatrix,\
-                                                                activationMatrixQuantized,\
-                                                                sizeM,\
-                                                                sizeK,\
-                                                                sizeM,\
-                                                                sizeKPadded)};\
-    double activationMatrixMeanQuantized;\
-    double activationMatrixStdDevQuantized;\
-    getMeanAndStdDevPadded(activationMatrixQuantized,\
-                            sizeM,\
-                            sizeK,\
-                            sizeM,\
-                            sizeKPadded,\
-                            activationMatrixMeanQuantized,\
-                            activationMatrixStdDevQuantized);\
-    std::cout << "Quantized activations: Mean: " << activationMatrixMeanQuantized\
-                    << "\tStdDev: " << activationMatrixStdDevQuantized << std::endl;\
-    mpuPtr->storeActivationMatrix(activationMatrixQuantized, sizeM, sizeKPadded);\
-    mpuPtr->runMultiplication(operationNameString);\
-    mpuPtr->loadResultMatrix(reinterpret_cast<ResultsDatatype*>(\
-                                                        quantizationBufferPtr +\
-                                                        weightMatrixSizeByte +\
-                                                        activationMatrixSizeByte),\
-                                                        sizeM*sizeNPadded);\
-    scaleToFactorAndCrop(reinterpret_cast<ResultsDatatype*>(\
-                                            quantizationBufferPtr +\
-                                            weightMatrixSizeByte +\
-                                            activationMatrixSizeByte),\
-                                            resultMatrix,\
-                                            scaleFactorResults,\
-                                            sizeM,\
-                                            sizeNPadded,\
-                                            sizeM,\
-                                            sizeN);\
-}\
-mpuPtr->resetIterationCounts();\
-mpuPtr->resetDataMovementAndFootprintMetrics();\
-mpuPtr->printUnifiedBufferLayout();\
-std::cout << "Unified buffer memory usage: "\
-            << mpuPtr->getUnifiedBufferSizeMinBit() << std::endl\
+#include "quantization_kernels.h"
+#include "fixed_geometry_matrix_processing_unit.h"
 
 namespace
 {
 
-constexpr size_t bufferSizeBegin{1024};
-
-class QuantizationBufferSingleton final
-{
-public:
-
-    static QuantizationBufferSingleton& getInstance()
-    {
-        static QuantizationBufferSingleton instance;
-        return instance;
-    }
-
-    inline mpusim::byte* get(const size_t size)
-    {
-        if(size == 0)
-        {
-            throw;
-        }
-        
-        if(size > m_size)
-        {
-            m_size = size;
-            m_memory.resize(m_size);
-            
-            std::cout << "Resized quantization buffer, "
-                                                "new size: "
-                        << m_size/1024UL << " kB" << std::endl;
-        }
-
-        return m_memory.data();
-    }
-
-private:
-
-    QuantizationBufferSingleton(): m_memory(bufferSizeBegin){}
-
-    QuantizationBufferSingleton(QuantizationBufferSingleton& other) = delete;
-    QuantizationBufferSingleton(QuantizationBufferSingleton&& other) = delete;
-
-    void operator=(QuantizationBufferSingleton& other) = delete;
-
-    std::vector<mpusim::byte> m_memory;
-
-    size_t m_size{bufferSizeBegin};
-
-};
-
 constexpr size_t combineParameterDatatypeSizes(const size_t weightsDatatypeSizeByte,
                                                 const size_t activationsDatatypeSizeByte,
                                                 const size_t resultsDatatypeSizeByte)
@@ -225,228 +54,132 @@ constexpr size_t combineParameterDatatypeSizes(const size_t weightsDatatypeSizeB
             resultsDatatypeSizeByte;
 }
 
-template<typename T> void getMeanAndStdDev(T* const data,
-                                            const size_t size,
-                                            double& mean,
-                                            double& stdDev)
-{
-    if(std::is_floating_point<T>::value)
-    {
-        const T sum{std::accumulate(data, data + size, T{0})};
-        mean = static_cast<double>(sum)/static_cast<double>(size);
-
-        std::vector<double> diff(size);
+#ifdef MPUSIM_WRAPPER_NO_QUANTIZATION_STATISTICS
+constexpr bool quantizationStatisticsEnabled{false};
+#else
+constexpr bool quantizationStatisticsEnabled{true};
+#endif
 
-        std::transform(data, data + size,
-                        diff.begin(), [mean](const double x) { return x - mean; });
+#ifdef MPUSIM_WRAPPER_NO_WEIGHT_REUSE
+constexpr bool weightMatrixReuseEnabled{false};
+#else
+constexpr bool weightMatrixReuseEnabled{true};
+#endif
 
-        const double squareSum{std::inner_product(diff.begin(), diff.end(), diff.begin(), 0.0)};
-        stdDev = std::sqrt(squareSum/size);
-    }
-
-    else
-    {
-        const size_t sum{std::accumulate(data, data + size, 0UL)};
-        mean = static_cast<double>(sum)/static_cast<double>(size);
-
-        std::vector<double> diff(size);
+constexpr size_t unifiedBufferSizeMaxByte{1024UL*1024UL*1024UL};
 
-        std::transform(data, data + size,
-                        diff.begin(), [mean](const double x) { return x - mean; });
+#ifdef MPUSIM_WRAPPER_FIXED_GEOMETRY
 
-        const double squareSum{std::inner_product(diff.begin(), diff.end(), diff.begin(), 0.0)};
-        stdDev = std::sqrt(squareSum/size);
-    }
-}
+/**
+ * @brief   Create an MPU specialized for the first of the given square
+ *          systolic array sizes matching the requested configuration,
+ *          or return nullptr if none of them matches
+ */
 
-template<typename T> void getMeanAndStdDevPadded(T* const data,
-                                                    const size_t heightOriginal,
-                                                    const size_t widthOriginal,
-                                                    const size_t heightPadded,
-                                                    const size_t widthPadded,
-                                                    double& mean,
-                                                    double& stdDev)
+template<typename WeightsDatatype,
+            typename ActivationsDatatype,
+            typename ResultsDatatype,
+            size_t ActivationFifoDepth> MatrixProcessingUnit<WeightsDatatype,
+                                                                ActivationsDatatype,
+                                                                ResultsDatatype>* createFixedGeometryMatrixProcessingUnit(
+                                                                                            const size_t,
+                                                                                            const size_t,
+                                                                                            const size_t,
+                                                                                            const size_t)
 {
-    if(std::is_floating_point<T>::value)
-    {
-        const size_t elementCountOriginal{heightOriginal*widthOriginal};
-        
-        typename std::remove_const<T>::type sum{0UL};
-        
-        for(size_t rowCount{0UL}; rowCount < heightOriginal; ++rowCount)
-        {
-            sum += std::accumulate(data + rowCount*widthPadded,
-                                    data + rowCount*widthPadded + widthOriginal, T{0});
-        }
-        
-        mean = static_cast<double>(sum)/static_cast<double>(elementCountOriginal);
-
-        std::vector<double> diff;
-        
-        diff.reserve(elementCountOriginal);
-
-        for(size_t rowCount{0UL}; rowCount < heightOriginal; ++rowCount)
-        {
-            std::transform(data + rowCount*widthPadded,
-                            data + rowCount*widthPadded + widthOriginal,
-                            std::back_inserter(diff),
-                            [mean](const double x) { return x - mean; });
-        }
-
-        const double squareSum{std::inner_product(diff.begin(), diff.end(), diff.begin(), 0.0)};
-        stdDev = std::sqrt(squareSum/elementCountOriginal);
-    }
-    
-    else
-    {
-        const size_t elementCountOriginal{heightOriginal*widthOriginal};
-        
-        size_t sum{0UL};
-        
-        for(size_t rowCount{0UL}; rowCount < heightOriginal; ++rowCount)
-        {
-            sum += std::accumulate(data + rowCount*widthPadded,
-                                    data + rowCount*widthPadded + widthOriginal, 0UL);
-        }
-        
-        mean = static_cast<double>(sum)/static_cast<double>(elementCountOriginal);
-
-        std::vector<double> diff;
-        
-        diff.reserve(elementCountOriginal);
-
-        for(size_t rowCount{0UL}; rowCount < heightOriginal; ++rowCount)
-        {
-            std::transform(data + rowCount*widthPadded,
-                            data + rowCount*widthPadded + widthOriginal,
-                            std::back_inserter(diff),
-                            [mean](const double x) { return x - mean; });
-        }
-
-        const double squareSum{std::inner_product(diff.begin(), diff.end(), diff.begin(), 0.0)};
-        stdDev = std::sqrt(squareSum/elementCountOriginal);
-    }
+    return nullptr;
 }
 
-template<typename T> float quantizeLinear(const float* const inputMatrix,
-                                                    T* const outputMatrix,
-                                                    const size_t size)
+template<typename WeightsDatatype,
+            typename ActivationsDatatype,
+            typename ResultsDatatype,
+            size_t ActivationFifoDepth,
+            size_t SystolicArraySize,
+            size_t... SystolicArraySizes> MatrixProcessingUnit<WeightsDatatype,
+                                                                ActivationsDatatype,
+                                                                ResultsDatatype>* createFixedGeometryMatrixProcessingUnit(
+                                                                                            const size_t systolicArrayHeight,
+                                                                                            const size_t systolicArrayWidth,
+                                                                                            const size_t activationFifoDepth,
+                                                                                            const size_t accumulatorArrayHeight)
 {
-    const float inputValueMax{*(std::max_element(inputMatrix,
-                                                    inputMatrix + size,
-                                                    [](float lh, float rh){
-        return std::fabs(lh) < std::fabs(rh);
-    }))};
-    
-    const float scaleFactor{static_cast<float>(std::numeric_limits<T>::max())/
-                                                                    inputValueMax};
-
-    std::transform(inputMatrix,
-                    inputMatrix + size,
-                    outputMatrix,
-                    [scaleFactor](const float input) -> T {
-                        return static_cast<T>(input*scaleFactor);
-    });
-    
-    return scaleFactor;
-}
-
-template<typename T> float quantizeLinearAndPad(const float* const inputMatrix,
-                                                    T* const outputMatrix,
-                                                    const size_t heightOriginal,
-                                                    const size_t widthOriginal,
-                                                    const size_t heightTarget,
-                                                    const size_t widthTarget)
-{
-    
-    if(heightTarget < heightOriginal)
-    {
-        throw std::invalid_argument("MpuSim Wrapper: quantizeLinearAndPad "
-                                        "target height smaller than original height");
-    }
-    
-    if(widthTarget < widthOriginal)
+    using FixedGeometryMpu = FixedGeometryMatrixProcessingUnit<WeightsDatatype,
+                                                                ActivationsDatatype,
+                                                                ResultsDatatype,
+                                                                SystolicArraySize,
+                                                                SystolicArraySize,
+                                                                ActivationFifoDepth>;
+
+    if(FixedGeometryMpu::matchesGeometry(systolicArrayWidth,
+                                            systolicArrayHeight,
+                                            activationFifoDepth))
     {
-        throw std::invalid_argument("MpuSim Wrapper: quantizeLinearAndPad "
-                                        "target width smaller than original width");
+        return new FixedGeometryMpu(accumulatorArrayHeight,
+                                        unifiedBufferSizeMaxByte);
     }
-    
-    const size_t elementCountOriginal{heightOriginal*widthOriginal};
-    const size_t elementCountTarget{heightTarget*widthTarget};
-    
-    const float inputValueMax{*(std::max_element(inputMatrix,
-                                                    inputMatrix +
-                                                        elementCountOriginal,
-                                                    [](float lh, float rh){
-        return std::fabs(lh) < std::fabs(rh);
-    }))};
-    
-    const float scaleFactor{static_cast<float>(std::numeric_limits<T>::max())/
-                                                                    inputValueMax};
-                                                                    
-    std::fill(outputMatrix, outputMatrix + elementCountTarget, T{0});
 
-    for(size_t rowCount{0UL}; rowCount < heightOriginal; ++rowCount)
-    {
-        for(size_t columnCount{0UL}; columnCount < widthOriginal; ++columnCount)
-        {
-            outputMatrix[rowCount*widthTarget + columnCount] = 
-                            static_cast<T>(inputMatrix[rowCount*widthOriginal + columnCount]*
-                                                                                    scaleFactor);
-        }
-    }
-    
-    return scaleFactor;
+    return createFixedGeometryMatrixProcessingUnit<WeightsDatatype,
+                                                    ActivationsDatatype,
+                                                    ResultsDatatype,
+                                                    ActivationFifoDepth,
+                                                    SystolicArraySizes...>(systolicArrayHeight,
+                                                                            systolicArrayWidth,
+                                                                            activationFifoDepth,
+                                                                            accumulatorArrayHeight);
 }
 
-template<typename T> void scaleToFactor(const T* const inputMatrix,
-                                                float* const outputMatrix,
-                                                const float factor,
-                                                const size_t size)
-
-{
-    std::transform(inputMatrix,
-                    inputMatrix + size,
-                    outputMatrix,
-                    [factor](const decltype(*inputMatrix) input) -> float {
-                        return static_cast<float>(input*factor);
-    });
-}
+#endif
 
-template<typename T> void scaleToFactorAndCrop(const T* const inputMatrix,
-                                                float* const outputMatrix,
-                                                const float factor,
-                                                const size_t heightOriginal,
-                                                const size_t widthOriginal,
-                                                const size_t heightCropped,
-                                                const size_t widthCropped)
-{    
-    if(heightOriginal < heightCropped)
-    {
-        throw std::invalid_argument("MpuSim Wrapper: scaleToFactorAndCrop "
-                                        "target height larger than original height");
-    }
+/**
+ * @brief   Create an MPU using the structure of arrays systolic array engine.
+ *          If the wrapper was built with fixed geometry MPUs, configurations
+ *          matching one of the compiled geometries use the MPU specialized for it.
+ */
 
-    if(heightOriginal < heightCropped)
+template<typename WeightsDatatype,
+            typename ActivationsDatatype,
+            typename ResultsDatatype> MatrixProcessingUnit<WeightsDatatype,
+                                                            ActivationsDatatype,
+                                                            ResultsDatatype>* createMatrixProcessingUnit(
+                                                                                    const size_t systolicArrayWidth,
+                                                                                    const size_t systolicArrayHeight,
+                                                                                    const size_t activationFifoDepth,
+                                                                                    const size_t accumulatorArrayHeight)
+{
+#ifdef MPUSIM_WRAPPER_FIXED_GEOMETRY
+    MatrixProcessingUnit<WeightsDatatype,
+                            ActivationsDatatype,
+                            ResultsDatatype>* const fixedGeometryMpuPtr{
+                                    createFixedGeometryMatrixProcessingUnit<WeightsDatatype,
+                                                                            ActivationsDatatype,
+                                                                            ResultsDatatype,
+                                                                            8UL,
+                                                                            8UL, 16UL, 32UL,
+                                                                            64UL, 128UL, 256UL>(
+                                                                                    systolicArrayHeight,
+                                                                                    systolicArrayWidth,
+                                                                                    activationFifoDepth,
+                                                                                    accumulatorArrayHeight)};
+
+    if(fixedGeometryMpuPtr)
     {
-        throw std::invalid_argument("MpuSim Wrapper: scaleToFactorAndCrop "
-                                        "target width larger than original width");
-    }
+        std::cout << "MpuSim Wrapper: Using MPU specialized for "
+                        "the requested systolic array geometry" << std::endl;
 
-    for(size_t rowCount{0UL}; rowCount < heightCropped; ++rowCount)
-    {
-        std::transform(inputMatrix + rowCount*widthOriginal,
-                        inputMatrix + rowCount*widthOriginal + widthCropped,
-                        outputMatrix + rowCount*widthCropped,
-                        [factor](const decltype(*inputMatrix) input) -> float {
-                            return static_cast<float>(input*factor);
-        });
+        return fixedGeometryMpuPtr;
     }
+#endif
+
+    return new MatrixProcessingUnit<WeightsDatatype,
+                                    ActivationsDatatype,
+                                    ResultsDatatype>(systolicArrayWidth,
+                                                        systolicArrayHeight,
+                                                        activationFifoDepth,
+                                                        accumulatorArrayHeight,
+                                                        unifiedBufferSizeMaxByte,
+                                                        SystolicArrayEngine::StructureOfArrays);
 }
 
-
-constexpr size_t unifiedBufferSizeMaxByte{1024UL*1024UL*1024UL};
-
 constexpr size_t parameterDatatypeSizesCombined8_8_8{
                             combineParameterDatatypeSizes(1UL, 1UL, 1UL)};
 
@@ -510,714 +243,537 @@ constexpr size_t parameterDatatypeSizesCombined32_64_64{
                             combineParameterDatatypeSizes(4UL, 8UL, 8UL)};
 constexpr size_t parameterDatatypeSizesCombined64_64_64{
                             combineParameterDatatypeSizes(8UL, 8UL, 8UL)};
-    
-}
 
-void MpuSimWrapper::runMultiplication(const size_t activationsDatatypeSizeByte,
-                                                const size_t weightsDatatypeSizeByte,
-                                                const size_t resultsDatatypeSizeByte,
-                                                const size_t systolicArrayHeight,
-                                                const size_t systolicArrayWidth,
-                                                const size_t activationFifoDepth,
-                                                const size_t accumulatorArrayHeight,
-                                                const size_t sizeM,
-                                                const size_t sizeN,
-                                                const size_t sizeK,
-                                                const float* const activationMatrix,
-                                                const float* const weightMatrix,
-                                                float* const resultMatrix,
-                                                const std::string& logFileOutputDirString,
-                                                const std::string& modelNameString,
-                                                const std::string& operationNameString)
+constexpr size_t mpuInstanceCacheCapacity{4UL};
+
+constexpr size_t weightMatrixFingerprintFullElementCountMax{64UL*1024UL};
+constexpr size_t weightMatrixFingerprintSampleCount{256UL};
+
+/**
+ * @brief   Get a fingerprint of the contents of a weight matrix, an FNV-1a
+ *          hash of its size and of the bit patterns of its elements. Matrices
+ *          of up to weightMatrixFingerprintFullElementCountMax elements are
+ *          hashed completely. Larger ones are hashed from evenly spaced
+ *          samples including the last element, at a cost independent of
+ *          their size. This is a limitation: a change confined to elements
+ *          that are not sampled is not detected, and the stale quantized
+ *          matrix is reused. Training steps that update all weights are
+ *          detected; for sparse in-place updates of large matrices, build
+ *          with MPUSIM_WRAPPER_WEIGHT_REUSE disabled to quantize the
+ *          weights on every call.
+ */
+
+uint64_t getWeightMatrixFingerprint(const float* const weightMatrix,
+                                        const size_t size)
 {
+    uint64_t fingerprint{0xcbf29ce484222325UL};
 
-    
-    const bool matrixNeedsPadding{((sizeN > systolicArrayWidth) &&
-                                    (sizeK <= systolicArrayHeight))};
-    
-//     const size_t sizeNPadded{matrixNeedsPadding &&
-//                                 (sizeN <= systolicArrayWidth) ?
-//                                                     systolicArrayWidth + 1UL : sizeN};
-                                    
-    const size_t sizeNPadded{sizeN};
-                                                            
-    const size_t sizeKPadded{matrixNeedsPadding &&
-                                    (sizeK <= systolicArrayHeight) ?
-                                                    systolicArrayHeight + 1UL : sizeK};
-
-    if(matrixNeedsPadding)
+    const auto addToFingerprint = [&fingerprint](uint64_t value)
     {
-        std::cout << "MpuSim Wrapper: Padding matrix in dimension ";
-        
-        if(sizeN <= systolicArrayWidth)
+        for(size_t byteCount{0UL}; byteCount < sizeof(value); ++byteCount)
         {
-            std::cout << "N, old size: "
-                        << sizeN
-                        << ", new size: "
-                        << sizeNPadded;
-        }
+            fingerprint ^= value & 0xffUL;
+            fingerprint *= 0x100000001b3UL;
 
-        else
-        {
-            std::cout << "K, old size: "
-                        << sizeK
-                        << ", new size: "
-                        << sizeKPadded;
+            value >>= 8;
         }
-        std::cout << std::endl;
+    };
+
+    addToFingerprint(size);
+
+    if(size == 0UL)
+    {
+        return fingerprint;
+    }
+
+    const size_t stride{(size <= weightMatrixFingerprintFullElementCountMax) ? 1UL :
+                                        size/weightMatrixFingerprintSampleCount};
+
+    uint32_t elementBits;
+
+    for(size_t element{0UL}; element < size; element += stride)
+    {
+        std::memcpy(&elementBits, weightMatrix + element, sizeof(elementBits));
+        addToFingerprint(elementBits);
     }
 
-    mpusim::byte* const quantizationBufferPtr{
-                            QuantizationBufferSingleton::getInstance().get(
-                                                sizeKPadded*sizeNPadded*weightsDatatypeSizeByte +
-                                                sizeM*sizeKPadded*activationsDatatypeSizeByte + 
-                                                sizeM*sizeNPadded*resultsDatatypeSizeByte)};
+    std::memcpy(&elementBits, weightMatrix + size - 1UL, sizeof(elementBits));
+    addToFingerprint(elementBits);
 
-    const size_t parameterDatatypeSizesCombinedCurrent{
-                            combineParameterDatatypeSizes(m_weightsDatatypeSizeByteCurrent,
-                                                            m_activationsDatatypeSizeByteCurrent,
-                                                            m_resultsDatatypeSizeByteCurrent)};
+    return fingerprint;
+}
 
+/**
+ * @class   MpuInstance
+ * @brief   MPU instance of a specific combination of parameter datatypes
+ *          behind the type-erased handle used by the MPU instance cache
+ */
 
-    const size_t parameterDatatypeSizesCombinedNext{
-                            combineParameterDatatypeSizes(weightsDatatypeSizeByte,
-                                                            activationsDatatypeSizeByte,
-                                                            resultsDatatypeSizeByte)};
+template<typename WeightsDatatype,
+            typename ActivationsDatatype,
+            typename ResultsDatatype> class MpuInstance final : public MpuInstanceHandle
+{
+
+public:
+
+    MpuInstance(const MpuConfiguration& mpuConfiguration,
+                    MpuStatisticsLogger* const mpuStatisticsLoggerPtr):
+                            m_systolicArrayHeight{mpuConfiguration.systolicArrayHeight},
+                            m_systolicArrayWidth{mpuConfiguration.systolicArrayWidth},
+                            m_mpuPtr{createMatrixProcessingUnit<WeightsDatatype,
+                                                                ActivationsDatatype,
+                                                                ResultsDatatype>(
+                                                                        mpuConfiguration.systolicArrayWidth,
+                                                                        mpuConfiguration.systolicArrayHeight,
+                                                                        mpuConfiguration.activationFifoDepth,
+                                                                        mpuConfiguration.accumulatorArrayHeight)}
+    {
+        m_mpuPtr->setDebugFlag(true);
+        m_mpuPtr->registerLogEntryAvailableCallback([this, mpuStatisticsLoggerPtr](
+                                                        MpuStatisticsLogEntry&& mpuStatisticsLogEntry){
+            mpuStatisticsLogEntry.setActivationUnitCycles(m_activationUnitCycleCountMultiplication);
+            mpuStatisticsLoggerPtr->addMpuStatisticsLogEntry(std::move(mpuStatisticsLogEntry));
+        });
+    }
 
-    if((parameterDatatypeSizesCombinedNext !=
-                        parameterDatatypeSizesCombinedCurrent) ||
-            (systolicArrayHeight != m_systolicArrayHeightCurrent) ||
-            (systolicArrayWidth != m_systolicArrayWidthCurrent) || 
-            (activationFifoDepth != m_activationFifoDepthCurrent) ||
-            (accumulatorArrayHeight != m_accumulatorArrayHeightCurrent))
+    void runMultiplication(const size_t sizeM,
+                            const size_t sizeN,
+                            const size_t sizeK,
+                            const float* const activationMatrix,
+                            const float* const weightMatrix,
+                            float* const resultMatrix,
+                            const std::string& operationNameString,
+                            const float* const biasVector,
+                            const ActivationFunction activationFunction) override
     {
-        switch(parameterDatatypeSizesCombinedCurrent)
+        const bool matrixNeedsPadding{((sizeN > m_systolicArrayWidth) &&
+                                        (sizeK <= m_systolicArrayHeight))};
+
+//         const size_t sizeNPadded{matrixNeedsPadding &&
+//                                     (sizeN <= m_systolicArrayWidth) ?
+//                                                         m_systolicArrayWidth + 1UL : sizeN};
+
+        const size_t sizeNPadded{sizeN};
+
+        const size_t sizeKPadded{matrixNeedsPadding &&
+                                        (sizeK <= m_systolicArrayHeight) ?
+                                                        m_systolicArrayHeight + 1UL : sizeK};
+
+        if(matrixNeedsPadding)
         {
-            case parameterDatatypeSizesCombined8_8_8:
-            {
-                delete m_matrixProcessingUnit8_8_8Ptr;
-                break;
-            }
-                
-            case parameterDatatypeSizesCombined8_8_16:
-            {
-                delete m_matrixProcessingUnit8_8_16Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_8_16:
-            {
-                delete m_matrixProcessingUnit16_8_16Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_16_16:
-            {
-                delete m_matrixProcessingUnit8_16_16Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_16_16:
-            {
-                delete m_matrixProcessingUnit16_16_16Ptr;
-                break;
-            }
-                
-            case parameterDatatypeSizesCombined8_8_32:
-            {
-                delete m_matrixProcessingUnit8_8_32Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_8_32:
-            {
-                delete m_matrixProcessingUnit16_8_32Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_8_32:
-            {
-                delete m_matrixProcessingUnit32_8_32Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_16_32:
-            {
-                delete m_matrixProcessingUnit8_16_32Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_16_32:
-            {
-                delete m_matrixProcessingUnit16_16_32Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_16_32:
-            {
-                delete m_matrixProcessingUnit32_16_32Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_32_32:
-            {
-                delete m_matrixProcessingUnit8_32_32Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_32_32:
-            {
-                delete m_matrixProcessingUnit16_32_32Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_32_32:
-            {
-                delete m_matrixProcessingUnit32_32_32Ptr;
-                break;
-            }
-                
-            case parameterDatatypeSizesCombined8_8_64:
-            {
-                delete m_matrixProcessingUnit8_8_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_8_64:
-            {
-                delete m_matrixProcessingUnit16_8_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_8_64:
-            {
-                delete m_matrixProcessingUnit32_8_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined64_8_64:
-            {
-                delete m_matrixProcessingUnit64_8_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_16_64:
-            {
-                delete m_matrixProcessingUnit8_16_64Ptr;
-                break;
-            }
-                
-            case parameterDatatypeSizesCombined16_16_64:
-            {
-                delete m_matrixProcessingUnit16_16_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_16_64:
-            {
-                delete m_matrixProcessingUnit32_16_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined64_16_64:
-            {
-                delete m_matrixProcessingUnit64_16_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_32_64:
-            {
-                delete m_matrixProcessingUnit8_32_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_32_64:
-            {
-                delete m_matrixProcessingUnit16_32_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_32_64:
-            {
-                delete m_matrixProcessingUnit32_32_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined64_32_64:
-            {
-                delete m_matrixProcessingUnit64_32_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_64_64:
-            {
-                delete m_matrixProcessingUnit8_64_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_64_64:
-            {
-                delete m_matrixProcessingUnit16_64_64Ptr;
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_64_64:
+            std::cout << "MpuSim Wrapper: Padding matrix in dimension ";
+
+            if(sizeN <= m_systolicArrayWidth)
             {
-                delete m_matrixProcessingUnit32_64_64Ptr;
-                break;
+                std::cout << "N, old size: "
+                            << sizeN
+                            << ", new size: "
+                            << sizeNPadded;
             }
-            
-            case parameterDatatypeSizesCombined64_64_64:
+
+            else
             {
-                delete m_matrixProcessingUnit64_64_64Ptr;
-                break;
+                std::cout << "K, old size: "
+                            << sizeK
+                            << ", new size: "
+                            << sizeKPadded;
             }
-        
-            default:
-                break;
+            std::cout << std::endl;
         }
-        
-        if(parameterDatatypeSizesCombinedNext !=
-                        parameterDatatypeSizesCombinedCurrent)
+
+        // Weights are static during inference, so the weight matrix
+        // quantized into the unified buffer on the first call of an
+        // operation is reused as long as its fingerprint is unchanged,
+        // unless reuse is disabled at compile time
+
+        const uint64_t weightMatrixFingerprint{getWeightMatrixFingerprint(weightMatrix,
+                                                                            sizeK*sizeN)};
+
+        QuantizedWeightMatrixRecord& quantizedWeightMatrixRecord{
+                                        m_quantizedWeightMatrixRecordMap[operationNameString]};
+
+        if(weightMatrixReuseEnabled &&
+                quantizedWeightMatrixRecord.valid &&
+                (quantizedWeightMatrixRecord.fingerprint == weightMatrixFingerprint) &&
+                (quantizedWeightMatrixRecord.sizeK == sizeK) &&
+                (quantizedWeightMatrixRecord.sizeN == sizeN))
         {
-            if(m_mpuStatisticsLoggerPtr)
-            {
-                delete m_mpuStatisticsLoggerPtr;
-            }
-            
-            m_mpuStatisticsLoggerPtr = new MpuStatisticsLogger(
-                                                std::string{logFileOutputDirString +
-                                                                    std::string{"/"} +
-                                                                    modelNameString},
-                                                weightsDatatypeSizeByte,
-                                                activationsDatatypeSizeByte,
-                                                resultsDatatypeSizeByte);
+            ++m_quantizedWeightMatrixHitCount;
         }
-        
-        switch(parameterDatatypeSizesCombinedNext)
+
+        else
         {
-            case parameterDatatypeSizesCombined8_8_8:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit8_8_8Ptr, int8_t, int8_t, int8_t);
-                break;
-            }
-                
-            case parameterDatatypeSizesCombined8_8_16:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit8_8_16Ptr, int8_t, int8_t, int16_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_8_16:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit16_8_16Ptr, int16_t, int8_t, int16_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_16_16:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit8_16_16Ptr, int8_t, int16_t, int16_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_16_16:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit16_16_16Ptr, int16_t, int16_t, int16_t);
-                break;
-            }
-                
-            case parameterDatatypeSizesCombined8_8_32:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit8_8_32Ptr, int8_t, int8_t, int32_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_8_32:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit16_8_32Ptr, int16_t, int8_t, int32_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_8_32:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit32_8_32Ptr, int32_t, int8_t, int32_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_16_32:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit8_16_32Ptr, int8_t, int16_t, int32_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_16_32:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit16_16_32Ptr, int16_t, int16_t, int32_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_16_32:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit32_16_32Ptr, int32_t, int16_t, int32_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_32_32:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit8_32_32Ptr, int8_t, int32_t, int32_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_32_32:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit16_32_32Ptr, int16_t, int32_t, int32_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_32_32:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit32_32_32Ptr, int32_t, int32_t, int32_t);
-                break;
-            }
-                
-            case parameterDatatypeSizesCombined8_8_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit8_8_64Ptr, int8_t, int8_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_8_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit16_8_64Ptr, int16_t, int8_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_8_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit32_8_64Ptr, int32_t, int8_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined64_8_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit64_8_64Ptr, int64_t, int8_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_16_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit8_16_64Ptr, int8_t, int16_t, int64_t);
-                break;
-            }
-                
-            case parameterDatatypeSizesCombined16_16_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit16_16_64Ptr, int16_t, int16_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_16_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit32_16_64Ptr, int32_t, int16_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined64_16_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit64_16_64Ptr, int64_t, int16_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_32_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit8_32_64Ptr, int8_t, int32_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_32_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit16_32_64Ptr, int16_t, int32_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_32_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit32_32_64Ptr, int32_t, int32_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined64_32_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit64_32_64Ptr, int64_t, int32_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined8_64_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit8_64_64Ptr, int8_t, int64_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined16_64_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit16_64_64Ptr, int16_t, int64_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined32_64_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit32_64_64Ptr, int32_t, int64_t, int64_t);
-                break;
-            }
-            
-            case parameterDatatypeSizesCombined64_64_64:
-            {
-                CONSTRUCT_AND_CONFIGURE_MPU(m_matrixProcessingUnit64_64_64Ptr, int64_t, int64_t, int64_t);
-                break;
-            }
-        
-            default:
-            {
-                throw std::invalid_argument("MpuSim Wrapper: One or more parameter datatype "
-                                                    "size parameters have an unsupported value");
-            }
-        }
-        
-        m_weightsDatatypeSizeByteCurrent =
-                            weightsDatatypeSizeByte;
-        
-        m_activationsDatatypeSizeByteCurrent =
-                            activationsDatatypeSizeByte;
-                            
-        m_resultsDatatypeSizeByteCurrent =
-                            resultsDatatypeSizeByte;
-                            
-        m_systolicArrayHeightCurrent =
-                            systolicArrayHeight;
-                            
-        m_systolicArrayWidthCurrent =
-                            systolicArrayWidth;
-                        
-        m_activationFifoDepthCurrent =
-                            activationFifoDepth;
-                            
-        m_accumulatorArrayHeightCurrent =
-                            accumulatorArrayHeight;
-                            
+            ++m_quantizedWeightMatrixMissCount;
+
+            quantizedWeightMatrixRecord.valid = false;
+
+            WeightsDatatype* const weightMatrixQuantized{
+                                    m_mpuPtr->allocateWeightMatrix(operationNameString,
+                                                                    sizeKPadded, sizeNPadded)};
+
+            quantizedWeightMatrixRecord.scaleFactor = quantizeLinear(weightMatrix,
+                                                                        weightMatrixQuantized,
+                                                                        sizeK,
+                                                                        sizeN,
+                                                                        sizeKPadded,
+                                                                        sizeNPadded,
+                                                                        nullptr);
+
+            quantizedWeightMatrixRecord.fingerprint = weightMatrixFingerprint;
+            quantizedWeightMatrixRecord.sizeK = sizeK;
+            quantizedWeightMatrixRecord.sizeN = sizeN;
+            quantizedWeightMatrixRecord.valid = true;
+        }
+
+        ActivationsDatatype* const activationMatrixQuantized{
+                                        m_mpuPtr->allocateActivationMatrix(sizeM, sizeKPadded)};
+        QuantizationStatistics activationMatrixStatistics;
+        const float scaleFactorActivations{quantizeLinear(activationMatrix,
+                                                            activationMatrixQuantized,
+                                                            sizeM,
+                                                            sizeK,
+                                                            sizeM,
+                                                            sizeKPadded,
+                                                            quantizationStatisticsEnabled ?
+                                                                &activationMatrixStatistics :
+                                                                nullptr)};
+
+        // The results are scaled by both the activation and the
+        // weight scale factor, the latter cached with the quantized
+        // weight matrix, so that the bias and the activation function
+        // are applied to results on the scale of the float operands,
+        // also when the quantized weights are reused
+
+        const float scaleFactorResults{1.0F/(scaleFactorActivations*
+                                                quantizedWeightMatrixRecord.scaleFactor)};
+
+        if(quantizationStatisticsEnabled)
+        {
+            std::cout << "Raw activations: Mean: " << activationMatrixStatistics.meanUnquantized
+                        << "\tStdDev: " << activationMatrixStatistics.stdDevUnquantized << std::endl;
+            std::cout << "Quantized activations: Mean: " << activationMatrixStatistics.meanQuantized
+                            << "\tStdDev: " << activationMatrixStatistics.stdDevQuantized << std::endl;
+        }
+
+        // The activation unit processes one row of results per
+        // systolic array column per cycle, its cycle count is
+        // added to the log entry of the multiplication
+
+        m_activationUnitCycleCountMultiplication = sizeM*((sizeN + m_systolicArrayWidth - 1UL)/
+                                                                        m_systolicArrayWidth);
+
+        m_mpuPtr->runMultiplication(operationNameString);
+
+        // The activation unit after the accumulators scales the results
+        // back to floating point, adds the bias and applies the activation
+        // function in a single pass over the result matrix
+
+        dequantizeLinear(m_mpuPtr->getResultMatrixView(),
+                            resultMatrix,
+                            scaleFactorResults,
+                            sizeM,
+                            sizeNPadded,
+                            sizeM,
+                            sizeN,
+                            biasVector,
+                            (activationFunction == ActivationFunction::None) ?
+                                        -std::numeric_limits<float>::infinity() : 0.0F,
+                            (activationFunction == ActivationFunction::Relu6) ?
+                                        6.0F : std::numeric_limits<float>::infinity());
+
+        m_activationUnitCycleCount += m_activationUnitCycleCountMultiplication;
+
+        m_mpuPtr->resetIterationCounts();
+        m_mpuPtr->resetDataMovementAndFootprintMetrics();
+        m_mpuPtr->printUnifiedBufferLayout();
+        std::cout << "Unified buffer memory usage: "
+                    << m_mpuPtr->getUnifiedBufferSizeMinBit() << std::endl;
     }
-    
-    switch(parameterDatatypeSizesCombinedNext)
+
+    void printUnifiedBufferLayout() const override
+    {
+        m_mpuPtr->printUnifiedBufferLayout();
+    }
+
+    std::string getStatisticsString() const override
+    {
+        return "Quantized weight matrices: Reused: " +
+                    std::to_string(m_quantizedWeightMatrixHitCount) +
+                    "\tQuantized: " +
+                    std::to_string(m_quantizedWeightMatrixMissCount) +
+                    "\tActivation unit cycles: " +
+                    std::to_string(m_activationUnitCycleCount);
+    }
+
+    size_t getQuantizedWeightMatrixHitCount() const override
+    {
+        return m_quantizedWeightMatrixHitCount;
+    }
+
+    size_t getQuantizedWeightMatrixMissCount() const override
+    {
+        return m_quantizedWeightMatrixMissCount;
+    }
+
+private:
+
+    /**
+     * @struct  QuantizedWeightMatrixRecord
+     * @brief   Describes the quantized weight matrix of an
+     *          operation resident in the unified buffer
+     */
+
+    struct QuantizedWeightMatrixRecord
+    {
+        bool valid{false};
+
+        uint64_t fingerprint{0UL};
+
+        size_t sizeK{0UL};
+        size_t sizeN{0UL};
+
+        float scaleFactor{1.0F};
+    };
+
+    const size_t m_systolicArrayHeight;
+    const size_t m_systolicArrayWidth;
+
+    std::unordered_map<std::string, QuantizedWeightMatrixRecord> m_quantizedWeightMatrixRecordMap;
+
+    size_t m_quantizedWeightMatrixHitCount{0UL};
+    size_t m_quantizedWeightMatrixMissCount{0UL};
+
+    size_t m_activationUnitCycleCount{0UL};
+    size_t m_activationUnitCycleCountMultiplication{0UL};
+
+    const std::unique_ptr<MatrixProcessingUnit<WeightsDatatype,
+                                                ActivationsDatatype,
+                                                ResultsDatatype>> m_mpuPtr;
+
+};
+
+/**
+ * @brief   Create the MPU instance matching the parameter
+ *          datatype sizes of the given configuration
+ */
+
+std::unique_ptr<MpuInstanceHandle> createMpuInstance(const MpuConfiguration& mpuConfiguration,
+                                                        MpuStatisticsLogger* const mpuStatisticsLoggerPtr)
+{
+    switch(combineParameterDatatypeSizes(mpuConfiguration.weightsDatatypeSizeByte,
+                                            mpuConfiguration.activationsDatatypeSizeByte,
+                                            mpuConfiguration.resultsDatatypeSizeByte))
     {
         case parameterDatatypeSizesCombined8_8_8:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit8_8_8Ptr,
-                                                                int8_t, int8_t, int8_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int8_t, int8_t, int8_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-            
+
         case parameterDatatypeSizesCombined8_8_16:
-        {            
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit8_8_16Ptr,
-                                                                int8_t, int8_t, int16_t);
-            break;
+        {
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int8_t, int8_t, int16_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined16_8_16:
-        {            
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit16_8_16Ptr,
-                                                                int16_t, int8_t, int16_t);
-            break;
+        {
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int16_t, int8_t, int16_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined8_16_16:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit8_16_16Ptr,
-                                                                int8_t, int16_t, int16_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int8_t, int16_t, int16_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined16_16_16:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit16_16_16Ptr,
-                                                                int16_t, int16_t, int16_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int16_t, int16_t, int16_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-            
+
         case parameterDatatypeSizesCombined8_8_32:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit8_8_32Ptr,
-                                                                int8_t, int8_t, int32_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int8_t, int8_t, int32_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined16_8_32:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit16_8_32Ptr,
-                                                                int16_t, int8_t, int32_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int16_t, int8_t, int32_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined32_8_32:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit32_8_32Ptr,
-                                                                int32_t, int8_t, int32_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int32_t, int8_t, int32_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined8_16_32:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit8_16_32Ptr,
-                                                                int8_t, int16_t, int32_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int8_t, int16_t, int32_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined16_16_32:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit16_16_32Ptr,
-                                                                int16_t, int16_t, int32_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int16_t, int16_t, int32_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined32_16_32:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit32_16_32Ptr,
-                                                                int32_t, int16_t, int32_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int32_t, int16_t, int32_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined8_32_32:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit8_32_32Ptr,
-                                                                int8_t, int32_t, int32_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int8_t, int32_t, int32_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined16_32_32:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit16_32_32Ptr,
-                                                                int16_t, int32_t, int32_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int16_t, int32_t, int32_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined32_32_32:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit32_32_32Ptr,
-                                                                int32_t, int32_t, int32_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int32_t, int32_t, int32_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-            
+
         case parameterDatatypeSizesCombined8_8_64:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit8_8_64Ptr,
-                                                                int8_t, int8_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int8_t, int8_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined16_8_64:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit16_8_64Ptr,
-                                                                int16_t, int8_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int16_t, int8_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined32_8_64:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit32_8_64Ptr,
-                                                                int32_t, int8_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int32_t, int8_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined64_8_64:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit64_8_64Ptr,
-                                                                int64_t, int8_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int64_t, int8_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined8_16_64:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit8_16_64Ptr,
-                                                                int8_t, int16_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int8_t, int16_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-            
+
         case parameterDatatypeSizesCombined16_16_64:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit16_16_64Ptr,
-                                                                int16_t, int16_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int16_t, int16_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined32_16_64:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit32_16_64Ptr,
-                                                                int32_t, int16_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int32_t, int16_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined64_16_64:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit64_16_64Ptr,
-                                                                int64_t, int16_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int64_t, int16_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined8_32_64:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit8_32_64Ptr,
-                                                                int8_t, int32_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int8_t, int32_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined16_32_64:
         {
-            QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit16_32_64Ptr,
-                                                                int16_t, int32_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int16_t, int32_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined32_32_64:
         {
-              QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit32_32_64Ptr,
-                                                                int32_t, int32_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int32_t, int32_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined64_32_64:
         {
-              QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit64_32_64Ptr,
-                                                                int64_t, int32_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int64_t, int32_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined8_64_64:
         {
-              QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit8_64_64Ptr,
-                                                                int8_t, int64_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int8_t, int64_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined16_64_64:
         {
-              QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit16_64_64Ptr,
-                                                                int16_t, int64_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int16_t, int64_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined32_64_64:
         {
-              QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit32_64_64Ptr,
-                                                                int32_t, int64_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int32_t, int64_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-        
+
         case parameterDatatypeSizesCombined64_64_64:
         {
-              QUANTIZE_AND_RUN_MATRIX_MULTIPLICATION(m_matrixProcessingUnit64_64_64Ptr,
-                                                                int64_t, int64_t, int64_t);
-            break;
+            return std::unique_ptr<MpuInstanceHandle>(
+                        new MpuInstance<int64_t, int64_t, int64_t>(mpuConfiguration,
+                                                                    mpuStatisticsLoggerPtr));
         }
-    
+
         default:
         {
             throw std::invalid_argument("MpuSim Wrapper: One or more parameter datatype "
@@ -1225,202 +781,137 @@ void MpuSimWrapper::runMultiplication(const size_t activationsDatatypeSizeByte,
         }
     }
 }
+    
+}
 
-MpuSimWrapper::~MpuSimWrapper()
+MpuSimWrapper::MpuSimWrapper(): m_mpuInstanceCache(mpuInstanceCacheCapacity)
+{
+    std::cout << "Allocated MPU simulator wrapper object" << std::endl;
+}
+
+void MpuSimWrapper::runMultiplication(const size_t activationsDatatypeSizeByte,
+                                                const size_t weightsDatatypeSizeByte,
+                                                const size_t resultsDatatypeSizeByte,
+                                                const size_t systolicArrayHeight,
+                                                const size_t systolicArrayWidth,
+                                                const size_t activationFifoDepth,
+                                                const size_t accumulatorArrayHeight,
+                                                const size_t sizeM,
+                                                const size_t sizeN,
+                                                const size_t sizeK,
+                                                const float* const activationMatrix,
+                                                const float* const weightMatrix,
+                                                float* const resultMatrix,
+                                                const std::string& logFileOutputDirString,
+                                                const std::string& modelNameString,
+                                                const std::string& operationNameString,
+                                                const float* const biasVector,
+                                                const ActivationFunction activationFunction)
 {
-    switch(combineParameterDatatypeSizes(m_weightsDatatypeSizeByteCurrent,
-                                            m_activationsDatatypeSizeByteCurrent,
-                                            m_resultsDatatypeSizeByteCurrent))
+    const MpuConfiguration mpuConfiguration{weightsDatatypeSizeByte,
+                                                activationsDatatypeSizeByte,
+                                                resultsDatatypeSizeByte,
+                                                systolicArrayHeight,
+                                                systolicArrayWidth,
+                                                activationFifoDepth,
+                                                accumulatorArrayHeight};
+
+    // Concurrent callers each run on an instance checked out of the
+    // cache, so only the cache and the logger map are shared between them.
+    // If the multiplication throws, the instance is destroyed instead
+    // of being returned to the cache.
+
+    std::unique_ptr<MpuInstanceHandle> mpuInstancePtr{
+                                    m_mpuInstanceCache.checkOut(mpuConfiguration)};
+
+    if(!mpuInstancePtr)
     {
-        case parameterDatatypeSizesCombined8_8_8:
-        {
-            m_matrixProcessingUnit8_8_8Ptr->printUnifiedBufferLayout();
-            delete m_matrixProcessingUnit8_8_8Ptr;
-            break;
-        }
-            
-        case parameterDatatypeSizesCombined8_8_16:
-        {
-            delete m_matrixProcessingUnit8_8_16Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined16_8_16:
-        {
-            delete m_matrixProcessingUnit16_8_16Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined8_16_16:
-        {
-            delete m_matrixProcessingUnit8_16_16Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined16_16_16:
-        {
-            delete m_matrixProcessingUnit16_16_16Ptr;
-            break;
-        }
-            
-        case parameterDatatypeSizesCombined8_8_32:
-        {
-            delete m_matrixProcessingUnit8_8_32Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined16_8_32:
-        {
-            delete m_matrixProcessingUnit16_8_32Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined32_8_32:
-        {
-            delete m_matrixProcessingUnit32_8_32Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined8_16_32:
-        {
-            delete m_matrixProcessingUnit8_16_32Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined16_16_32:
-        {
-            delete m_matrixProcessingUnit16_16_32Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined32_16_32:
-        {
-            delete m_matrixProcessingUnit32_16_32Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined8_32_32:
-        {
-            delete m_matrixProcessingUnit8_32_32Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined16_32_32:
-        {
-            delete m_matrixProcessingUnit16_32_32Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined32_32_32:
-        {
-            delete m_matrixProcessingUnit32_32_32Ptr;
-            break;
-        }
-            
-        case parameterDatatypeSizesCombined8_8_64:
-        {
-            delete m_matrixProcessingUnit8_8_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined16_8_64:
-        {
-            delete m_matrixProcessingUnit16_8_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined32_8_64:
-        {
-            delete m_matrixProcessingUnit32_8_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined64_8_64:
-        {
-            delete m_matrixProcessingUnit64_8_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined8_16_64:
-        {
-            delete m_matrixProcessingUnit8_16_64Ptr;
-            break;
-        }
-            
-        case parameterDatatypeSizesCombined16_16_64:
-        {
-            delete m_matrixProcessingUnit16_16_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined32_16_64:
-        {
-            delete m_matrixProcessingUnit32_16_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined64_16_64:
-        {
-            delete m_matrixProcessingUnit64_16_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined8_32_64:
-        {
-            delete m_matrixProcessingUnit8_32_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined16_32_64:
-        {
-            delete m_matrixProcessingUnit16_32_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined32_32_64:
-        {
-            delete m_matrixProcessingUnit32_32_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined64_32_64:
-        {
-            delete m_matrixProcessingUnit64_32_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined8_64_64:
-        {
-            delete m_matrixProcessingUnit8_64_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined16_64_64:
-        {
-            delete m_matrixProcessingUnit16_64_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined32_64_64:
-        {
-            delete m_matrixProcessingUnit32_64_64Ptr;
-            break;
-        }
-        
-        case parameterDatatypeSizesCombined64_64_64:
-        {
-            delete m_matrixProcessingUnit64_64_64Ptr;
-            break;
-        }
-    
-        default:
-            break;
+        mpuInstancePtr = createMpuInstance(mpuConfiguration,
+                                            getMpuStatisticsLogger(
+                                                    weightsDatatypeSizeByte,
+                                                    activationsDatatypeSizeByte,
+                                                    resultsDatatypeSizeByte,
+                                                    logFileOutputDirString,
+                                                    modelNameString));
     }
-    
-    if(m_mpuStatisticsLoggerPtr)
+
+    mpuInstancePtr->runMultiplication(sizeM,
+                                        sizeN,
+                                        sizeK,
+                                        activationMatrix,
+                                        weightMatrix,
+                                        resultMatrix,
+                                        operationNameString,
+                                        biasVector,
+                                        activationFunction);
+
+    m_mpuInstanceCache.checkIn(mpuConfiguration, std::move(mpuInstancePtr));
+}
+
+size_t MpuSimWrapper::getQuantizedWeightMatrixHitCount() const
+{
+    size_t quantizedWeightMatrixHitCount{0UL};
+
+    m_mpuInstanceCache.forEach([&quantizedWeightMatrixHitCount](
+                                        const MpuInstanceHandle& mpuInstance){
+        quantizedWeightMatrixHitCount += mpuInstance.getQuantizedWeightMatrixHitCount();
+    });
+
+    return quantizedWeightMatrixHitCount;
+}
+
+size_t MpuSimWrapper::getQuantizedWeightMatrixMissCount() const
+{
+    size_t quantizedWeightMatrixMissCount{0UL};
+
+    m_mpuInstanceCache.forEach([&quantizedWeightMatrixMissCount](
+                                        const MpuInstanceHandle& mpuInstance){
+        quantizedWeightMatrixMissCount += mpuInstance.getQuantizedWeightMatrixMissCount();
+    });
+
+    return quantizedWeightMatrixMissCount;
+}
+
+MpuStatisticsLogger* MpuSimWrapper::getMpuStatisticsLogger(const size_t weightsDatatypeSizeByte,
+                                                                const size_t activationsDatatypeSizeByte,
+                                                                const size_t resultsDatatypeSizeByte,
+                                                                const std::string& logFileOutputDirString,
+                                                                const std::string& modelNameString)
+{
+    const size_t parameterDatatypeSizesCombined{
+                            combineParameterDatatypeSizes(weightsDatatypeSizeByte,
+                                                            activationsDatatypeSizeByte,
+                                                            resultsDatatypeSizeByte)};
+
+    std::lock_guard<std::mutex> lock(m_mpuStatisticsLoggerMapMutex);
+
+    std::unique_ptr<MpuStatisticsLogger>& mpuStatisticsLoggerPtr{
+                            m_mpuStatisticsLoggerMap[parameterDatatypeSizesCombined]};
+
+    if(!mpuStatisticsLoggerPtr)
     {
-        delete m_mpuStatisticsLoggerPtr;
+        mpuStatisticsLoggerPtr.reset(new MpuStatisticsLogger(
+                                            std::string{logFileOutputDirString +
+                                                                std::string{"/"} +
+                                                                modelNameString},
+                                            weightsDatatypeSizeByte,
+                                            activationsDatatypeSizeByte,
+                                            resultsDatatypeSizeByte));
     }
 
+    return mpuStatisticsLoggerPtr.get();
+}
+
+MpuSimWrapper::~MpuSimWrapper()
+{
+    m_mpuInstanceCache.forEach([](const MpuInstanceHandle& mpuInstance){
+        mpuInstance.printUnifiedBufferLayout();
+        std::cout << "MpuSim Wrapper: "
+                    << mpuInstance.getStatisticsString() << std::endl;
+    });
+
+    std::cout << "MpuSim Wrapper: "
+                << m_mpuInstanceCache.getStatisticsString() << std::endl;
+
     std::cout << "Deleted MPU simulator wrapper object" << std::endl;
 }
@@ -29,10 +29,15 @@
 #ifndef MPUSIM_WRAPPER_H
 #define MPUSIM_WRAPPER_H
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <cstdint>
 
 #include "matrix_processing_unit.h"
 #include "mpu_statistics_logger.h"
+#include "mpu_instance_cache.h"
 
 /**
  * @class MpuSimWrapper
@@ -68,6 +73,10 @@ public:
  * @param logFileOutputDirString        
  * @param modelNameString               
  * @param operationNameString           
+ * @param biasVector                    The bias of each result column, added together
+ *                                      with the scaling of the results, nullptr for none
+ * @param activationFunction            The activation function applied to the results
+ *                                      after adding the bias
  */
     
 void runMultiplication(const size_t activationsDatatypeSizeByte,
@@ -85,14 +94,29 @@ void runMultiplication(const size_t activationsDatatypeSizeByte,
                                 float* const resultMatrix,
                                 const std::string& logFileOutputDirString,
                                 const std::string& modelNameString,
-                                const std::string& operationNameString);
+                                const std::string& operationNameString,
+                                const float* const biasVector = nullptr,
+                                const ActivationFunction activationFunction =
+                                                            ActivationFunction::None);
+
+    /**
+     * @brief   Get the number of multiplications of the idle MPU
+     *          instances that reused the quantized weight matrix
+     *          resident in the unified buffer
+     */
+
+    size_t getQuantizedWeightMatrixHitCount() const;
+
+    /**
+     * @brief   Get the number of multiplications of the idle MPU
+     *          instances that had to quantize their weight matrix
+     */
+
+    size_t getQuantizedWeightMatrixMissCount() const;
 
 private:
 
-    MpuSimWrapper()
-    {
-        std::cout << "Allocated MPU simulator wrapper object" << std::endl;
-    }
+    MpuSimWrapper();
     
     ~MpuSimWrapper();
 
@@ -101,52 +125,23 @@ private:
 
     void operator=(MpuSimWrapper& other) = delete;
     
-    MpuStatisticsLogger* m_mpuStatisticsLoggerPtr{nullptr};
-    
-    union{
-        MatrixProcessingUnit<int8_t, int8_t, int8_t>* m_matrixProcessingUnit8_8_8Ptr{nullptr};
-        
-        MatrixProcessingUnit<int8_t, int8_t, int16_t>* m_matrixProcessingUnit8_8_16Ptr;
-        MatrixProcessingUnit<int16_t, int8_t, int16_t>* m_matrixProcessingUnit16_8_16Ptr;
-        MatrixProcessingUnit<int8_t, int16_t, int16_t>* m_matrixProcessingUnit8_16_16Ptr;
-        MatrixProcessingUnit<int16_t, int16_t, int16_t>* m_matrixProcessingUnit16_16_16Ptr;
-        
-        MatrixProcessingUnit<int8_t, int8_t, int32_t>* m_matrixProcessingUnit8_8_32Ptr;
-        MatrixProcessingUnit<int16_t, int8_t, int32_t>* m_matrixProcessingUnit16_8_32Ptr;
-        MatrixProcessingUnit<int32_t, int8_t, int32_t>* m_matrixProcessingUnit32_8_32Ptr;
-        MatrixProcessingUnit<int8_t, int16_t, int32_t>* m_matrixProcessingUnit8_16_32Ptr;
-        MatrixProcessingUnit<int16_t, int16_t, int32_t>* m_matrixProcessingUnit16_16_32Ptr;
-        MatrixProcessingUnit<int32_t, int16_t, int32_t>* m_matrixProcessingUnit32_16_32Ptr;
-        MatrixProcessingUnit<int8_t, int32_t, int32_t>* m_matrixProcessingUnit8_32_32Ptr;
-        MatrixProcessingUnit<int16_t, int32_t, int32_t>* m_matrixProcessingUnit16_32_32Ptr;
-        MatrixProcessingUnit<int32_t, int32_t, int32_t>* m_matrixProcessingUnit32_32_32Ptr;
-        
-        MatrixProcessingUnit<int8_t, int8_t, int64_t>* m_matrixProcessingUnit8_8_64Ptr;
-        MatrixProcessingUnit<int16_t, int8_t, int64_t>* m_matrixProcessingUnit16_8_64Ptr;
-        MatrixProcessingUnit<int32_t, int8_t, int64_t>* m_matrixProcessingUnit32_8_64Ptr;
-        MatrixProcessingUnit<int64_t, int8_t, int64_t>* m_matrixProcessingUnit64_8_64Ptr;
-        MatrixProcessingUnit<int8_t, int16_t, int64_t>* m_matrixProcessingUnit8_16_64Ptr;
-        MatrixProcessingUnit<int16_t, int16_t, int64_t>* m_matrixProcessingUnit16_16_64Ptr;
-        MatrixProcessingUnit<int32_t, int16_t, int64_t>* m_matrixProcessingUnit32_16_64Ptr;
-        MatrixProcessingUnit<int64_t, int16_t, int64_t>* m_matrixProcessingUnit64_16_64Ptr;
-        MatrixProcessingUnit<int8_t, int32_t, int64_t>* m_matrixProcessingUnit8_32_64Ptr;
-        MatrixProcessingUnit<int16_t, int32_t, int64_t>* m_matrixProcessingUnit16_32_64Ptr;
-        MatrixProcessingUnit<int32_t, int32_t, int64_t>* m_matrixProcessingUnit32_32_64Ptr;
-        MatrixProcessingUnit<int64_t, int32_t, int64_t>* m_matrixProcessingUnit64_32_64Ptr;
-        MatrixProcessingUnit<int8_t, int64_t, int64_t>* m_matrixProcessingUnit8_64_64Ptr;
-        MatrixProcessingUnit<int16_t, int64_t, int64_t>* m_matrixProcessingUnit16_64_64Ptr;
-        MatrixProcessingUnit<int32_t, int64_t, int64_t>* m_matrixProcessingUnit32_64_64Ptr;
-        MatrixProcessingUnit<int64_t, int64_t, int64_t>* m_matrixProcessingUnit64_64_64Ptr;
-    };
-    
-    size_t m_activationsDatatypeSizeByteCurrent{0UL};
-    size_t m_weightsDatatypeSizeByteCurrent{0UL};
-    size_t m_resultsDatatypeSizeByteCurrent{0UL};
-    
-    size_t m_systolicArrayHeightCurrent{0UL};
-    size_t m_systolicArrayWidthCurrent{0UL};
-    size_t m_activationFifoDepthCurrent{0UL};
-    size_t m_accumulatorArrayHeightCurrent{0UL};
+    /**
+     * @brief   Get the statistics logger of the given parameter
+     *          datatype combination, creating it on first use.
+     *          Thread safe, the logger itself is shared by all
+     *          MPU instances of the datatype combination.
+     */
+
+    MpuStatisticsLogger* getMpuStatisticsLogger(const size_t weightsDatatypeSizeByte,
+                                                    const size_t activationsDatatypeSizeByte,
+                                                    const size_t resultsDatatypeSizeByte,
+                                                    const std::string& logFileOutputDirString,
+                                                    const std::string& modelNameString);
+
+    std::map<size_t, std::unique_ptr<MpuStatisticsLogger>> m_mpuStatisticsLoggerMap;
+    std::mutex m_mpuStatisticsLoggerMapMutex;
+
+    MpuInstanceCache m_mpuInstanceCache;
 
 };
 
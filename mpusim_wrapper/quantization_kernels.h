@@ -0,0 +1,432 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        quantization_kernels.h
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#ifndef QUANTIZATION_KERNELS_H
+#define QUANTIZATION_KERNELS_H
+
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <cstddef>
+#include <cmath>
+
+#include <omp.h>
+
+/**
+ * @struct  QuantizationStatistics
+ * @brief   Mean and standard deviation of a matrix before
+ *          and after quantization, excluding padding
+ */
+
+struct QuantizationStatistics
+{
+    double meanUnquantized{0.0};
+    double stdDevUnquantized{0.0};
+    double meanQuantized{0.0};
+    double stdDevQuantized{0.0};
+};
+
+/**
+ * @brief   Element count from which the quantization
+ *          kernels distribute their passes across threads
+ */
+
+constexpr size_t quantizationParallelElementCountMin{1UL << 16};
+
+/**
+ * @brief   Get the largest float that converts to a value
+ *          representable in the integer datatype T. For 32 and
+ *          64 bit datatypes, the maximum of T itself rounds up to
+ *          the next power of two when converted to float.
+ */
+
+template<typename T> float getQuantizationRangeMax()
+{
+    const float rangeMax{static_cast<float>(std::numeric_limits<T>::max())};
+
+    return (static_cast<long double>(rangeMax) >
+                static_cast<long double>(std::numeric_limits<T>::max())) ?
+                                            std::nextafter(rangeMax, 0.0F) : rangeMax;
+}
+
+inline void getMeanAndStdDevFromShiftedSums(const double shift,
+                                                const double sum,
+                                                const double squareSum,
+                                                const size_t size,
+                                                double& mean,
+                                                double& stdDev)
+{
+    const double meanShifted{sum/static_cast<double>(size)};
+
+    mean = shift + meanShifted;
+    stdDev = std::sqrt(std::max(squareSum/static_cast<double>(size) -
+                                        meanShifted*meanShifted, 0.0));
+}
+
+template<bool ComputeStatistics> float getAbsMax(const float* const inputMatrix,
+                                                    const size_t size,
+                                                    double& sum,
+                                                    double& squareSum)
+{
+    const double shift{inputMatrix[0]};
+
+    float absMax{0.0F};
+
+    double sumLocal{0.0};
+    double squareSumLocal{0.0};
+
+    #pragma omp parallel for simd if(size >= quantizationParallelElementCountMin) \
+                                    reduction(max:absMax) reduction(+:sumLocal, squareSumLocal)
+    for(size_t element = 0UL; element < size; ++element)
+    {
+        const float value{inputMatrix[element]};
+
+        absMax = std::max(absMax, std::fabs(value));
+
+        if(ComputeStatistics)
+        {
+            const double difference{static_cast<double>(value) - shift};
+
+            sumLocal += difference;
+            squareSumLocal += difference*difference;
+        }
+    }
+
+    sum = sumLocal;
+    squareSum = squareSumLocal;
+
+    return absMax;
+}
+
+template<bool ComputeStatistics,
+            typename T> void quantizeRow(const float* const inputRow,
+                                            T* const outputRow,
+                                            const size_t size,
+                                            const float scaleFactor,
+                                            const float rangeMax,
+                                            const double shift,
+                                            double& sum,
+                                            double& squareSum)
+{
+    double sumLocal{0.0};
+    double squareSumLocal{0.0};
+
+    #pragma omp simd reduction(+:sumLocal, squareSumLocal)
+    for(size_t element = 0UL; element < size; ++element)
+    {
+        const T value{static_cast<T>(std::min(std::max(inputRow[element]*scaleFactor,
+                                                                    -rangeMax), rangeMax))};
+
+        outputRow[element] = value;
+
+        if(ComputeStatistics)
+        {
+            const double difference{static_cast<double>(value) - shift};
+
+            sumLocal += difference;
+            squareSumLocal += difference*difference;
+        }
+    }
+
+    sum += sumLocal;
+    squareSum += squareSumLocal;
+}
+
+template<bool ComputeStatistics,
+            typename T> float quantizeLinearFused(const float* const inputMatrix,
+                                                    T* const outputMatrix,
+                                                    const size_t heightOriginal,
+                                                    const size_t widthOriginal,
+                                                    const size_t heightTarget,
+                                                    const size_t widthTarget,
+                                                    QuantizationStatistics* const statisticsPtr)
+{
+    const size_t elementCountOriginal{heightOriginal*widthOriginal};
+    const size_t elementCountTarget{heightTarget*widthTarget};
+
+    double sumUnquantized;
+    double squareSumUnquantized;
+
+    const float inputValueAbsMax{getAbsMax<ComputeStatistics>(inputMatrix,
+                                                                elementCountOriginal,
+                                                                sumUnquantized,
+                                                                squareSumUnquantized)};
+
+    const float rangeMax{getQuantizationRangeMax<T>()};
+
+    const float scaleFactor{(inputValueAbsMax > 0.0F) ?
+                                    rangeMax/inputValueAbsMax : 1.0F};
+
+    const double shiftQuantized{static_cast<double>(
+                                    static_cast<T>(std::min(std::max(inputMatrix[0]*scaleFactor,
+                                                                        -rangeMax), rangeMax)))};
+
+    double sumQuantized{0.0};
+    double squareSumQuantized{0.0};
+
+    const bool parallel{elementCountTarget >= quantizationParallelElementCountMin};
+
+    if(widthTarget == widthOriginal)
+    {
+        // Without column padding, the rows of the original
+        // matrix are contiguous and can be split evenly
+
+        #pragma omp parallel if(parallel) reduction(+:sumQuantized, squareSumQuantized)
+        {
+            const size_t threadCount{static_cast<size_t>(omp_get_num_threads())};
+            const size_t threadId{static_cast<size_t>(omp_get_thread_num())};
+
+            const size_t elementBegin{(elementCountOriginal*threadId)/threadCount};
+            const size_t elementEnd{(elementCountOriginal*(threadId + 1UL))/threadCount};
+
+            quantizeRow<ComputeStatistics>(inputMatrix + elementBegin,
+                                            outputMatrix + elementBegin,
+                                            elementEnd - elementBegin,
+                                            scaleFactor,
+                                            rangeMax,
+                                            shiftQuantized,
+                                            sumQuantized,
+                                            squareSumQuantized);
+        }
+
+        std::fill(outputMatrix + elementCountOriginal,
+                    outputMatrix + elementCountTarget, T{0});
+    }
+
+    else
+    {
+        #pragma omp parallel for if(parallel) reduction(+:sumQuantized, squareSumQuantized)
+        for(size_t rowCount = 0UL; rowCount < heightTarget; ++rowCount)
+        {
+            T* const outputRow{outputMatrix + rowCount*widthTarget};
+
+            if(rowCount < heightOriginal)
+            {
+                quantizeRow<ComputeStatistics>(inputMatrix + rowCount*widthOriginal,
+                                                outputRow,
+                                                widthOriginal,
+                                                scaleFactor,
+                                                rangeMax,
+                                                shiftQuantized,
+                                                sumQuantized,
+                                                squareSumQuantized);
+
+                std::fill(outputRow + widthOriginal,
+                            outputRow + widthTarget, T{0});
+            }
+
+            else
+            {
+                std::fill(outputRow, outputRow + widthTarget, T{0});
+            }
+        }
+    }
+
+    if(ComputeStatistics)
+    {
+        getMeanAndStdDevFromShiftedSums(static_cast<double>(inputMatrix[0]),
+                                            sumUnquantized,
+                                            squareSumUnquantized,
+                                            elementCountOriginal,
+                                            statisticsPtr->meanUnquantized,
+                                            statisticsPtr->stdDevUnquantized);
+
+        getMeanAndStdDevFromShiftedSums(shiftQuantized,
+                                            sumQuantized,
+                                            squareSumQuantized,
+                                            elementCountOriginal,
+                                            statisticsPtr->meanQuantized,
+                                            statisticsPtr->stdDevQuantized);
+    }
+
+    return scaleFactor;
+}
+
+/**
+ * @brief                   Linearly quantize a row major float matrix
+ *                          to the integer datatype T, scaling its largest
+ *                          absolute value to the largest value of T, and
+ *                          zero pad it to the target size. The abs-max, the
+ *                          quantization and the optional statistics are
+ *                          computed in two vectorized passes, which are
+ *                          distributed across threads for large matrices.
+ * @param inputMatrix       The row major input matrix
+ * @param outputMatrix      The row major output matrix of the target size
+ * @param heightOriginal    The rows of the input matrix
+ * @param widthOriginal     The columns of the input matrix
+ * @param heightTarget      The rows of the output matrix
+ * @param widthTarget       The columns of the output matrix
+ * @param statisticsPtr     If not nullptr, set to the mean and standard
+ *                          deviation of the matrix before and after quantization
+ * @return                  The scale factor applied to the input matrix
+ */
+
+template<typename T> float quantizeLinear(const float* const inputMatrix,
+                                            T* const outputMatrix,
+                                            const size_t heightOriginal,
+                                            const size_t widthOriginal,
+                                            const size_t heightTarget,
+                                            const size_t widthTarget,
+                                            QuantizationStatistics* const statisticsPtr)
+{
+    static_assert(std::is_integral<T>::value && std::is_signed<T>::value,
+                        "Quantization target datatype has to be a signed integer");
+
+    if(heightTarget < heightOriginal)
+    {
+        throw std::invalid_argument("MpuSim Wrapper: quantizeLinear "
+                                        "target height smaller than original height");
+    }
+
+    if(widthTarget < widthOriginal)
+    {
+        throw std::invalid_argument("MpuSim Wrapper: quantizeLinear "
+                                        "target width smaller than original width");
+    }
+
+    if((heightOriginal == 0UL) || (widthOriginal == 0UL))
+    {
+        std::fill(outputMatrix, outputMatrix + heightTarget*widthTarget, T{0});
+
+        return 1.0F;
+    }
+
+    return statisticsPtr ? quantizeLinearFused<true>(inputMatrix,
+                                                        outputMatrix,
+                                                        heightOriginal,
+                                                        widthOriginal,
+                                                        heightTarget,
+                                                        widthTarget,
+                                                        statisticsPtr) :
+                            quantizeLinearFused<false>(inputMatrix,
+                                                        outputMatrix,
+                                                        heightOriginal,
+                                                        widthOriginal,
+                                                        heightTarget,
+                                                        widthTarget,
+                                                        statisticsPtr);
+}
+
+template<bool AddBias,
+            typename T> void dequantizeRow(const T* const inputRow,
+                                            float* const outputRow,
+                                            const size_t size,
+                                            const float scaleFactor,
+                                            const float* const biasVector,
+                                            const float outputValueMin,
+                                            const float outputValueMax)
+{
+    #pragma omp simd
+    for(size_t element = 0UL; element < size; ++element)
+    {
+        float value{static_cast<float>(inputRow[element])*scaleFactor};
+
+        if(AddBias)
+        {
+            value += biasVector[element];
+        }
+
+        outputRow[element] = std::min(std::max(value, outputValueMin), outputValueMax);
+    }
+}
+
+/**
+ * @brief                   Scale a row major integer result matrix back to
+ *                          floating point, crop it to the target size, add a
+ *                          bias to each row and clamp the result in a single
+ *                          vectorized pass, distributed across threads for
+ *                          large matrices. Activation functions that are
+ *                          clamps, like ReLU and ReLU6, are applied through
+ *                          the output value range.
+ * @param inputMatrix       The row major result matrix
+ * @param outputMatrix      The row major output matrix of the cropped size
+ * @param scaleFactor       The factor applied to each result
+ * @param heightOriginal    The rows of the result matrix
+ * @param widthOriginal     The columns of the result matrix
+ * @param heightCropped     The rows of the output matrix
+ * @param widthCropped      The columns of the output matrix
+ * @param biasVector        The bias of each output column, nullptr for none
+ * @param outputValueMin    The lower bound of the output values
+ * @param outputValueMax    The upper bound of the output values
+ */
+
+template<typename T> void dequantizeLinear(const T* const inputMatrix,
+                                            float* const outputMatrix,
+                                            const float scaleFactor,
+                                            const size_t heightOriginal,
+                                            const size_t widthOriginal,
+                                            const size_t heightCropped,
+                                            const size_t widthCropped,
+                                            const float* const biasVector,
+                                            const float outputValueMin,
+                                            const float outputValueMax)
+{
+    if(heightOriginal < heightCropped)
+    {
+        throw std::invalid_argument("MpuSim Wrapper: dequantizeLinear "
+                                        "target height larger than original height");
+    }
+
+    if(widthOriginal < widthCropped)
+    {
+        throw std::invalid_argument("MpuSim Wrapper: dequantizeLinear "
+                                        "target width larger than original width");
+    }
+
+    const bool parallel{(heightCropped*widthCropped) >=
+                                    quantizationParallelElementCountMin};
+
+    #pragma omp parallel for if(parallel)
+    for(size_t rowCount = 0UL; rowCount < heightCropped; ++rowCount)
+    {
+        if(biasVector)
+        {
+            dequantizeRow<true>(inputMatrix + rowCount*widthOriginal,
+                                    outputMatrix + rowCount*widthCropped,
+                                    widthCropped,
+                                    scaleFactor,
+                                    biasVector,
+                                    outputValueMin,
+                                    outputValueMax);
+        }
+
+        else
+        {
+            dequantizeRow<false>(inputMatrix + rowCount*widthOriginal,
+                                    outputMatrix + rowCount*widthCropped,
+                                    widthCropped,
+                                    scaleFactor,
+                                    biasVector,
+                                    outputValueMin,
+                                    outputValueMax);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,1029 @@
+/* Copyright (c) 2020 Computing Systems Group
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file        mpusim_wrapper_test.cpp
+ * @author      Kevin Stehle (stehle@stud.uni-heidelberg.de)
+ * @date        2020
+ * @copyright   MIT License
+ */
+
+#include <vector>
+#include <random>
+#include <iostream>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+#include "mpusim_wrapper.h"
+#include "mpu_instance_cache.h"
+#include "quantization_kernels.h"
+
+/**
+ * @class   TestMpuInstance
+ * @brief   MPU instance stand-in that only records its identifier,
+ *          so that the instance cache can be checked without simulation.
+ *          The identifier is appended to the given list on destruction.
+ */
+
+class TestMpuInstance final : public MpuInstanceHandle
+{
+
+public:
+
+    TestMpuInstance(const size_t id,
+                        std::vector<size_t>* const destroyedIdVectorPtr):
+                                m_id{id},
+                                m_destroyedIdVectorPtr{destroyedIdVectorPtr}
+    {
+    }
+
+    ~TestMpuInstance() override
+    {
+        m_destroyedIdVectorPtr->push_back(m_id);
+    }
+
+    void runMultiplication(const size_t,
+                            const size_t,
+                            const size_t,
+                            const float* const,
+                            const float* const,
+                            float* const,
+                            const std::string&,
+                            const float* const,
+                            const ActivationFunction) override
+    {
+    }
+
+    void printUnifiedBufferLayout() const override
+    {
+    }
+
+    std::string getStatisticsString() const override
+    {
+        return std::string();
+    }
+
+    size_t getQuantizedWeightMatrixHitCount() const override
+    {
+        return 0UL;
+    }
+
+    size_t getQuantizedWeightMatrixMissCount() const override
+    {
+        return 0UL;
+    }
+
+    size_t getId() const
+    {
+        return m_id;
+    }
+
+private:
+
+    const size_t m_id;
+
+    std::vector<size_t>* const m_destroyedIdVectorPtr;
+
+};
+
+static size_t getInstanceId(const MpuInstanceHandle& mpuInstance)
+{
+    return static_cast<const TestMpuInstance&>(mpuInstance).getId();
+}
+
+static MpuConfiguration getTestMpuConfiguration(const size_t systolicArrayHeight)
+{
+    return MpuConfiguration{1UL, 1UL, 4UL, systolicArrayHeight, 16UL, 8UL, 64UL};
+}
+
+static std::vector<size_t> getIdleInstanceIds(const MpuInstanceCache& mpuInstanceCache)
+{
+    std::vector<size_t> idVector;
+
+    mpuInstanceCache.forEach([&idVector](const MpuInstanceHandle& mpuInstance){
+        idVector.push_back(getInstanceId(mpuInstance));
+    });
+
+    return idVector;
+}
+
+static bool checkIdleInstanceIds(const MpuInstanceCache& mpuInstanceCache,
+                                    const std::vector<size_t>& idVectorExpected)
+{
+    const std::vector<size_t> idVector{getIdleInstanceIds(mpuInstanceCache)};
+
+    if(idVector != idVectorExpected)
+    {
+        std::cout << "Idle instances differ from expected order:";
+
+        for(const size_t id : idVector)
+        {
+            std::cout << " " << id;
+        }
+
+        std::cout << ", expected:";
+
+        for(const size_t id : idVectorExpected)
+        {
+            std::cout << " " << id;
+        }
+
+        std::cout << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief   Check that checking instances in beyond the capacity
+ *          evicts and destroys the least recently used idle ones,
+ *          and that an instance checked back in after a checkout
+ *          becomes the most recently used one
+ */
+
+static bool testInstanceCacheEviction()
+{
+    constexpr size_t capacity{3UL};
+
+    // Declared before the cache, which destroys its
+    // remaining instances when it goes out of scope
+
+    std::vector<size_t> destroyedIdVector;
+
+    MpuInstanceCache mpuInstanceCache(capacity);
+
+    bool testPassed{true};
+
+    const auto checkIn = [&](const size_t id)
+    {
+        return mpuInstanceCache.checkIn(getTestMpuConfiguration(16UL + id),
+                                            std::unique_ptr<MpuInstanceHandle>(
+                                                new TestMpuInstance(id, &destroyedIdVector)));
+    };
+
+    for(size_t id{0UL}; id < capacity; ++id)
+    {
+        if(checkIn(id) != 0UL)
+        {
+            std::cout << "Instance evicted below capacity" << std::endl;
+            testPassed = false;
+        }
+    }
+
+    testPassed &= checkIdleInstanceIds(mpuInstanceCache, {2UL, 1UL, 0UL});
+
+    // Using instance 0 makes instance 1 the least recently used one
+
+    std::unique_ptr<MpuInstanceHandle> mpuInstancePtr{
+                        mpuInstanceCache.checkOut(getTestMpuConfiguration(16UL))};
+
+    if(!mpuInstancePtr || (getInstanceId(*mpuInstancePtr) != 0UL))
+    {
+        std::cout << "Checkout did not return the idle instance" << std::endl;
+        return false;
+    }
+
+    testPassed &= checkIdleInstanceIds(mpuInstanceCache, {2UL, 1UL});
+
+    mpuInstanceCache.checkIn(getTestMpuConfiguration(16UL), std::move(mpuInstancePtr));
+
+    testPassed &= checkIdleInstanceIds(mpuInstanceCache, {0UL, 2UL, 1UL});
+
+    if(checkIn(3UL) != 1UL)
+    {
+        std::cout << "Check in beyond capacity did not evict one instance" << std::endl;
+        testPassed = false;
+    }
+
+    testPassed &= checkIdleInstanceIds(mpuInstanceCache, {3UL, 0UL, 2UL});
+
+    if(checkIn(4UL) != 1UL)
+    {
+        std::cout << "Check in beyond capacity did not evict one instance" << std::endl;
+        testPassed = false;
+    }
+
+    testPassed &= checkIdleInstanceIds(mpuInstanceCache, {4UL, 3UL, 0UL});
+
+    if(destroyedIdVector != std::vector<size_t>{1UL, 2UL})
+    {
+        std::cout << "Evicted instances were not destroyed in least recently used order" << std::endl;
+        testPassed = false;
+    }
+
+    // Evicted configurations are no longer available
+
+    if(mpuInstanceCache.checkOut(getTestMpuConfiguration(17UL)))
+    {
+        std::cout << "Checkout returned an evicted instance" << std::endl;
+        testPassed = false;
+    }
+
+    if((mpuInstanceCache.getHitCount() != 1UL) ||
+            (mpuInstanceCache.getMissCount() != 1UL) ||
+            (mpuInstanceCache.getEvictionCount() != 2UL) ||
+            (mpuInstanceCache.size() != capacity))
+    {
+        std::cout << "Unexpected cache statistics: "
+                    << mpuInstanceCache.getStatisticsString() << std::endl;
+        testPassed = false;
+    }
+
+    return testPassed;
+}
+
+/**
+ * @brief   Check that two callers holding an instance of the same
+ *          configuration at the same time get separate instances,
+ *          and that both are pooled once they are checked back in
+ */
+
+static bool testInstanceCacheConcurrentCheckOut()
+{
+    constexpr size_t threadCount{2UL};
+
+    std::vector<size_t> destroyedIdVector;
+
+    MpuInstanceCache mpuInstanceCache(4UL);
+
+    const MpuConfiguration mpuConfiguration{getTestMpuConfiguration(16UL)};
+
+    mpuInstanceCache.checkIn(mpuConfiguration,
+                                std::unique_ptr<MpuInstanceHandle>(
+                                        new TestMpuInstance(0UL, &destroyedIdVector)));
+
+    std::vector<const MpuInstanceHandle*> mpuInstancePtrVector(threadCount, nullptr);
+
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    size_t checkedOutCount{0UL};
+
+    const auto runCaller = [&](const size_t threadId)
+    {
+        std::unique_ptr<MpuInstanceHandle> mpuInstancePtr{
+                                        mpuInstanceCache.checkOut(mpuConfiguration)};
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if(!mpuInstancePtr)
+        {
+            mpuInstancePtr.reset(new TestMpuInstance(1UL + threadId, &destroyedIdVector));
+        }
+
+        mpuInstancePtrVector[threadId] = mpuInstancePtr.get();
+
+        // Hold the instance until both callers have one
+
+        ++checkedOutCount;
+        conditionVariable.notify_all();
+        conditionVariable.wait(lock, [&](){return checkedOutCount == threadCount;});
+
+        lock.unlock();
+
+        mpuInstanceCache.checkIn(mpuConfiguration, std::move(mpuInstancePtr));
+    };
+
+    std::vector<std::thread> threadVector;
+
+    for(size_t threadId{0UL}; threadId < threadCount; ++threadId)
+    {
+        threadVector.emplace_back(runCaller, threadId);
+    }
+
+    for(std::thread& thread : threadVector)
+    {
+        thread.join();
+    }
+
+    bool testPassed{true};
+
+    if(mpuInstancePtrVector[0] == mpuInstancePtrVector[1])
+    {
+        std::cout << "Concurrent callers shared an MPU instance" << std::endl;
+        testPassed = false;
+    }
+
+    if((mpuInstanceCache.getHitCount() != 1UL) ||
+            (mpuInstanceCache.getMissCount() != 1UL) ||
+            (mpuInstanceCache.size() != threadCount) ||
+            !destroyedIdVector.empty())
+    {
+        std::cout << "Unexpected cache statistics: "
+                    << mpuInstanceCache.getStatisticsString() << std::endl;
+        testPassed = false;
+    }
+
+    // Both instances are pooled under the same configuration
+
+    std::unique_ptr<MpuInstanceHandle> mpuInstancePtrFirst{
+                                    mpuInstanceCache.checkOut(mpuConfiguration)};
+    std::unique_ptr<MpuInstanceHandle> mpuInstancePtrSecond{
+                                    mpuInstanceCache.checkOut(mpuConfiguration)};
+
+    if(!mpuInstancePtrFirst || !mpuInstancePtrSecond ||
+            (mpuInstancePtrFirst.get() == mpuInstancePtrSecond.get()) ||
+            mpuInstanceCache.checkOut(mpuConfiguration))
+    {
+        std::cout << "Pooled instances of the same configuration "
+                        "were not returned separately" << std::endl;
+        testPassed = false;
+    }
+
+    return testPassed;
+}
+
+/**
+ * @brief   Get the largest float not exceeding the maximum of T
+ */
+
+template<typename T> float getReferenceRangeMax()
+{
+    float rangeMax{static_cast<float>(std::numeric_limits<T>::max())};
+
+    while(static_cast<long double>(rangeMax) >
+                static_cast<long double>(std::numeric_limits<T>::max()))
+    {
+        rangeMax = std::nextafter(rangeMax, 0.0F);
+    }
+
+    return rangeMax;
+}
+
+static bool checkStatisticsValue(const double value,
+                                    const double valueReference,
+                                    const double scale,
+                                    const std::string& nameString)
+{
+    if(std::fabs(value - valueReference) > 1e-6*std::max(scale, 1.0))
+    {
+        std::cout << nameString << " " << value
+                    << " differs from reference " << valueReference << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief   Compare quantizeLinear for the integer datatype T against
+ *          a plain element by element reference, for unpadded, row
+ *          padded, column padded, and fully padded output matrices,
+ *          each small enough for the sequential and large enough for
+ *          the parallel passes, with and without statistics
+ */
+
+template<typename T> bool checkQuantizeLinear(std::default_random_engine& rng)
+{
+    struct MatrixShape
+    {
+        size_t heightOriginal;
+        size_t widthOriginal;
+        size_t heightTarget;
+        size_t widthTarget;
+    };
+
+    const std::vector<MatrixShape> matrixShapeVector{{1UL, 1UL, 1UL, 1UL},
+                                                        {7UL, 5UL, 7UL, 5UL},
+                                                        {7UL, 5UL, 9UL, 5UL},
+                                                        {7UL, 5UL, 7UL, 8UL},
+                                                        {7UL, 5UL, 9UL, 8UL},
+                                                        {300UL, 250UL, 300UL, 250UL},
+                                                        {300UL, 250UL, 301UL, 250UL},
+                                                        {300UL, 250UL, 300UL, 257UL},
+                                                        {300UL, 250UL, 301UL, 257UL}};
+
+    std::normal_distribution<float> valueDistribution(0.5F, 3.0F);
+
+    const float rangeMax{getReferenceRangeMax<T>()};
+
+    bool testPassed{true};
+
+    for(const MatrixShape& matrixShape : matrixShapeVector)
+    {
+        for(const bool computeStatistics : {false, true})
+        {
+            const size_t elementCountOriginal{matrixShape.heightOriginal*
+                                                    matrixShape.widthOriginal};
+
+            std::vector<float> inputMatrix(elementCountOriginal);
+
+            for(float& value : inputMatrix)
+            {
+                value = valueDistribution(rng);
+            }
+
+            // Prefill the output so that missing padding is detected
+
+            std::vector<T> outputMatrix(matrixShape.heightTarget*
+                                            matrixShape.widthTarget, T{37});
+
+            QuantizationStatistics quantizationStatistics;
+
+            const float scaleFactor{quantizeLinear(inputMatrix.data(),
+                                                    outputMatrix.data(),
+                                                    matrixShape.heightOriginal,
+                                                    matrixShape.widthOriginal,
+                                                    matrixShape.heightTarget,
+                                                    matrixShape.widthTarget,
+                                                    computeStatistics ?
+                                                        &quantizationStatistics : nullptr)};
+
+            float inputValueAbsMax{0.0F};
+
+            for(const float value : inputMatrix)
+            {
+                inputValueAbsMax = std::max(inputValueAbsMax, std::fabs(value));
+            }
+
+            const float scaleFactorReference{rangeMax/inputValueAbsMax};
+
+            if(scaleFactor != scaleFactorReference)
+            {
+                std::cout << "Scale factor " << scaleFactor << " differs from reference "
+                            << scaleFactorReference << " for " << sizeof(T)
+                            << " byte datatype" << std::endl;
+                testPassed = false;
+            }
+
+            std::vector<double> quantizedValueVector;
+
+            size_t mismatchCount{0UL};
+
+            for(size_t rowCount{0UL}; rowCount < matrixShape.heightTarget; ++rowCount)
+            {
+                for(size_t columnCount{0UL}; columnCount < matrixShape.widthTarget; ++columnCount)
+                {
+                    T valueReference{0};
+
+                    if((rowCount < matrixShape.heightOriginal) &&
+                                (columnCount < matrixShape.widthOriginal))
+                    {
+                        const float value{inputMatrix[rowCount*matrixShape.widthOriginal +
+                                                                            columnCount]};
+
+                        valueReference = static_cast<T>(std::min(std::max(value*scaleFactorReference,
+                                                                            -rangeMax), rangeMax));
+
+                        quantizedValueVector.push_back(static_cast<double>(valueReference));
+                    }
+
+                    if(outputMatrix[rowCount*matrixShape.widthTarget + columnCount] != valueReference)
+                    {
+                        ++mismatchCount;
+                    }
+                }
+            }
+
+            if(mismatchCount != 0UL)
+            {
+                std::cout << mismatchCount << " quantized values of "
+                            << matrixShape.heightOriginal << "x" << matrixShape.widthOriginal
+                            << " matrix padded to " << matrixShape.heightTarget << "x"
+                            << matrixShape.widthTarget << " differ from reference for "
+                            << sizeof(T) << " byte datatype" << std::endl;
+                testPassed = false;
+            }
+
+            if(computeStatistics)
+            {
+                const auto getMeanAndStdDev = [](const std::vector<double>& valueVector,
+                                                    double& mean, double& stdDev)
+                {
+                    mean = 0.0;
+
+                    for(const double value : valueVector)
+                    {
+                        mean += value;
+                    }
+
+                    mean /= static_cast<double>(valueVector.size());
+
+                    double squareSum{0.0};
+
+                    for(const double value : valueVector)
+                    {
+                        squareSum += (value - mean)*(value - mean);
+                    }
+
+                    stdDev = std::sqrt(squareSum/static_cast<double>(valueVector.size()));
+                };
+
+                const std::vector<double> unquantizedValueVector(inputMatrix.begin(),
+                                                                    inputMatrix.end());
+
+                double meanUnquantized;
+                double stdDevUnquantized;
+                double meanQuantized;
+                double stdDevQuantized;
+
+                getMeanAndStdDev(unquantizedValueVector, meanUnquantized, stdDevUnquantized);
+                getMeanAndStdDev(quantizedValueVector, meanQuantized, stdDevQuantized);
+
+                testPassed &= checkStatisticsValue(quantizationStatistics.meanUnquantized,
+                                                    meanUnquantized, inputValueAbsMax,
+                                                    "Mean of unquantized values");
+                testPassed &= checkStatisticsValue(quantizationStatistics.stdDevUnquantized,
+                                                    stdDevUnquantized, inputValueAbsMax,
+                                                    "Standard deviation of unquantized values");
+                testPassed &= checkStatisticsValue(quantizationStatistics.meanQuantized,
+                                                    meanQuantized, rangeMax,
+                                                    "Mean of quantized values");
+                testPassed &= checkStatisticsValue(quantizationStatistics.stdDevQuantized,
+                                                    stdDevQuantized, rangeMax,
+                                                    "Standard deviation of quantized values");
+            }
+        }
+    }
+
+    // An all zero matrix is not scaled
+
+    std::vector<float> zeroMatrix(6UL, 0.0F);
+    std::vector<T> outputMatrix(12UL, T{37});
+
+    if((quantizeLinear(zeroMatrix.data(), outputMatrix.data(),
+                            2UL, 3UL, 3UL, 4UL, nullptr) != 1.0F) ||
+            (std::count(outputMatrix.begin(), outputMatrix.end(), T{0}) != 12))
+    {
+        std::cout << "All zero matrix not quantized to zeros with scale factor 1" << std::endl;
+        testPassed = false;
+    }
+
+    try
+    {
+        quantizeLinear(zeroMatrix.data(), outputMatrix.data(),
+                            3UL, 2UL, 2UL, 6UL, nullptr);
+
+        std::cout << "Target height smaller than original height accepted" << std::endl;
+        testPassed = false;
+    }
+
+    catch(const std::invalid_argument&)
+    {
+    }
+
+    return testPassed;
+}
+
+static bool testQuantizeLinear()
+{
+    std::default_random_engine rng(0UL);
+
+    bool testPassed{true};
+
+    testPassed &= checkQuantizeLinear<int8_t>(rng);
+    testPassed &= checkQuantizeLinear<int16_t>(rng);
+    testPassed &= checkQuantizeLinear<int32_t>(rng);
+    testPassed &= checkQuantizeLinear<int64_t>(rng);
+
+    return testPassed;
+}
+
+#ifdef MPUSIM_WRAPPER_NO_WEIGHT_REUSE
+constexpr bool weightMatrixReuseEnabled{false};
+#else
+constexpr bool weightMatrixReuseEnabled{true};
+#endif
+
+/**
+ * @brief   Check a result matrix of the wrapper against a double precision
+ *          reference. Each product is off by at most the quantization steps
+ *          of both operands, which are 1/127 of their absolute maximum of
+ *          at most 1.
+ */
+
+static bool checkWeightMatrixCacheResults(const std::vector<float>& activationMatrix,
+                                            const std::vector<float>& weightMatrix,
+                                            const std::vector<float>& resultMatrix,
+                                            const size_t sizeM,
+                                            const size_t sizeN,
+                                            const size_t sizeK)
+{
+    const float tolerance{static_cast<float>(sizeK)*2.0F/127.0F};
+
+    for(size_t rowCount{0UL}; rowCount < sizeM; ++rowCount)
+    {
+        for(size_t columnCount{0UL}; columnCount < sizeN; ++columnCount)
+        {
+            double resultReference{0.0};
+
+            for(size_t count{0UL}; count < sizeK; ++count)
+            {
+                resultReference += static_cast<double>(activationMatrix[rowCount*sizeK + count])*
+                                    static_cast<double>(weightMatrix[count*sizeN + columnCount]);
+            }
+
+            if(std::fabs(resultMatrix[rowCount*sizeN + columnCount] - resultReference) > tolerance)
+            {
+                std::cout << "Result differs from reference" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief   Check that repeated multiplications of an operation reuse
+ *          its quantized weight matrix, that changing the weights of
+ *          the operation quantizes them again, and that the results
+ *          follow the changed weights. Small weight matrices are
+ *          fingerprinted completely, so changing a single element is
+ *          detected. A change confined to an element that the sampled
+ *          fingerprint of a large weight matrix skips is not detected,
+ *          which is the documented limitation of the weight reuse,
+ *          unless the reuse is disabled at compile time.
+ */
+
+static bool testWeightMatrixCache()
+{
+    constexpr size_t sizeM{8UL};
+
+    MpuSimWrapper& mpuSimWrapper{MpuSimWrapper::getInstance()};
+
+    std::default_random_engine rng(0UL);
+    std::uniform_real_distribution<float> valueDistribution(-1.0F, 1.0F);
+
+    const auto getRandomMatrix = [&](const size_t size)
+    {
+        std::vector<float> matrix(size);
+
+        for(float& value : matrix)
+        {
+            value = valueDistribution(rng);
+        }
+
+        return matrix;
+    };
+
+    const auto runMultiplication = [&](const std::vector<float>& activationMatrix,
+                                        const std::vector<float>& weightMatrix,
+                                        const size_t sizeN,
+                                        const size_t sizeK,
+                                        const std::string& operationNameString)
+    {
+        std::vector<float> resultMatrix(sizeM*sizeN);
+
+        mpuSimWrapper.runMultiplication(1UL, 1UL, 4UL, 16UL, 16UL, 8UL, 64UL,
+                                            sizeM, sizeN, sizeK,
+                                            activationMatrix.data(),
+                                            weightMatrix.data(),
+                                            resultMatrix.data(),
+                                            ".", "mpusim_wrapper_test",
+                                            operationNameString);
+
+        return resultMatrix;
+    };
+
+    // Counts the multiplications that reuse or quantize
+    // the weight matrix if the reuse is enabled
+
+    size_t hitCountExpected{0UL};
+    size_t missCountExpected{0UL};
+
+    const auto checkCounts = [&](const bool reuseExpected)
+    {
+        if(reuseExpected && weightMatrixReuseEnabled)
+        {
+            ++hitCountExpected;
+        }
+
+        else
+        {
+            ++missCountExpected;
+        }
+
+        if((mpuSimWrapper.getQuantizedWeightMatrixHitCount() != hitCountExpected) ||
+                (mpuSimWrapper.getQuantizedWeightMatrixMissCount() != missCountExpected))
+        {
+            std::cout << "Quantized weight matrix reuses: "
+                        << mpuSimWrapper.getQuantizedWeightMatrixHitCount()
+                        << ", quantizations: "
+                        << mpuSimWrapper.getQuantizedWeightMatrixMissCount()
+                        << ", expected " << hitCountExpected << " and "
+                        << missCountExpected << std::endl;
+            return false;
+        }
+
+        return true;
+    };
+
+    bool testPassed{true};
+
+    constexpr size_t sizeN{12UL};
+    constexpr size_t sizeK{10UL};
+
+    const std::vector<float> activationMatrix{getRandomMatrix(sizeM*sizeK)};
+
+    std::vector<float> weightMatrix{getRandomMatrix(sizeK*sizeN)};
+
+    const std::vector<float> resultMatrixFirst{runMultiplication(activationMatrix, weightMatrix,
+                                                                    sizeN, sizeK,
+                                                                    "weight_matrix_cache_test")};
+
+    testPassed &= checkCounts(false);
+    testPassed &= checkWeightMatrixCacheResults(activationMatrix, weightMatrix,
+                                                    resultMatrixFirst, sizeM, sizeN, sizeK);
+
+    const std::vector<float> resultMatrixReused{runMultiplication(activationMatrix, weightMatrix,
+                                                                    sizeN, sizeK,
+                                                                    "weight_matrix_cache_test")};
+
+    testPassed &= checkCounts(true);
+
+    if(resultMatrixReused != resultMatrixFirst)
+    {
+        std::cout << "Results with reused weight matrix differ" << std::endl;
+        testPassed = false;
+    }
+
+    weightMatrix = getRandomMatrix(sizeK*sizeN);
+
+    testPassed &= checkWeightMatrixCacheResults(activationMatrix, weightMatrix,
+                                                    runMultiplication(activationMatrix, weightMatrix,
+                                                                        sizeN, sizeK,
+                                                                        "weight_matrix_cache_test"),
+                                                    sizeM, sizeN, sizeK);
+    testPassed &= checkCounts(false);
+
+    // A change of a single element of a small
+    // weight matrix is quantized again
+
+    weightMatrix[1] = -weightMatrix[1];
+
+    testPassed &= checkWeightMatrixCacheResults(activationMatrix, weightMatrix,
+                                                    runMultiplication(activationMatrix, weightMatrix,
+                                                                        sizeN, sizeK,
+                                                                        "weight_matrix_cache_test"),
+                                                    sizeM, sizeN, sizeK);
+    testPassed &= checkCounts(false);
+
+    // The fingerprint of this weight matrix is sampled with a
+    // stride of sizeN, so its element (0, 1) is not sampled
+
+    constexpr size_t sizeNSampled{272UL};
+    constexpr size_t sizeKSampled{256UL};
+
+    const std::vector<float> activationMatrixSampled{getRandomMatrix(sizeM*sizeKSampled)};
+
+    std::vector<float> weightMatrixSampled{getRandomMatrix(sizeKSampled*sizeNSampled)};
+
+    const std::vector<float> resultMatrixSampledFirst{runMultiplication(activationMatrixSampled,
+                                                                        weightMatrixSampled,
+                                                                        sizeNSampled, sizeKSampled,
+                                                                        "weight_matrix_cache_sampled_test")};
+
+    testPassed &= checkCounts(false);
+
+    weightMatrixSampled[1] = -weightMatrixSampled[1];
+
+    const std::vector<float> resultMatrixSampledChanged{runMultiplication(activationMatrixSampled,
+                                                                            weightMatrixSampled,
+                                                                            sizeNSampled, sizeKSampled,
+                                                                            "weight_matrix_cache_sampled_test")};
+
+    testPassed &= checkCounts(true);
+
+    if(weightMatrixReuseEnabled)
+    {
+        if(resultMatrixSampledChanged != resultMatrixSampledFirst)
+        {
+            std::cout << "Change of an element not sampled by the "
+                            "fingerprint was detected" << std::endl;
+            testPassed = false;
+        }
+    }
+
+    else
+    {
+        testPassed &= checkWeightMatrixCacheResults(activationMatrixSampled, weightMatrixSampled,
+                                                        resultMatrixSampledChanged, sizeM,
+                                                        sizeNSampled, sizeKSampled);
+    }
+
+    return testPassed;
+}
+
+/**
+ * @brief   Check the fused dequantization, bias addition and activation
+ *          function of the wrapper against a double precision reference
+ *          for each activation function. The result matrix is padded to
+ *          the systolic array width, so the results are also cropped.
+ */
+
+static bool testFusedBiasActivation()
+{
+    constexpr size_t sizeM{37UL};
+    constexpr size_t sizeN{29UL};
+    constexpr size_t sizeK{50UL};
+
+    // Activations in [-2, 2] make some results exceed
+    // the upper bound of ReLU6. With truncating quantization,
+    // each product is off by at most the quantization step of
+    // the activations times 1 plus that of the weights times 2.
+
+    constexpr float activationValueAbsMax{2.0F};
+
+    const float tolerance{static_cast<float>(sizeK)*4.0F/127.0F};
+
+    MpuSimWrapper& mpuSimWrapper{MpuSimWrapper::getInstance()};
+
+    std::default_random_engine rng(0UL);
+    std::uniform_real_distribution<float> valueDistribution(-1.0F, 1.0F);
+
+    std::vector<float> activationMatrix(sizeM*sizeK);
+    std::vector<float> weightMatrix(sizeK*sizeN);
+    std::vector<float> biasVector(sizeN);
+
+    for(float& value : activationMatrix)
+    {
+        value = activationValueAbsMax*valueDistribution(rng);
+    }
+
+    for(float& value : weightMatrix)
+    {
+        value = valueDistribution(rng);
+    }
+
+    for(float& value : biasVector)
+    {
+        value = valueDistribution(rng);
+    }
+
+    bool testPassed{true};
+
+    for(const ActivationFunction activationFunction : {ActivationFunction::None,
+                                                        ActivationFunction::Relu,
+                                                        ActivationFunction::Relu6})
+    {
+        std::vector<float> resultMatrix(sizeM*sizeN);
+
+        mpuSimWrapper.runMultiplication(1UL, 1UL, 4UL, 16UL, 16UL, 8UL, 64UL,
+                                            sizeM, sizeN, sizeK,
+                                            activationMatrix.data(),
+                                            weightMatrix.data(),
+                                            resultMatrix.data(),
+                                            ".", "mpusim_wrapper_test",
+                                            "fused_bias_activation_test",
+                                            biasVector.data(),
+                                            activationFunction);
+
+        size_t mismatchCount{0UL};
+
+        for(size_t rowCount{0UL}; rowCount < sizeM; ++rowCount)
+        {
+            for(size_t columnCount{0UL}; columnCount < sizeN; ++columnCount)
+            {
+                double resultReference{static_cast<double>(biasVector[columnCount])};
+
+                for(size_t count{0UL}; count < sizeK; ++count)
+                {
+                    resultReference += static_cast<double>(activationMatrix[rowCount*sizeK + count])*
+                                        static_cast<double>(weightMatrix[count*sizeN + columnCount]);
+                }
+
+                if(activationFunction != ActivationFunction::None)
+                {
+                    resultReference = std::max(resultReference, 0.0);
+                }
+
+                if(activationFunction == ActivationFunction::Relu6)
+                {
+                    resultReference = std::min(resultReference, 6.0);
+                }
+
+                if(std::fabs(resultMatrix[rowCount*sizeN + columnCount] - resultReference) > tolerance)
+                {
+                    ++mismatchCount;
+                }
+            }
+        }
+
+        if(mismatchCount != 0UL)
+        {
+            std::cout << mismatchCount << " results with bias and activation function "
+                        << static_cast<int>(activationFunction)
+                        << " differ from reference" << std::endl;
+            testPassed = false;
+        }
+    }
+
+    return testPassed;
+}
+
+int main()
+{
+    std::cout << "MPU wrapper test 0: MPU instance cache eviction" << std::endl;
+
+    const bool evictionCheckPassed{testInstanceCacheEviction()};
+
+    std::cout << "MPU wrapper test 1: Concurrent MPU instance checkout" << std::endl;
+
+    const bool concurrentCheckOutCheckPassed{testInstanceCacheConcurrentCheckOut()};
+
+    std::cout << "MPU wrapper test 2: Linear quantization" << std::endl;
+
+    const bool quantizationCheckPassed{testQuantizeLinear()};
+
+    std::cout << "MPU wrapper test 3: Quantized weight matrix reuse" << std::endl;
+
+    const bool weightMatrixCacheCheckPassed{testWeightMatrixCache()};
+
+    std::cout << "MPU wrapper test 4: Fused bias and activation function" << std::endl;
+
+    const bool fusedBiasActivationCheckPassed{testFusedBiasActivation()};
+
+    std::cout << "\n";
+
+    if(evictionCheckPassed)
+    {
+        std::cout << "Test 0: MPU instance cache eviction\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 0: MPU instance cache eviction\t\tFAILED\n\n";
+    }
+
+    if(concurrentCheckOutCheckPassed)
+    {
+        std::cout << "Test 1: Concurrent MPU instance checkout\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 1: Concurrent MPU instance checkout\t\tFAILED\n\n";
+    }
+
+    if(quantizationCheckPassed)
+    {
+        std::cout << "Test 2: Linear quantization\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 2: Linear quantization\t\tFAILED\n\n";
+    }
+
+    if(weightMatrixCacheCheckPassed)
+    {
+        std::cout << "Test 3: Quantized weight matrix reuse\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 3: Quantized weight matrix reuse\t\tFAILED\n\n";
+    }
+
+    if(fusedBiasActivationCheckPassed)
+    {
+        std::cout << "Test 4: Fused bias and activation function\t\tPASSED\n\n";
+    }
+
+    else
+    {
+        std::cout << "Test 4: Fused bias and activation function\t\tFAILED\n\n";
+    }
+
+    if(!(evictionCheckPassed && concurrentCheckOutCheckPassed &&
+                quantizationCheckPassed && weightMatrixCacheCheckPassed &&
+                fusedBiasActivationCheckPassed))
+    {
+        return -1;
+    }
+
+    else
+    {
+        return 0;
+    }
+}